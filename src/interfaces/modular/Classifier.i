@@ -65,6 +65,8 @@
 %rename(DirectorLinearMachine) CDirectorLinearMachine;
 %rename(DirectorKernelMachine) CDirectorKernelMachine;
 %rename(BaggingMachine) CBaggingMachine;
+%rename(DecisionTree) CDecisionTree;
+%rename(GradientBoostedTrees) CGradientBoostedTrees;
 
 /* These functions return new Objects */
 %newobject apply();
@@ -108,6 +110,8 @@
 %include <shogun/machine/DirectorLinearMachine.h>
 %include <shogun/machine/DirectorKernelMachine.h>
 %include <shogun/machine/BaggingMachine.h>
+%include <shogun/machine/DecisionTree.h>
+%include <shogun/machine/GradientBoostedTrees.h>
 
 #ifdef USE_SVMLIGHT
 
@@ -38,4 +38,6 @@
  #include <shogun/machine/DirectorLinearMachine.h>
  #include <shogun/machine/DirectorKernelMachine.h>
  #include <shogun/machine/BaggingMachine.h>
+ #include <shogun/machine/DecisionTree.h>
+ #include <shogun/machine/GradientBoostedTrees.h>
 %}
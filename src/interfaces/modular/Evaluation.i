@@ -28,6 +28,7 @@
 %rename(MeanSquaredError) CMeanSquaredError;
 %rename(MeanSquaredLogError) CMeanSquaredLogError;
 %rename(ROCEvaluation) CROCEvaluation;
+%rename(StreamingROCEvaluation) CStreamingROCEvaluation;
 %rename(PRCEvaluation) CPRCEvaluation;
 %rename(AccuracyMeasure) CAccuracyMeasure;
 %rename(ErrorRateMeasure) CErrorRateMeasure;
@@ -67,6 +68,7 @@
 %include <shogun/evaluation/MeanSquaredError.h>
 %include <shogun/evaluation/MeanSquaredLogError.h>
 %include <shogun/evaluation/ROCEvaluation.h>
+%include <shogun/evaluation/StreamingROCEvaluation.h>
 %include <shogun/evaluation/PRCEvaluation.h>
 %include <shogun/evaluation/MachineEvaluation.h>
 %include <shogun/evaluation/CrossValidation.h>
@@ -11,6 +11,7 @@
  #include <shogun/evaluation/MeanSquaredError.h>
  #include <shogun/evaluation/MeanSquaredLogError.h>
  #include <shogun/evaluation/ROCEvaluation.h>
+ #include <shogun/evaluation/StreamingROCEvaluation.h>
  #include <shogun/evaluation/PRCEvaluation.h>
  #include <shogun/evaluation/MachineEvaluation.h>
  #include <shogun/evaluation/CrossValidation.h>
@@ -102,6 +102,9 @@ PROTOCOLS_CUSTOMKERNEL(CustomKernel, float32_t, "f\0", NPY_FLOAT32)
 %rename(JensenShannonKernel) CJensenShannonKernel;
 %rename(LinearARDKernel) CLinearARDKernel;
 %rename(GaussianARDKernel) CGaussianARDKernel;
+%rename(ApproximateKernel) CApproximateKernel;
+%rename(NystromKernel) CNystromKernel;
+%rename(RandomFourierKernel) CRandomFourierKernel;
 
 /* Include Class Headers to make them visible from within the target language */
 %include <shogun/kernel/Kernel.h>
@@ -216,5 +219,8 @@ namespace shogun
 %include <shogun/kernel/JensenShannonKernel.h>
 %include <shogun/kernel/LinearARDKernel.h>
 %include <shogun/kernel/GaussianARDKernel.h>
+%include <shogun/kernel/ApproximateKernel.h>
+%include <shogun/kernel/NystromKernel.h>
+%include <shogun/kernel/RandomFourierKernel.h>
 
 EXTEND_CUSTOMKERNEL(CustomKernel, float32_t, NPY_FLOAT32)
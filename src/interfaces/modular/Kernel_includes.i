@@ -73,4 +73,7 @@
 #include <shogun/kernel/JensenShannonKernel.h>
 #include <shogun/kernel/LinearARDKernel.h>
 #include <shogun/kernel/GaussianARDKernel.h>
+#include <shogun/kernel/ApproximateKernel.h>
+#include <shogun/kernel/NystromKernel.h>
+#include <shogun/kernel/RandomFourierKernel.h>
 %}
@@ -108,6 +108,8 @@ namespace shogun
 #endif
 }
 
+%rename (KernelOperator) CKernelOperator;
+%rename (LowRankInverseOperator) CLowRankInverseOperator;
 %rename (ConjugateGradientSolver) CConjugateGradientSolver;
 %rename (ConjugateOrthogonalCGSolver) CConjugateOrthogonalCGSolver;
 
@@ -141,6 +143,8 @@ namespace shogun
 %include <shogun/mathematics/linalg/linop/MatrixOperator.h>
 %include <shogun/mathematics/linalg/linop/SparseMatrixOperator.h>
 %include <shogun/mathematics/linalg/linop/DenseMatrixOperator.h>
+%include <shogun/mathematics/linalg/linop/KernelOperator.h>
+%include <shogun/mathematics/linalg/linop/LowRankInverseOperator.h>
 
 %include <shogun/mathematics/linalg/ratapprox/opfunc/OperatorFunction.h>
 %include <shogun/mathematics/linalg/ratapprox/opfunc/RationalApproximation.h>
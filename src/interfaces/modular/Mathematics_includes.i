@@ -12,6 +12,8 @@
 #include <shogun/mathematics/linalg/linop/MatrixOperator.h>
 #include <shogun/mathematics/linalg/linop/SparseMatrixOperator.h>
 #include <shogun/mathematics/linalg/linop/DenseMatrixOperator.h>
+#include <shogun/mathematics/linalg/linop/KernelOperator.h>
+#include <shogun/mathematics/linalg/linop/LowRankInverseOperator.h>
 
 #include <shogun/mathematics/linalg/ratapprox/opfunc/OperatorFunction.h>
 #include <shogun/mathematics/linalg/ratapprox/opfunc/RationalApproximation.h>
@@ -636,294 +636,294 @@ void Parameter::add(SGVector<bool>* param, const char* name,
 		const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_NONE, PT_BOOL, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<char>* param, const char* name,
 		const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_NONE, PT_CHAR, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<int8_t>* param, const char* name,
 		const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_NONE, PT_INT8, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<uint8_t>* param, const char* name,
 		const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_NONE, PT_UINT8, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<int16_t>* param, const char* name,
 		const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_NONE, PT_INT16, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<uint16_t>* param, const char* name,
 		const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_NONE, PT_UINT16, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<int32_t>* param, const char* name,
 		const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_NONE, PT_INT32, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<uint32_t>* param, const char* name,
 		const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_NONE, PT_UINT32, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<int64_t>* param, const char* name,
 		const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_NONE, PT_INT64, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<uint64_t>* param, const char* name,
 		const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_NONE, PT_UINT64, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<float32_t>* param, const char* name,
 		const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_NONE, PT_FLOAT32, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<float64_t>* param, const char* name,
 		const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_NONE, PT_FLOAT64, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<floatmax_t>* param, const char* name,
 		const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_NONE, PT_FLOATMAX, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<complex128_t>* param, const char* name,
 		const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_NONE, PT_COMPLEX128, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<CSGObject*>* param, const char* name,
 		const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_NONE, PT_SGOBJECT, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGString<bool> >* param, const char* name,
 		const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_STRING, PT_BOOL, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGString<char> >* param, const char* name,
 		const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_STRING, PT_CHAR, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGString<int8_t> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_STRING, PT_INT8, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGString<uint8_t> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_STRING, PT_UINT8, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGString<int16_t> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_STRING, PT_INT16, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGString<uint16_t> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_STRING, PT_UINT16, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGString<int32_t> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_STRING, PT_INT32, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGString<uint32_t> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_STRING, PT_UINT32, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGString<int64_t> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_STRING, PT_INT64, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGString<uint64_t> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_STRING, PT_UINT64, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGString<float32_t> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_STRING, PT_FLOAT32, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGString<float64_t> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_STRING, PT_FLOAT64, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGString<floatmax_t> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_STRING, PT_FLOATMAX, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGSparseVector<bool> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_SPARSE, PT_BOOL, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGSparseVector<char> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_SPARSE, PT_CHAR, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGSparseVector<int8_t> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_SPARSE, PT_INT8, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGSparseVector<uint8_t> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_SPARSE, PT_UINT8, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGSparseVector<int16_t> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_SPARSE, PT_INT16, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGSparseVector<uint16_t> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_SPARSE, PT_UINT16, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGSparseVector<int32_t> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_SPARSE, PT_INT32, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGSparseVector<uint32_t> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_SPARSE, PT_UINT32, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGSparseVector<int64_t> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_SPARSE, PT_INT64, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGSparseVector<uint64_t> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_SPARSE, PT_UINT64, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGSparseVector<float32_t> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_SPARSE, PT_FLOAT32, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGSparseVector<float64_t> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_SPARSE, PT_FLOAT64, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGSparseVector<floatmax_t> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_SPARSE, PT_FLOATMAX, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 void Parameter::add(SGVector<SGSparseVector<complex128_t> >* param,
 		const char* name, const char* description)
 {
 	TSGDataType type(CT_SGVECTOR, ST_SPARSE, PT_COMPLEX128, &param->vlen);
-	add_type(&type, &param->vector, name, description);
+	add_type(&type, &param->vector, name, description, param);
 }
 
 /* **************************************************************** */
@@ -1315,7 +1315,7 @@ void Parameter::add(SGMatrix<bool>* param, const char* name,
 {
 	TSGDataType type(CT_SGMATRIX, ST_NONE, PT_BOOL, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<char>* param, const char* name,
@@ -1323,7 +1323,7 @@ void Parameter::add(SGMatrix<char>* param, const char* name,
 {
 	TSGDataType type(CT_SGMATRIX, ST_NONE, PT_CHAR, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<int8_t>* param, const char* name,
@@ -1331,7 +1331,7 @@ void Parameter::add(SGMatrix<int8_t>* param, const char* name,
 {
 	TSGDataType type(CT_SGMATRIX, ST_NONE, PT_INT8, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<uint8_t>* param, const char* name,
@@ -1339,7 +1339,7 @@ void Parameter::add(SGMatrix<uint8_t>* param, const char* name,
 {
 	TSGDataType type(CT_SGMATRIX, ST_NONE, PT_UINT8, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<int16_t>* param, const char* name,
@@ -1347,7 +1347,7 @@ void Parameter::add(SGMatrix<int16_t>* param, const char* name,
 {
 	TSGDataType type(CT_SGMATRIX, ST_NONE, PT_INT16, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<uint16_t>* param, const char* name,
@@ -1355,7 +1355,7 @@ void Parameter::add(SGMatrix<uint16_t>* param, const char* name,
 {
 	TSGDataType type(CT_SGMATRIX, ST_NONE, PT_UINT16, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<int32_t>* param, const char* name,
@@ -1363,7 +1363,7 @@ void Parameter::add(SGMatrix<int32_t>* param, const char* name,
 {
 	TSGDataType type(CT_SGMATRIX, ST_NONE, PT_INT32, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<uint32_t>* param, const char* name,
@@ -1371,7 +1371,7 @@ void Parameter::add(SGMatrix<uint32_t>* param, const char* name,
 {
 	TSGDataType type(CT_SGMATRIX, ST_NONE, PT_UINT32, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<int64_t>* param, const char* name,
@@ -1379,7 +1379,7 @@ void Parameter::add(SGMatrix<int64_t>* param, const char* name,
 {
 	TSGDataType type(CT_SGMATRIX, ST_NONE, PT_INT64, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<uint64_t>* param, const char* name,
@@ -1387,7 +1387,7 @@ void Parameter::add(SGMatrix<uint64_t>* param, const char* name,
 {
 	TSGDataType type(CT_SGMATRIX, ST_NONE, PT_UINT64, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<float32_t>* param, const char* name,
@@ -1395,7 +1395,7 @@ void Parameter::add(SGMatrix<float32_t>* param, const char* name,
 {
 	TSGDataType type(CT_SGMATRIX, ST_NONE, PT_FLOAT32, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<float64_t>* param, const char* name,
@@ -1403,7 +1403,7 @@ void Parameter::add(SGMatrix<float64_t>* param, const char* name,
 {
 	TSGDataType type(CT_SGMATRIX, ST_NONE, PT_FLOAT64, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<floatmax_t>* param, const char* name,
@@ -1411,7 +1411,7 @@ void Parameter::add(SGMatrix<floatmax_t>* param, const char* name,
 {
 	TSGDataType type(CT_SGMATRIX, ST_NONE, PT_FLOATMAX, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<complex128_t>* param, const char* name,
@@ -1419,7 +1419,7 @@ void Parameter::add(SGMatrix<complex128_t>* param, const char* name,
 {
 	TSGDataType type(CT_SGMATRIX, ST_NONE, PT_COMPLEX128, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<CSGObject*>* param, const char* name,
@@ -1427,7 +1427,7 @@ void Parameter::add(SGMatrix<CSGObject*>* param, const char* name,
 {
 	TSGDataType type(CT_SGMATRIX, ST_NONE, PT_SGOBJECT, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGString<bool> >* param, const char* name,
@@ -1435,7 +1435,7 @@ void Parameter::add(SGMatrix<SGString<bool> >* param, const char* name,
 {
 	TSGDataType type(CT_SGMATRIX, ST_STRING, PT_BOOL, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGString<char> >* param, const char* name,
@@ -1443,7 +1443,7 @@ void Parameter::add(SGMatrix<SGString<char> >* param, const char* name,
 {
 	TSGDataType type(CT_SGMATRIX, ST_STRING, PT_CHAR, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGString<int8_t> >* param,
@@ -1451,7 +1451,7 @@ void Parameter::add(SGMatrix<SGString<int8_t> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_STRING, PT_INT8, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGString<uint8_t> >* param,
@@ -1459,7 +1459,7 @@ void Parameter::add(SGMatrix<SGString<uint8_t> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_STRING, PT_UINT8, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGString<int16_t> >* param,
@@ -1467,7 +1467,7 @@ void Parameter::add(SGMatrix<SGString<int16_t> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_STRING, PT_INT16, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGString<uint16_t> >* param,
@@ -1475,7 +1475,7 @@ void Parameter::add(SGMatrix<SGString<uint16_t> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_STRING, PT_UINT16, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGString<int32_t> >* param,
@@ -1483,7 +1483,7 @@ void Parameter::add(SGMatrix<SGString<int32_t> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_STRING, PT_INT32, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGString<uint32_t> >* param,
@@ -1491,7 +1491,7 @@ void Parameter::add(SGMatrix<SGString<uint32_t> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_STRING, PT_UINT32, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGString<int64_t> >* param,
@@ -1499,7 +1499,7 @@ void Parameter::add(SGMatrix<SGString<int64_t> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_STRING, PT_INT64, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGString<uint64_t> >* param,
@@ -1507,7 +1507,7 @@ void Parameter::add(SGMatrix<SGString<uint64_t> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_STRING, PT_UINT64, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGString<float32_t> >* param,
@@ -1515,7 +1515,7 @@ void Parameter::add(SGMatrix<SGString<float32_t> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_STRING, PT_FLOAT32, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGString<float64_t> >* param,
@@ -1523,7 +1523,7 @@ void Parameter::add(SGMatrix<SGString<float64_t> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_STRING, PT_FLOAT64, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGString<floatmax_t> >* param,
@@ -1531,7 +1531,7 @@ void Parameter::add(SGMatrix<SGString<floatmax_t> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_STRING, PT_FLOATMAX, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGSparseVector<bool> >* param,
@@ -1539,7 +1539,7 @@ void Parameter::add(SGMatrix<SGSparseVector<bool> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_BOOL, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGSparseVector<char> >* param,
@@ -1547,7 +1547,7 @@ void Parameter::add(SGMatrix<SGSparseVector<char> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_CHAR, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGSparseVector<int8_t> >* param,
@@ -1555,7 +1555,7 @@ void Parameter::add(SGMatrix<SGSparseVector<int8_t> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_INT8, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGSparseVector<uint8_t> >* param,
@@ -1563,7 +1563,7 @@ void Parameter::add(SGMatrix<SGSparseVector<uint8_t> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_UINT8, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGSparseVector<int16_t> >* param,
@@ -1571,7 +1571,7 @@ void Parameter::add(SGMatrix<SGSparseVector<int16_t> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_INT16, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGSparseVector<uint16_t> >* param,
@@ -1579,7 +1579,7 @@ void Parameter::add(SGMatrix<SGSparseVector<uint16_t> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_UINT16, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGSparseVector<int32_t> >* param,
@@ -1587,7 +1587,7 @@ void Parameter::add(SGMatrix<SGSparseVector<int32_t> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_INT32, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGSparseVector<uint32_t> >* param,
@@ -1595,7 +1595,7 @@ void Parameter::add(SGMatrix<SGSparseVector<uint32_t> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_UINT32, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGSparseVector<int64_t> >* param,
@@ -1603,7 +1603,7 @@ void Parameter::add(SGMatrix<SGSparseVector<int64_t> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_INT64, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGSparseVector<uint64_t> >* param,
@@ -1611,7 +1611,7 @@ void Parameter::add(SGMatrix<SGSparseVector<uint64_t> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_UINT64, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGSparseVector<float32_t> >* param,
@@ -1619,7 +1619,7 @@ void Parameter::add(SGMatrix<SGSparseVector<float32_t> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_FLOAT32, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGSparseVector<float64_t> >* param,
@@ -1627,7 +1627,7 @@ void Parameter::add(SGMatrix<SGSparseVector<float64_t> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_FLOAT64, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGSparseVector<floatmax_t> >* param,
@@ -1635,7 +1635,7 @@ void Parameter::add(SGMatrix<SGSparseVector<floatmax_t> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_FLOATMAX, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGMatrix<SGSparseVector<complex128_t> >* param,
@@ -1643,7 +1643,7 @@ void Parameter::add(SGMatrix<SGSparseVector<complex128_t> >* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_COMPLEX128, &param->num_rows,
 			&param->num_cols);
-	add_type(&type, &param->matrix, name, description);
+	add_type(&type, &param->matrix, name, description, param);
 }
 
 void Parameter::add(SGSparseMatrix<bool>* param,
@@ -1651,7 +1651,7 @@ void Parameter::add(SGSparseMatrix<bool>* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_BOOL, &param->num_vectors,
 			&param->num_features);
-	add_type(&type, &param->sparse_matrix, name, description);
+	add_type(&type, &param->sparse_matrix, name, description, param);
 }
 
 void Parameter::add(SGSparseMatrix<char>* param,
@@ -1659,7 +1659,7 @@ void Parameter::add(SGSparseMatrix<char>* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_CHAR, &param->num_vectors,
 			&param->num_features);
-	add_type(&type, &param->sparse_matrix, name, description);
+	add_type(&type, &param->sparse_matrix, name, description, param);
 }
 
 void Parameter::add(SGSparseMatrix<int8_t>* param,
@@ -1667,7 +1667,7 @@ void Parameter::add(SGSparseMatrix<int8_t>* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_INT8, &param->num_vectors,
 			&param->num_features);
-	add_type(&type, &param->sparse_matrix, name, description);
+	add_type(&type, &param->sparse_matrix, name, description, param);
 }
 
 void Parameter::add(SGSparseMatrix<uint8_t>* param,
@@ -1675,7 +1675,7 @@ void Parameter::add(SGSparseMatrix<uint8_t>* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_UINT8, &param->num_vectors,
 			&param->num_features);
-	add_type(&type, &param->sparse_matrix, name, description);
+	add_type(&type, &param->sparse_matrix, name, description, param);
 }
 
 void Parameter::add(SGSparseMatrix<int16_t>* param,
@@ -1683,7 +1683,7 @@ void Parameter::add(SGSparseMatrix<int16_t>* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_INT16, &param->num_vectors,
 			&param->num_features);
-	add_type(&type, &param->sparse_matrix, name, description);
+	add_type(&type, &param->sparse_matrix, name, description, param);
 }
 
 void Parameter::add(SGSparseMatrix<uint16_t>* param,
@@ -1691,7 +1691,7 @@ void Parameter::add(SGSparseMatrix<uint16_t>* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_UINT16, &param->num_vectors,
 			&param->num_features);
-	add_type(&type, &param->sparse_matrix, name, description);
+	add_type(&type, &param->sparse_matrix, name, description, param);
 }
 
 void Parameter::add(SGSparseMatrix<int32_t>* param,
@@ -1699,7 +1699,7 @@ void Parameter::add(SGSparseMatrix<int32_t>* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_INT32, &param->num_vectors,
 			&param->num_features);
-	add_type(&type, &param->sparse_matrix, name, description);
+	add_type(&type, &param->sparse_matrix, name, description, param);
 }
 
 void Parameter::add(SGSparseMatrix<uint32_t>* param,
@@ -1707,7 +1707,7 @@ void Parameter::add(SGSparseMatrix<uint32_t>* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_UINT32, &param->num_vectors,
 			&param->num_features);
-	add_type(&type, &param->sparse_matrix, name, description);
+	add_type(&type, &param->sparse_matrix, name, description, param);
 }
 
 void Parameter::add(SGSparseMatrix<int64_t>* param,
@@ -1715,7 +1715,7 @@ void Parameter::add(SGSparseMatrix<int64_t>* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_INT64, &param->num_vectors,
 			&param->num_features);
-	add_type(&type, &param->sparse_matrix, name, description);
+	add_type(&type, &param->sparse_matrix, name, description, param);
 }
 
 void Parameter::add(SGSparseMatrix<uint64_t>* param,
@@ -1723,7 +1723,7 @@ void Parameter::add(SGSparseMatrix<uint64_t>* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_UINT64, &param->num_vectors,
 			&param->num_features);
-	add_type(&type, &param->sparse_matrix, name, description);
+	add_type(&type, &param->sparse_matrix, name, description, param);
 }
 
 void Parameter::add(SGSparseMatrix<float32_t>* param,
@@ -1731,7 +1731,7 @@ void Parameter::add(SGSparseMatrix<float32_t>* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_FLOAT32, &param->num_vectors,
 			&param->num_features);
-	add_type(&type, &param->sparse_matrix, name, description);
+	add_type(&type, &param->sparse_matrix, name, description, param);
 }
 
 void Parameter::add(SGSparseMatrix<float64_t>* param,
@@ -1739,7 +1739,7 @@ void Parameter::add(SGSparseMatrix<float64_t>* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_FLOAT64, &param->num_vectors,
 			&param->num_features);
-	add_type(&type, &param->sparse_matrix, name, description);
+	add_type(&type, &param->sparse_matrix, name, description, param);
 }
 
 void Parameter::add(SGSparseMatrix<floatmax_t>* param,
@@ -1747,7 +1747,7 @@ void Parameter::add(SGSparseMatrix<floatmax_t>* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_FLOATMAX, &param->num_vectors,
 			&param->num_features);
-	add_type(&type, &param->sparse_matrix, name, description);
+	add_type(&type, &param->sparse_matrix, name, description, param);
 }
 
 void Parameter::add(SGSparseMatrix<complex128_t>* param,
@@ -1755,7 +1755,7 @@ void Parameter::add(SGSparseMatrix<complex128_t>* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_COMPLEX128, &param->num_vectors,
 			&param->num_features);
-	add_type(&type, &param->sparse_matrix, name, description);
+	add_type(&type, &param->sparse_matrix, name, description, param);
 }
 
 void Parameter::add(SGSparseMatrix<CSGObject*>* param,
@@ -1763,7 +1763,7 @@ void Parameter::add(SGSparseMatrix<CSGObject*>* param,
 {
 	TSGDataType type(CT_SGMATRIX, ST_SPARSE, PT_SGOBJECT, &param->num_vectors,
 			&param->num_features);
-	add_type(&type, &param->sparse_matrix, name, description);
+	add_type(&type, &param->sparse_matrix, name, description, param);
 }
 
 /* **************************************************************** */
@@ -1778,6 +1778,7 @@ TParameter::TParameter(const TSGDataType* datatype, void* parameter,
 	m_description = get_strdup(description);
 	m_delete_data=false;
 	m_was_allocated_from_scratch=false;
+	m_referenced_data=NULL;
 }
 
 TParameter::~TParameter()
@@ -2758,7 +2759,8 @@ Parameter::~Parameter()
 
 void
 Parameter::add_type(const TSGDataType* type, void* param,
-					 const char* name, const char* description)
+					 const char* name, const char* description,
+					 SGReferencedData* referenced_data)
 {
 	if (name == NULL || *name == '\0')
 		SG_SERROR("FATAL: Parameter::add_type(): `name' is empty!\n")
@@ -2778,9 +2780,9 @@ Parameter::add_type(const TSGDataType* type, void* param,
 			SG_SERROR("FATAL: Parameter::add_type(): "
 					 "Double parameter `%s'!\n", name);
 
-	m_params.append_element(
-		new TParameter(type, param, name, description)
-		);
+	TParameter* parameter=new TParameter(type, param, name, description);
+	parameter->m_referenced_data=referenced_data;
+	m_params.append_element(parameter);
 }
 
 void
@@ -2952,7 +2954,7 @@ void Parameter::add_parameters(Parameter* params)
 	{
 		TParameter* current=params->get_parameter(i);
 		add_type(&(current->m_datatype), current->m_parameter, current->m_name,
-				current->m_description);
+				current->m_description, current->m_referenced_data);
 	}
 }
 
@@ -4000,6 +4002,16 @@ bool TParameter::copy(TParameter* target)
 		{
 			SG_SDEBUG("CT_VECTOR or CT_SGVECTOR\n");
 
+			/* vectors whose data is held elsewhere are copied as they are */
+			if (m_datatype.m_ctype==CT_VECTOR && *(char**)m_parameter==NULL)
+			{
+				SG_SDEBUG("source vector is NULL\n");
+				SG_FREE(*(char**)target->m_parameter);
+				*(char**)target->m_parameter=NULL;
+				*target->m_datatype.m_length_y=*m_datatype.m_length_y;
+				break;
+			}
+
 			/* if sizes are different or memory is not allocated, do that */
 			if (!m_datatype.equals(target->m_datatype))
 			{
@@ -4135,3 +4147,83 @@ bool TParameter::copy(TParameter* target)
 	SG_SDEBUG("leaving TParameter::copy(): Copy successful\n");
 	return true;
 }
+
+bool TParameter::share(TParameter* target)
+{
+	SG_SDEBUG("entering TParameter::share()\n");
+
+	if (!target || !m_parameter || !target->m_parameter ||
+			strcmp(m_name, target->m_name) ||
+			!m_datatype.equals_without_length(target->m_datatype))
+	{
+		SG_SDEBUG("leaving TParameter::share(): parameters do not match\n");
+		return false;
+	}
+
+	/* reference counted data, data without a reference counter could be
+	 * freed while the target still uses it and is therefore copied */
+	if (m_referenced_data && target->m_referenced_data &&
+			m_datatype.m_ptype!=PT_SGOBJECT &&
+			m_referenced_data->ref_count()>=0)
+	{
+		SG_SDEBUG("leaving TParameter::share(): sharing data of \"%s\"\n",
+				m_name);
+		*target->m_referenced_data=*m_referenced_data;
+		return true;
+	}
+
+	if (m_datatype.m_stype!=ST_NONE || m_datatype.m_ptype!=PT_SGOBJECT ||
+			m_datatype.m_ctype==CT_NDARRAY)
+	{
+		SG_SDEBUG("leaving TParameter::share(): copying \"%s\"\n", m_name);
+		return copy(target);
+	}
+
+	/* SGObjects, both single ones and arrays of them */
+	CSGObject** source_objects=NULL;
+	CSGObject** target_objects=NULL;
+	int64_t num=m_datatype.get_num_elements();
+
+	if (m_datatype.m_ctype==CT_SCALAR)
+	{
+		source_objects=(CSGObject**) m_parameter;
+		target_objects=(CSGObject**) target->m_parameter;
+	}
+	else
+	{
+		if (!m_datatype.equals(target->m_datatype))
+		{
+			SG_FREE(*(CSGObject***) target->m_parameter);
+			*(CSGObject***) target->m_parameter=NULL;
+		}
+
+		if (*(CSGObject***) target->m_parameter==NULL && num>0)
+		{
+			*(CSGObject***) target->m_parameter=SG_CALLOC(CSGObject*, num);
+			*target->m_datatype.m_length_y=*m_datatype.m_length_y;
+			if (m_datatype.m_length_x)
+				*target->m_datatype.m_length_x=*m_datatype.m_length_x;
+		}
+
+		source_objects=*(CSGObject***) m_parameter;
+		target_objects=*(CSGObject***) target->m_parameter;
+	}
+
+	for (int64_t i=0; i<num; i++)
+	{
+		SG_UNREF(target_objects[i]);
+		if (source_objects[i])
+		{
+			target_objects[i]=source_objects[i]->shared_clone();
+			if (!target_objects[i])
+			{
+				SG_SDEBUG("leaving TParameter::share(): sharing \"%s\" "
+						"failed\n", m_name);
+				return false;
+			}
+		}
+	}
+
+	SG_SDEBUG("leaving TParameter::share(): Sharing successful\n");
+	return true;
+}
@@ -141,6 +141,15 @@ struct TParameter
 	 */
 	bool copy(TParameter* target);
 
+	/** Shares this parameter with parameter target. Reference counted
+	 * SGVector, SGMatrix and SGSparseMatrix data is not copied but shared,
+	 * SGObjects are shared recursively via CSGObject::shared_clone. All
+	 * other data is copied as in copy().
+	 *
+	 * @param target where this should be shared with
+	 */
+	bool share(TParameter* target);
+
 
 
 	/** operator for comparison, (by string m_name) */
@@ -174,6 +183,11 @@ struct TParameter
 	 * its parameter, but from scratch using allocate_data_from_scratch */
 	bool m_was_allocated_from_scratch;
 
+	/** the SGVector, SGMatrix or SGSparseMatrix which holds the data of
+	 * this parameter, NULL for all other types. Used to share the data
+	 * with share() */
+	SGReferencedData* m_referenced_data;
+
 	/** Incrementally get a hash from parameter value
 	 *
 	 * @param hash current hash value
@@ -2067,10 +2081,13 @@ protected:
 	 * @param param pointer to parameter
 	 * @param name name of parameter
 	 * @param description description of parameter
+	 * @param referenced_data SGVector, SGMatrix or SGSparseMatrix which
+	 * holds the parameter, if any
 	 */
 	virtual void add_type(const TSGDataType* type, void* param,
 						  const char* name,
-						  const char* description);
+						  const char* description,
+						  SGReferencedData* referenced_data=NULL);
 };
 }
 #endif //__PARAMETER_H__
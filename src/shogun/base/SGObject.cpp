@@ -20,7 +20,9 @@
 #include <shogun/base/ParameterMap.h>
 #include <shogun/base/DynArray.h>
 #include <shogun/lib/Map.h>
+#include <shogun/lib/Set.h>
 #include <shogun/lib/SGStringList.h>
+#include <shogun/lib/SGSparseVector.h>
 
 #include "class_list.h"
 
@@ -1300,3 +1302,126 @@ CSGObject* CSGObject::clone()
 	SG_DEBUG("leaving %s::clone(): Clone successful\n", get_name());
 	return copy;
 }
+
+CSGObject* CSGObject::shared_clone()
+{
+	SG_DEBUG("entering %s::shared_clone()\n", get_name());
+
+	CSGObject* copy=new_sgserializable(get_name(), this->m_generic);
+
+	SG_REF(copy);
+
+	REQUIRE(copy, "Could not create empty instance of \"%s\". The reason for "
+			"this usually is that get_name() of the class returns something "
+			"wrong, or that a class has a wrongly set generic type.\n",
+			get_name());
+
+	for (index_t i=0; i<m_parameters->get_num_parameters(); ++i)
+	{
+		SG_DEBUG("sharing parameter \"%s\" at index %d\n",
+				m_parameters->get_parameter(i)->m_name, i);
+
+		if (!m_parameters->get_parameter(i)->share(copy->m_parameters->get_parameter(i)))
+		{
+			SG_DEBUG("leaving %s::shared_clone(): Clone failed. Returning "
+					"NULL\n", get_name());
+			SG_UNREF(copy);
+			return NULL;
+		}
+	}
+
+	SG_DEBUG("leaving %s::shared_clone(): Clone successful\n", get_name());
+	return copy;
+}
+
+int64_t CSGObject::get_memory_footprint()
+{
+	CSet<void*>* processed=new CSet<void*>();
+	SG_REF(processed);
+	int64_t bytes=get_memory_footprint(processed);
+	SG_UNREF(processed);
+
+	return bytes;
+}
+
+int64_t CSGObject::get_memory_footprint(CSet<void*>* processed)
+{
+	if (processed->contains(this))
+		return 0;
+
+	processed->add(this);
+	int64_t bytes=get_unregistered_memory_footprint();
+
+	for (index_t i=0; i<m_parameters->get_num_parameters(); i++)
+	{
+		TParameter* p=m_parameters->get_parameter(i);
+		if (!p || !p->is_valid() || p->m_datatype.m_ctype==CT_NDARRAY)
+			continue;
+
+		TSGDataType type=p->m_datatype;
+		int64_t num=type.get_num_elements();
+		char* data=NULL;
+
+		if (type.m_ctype==CT_SCALAR)
+		{
+			// scalars live inside the object, only follow their pointers
+			data=(char*) p->m_parameter;
+		}
+		else
+		{
+			data=*(char**) p->m_parameter;
+			if (!data || processed->contains(data))
+				continue;
+
+			processed->add(data);
+			if (type.m_stype==ST_NONE)
+				bytes+=num*type.sizeof_ptype();
+			else
+				bytes+=num*type.sizeof_stype();
+		}
+
+		if (type.m_stype==ST_NONE && type.m_ptype!=PT_SGOBJECT)
+			continue;
+
+		for (int64_t j=0; j<num; j++)
+		{
+			switch (type.m_stype)
+			{
+				case ST_NONE:
+				{
+					CSGObject* child=((CSGObject**) data)[j];
+					if (child)
+						bytes+=child->get_memory_footprint(processed);
+					break;
+				}
+				case ST_STRING:
+				{
+					SGString<char>* str=(SGString<char>*)
+						(data+j*type.sizeof_stype());
+					if (str->string && !processed->contains(str->string))
+					{
+						processed->add(str->string);
+						bytes+=str->slen*type.sizeof_ptype();
+					}
+					break;
+				}
+				case ST_SPARSE:
+				{
+					SGSparseVector<char>* vec=(SGSparseVector<char>*)
+						(data+j*type.sizeof_stype());
+					if (vec->features && !processed->contains(vec->features))
+					{
+						processed->add(vec->features);
+						bytes+=vec->num_feat_entries*
+							TSGDataType::sizeof_sparseentry(type.m_ptype);
+					}
+					break;
+				}
+				case ST_UNDEFINED: default:
+					break;
+			}
+		}
+	}
+
+	return bytes;
+}
@@ -42,6 +42,7 @@ template <class T, class K> class CMap;
 struct TParameter;
 template <class T> class DynArray;
 template <class T> class SGStringList;
+template <class T> class CSet;
 
 /*******************************************************************************
  * Macros for registering parameters/model selection parameters
@@ -426,7 +427,52 @@ public:
 	 */
 	virtual CSGObject* clone();
 
+	/** Creates a clone of the current object which shares its data with the
+	 * current object, e.g. to hand a model to parallel workers without
+	 * multiplying the memory. This is done via recursively traversing all
+	 * parameters like clone(), but reference counted SGVector, SGMatrix and
+	 * SGSparseMatrix parameters are shared rather than copied, so the cost
+	 * depends on the number of parameters and not on the size of the data.
+	 * Scalars and data without a reference counter are copied.
+	 *
+	 * Writing into a shared vector or matrix changes it for both objects.
+	 * Setters that assign a new vector or matrix only change the object
+	 * they are called on.
+	 *
+	 * @return a copy of the given object which shares its data. NULL if the
+	 * clone fails. Note that the returned object is SG_REF'ed
+	 */
+	virtual CSGObject* shared_clone();
+
+	/** Estimates the memory held by this object, e.g. to report the size
+	 * of a trained model or to catch memory regressions. This is done via
+	 * recursively traversing all registered parameters and summing up the
+	 * sizes of vectors, matrices, strings and sparse vectors as well as the
+	 * footprints of all objects reachable from them. Buffers and objects
+	 * that are reached more than once are counted once. Scalars and the
+	 * object itself are not counted.
+	 *
+	 * @return estimated number of bytes
+	 */
+	int64_t get_memory_footprint();
+
+protected:
+	/** Returns the number of bytes held in members that are not registered
+	 * as parameters, such as caches. Is added to get_memory_footprint(),
+	 * subclasses owning such memory should override it.
+	 *
+	 * @return number of bytes
+	 */
+	virtual int64_t get_unregistered_memory_footprint() { return 0; }
+
 private:
+	/** Recursion of get_memory_footprint()
+	 *
+	 * @param processed objects and buffers counted already
+	 * @return number of bytes not counted yet
+	 */
+	int64_t get_memory_footprint(CSet<void*>* processed);
+
 	void set_global_objects();
 	void unset_global_objects();
 	void init();
@@ -110,10 +110,31 @@ CBinaryLabels* CPluginEstimate::apply_binary(CFeatures* data)
 	}
 
 	ASSERT(features)
-	SGVector<float64_t> result(features->get_num_vectors());
 
-	for (int32_t vec=0; vec<features->get_num_vectors(); vec++)
-		result[vec] = apply_one(vec);
+	if ((!pos_model) || (!neg_model))
+		SG_ERROR("model(s) not assigned\n")
+
+	int32_t num=features->get_num_vectors();
+	SGVector<index_t> idx(num);
+	SGVector<float64_t> result(num);
+	SGVector<float64_t> neg_result(num);
+	idx.range_fill();
+
+	/* score all examples in batches under both models, the models get
+	 * their own features back afterwards */
+	CFeatures* pos_features=pos_model->get_features();
+	CFeatures* neg_features=neg_model->get_features();
+	pos_model->set_features(features);
+	neg_model->set_features(features);
+	pos_model->get_log_likelihood(idx, result);
+	neg_model->get_log_likelihood(idx, neg_result);
+	pos_model->set_features(pos_features);
+	neg_model->set_features(neg_features);
+	SG_UNREF(pos_features);
+	SG_UNREF(neg_features);
+
+	for (int32_t vec=0; vec<num; vec++)
+		result[vec]-=neg_result[vec];
 
 	return new CBinaryLabels(result);
 }
@@ -287,6 +287,25 @@ bool CMKL::train_machine(CFeatures* data)
 		init_glpk();
 #endif
 
+	/* retraining of the svm is warm started from the previous solution, only
+	 * the binary solvers support that */
+	bool warm_start=m_labels && m_labels->get_label_type()==LT_BINARY;
+	if (warm_start && m_warm_start && get_num_support_vectors()>0)
+	{
+		SG_DEBUG("warm starting from %d support vectors\n", get_num_support_vectors())
+
+		int32_t nsv=get_num_support_vectors();
+		svm->create_new_model(nsv);
+		svm->set_bias(get_bias());
+		for (int32_t i=0; i<nsv; i++)
+		{
+			svm->set_alpha(i, get_alpha(i));
+			svm->set_support_vector(i, get_support_vector(i));
+		}
+		svm->set_warm_start();
+	}
+	m_warm_start=false;
+
 	mkl_iterations = 0;
 	CSignal::clear_cancel();
 
@@ -330,6 +349,9 @@ bool CMKL::train_machine(CFeatures* data)
 
 		while (true)
 		{
+			if (warm_start && mkl_iterations>0)
+				svm->set_warm_start();
+
 			svm->train();
 
 			float64_t suma=compute_sum_alpha();
@@ -130,7 +130,16 @@ bool CLibSVM::train_machine(CFeatures* data)
 	if(error_msg)
 		SG_ERROR("Error: %s\n",error_msg)
 
+	SGVector<float64_t> initial_alphas;
+	if (m_warm_start && param.svm_type==C_SVC)
+	{
+		initial_alphas=get_initial_alphas(problem.l);
+		problem.alpha0=initial_alphas.vector;
+	}
+	m_warm_start=false;
+
 	model = svm_train(&problem, &param);
+	problem.alpha0=NULL;
 
 	if (model)
 	{
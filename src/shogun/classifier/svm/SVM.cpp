@@ -62,6 +62,8 @@ void CSVM::set_defaults(int32_t num_sv)
 			MS_NOT_AVAILABLE);
 	SG_ADD(&m_linear_term, "linear_term", "Linear term in qp.",
 			MS_NOT_AVAILABLE);
+	SG_ADD(&m_warm_start, "warm_start",
+			"Next training starts from the current model.", MS_NOT_AVAILABLE);
 
 	callback=NULL;
 	mkl=NULL;
@@ -80,6 +82,7 @@ void CSVM::set_defaults(int32_t num_sv)
 	qpsize=41;
 	use_bias=true;
 	use_shrinking=true;
+	m_warm_start=false;
 	use_batch_computation=true;
 	use_linadd=true;
 
@@ -311,6 +314,106 @@ float64_t* CSVM::get_linear_term_array()
 	return a;
 }
 
+void CSVM::set_warm_start(SGVector<index_t> previous_index)
+{
+	m_warm_start=true;
+
+	int32_t num_sv=get_num_support_vectors();
+	if (previous_index.vlen==0 || num_sv==0)
+		return;
+
+	index_t max_index=0;
+	for (index_t i=0; i<previous_index.vlen; i++)
+		max_index=CMath::max(max_index, previous_index[i]);
+	for (int32_t i=0; i<num_sv; i++)
+		max_index=CMath::max(max_index, get_support_vector(i));
+
+	SGVector<index_t> new_index(max_index+1);
+	new_index.set_const(-1);
+	for (index_t i=0; i<previous_index.vlen; i++)
+	{
+		if (previous_index[i]>=0)
+			new_index[previous_index[i]]=i;
+	}
+
+	/* support vectors of examples that were removed are dropped */
+	int32_t num_kept=0;
+	for (int32_t i=0; i<num_sv; i++)
+	{
+		if (new_index[get_support_vector(i)]>=0)
+			num_kept++;
+	}
+
+	SGVector<int32_t> svs(num_kept);
+	SGVector<float64_t> alphas(num_kept);
+	for (int32_t i=0, j=0; i<num_sv; i++)
+	{
+		index_t idx=new_index[get_support_vector(i)];
+		if (idx>=0)
+		{
+			svs[j]=idx;
+			alphas[j]=get_alpha(i);
+			j++;
+		}
+	}
+
+	SG_DEBUG("warm start keeps %d of %d support vectors\n", num_kept, num_sv)
+
+	m_svs=svs;
+	m_alpha=alphas;
+}
+
+SGVector<float64_t> CSVM::get_initial_alphas(int32_t num_examples)
+{
+	ASSERT(m_labels && m_labels->get_num_labels()==num_examples)
+
+	SGVector<float64_t> alphas(num_examples);
+	alphas.zero();
+
+	CBinaryLabels* labels=(CBinaryLabels*) m_labels;
+	float64_t sum_pos=0;
+	float64_t sum_neg=0;
+
+	for (int32_t i=0; i<get_num_support_vectors(); i++)
+	{
+		int32_t idx=get_support_vector(i);
+		if (idx<0 || idx>=num_examples)
+			continue;
+
+		float64_t y=labels->get_label(idx);
+		float64_t a=get_alpha(i);
+
+		/* alphas of examples whose label changed start from zero */
+		if (a*y<=0)
+			continue;
+
+		a=CMath::min(CMath::abs(a), y>0 ? C2 : C1);
+		if (y>0)
+		{
+			alphas[idx]=a;
+			sum_pos+=a;
+		}
+		else
+		{
+			alphas[idx]=-a;
+			sum_neg+=a;
+		}
+	}
+
+	/* shrink the larger side to restore the equality constraint, this keeps
+	 * all alphas within their box */
+	if (use_bias && sum_pos!=sum_neg)
+	{
+		float64_t scale_pos=sum_pos>sum_neg ? sum_neg/sum_pos : 1.0;
+		float64_t scale_neg=sum_neg>sum_pos ? sum_pos/sum_neg : 1.0;
+
+		for (int32_t i=0; i<num_examples; i++)
+			alphas[i]*=alphas[i]>0 ? scale_pos : scale_neg;
+	}
+
+	return alphas;
+}
+
 void CSVM::set_linear_term(const SGVector<float64_t> linear_term)
 {
 	ASSERT(linear_term.vector)
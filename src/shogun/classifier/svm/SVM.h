@@ -218,6 +218,32 @@ class CSVM : public CKernelMachine
 			return objective;
 		}
 
+		/** start the next training from the current model instead of from
+		 * scratch
+		 *
+		 * The solvers use the alphas of the current model as initial point,
+		 * so after a small change of the training set (a few examples added
+		 * or removed) or of C, retraining only needs a few iterations. The
+		 * alphas are clipped to the new box constraints and, if a bias is
+		 * used, rescaled such that \f$\sum_i y_i\alpha_i=0\f$ holds again.
+		 * Support vectors that were removed from the training set are
+		 * dropped. Only the next call to train() is affected.
+		 *
+		 * Supported by CSVMLight (and thus CMKL) and by CLibSVM with the
+		 * C-SVC solver.
+		 *
+		 * @param previous_index for every example of the next training set
+		 * its index in the previous one or -1 if it is new, empty if the
+		 * training set did not change
+		 */
+		void set_warm_start(SGVector<index_t> previous_index=SGVector<index_t>());
+
+		/** @return whether the next training starts from the current model */
+		inline bool get_warm_start()
+		{
+			return m_warm_start;
+		}
+
 		/** set callback function svm optimizers may call when they have a new
 		 * (small) set of alphas
 		 *
@@ -240,6 +266,13 @@ class CSVM : public CKernelMachine
 		 */
 		virtual float64_t* get_linear_term_array();
 
+		/** initial point for a warm started training, see set_warm_start()
+		 *
+		 * @param num_examples number of training examples
+		 * @return feasible signed alphas \f$y_i\alpha_i\f$ per example
+		 */
+		SGVector<float64_t> get_initial_alphas(int32_t num_examples);
+
 		/** linear term in qp */
 		SGVector<float64_t> m_linear_term;
 
@@ -261,6 +294,8 @@ class CSVM : public CKernelMachine
 		int32_t qpsize;
 		/** if shrinking shall be used */
 		bool use_shrinking;
+		/** if the next training starts from the current model */
+		bool m_warm_start;
 
 		/** callback function svm optimizers may call when they have a new
 		 * (small) set of alphas */
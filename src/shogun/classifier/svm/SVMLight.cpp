@@ -261,6 +261,7 @@ bool CSVMLight::train_machine(CFeatures* data)
 
 	// train the svm
 	svm_learn();
+	m_warm_start=false;
 
 	// brain damaged svm light work around
 	create_new_model(model->sv_num-1);
@@ -415,8 +416,16 @@ void CSVMLight::svm_learn()
 	for (i=0; i<totdoc; i++)
 		alpha[i]=0;
 
-	for (i=0; i<get_num_support_vectors(); i++)
-		alpha[get_support_vector(i)]=get_alpha(i);
+	if (m_warm_start)
+	{
+		SGVector<float64_t> initial_alphas=get_initial_alphas(totdoc);
+		memcpy(alpha, initial_alphas.vector, sizeof(float64_t)*totdoc);
+	}
+	else
+	{
+		for (i=0; i<get_num_support_vectors(); i++)
+			alpha[get_support_vector(i)]=get_alpha(i);
+	}
 
     int32_t* index = SG_MALLOC(int32_t, totdoc);
     int32_t* index2dnum = SG_MALLOC(int32_t, totdoc+11);
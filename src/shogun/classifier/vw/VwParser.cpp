@@ -15,6 +15,7 @@
 
 #include <shogun/classifier/vw/VwParser.h>
 #include <shogun/classifier/vw/cache/VwNativeCacheWriter.h>
+#include <shogun/classifier/vw/cache/VwChunkedCacheWriter.h>
 
 using namespace shogun;
 
@@ -261,6 +262,9 @@ void CVwParser::init_cache(char * fname, EVwCacheType type)
 	case C_NATIVE:
 		cache_writer = new CVwNativeCacheWriter(file_name, env);
 		return;
+	case C_CHUNKED:
+		cache_writer = new CVwChunkedCacheWriter(file_name, env);
+		return;
 	case C_PROTOBUF:
 		SG_ERROR("Protocol buffers cache support is not implemented yet.\n")
 	}
@@ -25,11 +25,12 @@ namespace shogun
 {
 
 /// Enum EVwCacheType specifies the type of
-/// cache used, either C_NATIVE or C_PROTOBUF.
+/// cache used, either C_NATIVE, C_PROTOBUF or C_CHUNKED.
 enum EVwCacheType
 {
 	C_NATIVE = 0,
-	C_PROTOBUF = 1
+	C_PROTOBUF = 1,
+	C_CHUNKED = 2
 };
 
 /** @brief Base class from which all cache readers for VW
@@ -0,0 +1,356 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society.
+ */
+
+#include <shogun/classifier/vw/cache/VwChunkedCacheReader.h>
+#include <shogun/classifier/vw/cache/VwNativeCacheReader.h>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace shogun;
+
+CVwChunkedCacheReader::CVwChunkedCacheReader()
+	: CVwCacheReader()
+{
+	init();
+}
+
+CVwChunkedCacheReader::CVwChunkedCacheReader(char * fname, CVwEnvironment* env_to_use)
+	: CVwCacheReader(fname, env_to_use)
+{
+	init();
+	check_cache_metadata();
+}
+
+CVwChunkedCacheReader::CVwChunkedCacheReader(int32_t f, CVwEnvironment* env_to_use)
+	: CVwCacheReader(f, env_to_use)
+{
+	init();
+	check_cache_metadata();
+}
+
+CVwChunkedCacheReader::~CVwChunkedCacheReader()
+{
+	SG_FREE(raw_buf);
+	SG_FREE(packed_buf);
+	SG_UNREF(compressor);
+}
+
+void CVwChunkedCacheReader::set_file(int32_t f)
+{
+	fd = f;
+	check_cache_metadata();
+}
+
+void CVwChunkedCacheReader::init()
+{
+	neg_1 = 1;
+	general = 2;
+
+	compression_type = UNCOMPRESSED;
+	compressor = NULL;
+	order_pos = 0;
+	raw_buf = NULL;
+	raw_capacity = 0;
+	packed_buf = NULL;
+	packed_capacity = 0;
+	cursor = NULL;
+	cursor_end = NULL;
+	examples_left = 0;
+}
+
+void CVwChunkedCacheReader::read_bytes(void* data, size_t nbytes, uint64_t offset)
+{
+	size_t done = 0;
+	while (done < nbytes)
+	{
+		ssize_t num_read = pread(fd, (char*) data + done, nbytes - done, offset + done);
+		if (num_read <= 0)
+			SG_SERROR("Truncated chunked cache! Wanted %d bytes at offset %lld.\n",
+					nbytes, offset)
+		done += num_read;
+	}
+}
+
+void CVwChunkedCacheReader::check_cache_metadata()
+{
+	char magic[4];
+	uint32_t format_version = 0;
+	vw_size_t v_length = 0;
+	uint64_t pos = 0;
+
+	read_bytes(magic, 4, pos);
+	pos += 4;
+	if (memcmp(magic, VW_CHUNKED_CACHE_MAGIC, 4) != 0)
+		SG_SERROR("File is not a chunked VW cache!\n")
+
+	read_bytes(&format_version, sizeof(format_version), pos);
+	pos += sizeof(format_version);
+	if (format_version != VW_CHUNKED_CACHE_VERSION)
+		SG_SERROR("Unsupported chunked cache version %d!\n", format_version)
+
+	read_bytes(&v_length, sizeof(v_length), pos);
+	pos += sizeof(v_length);
+	if (v_length > 29)
+		SG_SERROR("Cache version too long, cache file is probably invalid.\n")
+
+	char* t = SG_MALLOC(char, v_length);
+	read_bytes(t, v_length, pos);
+	pos += v_length;
+	if (strcmp(t, env->vw_version) != 0)
+	{
+		SG_FREE(t);
+		SG_SERROR("Cache has possibly incompatible version!\n")
+	}
+	SG_FREE(t);
+
+	vw_size_t cache_numbits = 0;
+	read_bytes(&cache_numbits, sizeof(cache_numbits), pos);
+	pos += sizeof(cache_numbits);
+	if (cache_numbits != env->num_bits)
+		SG_SERROR("Bug encountered in caching! Bits used for weight in cache: %d.\n", cache_numbits)
+
+	int32_t ct = 0;
+	read_bytes(&ct, sizeof(ct), pos);
+	compression_type = (E_COMPRESSION_TYPE) ct;
+	SG_UNREF(compressor);
+	compressor = new CCompressor(compression_type);
+	SG_REF(compressor);
+
+	// Trailer: index offset, number of chunks, magic
+	struct stat st;
+	if (fstat(fd, &st) != 0)
+		SG_SERROR("Could not determine size of chunked cache!\n")
+
+	uint64_t index_offset = 0;
+	uint64_t num_chunks = 0;
+	uint64_t trailer_size = sizeof(index_offset) + sizeof(num_chunks) + 4;
+	if ((uint64_t) st.st_size < pos + trailer_size)
+		SG_SERROR("Chunked cache has no index, was the writer finalized?\n")
+
+	pos = st.st_size - trailer_size;
+	read_bytes(&index_offset, sizeof(index_offset), pos);
+	read_bytes(&num_chunks, sizeof(num_chunks), pos + sizeof(index_offset));
+	read_bytes(magic, 4, pos + sizeof(index_offset) + sizeof(num_chunks));
+	if (memcmp(magic, VW_CHUNKED_CACHE_INDEX_MAGIC, 4) != 0)
+		SG_SERROR("Chunked cache has no index, was the writer finalized?\n")
+
+	chunk_offsets = SGVector<uint64_t>(num_chunks);
+	chunk_counts = SGVector<uint32_t>(num_chunks);
+	chunk_raw_sizes = SGVector<uint64_t>(num_chunks);
+	chunk_packed_sizes = SGVector<uint64_t>(num_chunks);
+
+	uint64_t entry_size = 3*sizeof(uint64_t) + sizeof(uint32_t);
+	uint8_t* index = SG_MALLOC(uint8_t, num_chunks*entry_size);
+	read_bytes(index, num_chunks*entry_size, index_offset);
+
+	uint8_t* p = index;
+	for (uint64_t i=0; i<num_chunks; i++)
+	{
+		memcpy(&chunk_offsets[i], p, sizeof(uint64_t));
+		p += sizeof(uint64_t);
+		memcpy(&chunk_counts[i], p, sizeof(uint32_t));
+		p += sizeof(uint32_t);
+		memcpy(&chunk_raw_sizes[i], p, sizeof(uint64_t));
+		p += sizeof(uint64_t);
+		memcpy(&chunk_packed_sizes[i], p, sizeof(uint64_t));
+		p += sizeof(uint64_t);
+	}
+	SG_FREE(index);
+
+	chunk_order = SGVector<index_t>(num_chunks);
+	chunk_order.range_fill();
+	reset();
+}
+
+void CVwChunkedCacheReader::reset()
+{
+	order_pos = 0;
+	examples_left = 0;
+	cursor = NULL;
+	cursor_end = NULL;
+}
+
+void CVwChunkedCacheReader::set_chunk_order(SGVector<index_t> order)
+{
+	for (index_t i=0; i<order.vlen; i++)
+	{
+		REQUIRE(order[i]>=0 && order[i]<get_num_chunks(),
+				"Chunk index %d out of range [0, %d)\n", order[i], get_num_chunks())
+	}
+
+	chunk_order = order;
+	reset();
+}
+
+void CVwChunkedCacheReader::shuffle_chunks()
+{
+	SGVector<index_t>::permute(chunk_order.vector, chunk_order.vlen);
+	reset();
+}
+
+void CVwChunkedCacheReader::set_partition(int32_t part, int32_t num_parts)
+{
+	REQUIRE(num_parts>0 && part>=0 && part<num_parts,
+			"Invalid partition %d of %d\n", part, num_parts)
+
+	index_t num_chunks = get_num_chunks();
+	index_t len = num_chunks > part ? (num_chunks - part + num_parts - 1) / num_parts : 0;
+	SGVector<index_t> order(len);
+	for (index_t i=0; i<len; i++)
+		order[i] = part + i*num_parts;
+
+	chunk_order = order;
+	reset();
+}
+
+int32_t CVwChunkedCacheReader::get_chunk_num_examples(index_t c)
+{
+	REQUIRE(c>=0 && c<get_num_chunks(), "Chunk index %d out of range [0, %d)\n",
+			c, get_num_chunks())
+	return chunk_counts[c];
+}
+
+int64_t CVwChunkedCacheReader::get_num_examples()
+{
+	int64_t num = 0;
+	for (index_t i=0; i<chunk_counts.vlen; i++)
+		num += chunk_counts[i];
+
+	return num;
+}
+
+void CVwChunkedCacheReader::load_chunk(index_t c)
+{
+	REQUIRE(c>=0 && c<get_num_chunks(), "Chunk index %d out of range [0, %d)\n",
+			c, get_num_chunks())
+
+	uint64_t raw_size = chunk_raw_sizes[c];
+	uint64_t packed_size = chunk_packed_sizes[c];
+	uint64_t header_size = sizeof(uint32_t) + 2*sizeof(uint64_t);
+
+	if (packed_size > packed_capacity)
+	{
+		packed_buf = SG_REALLOC(uint8_t, packed_buf, packed_capacity, packed_size);
+		packed_capacity = packed_size;
+	}
+	if (raw_size > raw_capacity)
+	{
+		raw_buf = SG_REALLOC(uint8_t, raw_buf, raw_capacity, raw_size);
+		raw_capacity = raw_size;
+	}
+
+	read_bytes(packed_buf, packed_size, chunk_offsets[c] + header_size);
+
+	uint64_t decoded_size = raw_size;
+	compressor->decompress(packed_buf, packed_size, raw_buf, decoded_size);
+	if (decoded_size != raw_size)
+		SG_SERROR("Corrupt chunk %d in cache: %lld bytes decoded, %lld expected!\n",
+				c, decoded_size, raw_size)
+
+	cursor = (char*) raw_buf;
+	cursor_end = cursor + raw_size;
+	examples_left = chunk_counts[c];
+}
+
+char* CVwChunkedCacheReader::run_len_decode(char *p, vw_size_t& i)
+{
+	// Read an int32_t 7 bits at a time.
+	vw_size_t count = 0;
+	while(*p & 128)
+		i = i | ((*(p++) & 127) << 7*count++);
+	i = i | (*(p++) << 7*count);
+	return p;
+}
+
+char* CVwChunkedCacheReader::take_bytes(uint64_t n)
+{
+	if (cursor + n > cursor_end)
+		SG_SERROR("Truncated example! Wanted %d bytes!\n", n)
+
+	char* c = cursor;
+	cursor += n;
+	return c;
+}
+
+bool CVwChunkedCacheReader::read_cached_example(VwExample* const ae)
+{
+	while (examples_left == 0)
+	{
+		if (order_pos >= chunk_order.vlen)
+			return false;
+
+		load_chunk(chunk_order[order_pos++]);
+	}
+	examples_left--;
+
+	vw_size_t mask = env->mask;
+	VwLabel* ld = ae->ld;
+
+	char* c = take_bytes(sizeof(ld->label)+sizeof(ld->weight)+sizeof(ld->initial));
+	ld->label = *(float32_t*)c;
+	c += sizeof(ld->label);
+	set_minmax(ld->label);
+	ld->weight = *(float32_t*)c;
+	c += sizeof(ld->weight);
+	ld->initial = *(float32_t*)c;
+
+	vw_size_t tag_size = *(vw_size_t*) take_bytes(sizeof(vw_size_t));
+	c = take_bytes(tag_size);
+	ae->tag.erase();
+	ae->tag.push_many(c, tag_size);
+
+	unsigned char num_indices = *(unsigned char*) take_bytes(sizeof(num_indices));
+
+	for (; num_indices > 0; num_indices--)
+	{
+		unsigned char index = *(unsigned char*) take_bytes(sizeof(index));
+		ae->indices.push((vw_size_t) index);
+
+		v_array<VwFeature>* ours = ae->atomics+index;
+		float64_t* our_sum_feat_sq = ae->sum_feat_sq+index;
+		vw_size_t storage = *(vw_size_t*) take_bytes(sizeof(vw_size_t));
+
+		c = take_bytes(storage);
+		char *end = c + storage;
+
+		vw_size_t last = 0;
+
+		for (; c!=end; )
+		{
+			VwFeature f = {1., 0};
+			vw_size_t temp = f.weight_index;
+			c = run_len_decode(c, temp);
+			f.weight_index = temp;
+
+			if (f.weight_index & neg_1)
+				f.x = -1.;
+			else if (f.weight_index & general)
+			{
+				f.x = ((one_float*)c)->f;
+				c += sizeof(float32_t);
+			}
+
+			*our_sum_feat_sq += f.x*f.x;
+
+			vw_size_t diff = f.weight_index >> 2;
+			int32_t s_diff = ZigZagDecode(diff);
+			if (s_diff < 0)
+				ae->sorted = false;
+
+			f.weight_index = last + s_diff;
+			last = f.weight_index;
+			f.weight_index = f.weight_index & mask;
+
+			ours->push(f);
+		}
+	}
+
+	return true;
+}
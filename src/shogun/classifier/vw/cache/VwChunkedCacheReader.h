@@ -0,0 +1,261 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society.
+ */
+
+#ifndef _VW_CHUNKEDCACHE_READ_H__
+#define _VW_CHUNKEDCACHE_READ_H__
+
+#include <shogun/classifier/vw/cache/VwCacheReader.h>
+#include <shogun/lib/Compressor.h>
+#include <shogun/lib/SGVector.h>
+
+/// Magic bytes at the start of a chunked cache
+#define VW_CHUNKED_CACHE_MAGIC "VWC2"
+/// Magic bytes at the end of the chunk index
+#define VW_CHUNKED_CACHE_INDEX_MAGIC "VWI2"
+/// Version of the chunked cache format
+#define VW_CHUNKED_CACHE_VERSION 2
+
+namespace shogun
+{
+
+/** @brief Class CVwChunkedCacheReader reads a block-indexed cache as
+ * written by CVwChunkedCacheWriter.
+ *
+ * Chunks are located via the index at the end of the file and read with
+ * positioned reads, so the reader never depends on the file offset of the
+ * descriptor. Several readers may therefore be opened on the same file (or
+ * share one descriptor) and decode disjoint chunks from different threads,
+ * e.g. by calling set_partition(thread_id, num_threads) on each of them.
+ * Note that LZO decompression is not thread safe, prefer SNAPPY for
+ * concurrent readers.
+ *
+ * For multi-pass training, reset() restarts the pass and shuffle_chunks()
+ * or set_chunk_order() visit the chunks in a different order per epoch.
+ */
+class CVwChunkedCacheReader: public CVwCacheReader
+{
+public:
+	/**
+	 * Default constructor
+	 */
+	CVwChunkedCacheReader();
+
+	/**
+	 * Constructor, opens a file whose name is specified
+	 *
+	 * @param fname file name
+	 * @param env_to_use Environment to use
+	 */
+	CVwChunkedCacheReader(char * fname, CVwEnvironment* env_to_use);
+
+	/**
+	 * Constructor, passed a file descriptor
+	 *
+	 * @param f descriptor of opened file
+	 * @param env_to_use Environment to use
+	 */
+	CVwChunkedCacheReader(int32_t f, CVwEnvironment* env_to_use);
+
+	/**
+	 * Destructor
+	 */
+	virtual ~CVwChunkedCacheReader();
+
+	/**
+	 * Set the file descriptor to use
+	 *
+	 * @param f descriptor of cache file
+	 */
+	virtual void set_file(int32_t f);
+
+	/**
+	 * Read the next example of the current pass
+	 *
+	 * @param ae example to fill
+	 *
+	 * @return false if the pass is finished
+	 */
+	virtual bool read_cached_example(VwExample* const ae);
+
+	/**
+	 * Check the header and load the chunk index
+	 */
+	void check_cache_metadata();
+
+	/**
+	 * Restart the pass over the chunks of this reader
+	 */
+	void reset();
+
+	/**
+	 * Set the order in which chunks are visited, entries may be
+	 * any subset of [0, get_num_chunks())
+	 *
+	 * @param order chunk indices
+	 */
+	void set_chunk_order(SGVector<index_t> order);
+
+	/**
+	 * Get the order in which chunks are visited
+	 *
+	 * @return chunk indices
+	 */
+	SGVector<index_t> get_chunk_order() { return chunk_order; }
+
+	/**
+	 * Randomly permute the current chunk order and restart the pass
+	 */
+	void shuffle_chunks();
+
+	/**
+	 * Restrict the reader to chunks part, part+num_parts, ...
+	 * so num_parts readers cover the cache exactly once
+	 *
+	 * @param part index of this reader
+	 * @param num_parts total number of readers
+	 */
+	void set_partition(int32_t part, int32_t num_parts);
+
+	/**
+	 * Make chunk c the current chunk, the next read_cached_example()
+	 * returns its first example
+	 *
+	 * @param c chunk index
+	 */
+	void load_chunk(index_t c);
+
+	/**
+	 * @return number of chunks in the cache
+	 */
+	index_t get_num_chunks() { return chunk_offsets.vlen; }
+
+	/**
+	 * @param c chunk index
+	 *
+	 * @return number of examples in chunk c
+	 */
+	int32_t get_chunk_num_examples(index_t c);
+
+	/**
+	 * @return number of examples in the cache
+	 */
+	int64_t get_num_examples();
+
+	/**
+	 * @return compression type used for the chunks
+	 */
+	E_COMPRESSION_TYPE get_compression_type() { return compression_type; }
+
+	/**
+	 * Return the name of the object.
+	 *
+	 * @return VwChunkedCacheReader
+	 */
+	virtual const char* get_name() const { return "VwChunkedCacheReader"; }
+
+private:
+	/**
+	 * Initialize members
+	 */
+	void init();
+
+	/**
+	 * Read exactly nbytes at offset, raising an error on failure
+	 *
+	 * @param data target buffer
+	 * @param nbytes number of bytes
+	 * @param offset file offset
+	 */
+	void read_bytes(void* data, size_t nbytes, uint64_t offset);
+
+	/**
+	 * Decode an int32_t from RLE-encoded data
+	 *
+	 * @param p pointer to data
+	 * @param i decoded int
+	 *
+	 * @return new pointer position
+	 */
+	char* run_len_decode(char *p, vw_size_t& i);
+
+	/**
+	 * Decode a signed int32_t from an encoded unsigned form
+	 *
+	 * @param n encoded unsigned int
+	 *
+	 * @return decoded signed int
+	 */
+	inline int32_t ZigZagDecode(uint32_t n)
+	{
+		return (n >> 1) ^ -static_cast<int32_t>(n & 1);
+	}
+
+	/**
+	 * Advance the cursor by n bytes within the current chunk
+	 *
+	 * @param n number of bytes
+	 *
+	 * @return pointer to the first of the n bytes
+	 */
+	char* take_bytes(uint64_t n);
+
+protected:
+	/// Compression type of the chunks
+	E_COMPRESSION_TYPE compression_type;
+
+	/// Decompressor
+	CCompressor* compressor;
+
+	/// Offsets of the chunks
+	SGVector<uint64_t> chunk_offsets;
+
+	/// Examples per chunk
+	SGVector<uint32_t> chunk_counts;
+
+	/// Uncompressed chunk sizes
+	SGVector<uint64_t> chunk_raw_sizes;
+
+	/// Compressed chunk sizes
+	SGVector<uint64_t> chunk_packed_sizes;
+
+	/// Chunks visited in a pass
+	SGVector<index_t> chunk_order;
+
+	/// Position in chunk_order
+	index_t order_pos;
+
+	/// Decompressed current chunk
+	uint8_t* raw_buf;
+
+	/// Capacity of raw_buf
+	uint64_t raw_capacity;
+
+	/// Compressed data of the current chunk
+	uint8_t* packed_buf;
+
+	/// Capacity of packed_buf
+	uint64_t packed_capacity;
+
+	/// Read position in raw_buf
+	char* cursor;
+
+	/// End of the data in raw_buf
+	char* cursor_end;
+
+	/// Examples left in the current chunk
+	uint32_t examples_left;
+
+private:
+	// Used while parsing
+	vw_size_t neg_1;
+	vw_size_t general;
+};
+
+}
+#endif // _VW_CHUNKEDCACHE_READ_H__
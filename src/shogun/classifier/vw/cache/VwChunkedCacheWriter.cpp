@@ -0,0 +1,277 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society.
+ */
+
+#include <shogun/classifier/vw/cache/VwChunkedCacheWriter.h>
+#include <shogun/classifier/vw/cache/VwChunkedCacheReader.h>
+#include <shogun/lib/ShogunException.h>
+
+using namespace shogun;
+
+CVwChunkedCacheWriter::CVwChunkedCacheWriter()
+	: CVwCacheWriter()
+{
+	init();
+}
+
+CVwChunkedCacheWriter::CVwChunkedCacheWriter(char * fname, CVwEnvironment* env_to_use,
+		E_COMPRESSION_TYPE ct, int32_t examples_per_chunk)
+	: CVwCacheWriter(fname, env_to_use)
+{
+	init();
+	set_compression_type(ct);
+	REQUIRE(examples_per_chunk>0, "Number of examples per chunk (%d) must be positive\n",
+			examples_per_chunk)
+	chunk_size=examples_per_chunk;
+
+	write_header();
+}
+
+CVwChunkedCacheWriter::~CVwChunkedCacheWriter()
+{
+	if (fd >= 0)
+	{
+		/* a destructor must not throw, a failed write only leaves the
+		 * file without its index */
+		try
+		{
+			finalize();
+		}
+		catch (ShogunException& e)
+		{
+			SG_WARNING("Could not finalize chunked cache: %s\n",
+					e.get_exception_string())
+		}
+		close(fd);
+	}
+
+	SG_UNREF(compressor);
+}
+
+void CVwChunkedCacheWriter::set_file(int32_t f)
+{
+	if (fd >= 0)
+	{
+		finalize();
+		close(fd);
+	}
+
+	fd = f;
+	file_offset = 0;
+	finalized = false;
+	chunk_examples = 0;
+	chunk_buf.erase();
+	chunk_offsets.reset(0);
+	chunk_counts.reset(0);
+	chunk_raw_sizes.reset(0);
+	chunk_packed_sizes.reset(0);
+
+	write_header();
+}
+
+void CVwChunkedCacheWriter::init()
+{
+	neg_1 = 1;
+	general = 2;
+	int_size = 6;
+
+	compression_type = UNCOMPRESSED;
+	compressor = new CCompressor(compression_type);
+	SG_REF(compressor);
+	chunk_size = 4096;
+	chunk_examples = 0;
+	file_offset = 0;
+	finalized = false;
+}
+
+void CVwChunkedCacheWriter::set_compression_type(E_COMPRESSION_TYPE ct)
+{
+	SG_UNREF(compressor);
+	compression_type = ct;
+	compressor = new CCompressor(compression_type);
+	SG_REF(compressor);
+}
+
+void CVwChunkedCacheWriter::write_bytes(const void* data, size_t nbytes)
+{
+	if (write(fd, data, nbytes) != (ssize_t) nbytes)
+		SG_ERROR("Error, failed to write to chunked cache!\n")
+
+	file_offset += nbytes;
+}
+
+void CVwChunkedCacheWriter::write_header()
+{
+	const char* vw_version = env->vw_version;
+	vw_size_t numbits = env->num_bits;
+	vw_size_t v_length = 4;
+	uint32_t format_version = VW_CHUNKED_CACHE_VERSION;
+	int32_t ct = compression_type;
+
+	write_bytes(VW_CHUNKED_CACHE_MAGIC, 4);
+	write_bytes(&format_version, sizeof(format_version));
+	write_bytes(&v_length, sizeof(vw_size_t));
+	write_bytes(vw_version, v_length);
+	write_bytes(&numbits, sizeof(vw_size_t));
+	write_bytes(&ct, sizeof(ct));
+	write_bytes(&chunk_size, sizeof(chunk_size));
+}
+
+void CVwChunkedCacheWriter::flush_chunk()
+{
+	if (chunk_examples == 0)
+		return;
+
+	uint64_t raw_size = chunk_buf.index();
+	uint8_t* packed = NULL;
+	uint64_t packed_size = 0;
+	compressor->compress((uint8_t*) chunk_buf.begin, raw_size, packed, packed_size);
+
+	chunk_offsets.append_element(file_offset);
+	chunk_counts.append_element(chunk_examples);
+	chunk_raw_sizes.append_element(raw_size);
+	chunk_packed_sizes.append_element(packed_size);
+
+	write_bytes(&chunk_examples, sizeof(chunk_examples));
+	write_bytes(&raw_size, sizeof(raw_size));
+	write_bytes(&packed_size, sizeof(packed_size));
+	write_bytes(packed, packed_size);
+	SG_FREE(packed);
+
+	chunk_buf.erase();
+	chunk_examples = 0;
+}
+
+void CVwChunkedCacheWriter::finalize()
+{
+	if (finalized || fd < 0)
+		return;
+
+	flush_chunk();
+
+	uint64_t index_offset = file_offset;
+	uint64_t num_chunks = chunk_offsets.get_num_elements();
+	for (index_t i=0; i<(index_t) num_chunks; i++)
+	{
+		uint64_t offset = chunk_offsets[i];
+		uint32_t count = chunk_counts[i];
+		uint64_t raw_size = chunk_raw_sizes[i];
+		uint64_t packed_size = chunk_packed_sizes[i];
+
+		write_bytes(&offset, sizeof(offset));
+		write_bytes(&count, sizeof(count));
+		write_bytes(&raw_size, sizeof(raw_size));
+		write_bytes(&packed_size, sizeof(packed_size));
+	}
+
+	write_bytes(&index_offset, sizeof(index_offset));
+	write_bytes(&num_chunks, sizeof(num_chunks));
+	write_bytes(VW_CHUNKED_CACHE_INDEX_MAGIC, 4);
+
+	fsync(fd);
+	finalized = true;
+}
+
+char* CVwChunkedCacheWriter::run_len_encode(char *p, vw_size_t i)
+{
+	while (i >= 128)
+	{
+		*(p++) = (i & 127) | 128;
+		i = i >> 7;
+	}
+	*(p++) = (i & 127);
+
+	return p;
+}
+
+char* CVwChunkedCacheWriter::reserve_bytes(vw_size_t n)
+{
+	if (chunk_buf.end + n > chunk_buf.end_array)
+	{
+		size_t length = chunk_buf.index();
+		size_t new_length = CMath::max(2 * (size_t) (chunk_buf.end_array - chunk_buf.begin),
+				length + n);
+		chunk_buf.begin = SG_REALLOC(char, chunk_buf.begin, length, new_length);
+		chunk_buf.end = chunk_buf.begin + length;
+		chunk_buf.end_array = chunk_buf.begin + new_length;
+	}
+
+	char* c = chunk_buf.end;
+	chunk_buf.end += n;
+	return c;
+}
+
+void CVwChunkedCacheWriter::output_features(unsigned char index, VwFeature* begin, VwFeature* end)
+{
+	vw_size_t storage = (end-begin) * int_size;
+	for (VwFeature* i = begin; i != end; i++)
+		if (i->x != 1. && i->x != -1.)
+			storage+=sizeof(float32_t);
+
+	// Reserve the upper bound and give back what RLE did not use
+	char* start = reserve_bytes(sizeof(index) + storage + sizeof(vw_size_t));
+	char* c = start;
+	*(unsigned char*)c = index;
+	c += sizeof(index);
+
+	char *storage_size_loc = c;
+	c += sizeof(vw_size_t);
+
+	vw_size_t last = 0;
+
+	// Store the differences in hashed feature indices
+	for (VwFeature* i = begin; i != end; i++)
+	{
+		int32_t s_diff = (i->weight_index - last);
+		vw_size_t diff = ZigZagEncode(s_diff) << 2;
+		last = i->weight_index;
+
+		if (i->x == 1.)
+			c = run_len_encode(c, diff);
+		else if (i->x == -1.)
+			c = run_len_encode(c, diff | neg_1);
+		else
+		{
+			c = run_len_encode(c, diff | general);
+			*(float32_t*)c = i->x;
+			c += sizeof(float32_t);
+		}
+	}
+	chunk_buf.end = c;
+	*(vw_size_t*)storage_size_loc = c - storage_size_loc - sizeof(vw_size_t);
+}
+
+void CVwChunkedCacheWriter::cache_example(VwExample* &ex)
+{
+	REQUIRE(!finalized, "Cannot cache examples after the chunked cache was finalized\n")
+
+	// Label
+	VwLabel* ld = ex->ld;
+	char* c = reserve_bytes(sizeof(ld->label)+sizeof(ld->weight)+sizeof(ld->initial));
+	*(float32_t*)c = ld->label;
+	c += sizeof(ld->label);
+	*(float32_t*)c = ld->weight;
+	c += sizeof(ld->weight);
+	*(float32_t*)c = ld->initial;
+
+	// Tag
+	vw_size_t tag_size = ex->tag.index();
+	c = reserve_bytes(sizeof(vw_size_t)+tag_size);
+	*(vw_size_t*)c = tag_size;
+	c += sizeof(vw_size_t);
+	memcpy(c, ex->tag.begin, tag_size);
+
+	// Namespaces
+	c = reserve_bytes(1);
+	*c = (unsigned char) ex->indices.index();
+	for (vw_size_t* b = ex->indices.begin; b != ex->indices.end; b++)
+		output_features(*b, ex->atomics[*b].begin, ex->atomics[*b].end);
+
+	if (++chunk_examples >= (uint32_t) chunk_size)
+		flush_chunk();
+}
@@ -0,0 +1,219 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society.
+ */
+
+#ifndef _VW_CHUNKEDCACHE_WRITE_H__
+#define _VW_CHUNKEDCACHE_WRITE_H__
+
+#include <shogun/classifier/vw/cache/VwCacheWriter.h>
+#include <shogun/lib/Compressor.h>
+#include <shogun/base/DynArray.h>
+
+namespace shogun
+{
+
+/** @brief Class CVwChunkedCacheWriter writes a block-indexed (version 2)
+ * cache for VW.
+ *
+ * Examples are encoded exactly as in CVwNativeCacheWriter, but are grouped
+ * into chunks of a fixed number of examples. Every chunk is optionally
+ * compressed with CCompressor (SNAPPY or LZO are recommended) and its
+ * offset is recorded in an index appended to the end of the file when the
+ * writer is closed.
+ *
+ * The index lets CVwChunkedCacheReader access chunks in arbitrary order and
+ * lets several readers decode disjoint sets of chunks concurrently.
+ *
+ * File layout:
+ *   header  : magic, format version, vw version, num_bits,
+ *             compression type, examples per chunk
+ *   chunks  : [num_examples, uncompressed size, compressed size, data]*
+ *   index   : [offset, num_examples, uncompressed size, compressed size]*
+ *   trailer : index offset, number of chunks, magic
+ */
+class CVwChunkedCacheWriter: public CVwCacheWriter
+{
+public:
+	/**
+	 * Default constructor
+	 */
+	CVwChunkedCacheWriter();
+
+	/**
+	 * Constructor, opens a file whose name is specified
+	 *
+	 * @param fname file name
+	 * @param env_to_use Environment to use
+	 * @param ct compression applied to each chunk
+	 * @param examples_per_chunk number of examples stored in one chunk
+	 */
+	CVwChunkedCacheWriter(char * fname, CVwEnvironment* env_to_use,
+			E_COMPRESSION_TYPE ct=UNCOMPRESSED,
+			int32_t examples_per_chunk=4096);
+
+	/**
+	 * Destructor, writes the pending chunk and the index
+	 */
+	virtual ~CVwChunkedCacheWriter();
+
+	/**
+	 * Set the file descriptor to use.
+	 * Finalizes a previously used file first.
+	 *
+	 * @param f descriptor of cache file
+	 */
+	virtual void set_file(int32_t f);
+
+	/**
+	 * Cache one example
+	 *
+	 * @param ex example to write to cache
+	 */
+	virtual void cache_example(VwExample* &ex);
+
+	/**
+	 * Write the pending chunk, the chunk index and the trailer.
+	 * No further examples can be cached to this file afterwards.
+	 *
+	 * The destructor finalizes the file if this was not done, but can
+	 * only warn about write errors then.
+	 */
+	void finalize();
+
+	/**
+	 * Set compression used for chunks written from now on
+	 *
+	 * @param ct compression type
+	 */
+	void set_compression_type(E_COMPRESSION_TYPE ct);
+
+	/**
+	 * Get compression used for chunks
+	 *
+	 * @return compression type
+	 */
+	E_COMPRESSION_TYPE get_compression_type() { return compression_type; }
+
+	/**
+	 * Return the name of the object.
+	 *
+	 * @return VwChunkedCacheWriter
+	 */
+	virtual const char* get_name() const { return "VwChunkedCacheWriter"; }
+
+private:
+	/**
+	 * Initialize members
+	 */
+	void init();
+
+	/**
+	 * Write the header of the cache.
+	 */
+	void write_header();
+
+	/**
+	 * Compress and write the examples collected so far as one chunk
+	 */
+	void flush_chunk();
+
+	/**
+	 * Write nbytes to the file, raising an error on failure
+	 *
+	 * @param data data to write
+	 * @param nbytes number of bytes
+	 */
+	void write_bytes(const void* data, size_t nbytes);
+
+	/**
+	 * Use run-length encoding on an int
+	 *
+	 * @param p compressed data ptr
+	 * @param i int32_t to compress
+	 *
+	 * @return ptr to compressed data
+	 */
+	char* run_len_encode(char *p, vw_size_t i);
+
+	/**
+	 * Encode a signed int32_t into an unsigned representation
+	 *
+	 * @param n signed int
+	 *
+	 * @return unsigned int
+	 */
+	inline uint32_t ZigZagEncode(int32_t n)
+	{
+		uint32_t ret = (n << 1) ^ (n >> 31);
+
+		return ret;
+	}
+
+	/**
+	 * Reserve n bytes at the end of the chunk buffer
+	 *
+	 * @param n number of bytes
+	 *
+	 * @return pointer to the reserved bytes
+	 */
+	char* reserve_bytes(vw_size_t n);
+
+	/**
+	 * Write the features of one namespace into the chunk buffer
+	 *
+	 * @param index namespace index
+	 * @param begin first feature
+	 * @param end pointer to end of features
+	 */
+	void output_features(unsigned char index, VwFeature* begin, VwFeature* end);
+
+protected:
+	/// Compressor for chunks
+	CCompressor* compressor;
+
+	/// Compression type
+	E_COMPRESSION_TYPE compression_type;
+
+	/// Examples per chunk
+	int32_t chunk_size;
+
+	/// Encoded examples of the current chunk
+	v_array<char> chunk_buf;
+
+	/// Number of examples in the current chunk
+	uint32_t chunk_examples;
+
+	/// Current write offset in the file
+	uint64_t file_offset;
+
+	/// Offsets of the written chunks
+	DynArray<uint64_t> chunk_offsets;
+
+	/// Number of examples of the written chunks
+	DynArray<uint32_t> chunk_counts;
+
+	/// Uncompressed sizes of the written chunks
+	DynArray<uint64_t> chunk_raw_sizes;
+
+	/// Compressed sizes of the written chunks
+	DynArray<uint64_t> chunk_packed_sizes;
+
+	/// Whether the index was written already
+	bool finalized;
+
+private:
+	/// Used for encoding -1
+	vw_size_t neg_1;
+	/// Used for encoding other numbers
+	vw_size_t general;
+	/// int size for encoding
+	vw_size_t int_size;
+};
+
+}
+#endif // _VW_CHUNKEDCACHE_WRITE_H__
@@ -25,6 +25,41 @@
 using namespace shogun;
 using namespace std;
 
+/** number of training vectors processed together */
+#define GMM_BLOCK_POINTS 256
+
+/* copy vectors [start, start+n) of data into block, one per column */
+static void fetch_block(CDotFeatures* data, int32_t start, int32_t n,
+		int32_t dim, float64_t* block)
+{
+	memset(block, 0, sizeof(float64_t)*int64_t(dim)*n);
+	for (int32_t i=0; i<n; i++)
+		data->add_to_dense_vec(1.0, start+i, &block[int64_t(i)*dim], dim);
+}
+
+/* contiguous chunks of vectors with their own statistics, merged in chunk
+ * order so the result does not depend on thread scheduling */
+static int32_t get_num_chunks(int32_t num_vectors, int32_t num_threads)
+{
+	return CMath::max(1, CMath::min(num_threads, num_vectors/GMM_BLOCK_POINTS));
+}
+
+static float64_t log_sum_exp(const float64_t* values, int32_t num)
+{
+	float64_t max_value=values[0];
+	for (int32_t i=1; i<num; i++)
+		max_value=CMath::max(max_value, values[i]);
+
+	if (max_value==-CMath::INFTY)
+		return max_value;
+
+	float64_t sum=0;
+	for (int32_t i=0; i<num; i++)
+		sum+=CMath::exp(values[i]-max_value);
+
+	return max_value+CMath::log(sum);
+}
+
 CGMM::CGMM() : CDistribution(), m_components(),	m_coefficients()
 {
 	register_params();
@@ -61,7 +96,7 @@ CGMM::CGMM(vector<CGaussian*> components, SGVector<float64_t> coefficients, bool
 	}
 	else
 	{
-		m_coefficients = coefficients;
+		m_coefficients = SGVector<float64_t>(coefficients.vlen);
 		m_components = vector<CGaussian*>(components.size());
 
 		for (int32_t i=0; i<int32_t(components.size()); i++)
@@ -132,6 +167,7 @@ float64_t CGMM::train_em(float64_t min_cov, int32_t max_iter, float64_t min_chan
 
 	CDotFeatures* dotdata=(CDotFeatures *) features;
 	int32_t num_vectors=dotdata->get_num_vectors();
+	int32_t num_comp=int32_t(m_components.size());
 
 	SGMatrix<float64_t> alpha;
 
@@ -154,33 +190,24 @@ float64_t CGMM::train_em(float64_t min_cov, int32_t max_iter, float64_t min_chan
 	int32_t iter=0;
 	float64_t log_likelihood_prev=0;
 	float64_t log_likelihood_cur=0;
-	float64_t* logPxy=SG_MALLOC(float64_t, num_vectors*m_components.size());
-	float64_t* logPx=SG_MALLOC(float64_t, num_vectors);
-	//float64_t* logPost=SG_MALLOC(float64_t, num_vectors*m_components.vlen);
+	float64_t* logPxy=SG_MALLOC(float64_t, int64_t(num_vectors)*num_comp);
 
 	while (iter<max_iter)
 	{
 		log_likelihood_prev=log_likelihood_cur;
 		log_likelihood_cur=0;
 
+		compute_log_pxy(m_components, m_coefficients, logPxy);
+
+		#pragma omp parallel for reduction(+:log_likelihood_cur) num_threads(parallel->get_num_threads())
 		for (int32_t i=0; i<num_vectors; i++)
 		{
-			logPx[i]=0;
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
-			for (int32_t j=0; j<int32_t(m_components.size()); j++)
-			{
-				logPxy[i*m_components.size()+j]=m_components[j]->compute_log_PDF(v)+CMath::log(m_coefficients[j]);
-				logPx[i]+=CMath::exp(logPxy[i*m_components.size()+j]);
-			}
+			const float64_t* lp=&logPxy[int64_t(i)*num_comp];
+			float64_t logPx=log_sum_exp(lp, num_comp);
+			log_likelihood_cur+=logPx;
 
-			logPx[i]=CMath::log(logPx[i]);
-			log_likelihood_cur+=logPx[i];
-
-			for (int32_t j=0; j<int32_t(m_components.size()); j++)
-			{
-				//logPost[i*m_components.vlen+j]=logPxy[i*m_components.vlen+j]-logPx[i];
-				alpha.matrix[i*m_components.size()+j]=CMath::exp(logPxy[i*m_components.size()+j]-logPx[i]);
-			}
+			for (int32_t j=0; j<num_comp; j++)
+				alpha.matrix[int64_t(i)*num_comp+j]=CMath::exp(lp[j]-logPx);
 		}
 
 		if (iter>0 && log_likelihood_cur-log_likelihood_prev<min_change)
@@ -192,7 +219,6 @@ float64_t CGMM::train_em(float64_t min_cov, int32_t max_iter, float64_t min_chan
 	}
 
 	SG_FREE(logPxy);
-	SG_FREE(logPx);
 
 	return log_likelihood_cur;
 }
@@ -207,122 +233,167 @@ float64_t CGMM::train_smem(int32_t max_iter, int32_t max_cand, float64_t min_cov
 
 	CDotFeatures* dotdata=(CDotFeatures *) features;
 	int32_t num_vectors=dotdata->get_num_vectors();
+	int32_t num_dim=dotdata->get_dim_feature_space();
+	int32_t num_comp=int32_t(m_components.size());
+	int32_t num_pairs=num_comp*(num_comp-1)/2;
 
 	float64_t cur_likelihood=train_em(min_cov, max_em_iter, min_change);
 
 	int32_t iter=0;
-	float64_t* logPxy=SG_MALLOC(float64_t, num_vectors*m_components.size());
-	float64_t* logPx=SG_MALLOC(float64_t, num_vectors);
-	float64_t* logPost=SG_MALLOC(float64_t, num_vectors*m_components.size());
-	float64_t* logPostSum=SG_MALLOC(float64_t, m_components.size());
-	float64_t* logPostSum2=SG_MALLOC(float64_t, m_components.size());
-	float64_t* logPostSumSum=SG_MALLOC(float64_t, m_components.size()*(m_components.size()-1)/2);
-	float64_t* split_crit=SG_MALLOC(float64_t, m_components.size());
-	float64_t* merge_crit=SG_MALLOC(float64_t, m_components.size()*(m_components.size()-1)/2);
-	int32_t* split_ind=SG_MALLOC(int32_t, m_components.size());
-	int32_t* merge_ind=SG_MALLOC(int32_t, m_components.size()*(m_components.size()-1)/2);
+	float64_t* logPxy=SG_MALLOC(float64_t, int64_t(num_vectors)*num_comp);
+	float64_t* logPost=SG_MALLOC(float64_t, int64_t(num_vectors)*num_comp);
+	float64_t* logPostSum=SG_MALLOC(float64_t, num_comp);
+	float64_t* logPostSum2=SG_MALLOC(float64_t, num_comp);
+	float64_t* logPostSumSum=SG_MALLOC(float64_t, num_pairs);
+	float64_t* split_crit=SG_MALLOC(float64_t, num_comp);
+	float64_t* merge_crit=SG_MALLOC(float64_t, num_pairs);
+	int32_t* split_ind=SG_MALLOC(int32_t, num_comp);
+	int32_t* merge_ind=SG_MALLOC(int32_t, num_pairs);
 
 	while (iter<max_iter)
 	{
-		memset(logPostSum, 0, m_components.size()*sizeof(float64_t));
-		memset(logPostSum2, 0, m_components.size()*sizeof(float64_t));
-		memset(logPostSumSum, 0, (m_components.size()*(m_components.size()-1)/2)*sizeof(float64_t));
-		for (int32_t i=0; i<num_vectors; i++)
+		compute_log_pxy(m_components, m_coefficients, logPxy);
+
+		/* posterior sums of each chunk of vectors, in order sum, sum of
+		 * squares and sums of pairwise products */
+		int32_t num_chunks=get_num_chunks(num_vectors, parallel->get_num_threads());
+		int32_t stats_len=2*num_comp+num_pairs;
+		float64_t* chunk_stats=SG_CALLOC(float64_t, int64_t(num_chunks)*stats_len);
+
+		#pragma omp parallel for num_threads(parallel->get_num_threads())
+		for (int32_t c=0; c<num_chunks; c++)
 		{
-			logPx[i]=0;
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
-			for (int32_t j=0; j<int32_t(m_components.size()); j++)
+			int32_t first=int64_t(c)*num_vectors/num_chunks;
+			int32_t last=int64_t(c+1)*num_vectors/num_chunks;
+			float64_t* sum=&chunk_stats[int64_t(c)*stats_len];
+			float64_t* sum2=&sum[num_comp];
+			float64_t* sumsum=&sum2[num_comp];
+
+			for (int32_t i=first; i<last; i++)
 			{
-				logPxy[i*m_components.size()+j]=m_components[j]->compute_log_PDF(v)+CMath::log(m_coefficients[j]);
-				logPx[i]+=CMath::exp(logPxy[i*m_components.size()+j]);
-			}
+				const float64_t* lp=&logPxy[int64_t(i)*num_comp];
+				float64_t* lpost=&logPost[int64_t(i)*num_comp];
+				float64_t logPx=log_sum_exp(lp, num_comp);
 
-			logPx[i]=CMath::log(logPx[i]);
+				for (int32_t j=0; j<num_comp; j++)
+				{
+					lpost[j]=lp[j]-logPx;
+					sum[j]+=CMath::exp(lpost[j]);
+					sum2[j]+=CMath::exp(2*lpost[j]);
+				}
 
-			for (int32_t j=0; j<int32_t(m_components.size()); j++)
-			{
-				logPost[i*m_components.size()+j]=logPxy[i*m_components.size()+j]-logPx[i];
-				logPostSum[j]+=CMath::exp(logPost[i*m_components.size()+j]);
-				logPostSum2[j]+=CMath::exp(2*logPost[i*m_components.size()+j]);
+				int32_t counter=0;
+				for (int32_t j=0; j<num_comp; j++)
+				{
+					for (int32_t k=j+1; k<num_comp; k++)
+					{
+						sumsum[counter]+=CMath::exp(lpost[j]+lpost[k]);
+						counter++;
+					}
+				}
 			}
+		}
 
-			int32_t counter=0;
-			for (int32_t j=0; j<int32_t(m_components.size()); j++)
+		memset(logPostSum, 0, num_comp*sizeof(float64_t));
+		memset(logPostSum2, 0, num_comp*sizeof(float64_t));
+		memset(logPostSumSum, 0, num_pairs*sizeof(float64_t));
+		for (int32_t c=0; c<num_chunks; c++)
+		{
+			float64_t* sum=&chunk_stats[int64_t(c)*stats_len];
+			for (int32_t j=0; j<num_comp; j++)
 			{
-				for (int32_t k=j+1; k<int32_t(m_components.size()); k++)
-				{
-					logPostSumSum[counter]+=CMath::exp(logPost[i*m_components.size()+j]+logPost[i*m_components.size()+k]);
-					counter++;
-				}
+				logPostSum[j]+=sum[j];
+				logPostSum2[j]+=sum[num_comp+j];
 			}
+			for (int32_t j=0; j<num_pairs; j++)
+				logPostSumSum[j]+=sum[2*num_comp+j];
 		}
+		SG_FREE(chunk_stats);
 
-		int32_t counter=0;
-		for (int32_t i=0; i<int32_t(m_components.size()); i++)
+		#pragma omp parallel for num_threads(parallel->get_num_threads())
+		for (int32_t i=0; i<num_comp; i++)
 		{
 			logPostSum[i]=CMath::log(logPostSum[i]);
 			split_crit[i]=0;
 			split_ind[i]=i;
 			for (int32_t j=0; j<num_vectors; j++)
 			{
-				split_crit[i]+=(logPost[j*m_components.size()+i]-logPostSum[i]-logPxy[j*m_components.size()+i]+CMath::log(m_coefficients[i]))*
-								(CMath::exp(logPost[j*m_components.size()+i])/CMath::exp(logPostSum[i]));
+				split_crit[i]+=(logPost[int64_t(j)*num_comp+i]-logPostSum[i]-logPxy[int64_t(j)*num_comp+i]+CMath::log(m_coefficients[i]))*
+								(CMath::exp(logPost[int64_t(j)*num_comp+i])/CMath::exp(logPostSum[i]));
 			}
-			for (int32_t j=i+1; j<int32_t(m_components.size()); j++)
+		}
+
+		int32_t counter=0;
+		for (int32_t i=0; i<num_comp; i++)
+		{
+			for (int32_t j=i+1; j<num_comp; j++)
 			{
 				merge_crit[counter]=CMath::log(logPostSumSum[counter])-(0.5*CMath::log(logPostSum2[i]))-(0.5*CMath::log(logPostSum2[j]));
-				merge_ind[counter]=i*m_components.size()+j;
+				merge_ind[counter]=i*num_comp+j;
 				counter++;
 			}
 		}
-		CMath::qsort_backward_index(split_crit, split_ind, int32_t(m_components.size()));
-		CMath::qsort_backward_index(merge_crit, merge_ind, int32_t(m_components.size()*(m_components.size()-1)/2));
+		CMath::qsort_backward_index(split_crit, split_ind, num_comp);
+		CMath::qsort_backward_index(merge_crit, merge_ind, num_pairs);
 
-		bool better_found=false;
-		int32_t candidates_checked=0;
-		for (int32_t i=0; i<int32_t(m_components.size()); i++)
+		/* candidates in the order they are to be tried */
+		vector<int32_t> cand_split;
+		vector<int32_t> cand_merge;
+		for (int32_t i=0; i<num_comp && int32_t(cand_split.size())<CMath::max(max_cand, 1); i++)
 		{
-			for (int32_t j=0; j<int32_t(m_components.size()*(m_components.size()-1)/2); j++)
+			for (int32_t j=0; j<num_pairs && int32_t(cand_split.size())<CMath::max(max_cand, 1); j++)
 			{
-				if (merge_ind[j]/int32_t(m_components.size()) != split_ind[i] && int32_t(merge_ind[j]%m_components.size()) != split_ind[i])
+				if (merge_ind[j]/num_comp != split_ind[i] && merge_ind[j]%num_comp != split_ind[i])
 				{
-					candidates_checked++;
-					CGMM* candidate=new CGMM(m_components, m_coefficients, true);
-					candidate->train(features);
-					candidate->partial_em(split_ind[i], merge_ind[j]/int32_t(m_components.size()), merge_ind[j]%int32_t(m_components.size()), min_cov, max_em_iter, min_change);
-					float64_t cand_likelihood=candidate->train_em(min_cov, max_em_iter, min_change);
-
-					if (cand_likelihood>cur_likelihood)
-					{
-						cur_likelihood=cand_likelihood;
-						set_comp(candidate->get_comp());
-						set_coef(candidate->get_coef());
+					cand_split.push_back(split_ind[i]);
+					cand_merge.push_back(merge_ind[j]);
+				}
+			}
+		}
 
-						for (int32_t k=0; k<int32_t(candidate->get_comp().size()); k++)
-						{
-							SG_UNREF(candidate->get_comp()[k]);
-						}
+		/* candidates are set up and their random perturbations drawn
+		 * serially, so the outcome does not depend on the number of threads */
+		int32_t num_cand=int32_t(cand_split.size());
+		vector<CGMM*> candidates(num_cand);
+		vector<SGVector<float64_t> > noise(num_cand);
+		SGVector<float64_t> cand_likelihood(num_cand);
+		for (int32_t c=0; c<num_cand; c++)
+		{
+			candidates[c]=new CGMM(m_components, m_coefficients, true);
+			candidates[c]->train(features);
+			noise[c]=SGVector<float64_t>(2*num_dim);
+			for (int32_t k=0; k<2*num_dim; k++)
+				noise[c][k]=CMath::randn_double();
+		}
 
-						better_found=true;
-						break;
-					}
-					else
-						delete candidate;
+		#pragma omp parallel for schedule(dynamic) num_threads(parallel->get_num_threads())
+		for (int32_t c=0; c<num_cand; c++)
+		{
+			candidates[c]->partial_em(cand_split[c], cand_merge[c]/num_comp, cand_merge[c]%num_comp, min_cov, max_em_iter, min_change, noise[c]);
+			cand_likelihood[c]=candidates[c]->train_em(min_cov, max_em_iter, min_change);
+		}
 
-					if (candidates_checked>=max_cand)
-						break;
-				}
+		/* the first improving candidate wins, as when trying them in turn */
+		bool better_found=false;
+		for (int32_t c=0; c<num_cand; c++)
+		{
+			if (!better_found && cand_likelihood[c]>cur_likelihood)
+			{
+				cur_likelihood=cand_likelihood[c];
+				set_comp(candidates[c]->get_comp());
+				set_coef(candidates[c]->get_coef());
+				better_found=true;
 			}
-			if (better_found || candidates_checked>=max_cand)
-				break;
+
+			delete candidates[c];
 		}
+
 		if (!better_found)
 			break;
 		iter++;
 	}
 
 	SG_FREE(logPxy);
-	SG_FREE(logPx);
 	SG_FREE(logPost);
 	SG_FREE(split_crit);
 	SG_FREE(merge_crit);
@@ -335,36 +406,35 @@ float64_t CGMM::train_smem(int32_t max_iter, int32_t max_cand, float64_t min_cov
 	return cur_likelihood;
 }
 
-void CGMM::partial_em(int32_t comp1, int32_t comp2, int32_t comp3, float64_t min_cov, int32_t max_em_iter, float64_t min_change)
+void CGMM::partial_em(int32_t comp1, int32_t comp2, int32_t comp3, float64_t min_cov, int32_t max_em_iter, float64_t min_change,
+		SGVector<float64_t> noise)
 {
 	CDotFeatures* dotdata=(CDotFeatures *) features;
 	int32_t num_vectors=dotdata->get_num_vectors();
+	int32_t num_comp=int32_t(m_components.size());
 
-	float64_t* init_logPxy=SG_MALLOC(float64_t, num_vectors*m_components.size());
-	float64_t* init_logPx=SG_MALLOC(float64_t, num_vectors);
+	float64_t* init_logPxy=SG_MALLOC(float64_t, int64_t(num_vectors)*num_comp);
 	float64_t* init_logPx_fix=SG_MALLOC(float64_t, num_vectors);
 	float64_t* post_add=SG_MALLOC(float64_t, num_vectors);
 
+	compute_log_pxy(m_components, m_coefficients, init_logPxy);
+
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
 	for (int32_t i=0; i<num_vectors; i++)
 	{
-		init_logPx[i]=0;
-		init_logPx_fix[i]=0;
+		const float64_t* lp=&init_logPxy[int64_t(i)*num_comp];
+		float64_t init_logPx=log_sum_exp(lp, num_comp);
 
-		SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
-		for (int32_t j=0; j<int32_t(m_components.size()); j++)
+		init_logPx_fix[i]=0;
+		for (int32_t j=0; j<num_comp; j++)
 		{
-			init_logPxy[i*m_components.size()+j]=m_components[j]->compute_log_PDF(v)+CMath::log(m_coefficients[j]);
-			init_logPx[i]+=CMath::exp(init_logPxy[i*m_components.size()+j]);
 			if (j!=comp1 && j!=comp2 && j!=comp3)
-			{
-				init_logPx_fix[i]+=CMath::exp(init_logPxy[i*m_components.size()+j]);
-			}
+				init_logPx_fix[i]+=CMath::exp(lp[j]);
 		}
 
-		init_logPx[i]=CMath::log(init_logPx[i]);
-		post_add[i]=CMath::log(CMath::exp(init_logPxy[i*m_components.size()+comp1]-init_logPx[i])+
-					CMath::exp(init_logPxy[i*m_components.size()+comp2]-init_logPx[i])+
-					CMath::exp(init_logPxy[i*m_components.size()+comp3]-init_logPx[i]));
+		post_add[i]=CMath::log(CMath::exp(lp[comp1]-init_logPx)+
+					CMath::exp(lp[comp2]-init_logPx)+
+					CMath::exp(lp[comp3]-init_logPx));
 	}
 
 	vector<CGaussian*> components(3);
@@ -388,10 +458,11 @@ void CGMM::partial_em(int32_t comp1, int32_t comp2, int32_t comp3, float64_t min
 	SGVector<float64_t>::add(components[1]->get_mean().vector, alpha1, components[1]->get_mean().vector, alpha2,
 				components[2]->get_mean().vector, dim_n);
 
+	ASSERT(noise.vlen==2*dim_n)
 	for (int32_t i=0; i<dim_n; i++)
 	{
-		components[2]->get_mean().vector[i]=components[0]->get_mean().vector[i]+CMath::randn_double()*noise_mag;
-		components[0]->get_mean().vector[i]=components[0]->get_mean().vector[i]+CMath::randn_double()*noise_mag;
+		components[2]->get_mean().vector[i]=components[0]->get_mean().vector[i]+noise[2*i]*noise_mag;
+		components[0]->get_mean().vector[i]=components[0]->get_mean().vector[i]+noise[2*i+1]*noise_mag;
 	}
 
 	coefficients.vector[1]=coefficients.vector[1]+coefficients.vector[2];
@@ -464,33 +535,25 @@ void CGMM::partial_em(int32_t comp1, int32_t comp2, int32_t comp3, float64_t min
 	float64_t log_likelihood_cur=0;
 	int32_t iter=0;
 	SGMatrix<float64_t> alpha(num_vectors, 3);
-	float64_t* logPxy=SG_MALLOC(float64_t, num_vectors*3);
-	float64_t* logPx=SG_MALLOC(float64_t, num_vectors);
-	//float64_t* logPost=SG_MALLOC(float64_t, num_vectors*m_components.vlen);
+	float64_t* logPxy=SG_MALLOC(float64_t, int64_t(num_vectors)*3);
 
 	while (iter<max_em_iter)
 	{
 		log_likelihood_prev=log_likelihood_cur;
 		log_likelihood_cur=0;
 
+		compute_log_pxy(components, coefficients, logPxy);
+
+		#pragma omp parallel for reduction(+:log_likelihood_cur) num_threads(parallel->get_num_threads())
 		for (int32_t i=0; i<num_vectors; i++)
 		{
-			logPx[i]=0;
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
-			for (int32_t j=0; j<3; j++)
-			{
-				logPxy[i*3+j]=components[j]->compute_log_PDF(v)+CMath::log(coefficients[j]);
-				logPx[i]+=CMath::exp(logPxy[i*3+j]);
-			}
-
-			logPx[i]=CMath::log(logPx[i]+init_logPx_fix[i]);
-			log_likelihood_cur+=logPx[i];
+			const float64_t* lp=&logPxy[int64_t(i)*3];
+			float64_t logPx=CMath::log(CMath::exp(lp[0])+CMath::exp(lp[1])+
+					CMath::exp(lp[2])+init_logPx_fix[i]);
+			log_likelihood_cur+=logPx;
 
 			for (int32_t j=0; j<3; j++)
-			{
-				//logPost[i*m_components.vlen+j]=logPxy[i*m_components.vlen+j]-logPx[i];
-				alpha.matrix[i*3+j]=CMath::exp(logPxy[i*3+j]-logPx[i]+post_add[i]);
-			}
+				alpha.matrix[int64_t(i)*3+j]=CMath::exp(lp[j]-logPx+post_add[i]);
 		}
 
 		if (iter>0 && log_likelihood_cur-log_likelihood_prev<min_change)
@@ -509,9 +572,7 @@ void CGMM::partial_em(int32_t comp1, int32_t comp2, int32_t comp3, float64_t min
 
 	delete partial_candidate;
 	SG_FREE(logPxy);
-	SG_FREE(logPx);
 	SG_FREE(init_logPxy);
-	SG_FREE(init_logPx);
 	SG_FREE(init_logPx_fix);
 	SG_FREE(post_add);
 }
@@ -520,81 +581,177 @@ void CGMM::max_likelihood(SGMatrix<float64_t> alpha, float64_t min_cov)
 {
 	CDotFeatures* dotdata=(CDotFeatures *) features;
 	int32_t num_dim=dotdata->get_dim_feature_space();
+	int32_t num_vectors=alpha.num_rows;
+	int32_t num_comp=alpha.num_cols;
+	int32_t num_chunks=get_num_chunks(num_vectors, parallel->get_num_threads());
+
+	/* where the covariance statistics of each component start */
+	SGVector<int64_t> cov_offset(num_comp+1);
+	cov_offset[0]=0;
+	for (int32_t i=0; i<num_comp; i++)
+	{
+		switch (m_components[i]->get_cov_type())
+		{
+			case FULL:
+				cov_offset[i+1]=cov_offset[i]+int64_t(num_dim)*num_dim;
+				break;
+			case DIAG:
+				cov_offset[i+1]=cov_offset[i]+num_dim;
+				break;
+			case SPHERICAL:
+				cov_offset[i+1]=cov_offset[i]+1;
+				break;
+		}
+	}
+	int64_t cov_len=cov_offset[num_comp];
 
-	float64_t alpha_sum;
-	float64_t alpha_sum_sum=0;
-	float64_t* mean_sum;
-	float64_t* cov_sum=NULL;
+	/* sufficient statistics of each chunk of vectors */
+	float64_t* alpha_sums=SG_CALLOC(float64_t, int64_t(num_chunks)*num_comp);
+	float64_t* mean_sums=SG_CALLOC(float64_t, int64_t(num_chunks)*num_comp*num_dim);
+	float64_t* cov_sums=SG_CALLOC(float64_t, num_chunks*cov_len);
 
-	for (int32_t i=0; i<alpha.num_cols; i++)
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
+	for (int32_t c=0; c<num_chunks; c++)
 	{
-		alpha_sum=0;
-		mean_sum=SG_MALLOC(float64_t, num_dim);
-		memset(mean_sum, 0, num_dim*sizeof(float64_t));
+		int32_t first=int64_t(c)*num_vectors/num_chunks;
+		int32_t last=int64_t(c+1)*num_vectors/num_chunks;
+		float64_t* alpha_sum=&alpha_sums[int64_t(c)*num_comp];
+		float64_t* mean_sum=&mean_sums[int64_t(c)*num_comp*num_dim];
+		float64_t* block=SG_MALLOC(float64_t, int64_t(num_dim)*GMM_BLOCK_POINTS);
 
-		for (int32_t j=0; j<alpha.num_rows; j++)
+		for (int32_t start=first; start<last; start+=GMM_BLOCK_POINTS)
 		{
-			alpha_sum+=alpha.matrix[j*alpha.num_cols+i];
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(j);
-			SGVector<float64_t>::add(mean_sum, alpha.matrix[j*alpha.num_cols+i], v.vector, 1, mean_sum, v.vlen);
+			int32_t n=CMath::min(GMM_BLOCK_POINTS, last-start);
+			const float64_t* a=&alpha.matrix[int64_t(start)*num_comp];
+			fetch_block(dotdata, start, n, num_dim, block);
+
+			for (int32_t i=0; i<n; i++)
+			{
+				for (int32_t j=0; j<num_comp; j++)
+					alpha_sum[j]+=a[i*num_comp+j];
+			}
+
+			/* mean_sum+=block*a' with one column per component */
+			cblas_dgemm(CblasColMajor, CblasNoTrans, CblasTrans, num_dim, num_comp, n,
+					1, block, num_dim, a, num_comp, 1, mean_sum, num_dim);
 		}
 
-		for (int32_t j=0; j<num_dim; j++)
-			mean_sum[j]/=alpha_sum;
+		SG_FREE(block);
+	}
 
-		m_components[i]->set_mean(SGVector<float64_t>(mean_sum, num_dim));
+	SGVector<float64_t> alpha_sum(num_comp);
+	SGMatrix<float64_t> means(num_dim, num_comp);
+	alpha_sum.zero();
+	means.zero();
+	for (int32_t c=0; c<num_chunks; c++)
+	{
+		for (int32_t i=0; i<num_comp; i++)
+			alpha_sum[i]+=alpha_sums[int64_t(c)*num_comp+i];
 
-		ECovType cov_type=m_components[i]->get_cov_type();
+		SGVector<float64_t>::add(means.matrix, 1, means.matrix, 1,
+				&mean_sums[int64_t(c)*num_comp*num_dim], num_comp*num_dim);
+	}
 
-		if (cov_type==FULL)
-		{
-			cov_sum=SG_MALLOC(float64_t, num_dim*num_dim);
-			memset(cov_sum, 0, num_dim*num_dim*sizeof(float64_t));
-		}
-		else if(cov_type==DIAG)
-		{
-			cov_sum=SG_MALLOC(float64_t, num_dim);
-			memset(cov_sum, 0, num_dim*sizeof(float64_t));
-		}
-		else if(cov_type==SPHERICAL)
-		{
-			cov_sum=SG_MALLOC(float64_t, 1);
-			cov_sum[0]=0;
-		}
+	for (int32_t i=0; i<num_comp; i++)
+	{
+		for (int32_t j=0; j<num_dim; j++)
+			means(j,i)/=alpha_sum[i];
+	}
+
+	/* second pass accumulates the scatter around the new means */
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
+	for (int32_t c=0; c<num_chunks; c++)
+	{
+		int32_t first=int64_t(c)*num_vectors/num_chunks;
+		int32_t last=int64_t(c+1)*num_vectors/num_chunks;
+		float64_t* cov_sum=&cov_sums[c*cov_len];
+		float64_t* block=SG_MALLOC(float64_t, int64_t(num_dim)*GMM_BLOCK_POINTS);
+		float64_t* centered=SG_MALLOC(float64_t, int64_t(num_dim)*GMM_BLOCK_POINTS);
 
-		for (int32_t j=0; j<alpha.num_rows; j++)
+		for (int32_t start=first; start<last; start+=GMM_BLOCK_POINTS)
 		{
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(j);
-			SGVector<float64_t>::add(v.vector, 1, v.vector, -1, mean_sum, v.vlen);
+			int32_t n=CMath::min(GMM_BLOCK_POINTS, last-start);
+			fetch_block(dotdata, start, n, num_dim, block);
 
-			switch (cov_type)
+			for (int32_t i=0; i<num_comp; i++)
 			{
-				case FULL:
-					cblas_dger(CblasRowMajor, num_dim, num_dim, alpha.matrix[j*alpha.num_cols+i], v.vector, 1, v.vector,
-								 1, (double*) cov_sum, num_dim);
+				ECovType cov_type=m_components[i]->get_cov_type();
+				const float64_t* mean=means.get_column_vector(i);
+				float64_t* cs=&cov_sum[cov_offset[i]];
+
+				for (int32_t j=0; j<n; j++)
+				{
+					float64_t a=alpha.matrix[int64_t(start+j)*num_comp+i];
+					const float64_t* x=&block[int64_t(j)*num_dim];
 
-					break;
-				case DIAG:
-					for (int32_t k=0; k<num_dim; k++)
-						cov_sum[k]+=v.vector[k]*v.vector[k]*alpha.matrix[j*alpha.num_cols+i];
+					switch (cov_type)
+					{
+						case FULL:
+						{
+							/* weighted, centered vectors for a rank-n update */
+							float64_t* y=&centered[int64_t(j)*num_dim];
+							float64_t w=CMath::sqrt(a);
+							for (int32_t k=0; k<num_dim; k++)
+								y[k]=(x[k]-mean[k])*w;
+
+							break;
+						}
+						case DIAG:
+							for (int32_t k=0; k<num_dim; k++)
+								cs[k]+=(x[k]-mean[k])*(x[k]-mean[k])*a;
+
+							break;
+						case SPHERICAL:
+						{
+							float64_t temp=0;
 
-					break;
-				case SPHERICAL:
-					float64_t temp=0;
+							for (int32_t k=0; k<num_dim; k++)
+								temp+=(x[k]-mean[k])*(x[k]-mean[k]);
 
-					for (int32_t k=0; k<num_dim; k++)
-						temp+=v.vector[k]*v.vector[k];
+							cs[0]+=temp*a;
+							break;
+						}
+					}
+				}
 
-					cov_sum[0]+=temp*alpha.matrix[j*alpha.num_cols+i];
-					break;
+				if (cov_type==FULL)
+				{
+					cblas_dsyrk(CblasColMajor, CblasUpper, CblasNoTrans, num_dim, n,
+							1, centered, num_dim, 1, cs, num_dim);
+				}
 			}
 		}
 
-		switch (cov_type)
+		SG_FREE(block);
+		SG_FREE(centered);
+	}
+
+	for (int32_t c=1; c<num_chunks; c++)
+		SGVector<float64_t>::add(cov_sums, 1, cov_sums, 1, &cov_sums[c*cov_len], cov_len);
+
+	#pragma omp parallel for schedule(dynamic) num_threads(parallel->get_num_threads())
+	for (int32_t i=0; i<num_comp; i++)
+	{
+		SGVector<float64_t> mean(num_dim);
+		memcpy(mean.vector, means.get_column_vector(i), num_dim*sizeof(float64_t));
+		m_components[i]->set_mean(mean);
+
+		const float64_t* cs=&cov_sums[cov_offset[i]];
+		float64_t* cov_sum=NULL;
+
+		switch (m_components[i]->get_cov_type())
 		{
 			case FULL:
-				for (int32_t j=0; j<num_dim*num_dim; j++)
-					cov_sum[j]/=alpha_sum;
+				/* only the upper triangle was accumulated */
+				cov_sum=SG_MALLOC(float64_t, num_dim*num_dim);
+				for (int32_t j=0; j<num_dim; j++)
+				{
+					for (int32_t k=0; k<=j; k++)
+					{
+						cov_sum[j*num_dim+k]=cs[j*num_dim+k]/alpha_sum[i];
+						cov_sum[k*num_dim+j]=cov_sum[j*num_dim+k];
+					}
+				}
 
 				float64_t* d0;
 				d0=SGMatrix<float64_t>::compute_eigenvectors(cov_sum, num_dim, num_dim);
@@ -606,32 +763,72 @@ void CGMM::max_likelihood(SGMatrix<float64_t> alpha, float64_t min_cov)
 
 				break;
 			case DIAG:
+				cov_sum=SG_MALLOC(float64_t, num_dim);
 				for (int32_t j=0; j<num_dim; j++)
-				{
-					cov_sum[j]/=alpha_sum;
-					cov_sum[j]=CMath::max(min_cov, cov_sum[j]);
-				}
+					cov_sum[j]=CMath::max(min_cov, cs[j]/alpha_sum[i]);
 
 				m_components[i]->set_d(SGVector<float64_t>(cov_sum, num_dim));
 
 				break;
 			case SPHERICAL:
-				cov_sum[0]/=alpha_sum*num_dim;
-				cov_sum[0]=CMath::max(min_cov, cov_sum[0]);
+				cov_sum=SG_MALLOC(float64_t, 1);
+				cov_sum[0]=CMath::max(min_cov, cs[0]/(alpha_sum[i]*num_dim));
 
 				m_components[i]->set_d(SGVector<float64_t>(cov_sum, 1));
 
 				break;
 		}
+	}
 
-		m_coefficients.vector[i]=alpha_sum;
-		alpha_sum_sum+=alpha_sum;
+	SG_FREE(alpha_sums);
+	SG_FREE(mean_sums);
+	SG_FREE(cov_sums);
+
+	float64_t alpha_sum_sum=0;
+	for (int32_t i=0; i<num_comp; i++)
+	{
+		m_coefficients.vector[i]=alpha_sum[i];
+		alpha_sum_sum+=alpha_sum[i];
 	}
 
-	for (int32_t i=0; i<alpha.num_cols; i++)
+	for (int32_t i=0; i<num_comp; i++)
 		m_coefficients.vector[i]/=alpha_sum_sum;
 }
 
+void CGMM::compute_log_pxy(const vector<CGaussian*>& components,
+		SGVector<float64_t> coefficients, float64_t* logPxy)
+{
+	CDotFeatures* dotdata=(CDotFeatures *) features;
+	int32_t num_vectors=dotdata->get_num_vectors();
+	int32_t num_dim=dotdata->get_dim_feature_space();
+	int32_t num_comp=int32_t(components.size());
+	int32_t num_blocks=(num_vectors+GMM_BLOCK_POINTS-1)/GMM_BLOCK_POINTS;
+
+	SGVector<float64_t> log_coef(num_comp);
+	for (int32_t j=0; j<num_comp; j++)
+		log_coef[j]=CMath::log(coefficients[j]);
+
+	#pragma omp parallel for schedule(dynamic) num_threads(parallel->get_num_threads())
+	for (int32_t b=0; b<num_blocks; b++)
+	{
+		int32_t start=b*GMM_BLOCK_POINTS;
+		int32_t n=CMath::min(GMM_BLOCK_POINTS, num_vectors-start);
+		float64_t* block=SG_MALLOC(float64_t, int64_t(num_dim)*n);
+		fetch_block(dotdata, start, n, num_dim, block);
+
+		for (int32_t j=0; j<num_comp; j++)
+		{
+			float64_t* target=&logPxy[int64_t(start)*num_comp+j];
+			components[j]->compute_log_PDF_block(block, n, target, num_comp);
+
+			for (int32_t i=0; i<n; i++)
+				target[int64_t(i)*num_comp]+=log_coef[j];
+		}
+
+		SG_FREE(block);
+	}
+}
+
 int32_t CGMM::get_num_model_parameters()
 {
 	return 1;
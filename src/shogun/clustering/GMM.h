@@ -240,9 +240,22 @@ class CGMM : public CDistribution
 		 * @param min_cov minimum covariance
 		 * @param max_em_iter maximum iterations for EM
 		 * @param min_change minimum change in log likelihood
+		 * @param noise 2*dim normal samples perturbing the split means
 		 */
 		void partial_em(int32_t comp1, int32_t comp2, int32_t comp3,
-				float64_t min_cov, int32_t max_em_iter, float64_t min_change);
+				float64_t min_cov, int32_t max_em_iter, float64_t min_change,
+				SGVector<float64_t> noise);
+
+		/** compute log(coefficient)+log PDF of every training vector under
+		 * every component, in parallel over blocks of vectors
+		 *
+		 * @param components mixture components
+		 * @param coefficients mixture coefficients
+		 * @param logPxy num_vectors x components.size() results, stored row
+		 * after row
+		 */
+		void compute_log_pxy(const vector<CGaussian*>& components,
+				SGVector<float64_t> coefficients, float64_t* logPxy);
 
 	protected:
 		/** Mixture components */
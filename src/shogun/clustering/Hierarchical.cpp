@@ -99,7 +99,8 @@ bool CHierarchical::train_machine(CFeatures* data)
 		SG_PROGRESS(i, 0, num-1)
 	}
 
-	CMath::qsort_index<float64_t,pair>(distances, index, (num-1)*num/2);
+	CMath::radix_sort_index<float64_t,pair>(distances, index, (num-1)*num/2,
+			parallel->get_num_threads());
 	//CMath::display_vector(distances, (num-1)*num/2, "dists");
 
 	int32_t k=-1;
@@ -11,10 +11,10 @@
 #include <shogun/converter/HashedDocConverter.h>
 #include <shogun/lib/DelimiterTokenizer.h>
 #include <shogun/lib/Hash.h>
-#include <shogun/lib/DynamicArray.h>
 #include <shogun/features/StringFeatures.h>
 #include <shogun/features/HashedDocDotFeatures.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/base/Parallel.h>
 
 using namespace shogun;
 
@@ -85,14 +85,37 @@ CFeatures* CHashedDocConverter::apply(CFeatures* features)
 		SG_ERROR("CHashedConverter::apply() : CFeatures object passed is not of type CStringFeatures.");
 
 	CStringFeatures<char>* s_features = (CStringFeatures<char>*) features;
+	int32_t num_vectors = s_features->get_num_vectors();
+
+	for (index_t vec_idx=0; vec_idx<num_vectors; vec_idx++)
+		ASSERT(s_features->get_vector_length(vec_idx)>0)
 
 	int32_t dim = CMath::pow(2, num_bits);
-	SGSparseMatrix<float64_t> matrix(dim,features->get_num_vectors());
-	for (index_t vec_idx=0; vec_idx<s_features->get_num_vectors(); vec_idx++)
+	SGSparseMatrix<float64_t> matrix(dim, num_vectors);
+	int32_t num_threads = parallel->get_num_threads();
+
+	#pragma omp parallel num_threads(num_threads)
 	{
-		SGVector<char> doc = s_features->get_feature_vector(vec_idx);
-		matrix[vec_idx] = apply(doc);
-		s_features->free_feature_vector(doc, vec_idx);
+		/** the tokenizer keeps state, every thread works on its own copy */
+		CTokenizer* tzer = num_threads>1 ? tokenizer->get_copy() : tokenizer;
+		SG_REF(tzer);
+
+		SGVector<uint32_t> hashed_indices(1024);
+		SGVector<uint32_t> cached_hashes(ngrams+tokens_to_skip);
+		SGVector<index_t> ngram_indices((ngrams-1)*(tokens_to_skip+1) + 1);
+
+		#pragma omp for schedule(dynamic, 64)
+		for (index_t vec_idx=0; vec_idx<num_vectors; vec_idx++)
+		{
+			SGVector<char> doc = s_features->get_feature_vector(vec_idx);
+			index_t num_hashes = hash_document(doc, tzer, hashed_indices,
+					cached_hashes, ngram_indices);
+			matrix[vec_idx] = create_hashed_representation(hashed_indices.vector,
+					num_hashes, doc.size());
+			s_features->free_feature_vector(doc, vec_idx);
+		}
+
+		SG_UNREF(tzer);
 	}
 
 	return (CFeatures*) new CSparseFeatures<float64_t>(matrix);
@@ -101,46 +124,60 @@ CFeatures* CHashedDocConverter::apply(CFeatures* features)
 SGSparseVector<float64_t> CHashedDocConverter::apply(SGVector<char> document)
 {
 	ASSERT(document.size()>0)
-	const int32_t array_size = 1024*1024;
-	/** the array will contain all the hashes generated from the tokens */
-	CDynamicArray<uint32_t> hashed_indices(array_size);
 
-	/** this vector will maintain the current n+k active tokens
-	 * in a circular manner */
+	SGVector<uint32_t> hashed_indices(1024);
 	SGVector<uint32_t> cached_hashes(ngrams+tokens_to_skip);
+	SGVector<index_t> ngram_indices((ngrams-1)*(tokens_to_skip+1) + 1);
+
+	index_t num_hashes = hash_document(document, tokenizer, hashed_indices,
+			cached_hashes, ngram_indices);
+
+	return create_hashed_representation(hashed_indices.vector, num_hashes,
+			document.size());
+}
+
+index_t CHashedDocConverter::hash_document(SGVector<char> document, CTokenizer* tzer,
+	SGVector<uint32_t>& hashed_indices, SGVector<uint32_t>& cached_hashes,
+	SGVector<index_t>& ngram_indices)
+{
+	index_t num_hashes = 0;
+
+	/** cached_hashes maintains the current n+k active tokens
+	 * in a circular manner */
 	index_t hashes_start = 0;
 	index_t hashes_end = 0;
+	index_t num_tokens = 0;
 	int32_t len = cached_hashes.vlen - 1;
 
-	/** the combinations generated from the current active tokens will be
-	 * stored here to avoid creating new objects */
-	SGVector<index_t> ngram_indices((ngrams-1)*(tokens_to_skip+1) + 1);
-
 	/** Reading n+s-1 tokens */
 	const int32_t seed = 0xdeadbeaf;
-	tokenizer->set_text(document);
+	tzer->set_text(document);
 	index_t token_start = 0;
-	while (hashes_end<ngrams-1+tokens_to_skip && tokenizer->has_next())
+	while (hashes_end<ngrams-1+tokens_to_skip && tzer->has_next())
 	{
-		index_t end = tokenizer->next_token_idx(token_start);
+		index_t end = tzer->next_token_idx(token_start);
 		uint32_t token_hash = CHash::MurmurHash3((uint8_t* ) &document.vector[token_start],
 				end-token_start, seed);
 		cached_hashes[hashes_end++] = token_hash;
+		num_tokens++;
 	}
 
 	/** Reading token and storing index to hashed_indices */
-	while (tokenizer->has_next())
+	while (tzer->has_next())
 	{
-		index_t end = tokenizer->next_token_idx(token_start);
+		index_t end = tzer->next_token_idx(token_start);
 		uint32_t token_hash = CHash::MurmurHash3((uint8_t* ) &document.vector[token_start],
 				end-token_start, seed);
 		cached_hashes[hashes_end] = token_hash;
+		num_tokens++;
 
 		CHashedDocConverter::generate_ngram_hashes(cached_hashes, hashes_start, len,
 				ngram_indices, num_bits, ngrams, tokens_to_skip);
 
+		if (num_hashes+ngram_indices.vlen>hashed_indices.vlen)
+			hashed_indices.resize_vector(2*(num_hashes+ngram_indices.vlen));
 		for (index_t i=0; i<ngram_indices.vlen; i++)
-			hashed_indices.append_element(ngram_indices[i]);
+			hashed_indices[num_hashes++] = ngram_indices[i];
 
 		hashes_start++;
 		hashes_end++;
@@ -153,14 +190,18 @@ SGSparseVector<float64_t> CHashedDocConverter::apply(SGVector<char> document)
 	/** For remaining combinations */
 	if (ngrams>1)
 	{
+		/** a short document may not have filled the cache */
+		len = CMath::min(len, num_tokens);
 		while (hashes_start!=hashes_end)
 		{
 			len--;
 			index_t max_idx = CHashedDocConverter::generate_ngram_hashes(cached_hashes, hashes_start,
 					len, ngram_indices, num_bits, ngrams, tokens_to_skip);
 
+			if (num_hashes+max_idx>hashed_indices.vlen)
+				hashed_indices.resize_vector(2*(num_hashes+max_idx));
 			for (index_t i=0; i<max_idx; i++)
-				hashed_indices.append_element(ngram_indices[i]);
+				hashed_indices[num_hashes++] = ngram_indices[i];
 
 			hashes_start++;
 			if (hashes_start==cached_hashes.vlen)
@@ -168,37 +209,36 @@ SGSparseVector<float64_t> CHashedDocConverter::apply(SGVector<char> document)
 		}
 	}
 
-	SGSparseVector<float64_t> sparse_doc_rep = create_hashed_representation(hashed_indices);
-
-	/** Normalizing vector */
-	if (should_normalize)
-	{
-		float64_t norm_const = CMath::sqrt((float64_t) document.size());
-		for (index_t i=0; i<sparse_doc_rep.num_feat_entries; i++)
-			sparse_doc_rep.features[i].entry /= norm_const;
-	}
-
-	return sparse_doc_rep;
+	return num_hashes;
 }
 
-SGSparseVector<float64_t> CHashedDocConverter::create_hashed_representation(CDynamicArray<uint32_t>& hashed_indices)
+SGSparseVector<float64_t> CHashedDocConverter::create_hashed_representation(
+	uint32_t* hashed_indices, index_t num_hashes, index_t doc_size)
 {
-	int32_t num_nnz_features = count_distinct_indices(hashed_indices);
+	int32_t num_nnz_features = count_distinct_indices(hashed_indices, num_hashes);
 
 	SGSparseVector<float64_t> sparse_doc_rep(num_nnz_features);
 	index_t sparse_idx = 0;
-	for (index_t i=0; i<hashed_indices.get_num_elements(); i++)
+	for (index_t i=0; i<num_hashes; i++)
 	{
 		sparse_doc_rep.features[sparse_idx].feat_index = hashed_indices[i];
 		sparse_doc_rep.features[sparse_idx].entry = 1;
-		while ( (i+1<hashed_indices.get_num_elements()) &&
-				(hashed_indices[i+1]==hashed_indices[i]) )
+		while ( (i+1<num_hashes) && (hashed_indices[i+1]==hashed_indices[i]) )
 		{
 			sparse_doc_rep.features[sparse_idx].entry++;
 			i++;
 		}
 		sparse_idx++;
 	}
+
+	/** Normalizing vector */
+	if (should_normalize)
+	{
+		float64_t norm_const = CMath::sqrt((float64_t) doc_size);
+		for (index_t i=0; i<sparse_doc_rep.num_feat_entries; i++)
+			sparse_doc_rep.features[i].entry /= norm_const;
+	}
+
 	return sparse_doc_rep;
 }
 
@@ -225,20 +265,17 @@ index_t CHashedDocConverter::generate_ngram_hashes(SGVector<uint32_t>& hashes, i
 	return h_idx;
 }
 
-int32_t CHashedDocConverter::count_distinct_indices(CDynamicArray<uint32_t>& hashed_indices)
+int32_t CHashedDocConverter::count_distinct_indices(uint32_t* hashed_indices, index_t num_hashes)
 {
-	CMath::qsort(hashed_indices.get_array(), hashed_indices.get_num_elements());
+	CMath::qsort(hashed_indices, num_hashes);
 
 	/** Counting nnz features */
 	int32_t num_nnz_features = 0;
-	for (index_t i=0; i<hashed_indices.get_num_elements(); i++)
+	for (index_t i=0; i<num_hashes; i++)
 	{
 		num_nnz_features++;
-		while ( (i+1<hashed_indices.get_num_elements()) &&
-				(hashed_indices[i+1]==hashed_indices[i]) )
-		{
+		while ( (i+1<num_hashes) && (hashed_indices[i+1]==hashed_indices[i]) )
 			i++;
-		}
 	}
 	return num_nnz_features;
 }
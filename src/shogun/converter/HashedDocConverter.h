@@ -64,7 +64,8 @@ public:
 	/** Destructor */
 	virtual ~CHashedDocConverter();
 
-	/** Hashes each string contained in features
+	/** Hashes each string contained in features. The documents are hashed
+	 * in parallel, each thread working on a copy of the tokenizer.
 	 *
 	 * @param features the strings to be hashed. Must be an instance of CStringFeatures.
 	 * @return a CSparseFeatures object containing the hashes of the strings.
@@ -121,21 +122,38 @@ protected:
 	/** init */
 	void init(CTokenizer* tzer, int32_t d, bool normalize, int32_t n_grams, int32_t skips);
 
-	/** This method takes a dynamic array as an argument, sorts it and returns the number
+	/** Tokenizes a document and stores the hashes of all its k-skip n-grams
+	 * in hashed_indices, which is grown as needed. The buffers are reused
+	 * across documents.
+	 * @param document the char vector to tokenize and hash
+	 * @param tzer the tokenizer to use
+	 * @param hashed_indices buffer for the generated hashes
+	 * @param cached_hashes buffer of size ngrams+tokens_to_skip for the active tokens
+	 * @param ngram_indices buffer of size (ngrams-1)*(tokens_to_skip+1)+1 for the
+	 * combinations of the active tokens
+	 * @return the number of hashes stored in hashed_indices
+	 */
+	index_t hash_document(SGVector<char> document, CTokenizer* tzer,
+		SGVector<uint32_t>& hashed_indices, SGVector<uint32_t>& cached_hashes,
+		SGVector<index_t>& ngram_indices);
+
+	/** This method takes an array of hashed indices, sorts it and returns the number
 	 * of the distinct elements(indices here) in the array.
-	 *
 	 * @param hashed_indices the array to sort and count elements
+	 * @param num_hashes the number of elements in the array
 	 * @return the number of distinct elements
 	 */
-	int32_t count_distinct_indices(CDynamicArray<uint32_t>& hashed_indices);
+	int32_t count_distinct_indices(uint32_t* hashed_indices, index_t num_hashes);
 
-	/** This method takes the dynamic array containing all the hashed indices of a document and returns a compact
+	/** This method takes the array containing all the hashed indices of a document and returns a compact
 	 * sparse representation with each index found and with the count of such index
-	 *
 	 * @param hashed_indices the array containing the hashed indices
+	 * @param num_hashes the number of elements in the array
+	 * @param doc_size the length of the document, used for normalization
 	 * @return the compact hashed document representation
 	 */
-	SGSparseVector<float64_t> create_hashed_representation(CDynamicArray<uint32_t>& hashed_indices);
+	SGSparseVector<float64_t> create_hashed_representation(uint32_t* hashed_indices,
+		index_t num_hashes, index_t doc_size);
 
 protected:
 
@@ -32,6 +32,16 @@ class CDistance;
  * Advances in Neural Information Processing Systems 15, 15(Figure 2), 721-728. MIT Press.
  * Retrieved from http://citeseerx.ist.psu.edu/viewdoc/download?doi=10.1.1.9.3407&rep=rep1&type=pdf
  *
+ * Geodesic distances are shortest paths in the undirected k nearest
+ * neighbors graph, computed with Dijkstra's algorithm from several sources
+ * in parallel.
+ *
+ * With landmark approximation enabled (see set_landmark) only distances
+ * from the landmarks are computed: the landmarks are embedded with
+ * classic scaling and all other vectors are triangulated from their
+ * distances to the landmarks. This needs memory linear in the number of
+ * vectors instead of the full quadratic distance matrix.
+ *
  * It is possible to apply preprocessor to specified distance using
  * apply_to_distance.
  *
@@ -27,9 +27,11 @@ float64_t CDistribution::get_log_likelihood_sample()
 {
 	ASSERT(features)
 
+	SGVector<float64_t> loglik=get_log_likelihood();
+
 	float64_t sum=0;
-	for (int32_t i=0; i<features->get_num_vectors(); i++)
-		sum+=get_log_likelihood_example(i);
+	for (int32_t i=0; i<loglik.vlen; i++)
+		sum+=loglik[i];
 
 	return sum/features->get_num_vectors();
 }
@@ -39,12 +41,23 @@ SGVector<float64_t> CDistribution::get_log_likelihood()
 	ASSERT(features)
 
 	int32_t num=features->get_num_vectors();
-	float64_t* vec=SG_MALLOC(float64_t, num);
+	SGVector<index_t> idx(num);
+	SGVector<float64_t> result(num);
+	idx.range_fill();
 
-	for (int32_t i=0; i<num; i++)
-		vec[i]=get_log_likelihood_example(i);
+	get_log_likelihood(idx, result);
+
+	return result;
+}
+
+void CDistribution::get_log_likelihood(SGVector<index_t> idx,
+		SGVector<float64_t> output)
+{
+	REQUIRE(output.vlen==idx.vlen, "Output has %d entries but %d examples "
+			"were requested\n", output.vlen, idx.vlen)
 
-	return SGVector<float64_t>(vec,num);
+	for (index_t i=0; i<idx.vlen; i++)
+		output[i]=get_log_likelihood_example(idx[i]);
 }
 
 int32_t CDistribution::get_num_relevant_model_parameters()
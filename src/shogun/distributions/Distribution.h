@@ -112,6 +112,18 @@ class CDistribution : public CSGObject
 		 */
 		virtual SGVector<float64_t> get_log_likelihood();
 
+		/** compute log likelihood for a batch of examples
+		 *
+		 * The default calls get_log_likelihood_example() for each example,
+		 * subclasses override it with vectorized or multi-threaded versions.
+		 *
+		 * @param idx indices of the examples
+		 * @param output log likelihood of example idx[i] is stored in
+		 * output[i], must have as many entries as idx
+		 */
+		virtual void get_log_likelihood(SGVector<index_t> idx,
+				SGVector<float64_t> output);
+
 		/** get model parameter
 		 *
 		 * @param num_param which param
@@ -14,9 +14,13 @@
 #include <shogun/distributions/Gaussian.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/base/Parameter.h>
+#include <shogun/base/Parallel.h>
 
 using namespace shogun;
 
+/** number of points whose log PDF is computed by one matrix product */
+#define GAUSSIAN_BLOCK_POINTS 256
+
 CGaussian::CGaussian() : CDistribution(), m_constant(0), m_d(), m_u(), m_mean(), m_cov_type(FULL)
 {
 	register_params();
@@ -110,6 +114,34 @@ float64_t CGaussian::get_log_likelihood_example(int32_t num_example)
 	return answer;
 }
 
+void CGaussian::get_log_likelihood(SGVector<index_t> idx,
+		SGVector<float64_t> output)
+{
+	ASSERT(features->has_property(FP_DOT))
+	REQUIRE(output.vlen==idx.vlen, "Output has %d entries but %d examples "
+			"were requested\n", output.vlen, idx.vlen)
+
+	CDotFeatures* dotdata=(CDotFeatures*) features;
+	int32_t dim=m_mean.vlen;
+	ASSERT(dotdata->get_dim_feature_space()==dim)
+
+	int32_t num_blocks=(idx.vlen+GAUSSIAN_BLOCK_POINTS-1)/GAUSSIAN_BLOCK_POINTS;
+
+	#pragma omp parallel for schedule(dynamic) num_threads(parallel->get_num_threads())
+	for (int32_t b=0; b<num_blocks; b++)
+	{
+		int32_t start=b*GAUSSIAN_BLOCK_POINTS;
+		int32_t n=CMath::min(GAUSSIAN_BLOCK_POINTS, idx.vlen-start);
+		float64_t* block=SG_CALLOC(float64_t, int64_t(dim)*n);
+
+		for (int32_t i=0; i<n; i++)
+			dotdata->add_to_dense_vec(1.0, idx[start+i], &block[int64_t(i)*dim], dim);
+
+		compute_log_PDF_block(block, n, &output[start]);
+		SG_FREE(block);
+	}
+}
+
 float64_t CGaussian::compute_log_PDF(SGVector<float64_t> point)
 {
 	ASSERT(m_mean.vector && m_d.vector)
@@ -149,6 +181,95 @@ float64_t CGaussian::compute_log_PDF(SGVector<float64_t> point)
 	return -0.5*answer;
 }
 
+SGVector<float64_t> CGaussian::compute_log_PDF(SGMatrix<float64_t> points)
+{
+	ASSERT(points.num_rows==m_mean.vlen)
+	SGVector<float64_t> answer(points.num_cols);
+	compute_log_PDF_block(points.matrix, points.num_cols, answer.vector);
+
+	return answer;
+}
+
+void CGaussian::compute_log_PDF_block(const float64_t* points,
+		int32_t num_points, float64_t* target, int32_t stride)
+{
+	ASSERT(m_mean.vector && m_d.vector)
+	ASSERT(points && target)
+
+	if (num_points<=0)
+		return;
+
+	int32_t dim=m_mean.vlen;
+	int32_t block=CMath::min(num_points, GAUSSIAN_BLOCK_POINTS);
+	float64_t* difference=SG_MALLOC(float64_t, int64_t(dim)*block);
+	float64_t* whitened=NULL;
+	float64_t* projected=NULL;
+
+	if (m_cov_type==FULL)
+	{
+		/* scaling the rows of the unitary matrix by the inverse standard
+		 * deviations turns the Mahalanobis distance into a squared norm */
+		whitened=SG_MALLOC(float64_t, int64_t(dim)*dim);
+		for (int32_t i=0; i<dim; i++)
+		{
+			float64_t scale=1.0/CMath::sqrt(m_d.vector[i]);
+			for (int32_t j=0; j<dim; j++)
+				whitened[i*dim+j]=m_u.matrix[i*dim+j]*scale;
+		}
+		projected=SG_MALLOC(float64_t, int64_t(dim)*block);
+	}
+
+	for (int32_t start=0; start<num_points; start+=block)
+	{
+		int32_t n=CMath::min(block, num_points-start);
+		const float64_t* p=&points[int64_t(start)*dim];
+
+		for (int32_t i=0; i<n; i++)
+		{
+			for (int32_t k=0; k<dim; k++)
+				difference[int64_t(i)*dim+k]=p[int64_t(i)*dim+k]-m_mean.vector[k];
+		}
+
+		float64_t* result=difference;
+		if (m_cov_type==FULL)
+		{
+			/* whitened is stored row major, i.e. transposed for BLAS */
+			cblas_dgemm(CblasColMajor, CblasTrans, CblasNoTrans, dim, n, dim,
+					1, whitened, dim, difference, dim, 0, projected, dim);
+			result=projected;
+		}
+
+		for (int32_t i=0; i<n; i++)
+		{
+			const float64_t* r=&result[int64_t(i)*dim];
+			float64_t answer=0;
+
+			switch (m_cov_type)
+			{
+				case FULL:
+					for (int32_t k=0; k<dim; k++)
+						answer+=r[k]*r[k];
+					break;
+				case DIAG:
+					for (int32_t k=0; k<dim; k++)
+						answer+=r[k]*r[k]/m_d.vector[k];
+					break;
+				case SPHERICAL:
+					for (int32_t k=0; k<dim; k++)
+						answer+=r[k]*r[k];
+					answer/=m_d.vector[0];
+					break;
+			}
+
+			target[int64_t(start+i)*stride]=-0.5*(m_constant+answer);
+		}
+	}
+
+	SG_FREE(difference);
+	SG_FREE(whitened);
+	SG_FREE(projected);
+}
+
 SGVector<float64_t> CGaussian::get_mean()
 {
 	return m_mean;
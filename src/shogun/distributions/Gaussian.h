@@ -99,6 +99,20 @@ class CGaussian : public CDistribution
 		 */
 		virtual float64_t get_log_likelihood_example(int32_t num_example);
 
+		using CDistribution::get_log_likelihood;
+
+		/** compute log likelihood for several examples
+		 *
+		 * The examples are gathered into blocks which are scored in
+		 * parallel by compute_log_PDF_block().
+		 *
+		 * @param idx indices of the examples
+		 * @param output log likelihood of example idx[i] is stored in
+		 * output[i]
+		 */
+		virtual void get_log_likelihood(SGVector<index_t> idx,
+				SGVector<float64_t> output);
+
 		/** compute PDF
 		 *
 		 * @param point point for which to compute the PDF
@@ -116,6 +130,28 @@ class CGaussian : public CDistribution
 		 */
 		virtual float64_t compute_log_PDF(SGVector<float64_t> point);
 
+		/** compute log PDF of many points at once
+		 *
+		 * @param points points for which to compute the log PDF, one per
+		 * column
+		 * @return computed log PDF of each point
+		 */
+		SGVector<float64_t> compute_log_PDF(SGMatrix<float64_t> points);
+
+		/** compute log PDF of a block of points at once
+		 *
+		 * The covariance is whitened once and the Mahalanobis distances of
+		 * all points are obtained from a single matrix product. Only reads
+		 * the model, so it may be called from several threads.
+		 *
+		 * @param points num_points points stored column after column
+		 * @param num_points number of points
+		 * @param target log PDF of point i is stored in target[i*stride]
+		 * @param stride distance between two results in target
+		 */
+		void compute_log_PDF_block(const float64_t* points, int32_t num_points,
+				float64_t* target, int32_t stride=1);
+
 		/** get mean
 		 *
 		 * @return mean
@@ -1278,13 +1278,81 @@ float64_t CHMM::best_path(int32_t dimension)
 	}
 }
 
+float64_t CHMM::forward_nocache(int32_t dimension,
+	T_ALPHA_BETA_TABLE* alpha, T_ALPHA_BETA_TABLE* alpha_new) const
+{
+	int32_t len;
+	bool free_vec;
+	uint16_t* o=p_observations->get_feature_vector(dimension, len, free_vec);
+	float64_t sum=-CMath::INFTY;
+
+	if (len>0)
+	{
+		//initialization	alpha_1(i)=p_i*b_i(O_1)
+		for (int32_t i=0; i<N; i++)
+			alpha[i]=get_p(i) + get_b(i, o[0]);
+
+		//induction		alpha_t+1(j) = (sum_i=1^N alpha_t(i)a_ij) b_j(O_t+1)
+		for (int32_t t=1; t<len; t++)
+		{
+			for (int32_t j=0; j<N; j++)
+			{
+				int32_t num=trans_list_forward_cnt[j];
+				float64_t s=-CMath::INFTY;
+				for (int32_t i=0; i<num; i++)
+				{
+					int32_t ii=trans_list_forward[j][i];
+					s=CMath::logarithmic_sum(s, alpha[ii] + get_a(ii,j));
+				}
+
+				alpha_new[j]=s + get_b(j, o[t]);
+			}
+
+			CMath::swap(alpha, alpha_new);
+		}
+
+		// termination
+		for (int32_t i=0; i<N; i++)
+			sum=CMath::logarithmic_sum(sum, alpha[i] + get_q(i));
+	}
+
+	p_observations->free_feature_vector(o, dimension, free_vec);
+	return sum;
+}
+
+void CHMM::get_log_likelihood(SGVector<index_t> idx, SGVector<float64_t> output)
+{
+	REQUIRE(p_observations, "No observations set\n")
+	REQUIRE(output.vlen==idx.vlen, "Output has %d entries but %d observations "
+			"were requested\n", output.vlen, idx.vlen)
+
+	#pragma omp parallel num_threads(parallel->get_num_threads())
+	{
+		T_ALPHA_BETA_TABLE* alpha=SG_MALLOC(T_ALPHA_BETA_TABLE, N);
+		T_ALPHA_BETA_TABLE* alpha_new=SG_MALLOC(T_ALPHA_BETA_TABLE, N);
+
+		#pragma omp for schedule(dynamic, 16)
+		for (index_t i=0; i<idx.vlen; i++)
+			output[i]=forward_nocache(idx[i], alpha, alpha_new);
+
+		SG_FREE(alpha);
+		SG_FREE(alpha_new);
+	}
+}
+
 #ifndef USE_HMMPARALLEL
 float64_t CHMM::model_probability_comp()
 {
 	//for faster calculation cache model probability
+	int32_t num=p_observations->get_num_vectors();
+	SGVector<index_t> idx(num);
+	SGVector<float64_t> prob(num);
+	idx.range_fill();
+	get_log_likelihood(idx, prob);
+
 	mod_prob=0 ;
-	for (int32_t dim=0; dim<p_observations->get_num_vectors(); dim++) //sum in log space
-		mod_prob+=forward(p_observations->get_vector_length(dim), 0, dim);
+	for (int32_t dim=0; dim<num; dim++) //sum in log space
+		mod_prob+=prob[dim];
 
 	mod_prob_updated=true;
 	return mod_prob;
@@ -517,6 +517,20 @@ class CHMM : public CDistribution
 			return model_probability(num_example);
 		}
 
+		using CDistribution::get_log_likelihood;
+
+		/** compute model probabilities of several observations in parallel
+		 *
+		 * Each observation gets a forward pass over thread local tables,
+		 * the alpha caches are neither used nor updated.
+		 *
+		 * @param idx indices of the observations
+		 * @param output model probability (logarithmic) of observation
+		 * idx[i] is stored in output[i]
+		 */
+		virtual void get_log_likelihood(SGVector<index_t> idx,
+				SGVector<float64_t> output);
+
 		/** initialization function - gets called by constructors.
 		 * @param model model which holds definitions of states to be learned + consts
 		 * @param PSEUDO Pseudo Value
@@ -546,6 +560,17 @@ class CHMM : public CDistribution
 		float64_t forward_comp_old(
 			int32_t time, int32_t state, int32_t dimension);
 
+		/** forward algorithm for Pr[O|lambda] on caller provided tables.
+		 * Neither reads nor updates the alpha caches, so several
+		 * observations may be processed concurrently
+		 * @param dimension dimension of observation
+		 * @param alpha table of N entries
+		 * @param alpha_new table of N entries
+		 * @return model probability of the observation (logarithmic)
+		 */
+		float64_t forward_nocache(int32_t dimension,
+			T_ALPHA_BETA_TABLE* alpha, T_ALPHA_BETA_TABLE* alpha_new) const;
+
 		/** backward algorithm.
 		 * calculates Pr[O_t+1,O_t+2, ..., O_T-1| q_time=S_i, lambda] for 0<= time <= T-1
 		 * Pr[O|lambda] for time >= T
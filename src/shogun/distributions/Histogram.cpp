@@ -14,6 +14,7 @@
 #include <shogun/features/StringFeatures.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/base/Parallel.h>
 
 using namespace shogun;
 
@@ -101,6 +102,34 @@ float64_t CHistogram::get_log_likelihood_example(int32_t num_example)
 	return loglik;
 }
 
+void CHistogram::get_log_likelihood(SGVector<index_t> idx,
+		SGVector<float64_t> output)
+{
+	ASSERT(features)
+	ASSERT(features->get_feature_class()==C_STRING)
+	ASSERT(features->get_feature_type()==F_WORD)
+	REQUIRE(output.vlen==idx.vlen, "Output has %d entries but %d examples "
+			"were requested\n", output.vlen, idx.vlen)
+
+	CStringFeatures<uint16_t>* strings=(CStringFeatures<uint16_t>*) features;
+
+	#pragma omp parallel for schedule(dynamic, 64) num_threads(parallel->get_num_threads())
+	for (index_t i=0; i<idx.vlen; i++)
+	{
+		int32_t len;
+		bool free_vec;
+		float64_t loglik=0;
+
+		uint16_t* vector=strings->get_feature_vector(idx[i], len, free_vec);
+
+		for (int32_t j=0; j<len; j++)
+			loglik+=hist[vector[j]];
+
+		strings->free_feature_vector(vector, idx[i], free_vec);
+		output[i]=loglik;
+	}
+}
+
 float64_t CHistogram::get_log_derivative(int32_t num_param, int32_t num_example)
 {
 	if (hist[num_param] < CMath::ALMOST_NEG_INFTY)
@@ -13,6 +13,7 @@
 #include <shogun/io/SGIO.h>
 
 #include <shogun/base/Parameter.h>
+#include <shogun/base/Parallel.h>
 
 #include <shogun/distributions/LinearHMM.h>
 #include <shogun/features/StringFeatures.h>
@@ -207,6 +208,26 @@ float64_t CLinearHMM::get_log_likelihood_example(int32_t num_example)
 	return result;
 }
 
+void CLinearHMM::get_log_likelihood(SGVector<index_t> idx,
+		SGVector<float64_t> output)
+{
+	ASSERT(features)
+	REQUIRE(output.vlen==idx.vlen, "Output has %d entries but %d examples "
+			"were requested\n", output.vlen, idx.vlen)
+
+	CStringFeatures<uint16_t>* strings=(CStringFeatures<uint16_t>*) features;
+
+	#pragma omp parallel for schedule(dynamic, 64) num_threads(parallel->get_num_threads())
+	for (index_t i=0; i<idx.vlen; i++)
+	{
+		int32_t len;
+		bool free_vec;
+		uint16_t* vector=strings->get_feature_vector(idx[i], len, free_vec);
+		output[i]=get_log_likelihood_example(vector, len);
+		strings->free_feature_vector(vector, idx[i], free_vec);
+	}
+}
+
 float64_t CLinearHMM::get_likelihood_example(uint16_t* vector, int32_t len)
 {
 	float64_t result=transition_probs[vector[0]];
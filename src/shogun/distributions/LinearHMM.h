@@ -108,6 +108,18 @@ class CLinearHMM : public CDistribution
 		 */
 		virtual float64_t get_log_likelihood_example(int32_t num_example);
 
+		using CDistribution::get_log_likelihood;
+
+		/** get logarithm of the likelihood of several examples, computed
+		 * in parallel
+		 *
+		 * @param idx indices of the examples
+		 * @param output logarithm of example idx[i]'s likelihood is stored
+		 * in output[i]
+		 */
+		virtual void get_log_likelihood(SGVector<index_t> idx,
+				SGVector<float64_t> output);
+
 		/** get logarithm of one example's derivative's likelihood
 		 *
 		 * @param num_param which example's param
@@ -10,6 +10,7 @@
 #include <shogun/distributions/PositionalPWM.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/base/Parameter.h>
+#include <shogun/base/Parallel.h>
 #include <shogun/features/Alphabet.h>
 #include <shogun/features/StringFeatures.h>
 
@@ -84,6 +85,37 @@ float64_t CPositionalPWM::get_log_likelihood_example(int32_t num_example)
 	return lik;
 }
 
+void CPositionalPWM::get_log_likelihood(SGVector<index_t> idx,
+		SGVector<float64_t> output)
+{
+	ASSERT(features)
+	ASSERT(features->get_feature_class() == C_STRING)
+	ASSERT(features->get_feature_type()==F_BYTE)
+	REQUIRE(output.vlen==idx.vlen, "Output has %d entries but %d examples "
+			"were requested\n", output.vlen, idx.vlen)
+
+	CStringFeatures<uint8_t>* strs=(CStringFeatures<uint8_t>*) features;
+
+	#pragma omp parallel for schedule(dynamic, 64) num_threads(parallel->get_num_threads())
+	for (index_t i=0; i<idx.vlen; i++)
+	{
+		float64_t lik=0;
+		int32_t len=0;
+		bool do_free=false;
+
+		uint8_t* str=strs->get_feature_vector(idx[i], len, do_free);
+
+		if (m_w.num_cols==len)
+		{
+			for (int32_t j=0; j<len; j++)
+				lik+=m_w[4*j+str[j]];
+		}
+
+		strs->free_feature_vector(str, idx[i], do_free);
+		output[i]=lik;
+	}
+}
+
 float64_t CPositionalPWM::get_log_likelihood_window(uint8_t* window, int32_t len, float64_t pos)
 {
 	ASSERT(m_pwm.num_cols == len)
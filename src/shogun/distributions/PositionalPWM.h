@@ -66,6 +66,17 @@ class CPositionalPWM : public CDistribution
 		 */
 		virtual float64_t get_log_likelihood_example(int32_t num_example);
 
+		using CDistribution::get_log_likelihood;
+
+		/** compute log likelihood for several examples in parallel
+		 *
+		 * @param idx indices of the examples
+		 * @param output log likelihood of example idx[i] is stored in
+		 * output[i]
+		 */
+		virtual void get_log_likelihood(SGVector<index_t> idx,
+				SGVector<float64_t> output);
+
 		/** get log likelihood window
 		 * @param window
 		 * @param len
@@ -0,0 +1,115 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society
+ */
+
+#include <shogun/evaluation/BinaryClassEvaluation.h>
+#include <shogun/mathematics/Math.h>
+
+using namespace shogun;
+
+SGVector<float64_t> CBinaryClassEvaluation::gather_values(CLabels* labels)
+{
+	index_t num=labels->get_num_labels();
+	SGVector<float64_t> values(num);
+
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
+	for (index_t i=0; i<num; i++)
+		values[i]=labels->get_value(i);
+
+	return values;
+}
+
+SGVector<index_t> CBinaryClassEvaluation::argsort_scores(
+		SGVector<float64_t> scores)
+{
+	index_t num=scores.vlen;
+	SGVector<float64_t> neg_scores(num);
+	SGVector<index_t> order(num);
+	for (index_t i=0; i<num; i++)
+	{
+		neg_scores[i]=-scores[i];
+		order[i]=i;
+	}
+
+	/* stable, so equal scores stay in order of their index */
+	CMath::radix_sort_index(neg_scores.vector, order.vector, num,
+			parallel->get_num_threads());
+
+	return order;
+}
+
+void CBinaryClassEvaluation::accumulate_histograms(SGVector<float64_t> scores,
+		SGVector<float64_t> truth, float64_t min_score, float64_t max_score,
+		SGVector<int64_t> pos, SGVector<int64_t> neg)
+{
+	REQUIRE(scores.vlen==truth.vlen, "Number of scores (%d) and labels (%d) "
+			"differ\n", scores.vlen, truth.vlen);
+	REQUIRE(pos.vlen>0 && pos.vlen==neg.vlen, "Invalid number of bins\n");
+
+	index_t num=scores.vlen;
+	index_t num_bins=pos.vlen;
+	float64_t scale=max_score>min_score ? num_bins/(max_score-min_score) : 0.0;
+
+	#pragma omp parallel num_threads(parallel->get_num_threads())
+	{
+		int64_t* local=SG_CALLOC(int64_t, 2*num_bins);
+
+		#pragma omp for
+		for (index_t i=0; i<num; i++)
+		{
+			float64_t x=(scores[i]-min_score)*scale;
+			index_t bin=0;
+			if (x>=num_bins)
+				bin=num_bins-1;
+			else if (x>0)
+				bin=(index_t) x;
+
+			if (truth[i]>0)
+				local[bin]++;
+			else
+				local[num_bins+bin]++;
+		}
+
+		#pragma omp critical
+		{
+			for (index_t b=0; b<num_bins; b++)
+			{
+				pos[b]+=local[b];
+				neg[b]+=local[num_bins+b];
+			}
+		}
+
+		SG_FREE(local);
+	}
+}
+
+void CBinaryClassEvaluation::get_score_range(SGVector<float64_t> scores,
+		float64_t& min_score, float64_t& max_score)
+{
+	min_score=CMath::INFTY;
+	max_score=-CMath::INFTY;
+
+	#pragma omp parallel num_threads(parallel->get_num_threads())
+	{
+		float64_t local_min=CMath::INFTY;
+		float64_t local_max=-CMath::INFTY;
+
+		#pragma omp for
+		for (index_t i=0; i<scores.vlen; i++)
+		{
+			local_min=CMath::min(local_min, scores[i]);
+			local_max=CMath::max(local_max, scores[i]);
+		}
+
+		#pragma omp critical
+		{
+			min_score=CMath::min(min_score, local_min);
+			max_score=CMath::max(max_score, local_max);
+		}
+	}
+}
@@ -41,6 +41,46 @@ public:
 	 * @return evaluation result
 	 */
 	virtual float64_t evaluate(CLabels* predicted, CLabels* ground_truth) = 0;
+
+protected:
+	/** copies the values of labels, respecting subsets
+	 *
+	 * @param labels labels
+	 * @return values of labels
+	 */
+	SGVector<float64_t> gather_values(CLabels* labels);
+
+	/** sorts examples by decreasing score, ties by increasing index, with
+	 * a parallel radix sort.
+	 *
+	 * @param scores scores of the examples
+	 * @return indices of the examples in sorted order
+	 */
+	SGVector<index_t> argsort_scores(SGVector<float64_t> scores);
+
+	/** counts positive and negative examples per score bin. The bins split
+	 * [min_score, max_score] into equally wide intervals, scores outside
+	 * the range are counted in the first or last bin.
+	 *
+	 * @param scores scores of the examples
+	 * @param truth true labels, examples with label >0 are positive
+	 * @param min_score lower end of the first bin
+	 * @param max_score upper end of the last bin
+	 * @param pos counts of positive examples per bin, its length is the
+	 * number of bins, counts are added to its contents
+	 * @param neg counts of negative examples per bin
+	 */
+	void accumulate_histograms(SGVector<float64_t> scores,
+			SGVector<float64_t> truth, float64_t min_score,
+			float64_t max_score, SGVector<int64_t> pos,
+			SGVector<int64_t> neg);
+
+	/** @param scores scores
+	 * @param min_score smallest score
+	 * @param max_score largest score
+	 */
+	void get_score_range(SGVector<float64_t> scores, float64_t& min_score,
+			float64_t& max_score);
 };
 
 }
@@ -328,9 +328,13 @@ float64_t CCrossValidation::evaluate_one_run()
 						inverse_subset_indices.vlen, "training indices");
 			}
 
-			/* train machine on training features and remove subset */
+			/* train machine on training features and remove subset, a
+			 * compacted copy of the fold avoids the subset indirection
+			 * in every access of the training algorithm */
 			SG_DEBUG("starting training\n")
-			m_machine->train(m_features);
+			CFeatures* train_features=m_features->materialize_subset();
+			m_machine->train(train_features);
+			SG_UNREF(train_features);
 			SG_DEBUG("finished training\n")
 
 			/* evtl. update xvalidation output class */
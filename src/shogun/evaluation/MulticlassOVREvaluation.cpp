@@ -10,6 +10,7 @@
 #include <shogun/evaluation/MulticlassOVREvaluation.h>
 #include <shogun/evaluation/ROCEvaluation.h>
 #include <shogun/evaluation/PRCEvaluation.h>
+#include <shogun/evaluation/StreamingROCEvaluation.h>
 #include <shogun/labels/MulticlassLabels.h>
 #include <shogun/mathematics/Statistics.h>
 
@@ -51,6 +52,8 @@ float64_t CMulticlassOVREvaluation::evaluate(CLabels* predicted, CLabels* ground
 	m_last_results = SGVector<float64_t>(n_classes);
 
 	SGMatrix<float64_t> all(n_labels,n_classes);
+	SGVector<float64_t> truth(n_labels);
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
 	for (int32_t i=0; i<n_labels; i++)
 	{
 		SGVector<float64_t> confs = predicted_mc->get_multiclass_confidences(i);
@@ -58,8 +61,12 @@ float64_t CMulticlassOVREvaluation::evaluate(CLabels* predicted, CLabels* ground
 		{
 			all(i,j) = confs[j];
 		}
+		truth[i] = ground_truth_mc->get_label(i);
 	}
-	if (dynamic_cast<CROCEvaluation*>(m_binary_evaluation) || dynamic_cast<CPRCEvaluation*>(m_binary_evaluation))
+
+	CROCEvaluation* roc = dynamic_cast<CROCEvaluation*>(m_binary_evaluation);
+	CPRCEvaluation* prc = dynamic_cast<CPRCEvaluation*>(m_binary_evaluation);
+	if (roc || prc)
 	{
 		for (int32_t i=0; i<m_num_graph_results; i++)
 			m_graph_results[i].~SGMatrix<float64_t>();
@@ -67,30 +74,60 @@ float64_t CMulticlassOVREvaluation::evaluate(CLabels* predicted, CLabels* ground
 		m_graph_results = SG_MALLOC(SGMatrix<float64_t>, n_classes);
 		m_num_graph_results = n_classes;
 	}
+
+	/* ROC and PRC keep their curve in the evaluation object, so the classes
+	 * are evaluated concurrently with one evaluation object per class.
+	 * Other evaluations may have state of their own and run serially. */
+	bool concurrent = (roc && !dynamic_cast<CStreamingROCEvaluation*>(roc)) || prc;
+	int32_t num_threads = concurrent ? parallel->get_num_threads() : 1;
+
+	#pragma omp parallel for num_threads(num_threads) schedule(dynamic)
 	for (int32_t c=0; c<n_classes; c++)
 	{
 		CLabels* pred = new CBinaryLabels(SGVector<float64_t>(all.get_column_vector(c),n_labels,false));
+		SG_REF(pred);
 		SGVector<float64_t> gt_vec(n_labels);
 		for (int32_t i=0; i<n_labels; i++)
 		{
-			if (ground_truth_mc->get_label(i)==c)
+			if (truth[i]==c)
 				gt_vec[i] = +1.0;
 			else
 				gt_vec[i] = -1.0;
 		}
 		CLabels* gt = new CBinaryLabels(gt_vec);
-		m_last_results[c] = m_binary_evaluation->evaluate(pred, gt);
+		SG_REF(gt);
+
+		CBinaryClassEvaluation* evaluation = m_binary_evaluation;
+		if (concurrent && roc)
+		{
+			CROCEvaluation* roc_c = new CROCEvaluation();
+			roc_c->set_num_bins(roc->get_num_bins());
+			evaluation = roc_c;
+		}
+		else if (concurrent && prc)
+		{
+			CPRCEvaluation* prc_c = new CPRCEvaluation();
+			prc_c->set_num_bins(prc->get_num_bins());
+			evaluation = prc_c;
+		}
+		SG_REF(evaluation);
 
-		if (dynamic_cast<CROCEvaluation*>(m_binary_evaluation))
+		m_last_results[c] = evaluation->evaluate(pred, gt);
+
+		if (roc)
 		{
 			new (&m_graph_results[c]) SGMatrix<float64_t>();
-			m_graph_results[c] = ((CROCEvaluation*)m_binary_evaluation)->get_ROC();
+			m_graph_results[c] = ((CROCEvaluation*)evaluation)->get_ROC();
 		}
-		if (dynamic_cast<CPRCEvaluation*>(m_binary_evaluation))
+		if (prc)
 		{
 			new (&m_graph_results[c]) SGMatrix<float64_t>();
-			m_graph_results[c] = ((CPRCEvaluation*)m_binary_evaluation)->get_PRC();
+			m_graph_results[c] = ((CPRCEvaluation*)evaluation)->get_PRC();
 		}
+
+		SG_UNREF(evaluation);
+		SG_UNREF(gt);
+		SG_UNREF(pred);
 	}
 	return CStatistics::mean(m_last_results);
 }
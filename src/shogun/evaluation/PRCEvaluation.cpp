@@ -19,6 +19,12 @@ CPRCEvaluation::~CPRCEvaluation()
 {
 }
 
+void CPRCEvaluation::init()
+{
+	SG_ADD(&m_num_bins, "num_bins", "Number of bins of the approximate mode",
+			MS_NOT_AVAILABLE);
+}
+
 float64_t CPRCEvaluation::evaluate(CLabels* predicted, CLabels* ground_truth)
 {
 	ASSERT(predicted && ground_truth)
@@ -27,6 +33,24 @@ float64_t CPRCEvaluation::evaluate(CLabels* predicted, CLabels* ground_truth)
 	ASSERT(ground_truth->get_label_type()==LT_BINARY)
 	ground_truth->ensure_valid();
 
+	SGVector<float64_t> scores=gather_values(predicted);
+	SGVector<float64_t> truth=gather_values(ground_truth);
+
+	if (m_num_bins>0)
+	{
+		float64_t min_score;
+		float64_t max_score;
+		get_score_range(scores, min_score, max_score);
+
+		SGVector<int64_t> pos(m_num_bins);
+		SGVector<int64_t> neg(m_num_bins);
+		pos.zero();
+		neg.zero();
+		accumulate_histograms(scores, truth, min_score, max_score, pos, neg);
+
+		return compute_prc(pos, neg, min_score, max_score);
+	}
+
 	// number of true positive examples
 	float64_t tp = 0.0;
 	int32_t i;
@@ -34,21 +58,12 @@ float64_t CPRCEvaluation::evaluate(CLabels* predicted, CLabels* ground_truth)
 	// total number of positive labels in predicted
 	int32_t pos_count=0;
 
-	// initialize number of labels and labels
-	SGVector<float64_t> orig_labels = predicted->get_values();
-	int32_t length = orig_labels.vlen;
-	float64_t* labels = SGVector<float64_t>::clone_vector(orig_labels.vector, length);
-
-	// get indexes for sort
-	int32_t* idxs = SG_MALLOC(int32_t, length);
-	for(i=0; i<length; i++)
-		idxs[i] = i;
+	int32_t length = scores.vlen;
 
-	// sort indexes by labels ascending
-	CMath::qsort_backward_index(labels,idxs,length);
+	// sort indexes by labels descending
+	SGVector<index_t> idxs=argsort_scores(scores);
 
 	// clean and initialize graph and auPRC
-	SG_FREE(labels);
 	m_PRC_graph = SGMatrix<float64_t>(2,length);
 	m_thresholds = SGVector<float64_t>(length);
 	m_auPRC = 0.0;
@@ -56,7 +71,7 @@ float64_t CPRCEvaluation::evaluate(CLabels* predicted, CLabels* ground_truth)
 	// get total numbers of positive and negative labels
 	for (i=0; i<length; i++)
 	{
-		if (ground_truth->get_value(i) > 0)
+		if (truth[i] > 0)
 			pos_count++;
 	}
 
@@ -67,7 +82,7 @@ float64_t CPRCEvaluation::evaluate(CLabels* predicted, CLabels* ground_truth)
 	for (i=0; i<length; i++)
 	{
 		// update number of true positive examples
-		if (ground_truth->get_value(idxs[i]) > 0)
+		if (truth[idxs[i]] > 0)
 			tp += 1.0;
 
 		// precision (x)
@@ -75,7 +90,7 @@ float64_t CPRCEvaluation::evaluate(CLabels* predicted, CLabels* ground_truth)
 		// recall (y)
 		m_PRC_graph[2*i+1] = tp/float64_t(pos_count);
 
-		m_thresholds[i]= predicted->get_value(idxs[i]);
+		m_thresholds[i]= scores[idxs[i]];
 	}
 
 	// calc auRPC using area under curve
@@ -84,7 +99,53 @@ float64_t CPRCEvaluation::evaluate(CLabels* predicted, CLabels* ground_truth)
 	// set computed indicator
 	m_computed = true;
 
-	SG_FREE(idxs);
+	return m_auPRC;
+}
+
+float64_t CPRCEvaluation::compute_prc(SGVector<int64_t> pos,
+		SGVector<int64_t> neg, float64_t min_score, float64_t max_score)
+{
+	int32_t num_bins=pos.vlen;
+	float64_t bin_width=(max_score-min_score)/num_bins;
+
+	int64_t pos_count=0;
+	int32_t num_points=0;
+	for (int32_t b=0; b<num_bins; b++)
+	{
+		pos_count+=pos[b];
+		if (pos[b]+neg[b]>0)
+			num_points++;
+	}
+
+	// assure number of positive examples is >0
+	ASSERT(pos_count>0)
+
+	m_PRC_graph = SGMatrix<float64_t>(2,num_points);
+	m_thresholds = SGVector<float64_t>(num_points);
+
+	int64_t tp=0;
+	int64_t num=0;
+	int32_t j=0;
+	for (int32_t b=num_bins-1; b>=0; b--)
+	{
+		if (pos[b]+neg[b]==0)
+			continue;
+
+		tp+=pos[b];
+		num+=pos[b]+neg[b];
+
+		// precision (x)
+		m_PRC_graph[2*j] = float64_t(tp)/num;
+		// recall (y)
+		m_PRC_graph[2*j+1] = float64_t(tp)/pos_count;
+
+		m_thresholds[j] = min_score+b*bin_width;
+		j++;
+	}
+
+	m_auPRC = CMath::area_under_curve(m_PRC_graph.matrix,num_points,true);
+	m_computed = true;
+
 	return m_auPRC;
 }
 
@@ -21,17 +21,21 @@ class CLabels;
 /** @brief Class PRCEvaluation used to evaluate PRC
  * (Precision Recall Curve) and an area under PRC curve (auPRC).
  *
+ * The predictions are sorted in parallel. Like CROCEvaluation, an
+ * approximate mode based on a histogram of the predictions can be enabled
+ * with set_num_bins().
  */
 class CPRCEvaluation: public CBinaryClassEvaluation
 {
 public:
 	/** constructor */
 	CPRCEvaluation() :
-		CBinaryClassEvaluation(), m_computed(false)
+		CBinaryClassEvaluation(), m_computed(false), m_num_bins(0)
 	{
 		m_PRC_graph = SGMatrix<float64_t>();
 		m_thresholds = SGVector<float64_t>();
 		m_auPRC = 0.0;
+		init();
 	};
 
 	/** destructor */
@@ -67,6 +71,39 @@ public:
 	 */
 	SGVector<float64_t> get_thresholds();
 
+	/** set number of bins of the approximate mode
+	 * @param num_bins number of bins, 0 to sort all predictions
+	 */
+	void set_num_bins(int32_t num_bins)
+	{
+		REQUIRE(num_bins>=0, "Number of bins (%d) must not be negative\n",
+				num_bins);
+		m_num_bins=num_bins;
+	}
+
+	/** get number of bins of the approximate mode
+	 * @return number of bins, 0 if predictions are sorted
+	 */
+	int32_t get_num_bins() const
+	{
+		return m_num_bins;
+	}
+
+protected:
+
+	/** compute PRC and auPRC from per-bin counts of positive and negative
+	 * examples, in this case the thresholds are the lower ends of the
+	 * non-empty bins
+	 *
+	 * @param pos counts of positive examples per bin
+	 * @param neg counts of negative examples per bin
+	 * @param min_score lower end of the first bin
+	 * @param max_score upper end of the last bin
+	 * @return auPRC
+	 */
+	float64_t compute_prc(SGVector<int64_t> pos, SGVector<int64_t> neg,
+			float64_t min_score, float64_t max_score);
+
 protected:
 
 	/** 2-d array used to store PRC graph */
@@ -80,6 +117,13 @@ protected:
 
 	/** indicator of PRC and auPRC being computed already */
 	bool m_computed;
+
+	/** number of bins of the approximate mode, 0 for exact evaluation */
+	int32_t m_num_bins;
+
+private:
+	/** register parameters */
+	void init();
 };
 
 }
@@ -17,6 +17,12 @@ CROCEvaluation::~CROCEvaluation()
 {
 }
 
+void CROCEvaluation::init()
+{
+	SG_ADD(&m_num_bins, "num_bins", "Number of bins of the approximate mode",
+			MS_NOT_AVAILABLE);
+}
+
 float64_t CROCEvaluation::evaluate(CLabels* predicted, CLabels* ground_truth)
 {
 	return evaluate_roc(predicted,ground_truth);
@@ -30,6 +36,24 @@ float64_t CROCEvaluation::evaluate_roc(CLabels* predicted, CLabels* ground_truth
 	ASSERT(ground_truth->get_label_type()==LT_BINARY)
 	ground_truth->ensure_valid();
 
+	SGVector<float64_t> scores=gather_values(predicted);
+	SGVector<float64_t> truth=gather_values(ground_truth);
+
+	if (m_num_bins>0)
+	{
+		float64_t min_score;
+		float64_t max_score;
+		get_score_range(scores, min_score, max_score);
+
+		SGVector<int64_t> pos(m_num_bins);
+		SGVector<int64_t> neg(m_num_bins);
+		pos.zero();
+		neg.zero();
+		accumulate_histograms(scores, truth, min_score, max_score, pos, neg);
+
+		return compute_roc(pos, neg, min_score, max_score);
+	}
+
 	// assume threshold as negative infinity
 	float64_t threshold = CMath::ALMOST_NEG_INFTY;
 	// false positive rate
@@ -42,19 +66,10 @@ float64_t CROCEvaluation::evaluate_roc(CLabels* predicted, CLabels* ground_truth
 	int32_t pos_count=0;
 	int32_t neg_count=0;
 
-	// initialize number of labels and labels
-	SGVector<float64_t> orig_labels(predicted->get_num_labels());
-	int32_t length = orig_labels.vlen;
-	for (i=0; i<length; i++)
-		orig_labels[i] = predicted->get_value(i);
-	float64_t* labels = SGVector<float64_t>::clone_vector(orig_labels.vector, length);
+	int32_t length = scores.vlen;
 
 	// get sorted indexes
-	SGVector<int32_t> idxs(length);
-	for(i=0; i<length; i++)
-		idxs[i] = i;
-
-	CMath::qsort_backward_index(labels,idxs.vector,idxs.vlen);
+	SGVector<index_t> idxs=argsort_scores(scores);
 
 	// number of different predicted labels
 	int32_t diff_count=1;
@@ -62,12 +77,10 @@ float64_t CROCEvaluation::evaluate_roc(CLabels* predicted, CLabels* ground_truth
 	// get number of different labels
 	for (i=0; i<length-1; i++)
 	{
-		if (labels[i] != labels[i+1])
+		if (scores[idxs[i]] != scores[idxs[i+1]])
 			diff_count++;
 	}
 
-	SG_FREE(labels);
-
 	// initialize graph and auROC
 	m_ROC_graph = SGMatrix<float64_t>(2,diff_count+1);
 	m_thresholds = SGVector<float64_t>(length);
@@ -76,7 +89,7 @@ float64_t CROCEvaluation::evaluate_roc(CLabels* predicted, CLabels* ground_truth
 	// get total numbers of positive and negative labels
 	for(i=0; i<length; i++)
 	{
-		if (ground_truth->get_value(i) >= 0)
+		if (truth[i] > 0)
 			pos_count++;
 		else
 			neg_count++;
@@ -94,7 +107,7 @@ float64_t CROCEvaluation::evaluate_roc(CLabels* predicted, CLabels* ground_truth
 	// create ROC curve and calculate auROC
 	for(i=0; i<length; i++)
 	{
-		label = predicted->get_value(idxs[i]);
+		label = scores[idxs[i]];
 
 		if (label != threshold)
 		{
@@ -106,7 +119,7 @@ float64_t CROCEvaluation::evaluate_roc(CLabels* predicted, CLabels* ground_truth
 
 		m_thresholds[i]=threshold;
 
-		if (ground_truth->get_value(idxs[i]) > 0)
+		if (truth[idxs[i]] > 0)
 			tp+=1.0;
 		else
 			fp+=1.0;
@@ -124,6 +137,56 @@ float64_t CROCEvaluation::evaluate_roc(CLabels* predicted, CLabels* ground_truth
 	return m_auROC;
 }
 
+float64_t CROCEvaluation::compute_roc(SGVector<int64_t> pos,
+		SGVector<int64_t> neg, float64_t min_score, float64_t max_score)
+{
+	int32_t num_bins=pos.vlen;
+	float64_t bin_width=(max_score-min_score)/num_bins;
+
+	int64_t pos_count=0;
+	int64_t neg_count=0;
+	int32_t num_points=0;
+	for (int32_t b=0; b<num_bins; b++)
+	{
+		pos_count+=pos[b];
+		neg_count+=neg[b];
+		if (pos[b]+neg[b]>0)
+			num_points++;
+	}
+
+	REQUIRE(pos_count>0, "%s::compute_roc(): Number of positive labels is "
+			"zero, ROC fails!\n", get_name());
+	REQUIRE(neg_count>0, "%s::compute_roc(): Number of negative labels is "
+			"zero, ROC fails!\n", get_name());
+
+	// curve starts at (0,0), every non-empty bin adds a point
+	m_ROC_graph = SGMatrix<float64_t>(2,num_points+1);
+	m_thresholds = SGVector<float64_t>(num_points);
+	m_ROC_graph[0] = 0.0;
+	m_ROC_graph[1] = 0.0;
+
+	int64_t tp=0;
+	int64_t fp=0;
+	int32_t j=1;
+	for (int32_t b=num_bins-1; b>=0; b--)
+	{
+		if (pos[b]+neg[b]==0)
+			continue;
+
+		tp+=pos[b];
+		fp+=neg[b];
+		m_ROC_graph[2*j] = float64_t(fp)/neg_count;
+		m_ROC_graph[2*j+1] = float64_t(tp)/pos_count;
+		m_thresholds[j-1] = min_score+b*bin_width;
+		j++;
+	}
+
+	m_auROC = CMath::area_under_curve(m_ROC_graph.matrix,num_points+1,false);
+	m_computed = true;
+
+	return m_auROC;
+}
+
 SGMatrix<float64_t> CROCEvaluation::get_ROC()
 {
 	if (!m_computed)
@@ -26,16 +26,24 @@ class CLabels;
  *
  * Fawcett, Tom (2004) ROC Graphs:
  * Notes and Practical Considerations for Researchers; Machine Learning, 2004
+ *
+ * The predictions are sorted in parallel. For very large prediction sets an
+ * approximate mode can be enabled with set_num_bins(), which replaces the
+ * sort by a histogram of the predictions in equally wide bins between the
+ * smallest and largest prediction. Predictions within one bin are then
+ * treated as ties.
  */
 class CROCEvaluation: public CBinaryClassEvaluation
 {
 public:
 	/** constructor */
 	CROCEvaluation() :
-		CBinaryClassEvaluation(), m_computed(false)
+		CBinaryClassEvaluation(), m_auROC(0.0), m_computed(false),
+		m_num_bins(0)
 	{
 		m_ROC_graph = SGMatrix<float64_t>();
 		m_thresholds = SGVector<float64_t>();
+		init();
 	};
 
 	/** destructor */
@@ -71,6 +79,24 @@ public:
 	 */
 	SGVector<float64_t> get_thresholds();
 
+	/** set number of bins of the approximate mode
+	 * @param num_bins number of bins, 0 to sort all predictions
+	 */
+	void set_num_bins(int32_t num_bins)
+	{
+		REQUIRE(num_bins>=0, "Number of bins (%d) must not be negative\n",
+				num_bins);
+		m_num_bins=num_bins;
+	}
+
+	/** get number of bins of the approximate mode
+	 * @return number of bins, 0 if predictions are sorted
+	 */
+	int32_t get_num_bins() const
+	{
+		return m_num_bins;
+	}
+
 protected:
 
 	/** evaluate ROC and auROC
@@ -80,6 +106,19 @@ protected:
 	 */
 	float64_t evaluate_roc(CLabels* predicted, CLabels* ground_truth);
 
+	/** compute ROC and auROC from per-bin counts of positive and negative
+	 * examples, in this case the thresholds are the lower ends of the
+	 * non-empty bins
+	 *
+	 * @param pos counts of positive examples per bin
+	 * @param neg counts of negative examples per bin
+	 * @param min_score lower end of the first bin
+	 * @param max_score upper end of the last bin
+	 * @return auROC
+	 */
+	float64_t compute_roc(SGVector<int64_t> pos, SGVector<int64_t> neg,
+			float64_t min_score, float64_t max_score);
+
 protected:
 
 	/** 2-d array used to store ROC graph */
@@ -93,6 +132,13 @@ protected:
 
 	/** indicator of ROC and auROC being computed already */
 	bool m_computed;
+
+	/** number of bins of the approximate mode, 0 for exact evaluation */
+	int32_t m_num_bins;
+
+private:
+	/** register parameters */
+	void init();
 };
 
 }
@@ -0,0 +1,93 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society
+ */
+
+#include <shogun/evaluation/StreamingROCEvaluation.h>
+#include <shogun/labels/Labels.h>
+
+using namespace shogun;
+
+CStreamingROCEvaluation::CStreamingROCEvaluation() : CROCEvaluation()
+{
+	init(1000, -1.0, 1.0);
+}
+
+CStreamingROCEvaluation::CStreamingROCEvaluation(int32_t num_bins,
+		float64_t min_score, float64_t max_score) : CROCEvaluation()
+{
+	init(num_bins, min_score, max_score);
+}
+
+CStreamingROCEvaluation::~CStreamingROCEvaluation()
+{
+}
+
+void CStreamingROCEvaluation::init(int32_t num_bins, float64_t min_score,
+		float64_t max_score)
+{
+	REQUIRE(num_bins>0, "Number of bins (%d) must be positive\n", num_bins);
+	REQUIRE(min_score<max_score, "Score range [%f, %f] is empty\n",
+			min_score, max_score);
+
+	m_num_bins=num_bins;
+	m_min_score=min_score;
+	m_max_score=max_score;
+	m_pos_hist=SGVector<int64_t>(num_bins);
+	m_neg_hist=SGVector<int64_t>(num_bins);
+	reset();
+}
+
+float64_t CStreamingROCEvaluation::evaluate(CLabels* predicted,
+		CLabels* ground_truth)
+{
+	ASSERT(predicted && ground_truth)
+	ASSERT(predicted->get_num_labels()==ground_truth->get_num_labels())
+	ASSERT(predicted->get_label_type()==LT_BINARY)
+	ASSERT(ground_truth->get_label_type()==LT_BINARY)
+
+	update(gather_values(predicted), gather_values(ground_truth));
+
+	return m_computed ? m_auROC : 0.5;
+}
+
+void CStreamingROCEvaluation::update(SGVector<float64_t> scores,
+		SGVector<float64_t> truth)
+{
+	accumulate_histograms(scores, truth, m_min_score, m_max_score,
+			m_pos_hist, m_neg_hist);
+
+	int64_t pos_count=0;
+	int64_t neg_count=0;
+	for (int32_t b=0; b<m_num_bins; b++)
+	{
+		pos_count+=m_pos_hist[b];
+		neg_count+=m_neg_hist[b];
+	}
+
+	/* the curve only needs a pass over the bins, keep it up to date */
+	if (pos_count>0 && neg_count>0)
+		compute_roc(m_pos_hist, m_neg_hist, m_min_score, m_max_score);
+	else
+		m_computed=false;
+}
+
+void CStreamingROCEvaluation::reset()
+{
+	m_pos_hist.zero();
+	m_neg_hist.zero();
+	m_computed=false;
+}
+
+int64_t CStreamingROCEvaluation::get_num_examples() const
+{
+	int64_t num=0;
+	for (int32_t b=0; b<m_num_bins; b++)
+		num+=m_pos_hist[b]+m_neg_hist[b];
+
+	return num;
+}
@@ -0,0 +1,95 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society
+ */
+
+#ifndef STREAMINGROCEVALUATION_H_
+#define STREAMINGROCEVALUATION_H_
+
+#include <shogun/evaluation/ROCEvaluation.h>
+
+namespace shogun
+{
+
+class CLabels;
+
+/** @brief Class StreamingROCEvaluation accumulates the ROC and auROC over
+ * batches of predictions.
+ *
+ * Every call of evaluate() or update() adds a batch of predictions to a
+ * histogram of equally wide bins over a fixed score range, predictions
+ * outside the range fall into the first or last bin. No prediction is
+ * stored, memory is independent of the number of predictions and the
+ * auROC after each batch costs time linear in the number of bins.
+ * Predictions within one bin are treated as ties, so the result
+ * approximates the auROC of CROCEvaluation on all predictions.
+ */
+class CStreamingROCEvaluation: public CROCEvaluation
+{
+public:
+	/** default constructor, 1000 bins over [-1,1] */
+	CStreamingROCEvaluation();
+
+	/** constructor
+	 *
+	 * @param num_bins number of bins
+	 * @param min_score lower end of the first bin
+	 * @param max_score upper end of the last bin
+	 */
+	CStreamingROCEvaluation(int32_t num_bins, float64_t min_score,
+			float64_t max_score);
+
+	/** destructor */
+	virtual ~CStreamingROCEvaluation();
+
+	/** get name */
+	virtual const char* get_name() const { return "StreamingROCEvaluation"; };
+
+	/** add a batch of predictions
+	 *
+	 * @param predicted labels
+	 * @param ground_truth labels assumed to be correct
+	 * @return auROC of all predictions added so far, 0.5 as long as there
+	 * are no examples of both classes
+	 */
+	virtual float64_t evaluate(CLabels* predicted, CLabels* ground_truth);
+
+	/** add a batch of predictions and update ROC and auROC, which are
+	 * available once there are examples of both classes
+	 *
+	 * @param scores predicted values
+	 * @param truth true labels, examples with label >0 are positive
+	 */
+	void update(SGVector<float64_t> scores, SGVector<float64_t> truth);
+
+	/** drop all predictions */
+	void reset();
+
+	/** @return number of predictions added so far */
+	int64_t get_num_examples() const;
+
+private:
+	/** initialize histograms */
+	void init(int32_t num_bins, float64_t min_score, float64_t max_score);
+
+private:
+	/** counts of positive examples per bin */
+	SGVector<int64_t> m_pos_hist;
+
+	/** counts of negative examples per bin */
+	SGVector<int64_t> m_neg_hist;
+
+	/** lower end of the first bin */
+	float64_t m_min_score;
+
+	/** upper end of the last bin */
+	float64_t m_max_score;
+};
+
+}
+
+#endif /* STREAMINGROCEVALUATION_H_ */
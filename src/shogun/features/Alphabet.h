@@ -186,10 +186,11 @@ class CAlphabet : public CSGObject
 		/** add element to histogram
 		 *
 		 * @param p element
+		 * @param count number of occurrences of the element
 		 */
-		inline void add_byte_to_histogram(uint8_t p)
+		inline void add_byte_to_histogram(uint8_t p, int64_t count=1)
 		{
-			histogram[p]++;
+			histogram[p]+=count;
 		}
 
 		/// print histogram
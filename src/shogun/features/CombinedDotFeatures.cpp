@@ -155,7 +155,7 @@ void CCombinedDotFeatures::dense_dot_range(float64_t* output, int32_t start, int
 		}
 		else
 		{
-			f->dense_dot_range(tmp, start, stop, alphas, vec+offs, f_dim, b);
+			f->dense_dot_range(tmp, start, stop, alphas, vec+offs, f_dim, 0);
 			for (int32_t i=0; i<num; i++)
 				output[i]+=tmp[i];
 		}
@@ -187,7 +187,7 @@ void CCombinedDotFeatures::dense_dot_range_subset(int32_t* sub_index, int32_t nu
 		}
 		else
 		{
-			f->dense_dot_range_subset(sub_index, num, tmp, alphas, vec+offs, f_dim, b);
+			f->dense_dot_range_subset(sub_index, num, tmp, alphas, vec+offs, f_dim, 0);
 			for (int32_t i=0; i<num; i++)
 				output[i]+=tmp[i];
 		}
@@ -342,3 +342,22 @@ CFeatures* CCombinedFeatures::copy_subset(SGVector<index_t> indices)
 	SG_REF(result);
 	return result;
 }
+
+int64_t CCombinedFeatures::get_subset_copy_size()
+{
+	int64_t size=0;
+	for (index_t f_idx=0; f_idx<get_num_feature_obj() && size>=0; f_idx++)
+	{
+		CFeatures* current=get_feature_obj(f_idx);
+
+		/* copy_subset() of the sub-features drops their preprocessors */
+		int64_t current_size=-1;
+		if (current->get_num_preprocessors()==0)
+			current_size=current->get_subset_copy_size();
+
+		size=current_size>=0 ? size+current_size : -1;
+		SG_UNREF(current);
+	}
+
+	return size;
+}
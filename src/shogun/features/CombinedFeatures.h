@@ -180,6 +180,10 @@ class CCombinedFeatures : public CFeatures
 		 */
 		virtual CFeatures* copy_subset(SGVector<index_t> indices);
 
+		/** @return sum of get_subset_copy_size() of all sub-features, -1 if
+		 * one of them can not be copied */
+		virtual int64_t get_subset_copy_size();
+
 		/** @return object name */
 		virtual const char* get_name() const { return "CombinedFeatures"; }
 
@@ -15,8 +15,13 @@
 #include <shogun/preprocessor/DensePreprocessor.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/base/Parameter.h>
+#include <shogun/base/Parallel.h>
 #include <shogun/mathematics/Math.h>
 
+#ifdef HAVE_EIGEN3
+#include <shogun/mathematics/eigen3.h>
+#endif
+
 #include <string.h>
 
 namespace shogun {
@@ -545,6 +550,109 @@ void CDenseFeatures<float64_t>::add_to_dense_vec(float64_t alpha, int32_t vec_id
 	free_feature_vector(vec1, vec_idx1, vfree);
 }
 
+template<class ST> const float64_t* CDenseFeatures<ST>::get_dense_block(int32_t first,
+		int32_t len, float64_t* buffer)
+{
+	for (int32_t j=0; j<len; j++)
+	{
+		int32_t vlen;
+		bool vfree;
+		ST* vec=get_feature_vector(first+j, vlen, vfree);
+		ASSERT(vlen == num_features)
+
+		float64_t* col=&buffer[int64_t(j)*num_features];
+		for (int32_t i=0; i<num_features; i++)
+			col[i]=vec[i];
+
+		free_feature_vector(vec, first+j, vfree);
+	}
+
+	return buffer;
+}
+
+template<>
+const float64_t* CDenseFeatures<float64_t>::get_dense_block(int32_t first,
+		int32_t len, float64_t* buffer)
+{
+	if (feature_matrix.matrix && !m_subset_stack->has_subsets())
+		return &feature_matrix.matrix[int64_t(first)*num_features];
+
+	for (int32_t j=0; j<len; j++)
+	{
+		int32_t vlen;
+		bool vfree;
+		float64_t* vec=get_feature_vector(first+j, vlen, vfree);
+		ASSERT(vlen == num_features)
+		memcpy(&buffer[int64_t(j)*num_features], vec, sizeof(float64_t)*num_features);
+		free_feature_vector(vec, first+j, vfree);
+	}
+
+	return buffer;
+}
+
+template<class ST> void CDenseFeatures<ST>::dense_dot_range_multi(float64_t* output,
+		int32_t start, int32_t stop, const float64_t* W, int32_t dim, int32_t num_w,
+		const float64_t* b)
+{
+	ASSERT(output)
+	ASSERT(W)
+	ASSERT(dim == num_features)
+	ASSERT(start>=0)
+	ASSERT(start<stop)
+	ASSERT(stop<=get_num_vectors())
+	ASSERT(num_w>0)
+
+	// vectors per block, chosen such that a block stays in L2 cache
+	const int32_t block_size=CMath::max(1, CMath::min(256, 32768/CMath::max(1, num_features)));
+	int32_t num_range=stop-start;
+	int32_t num_blocks=(num_range+block_size-1)/block_size;
+
+	#pragma omp parallel num_threads(parallel->get_num_threads())
+	{
+		float64_t* buffer=SG_MALLOC(float64_t, int64_t(num_features)*block_size);
+
+		#pragma omp for schedule(static)
+		for (int32_t blk=0; blk<num_blocks; blk++)
+		{
+			int32_t first=blk*block_size;
+			int32_t len=CMath::min(block_size, num_range-first);
+			const float64_t* X=get_dense_block(start+first, len, buffer);
+			float64_t* out=output+first;
+
+#ifdef HAVE_EIGEN3
+			Eigen::Map<const Eigen::MatrixXd> eX(X, num_features, len);
+			Eigen::Map<const Eigen::MatrixXd> eW(W, num_features, num_w);
+			Eigen::Map<Eigen::MatrixXd, 0, Eigen::OuterStride<> > eO(out, len, num_w,
+					Eigen::OuterStride<>(num_range));
+
+			if (num_w==1)
+				eO.col(0).noalias()=eX.transpose()*eW.col(0);
+			else
+				eO.noalias()=eX.transpose()*eW;
+#else
+			for (int32_t k=0; k<num_w; k++)
+			{
+				for (int32_t j=0; j<len; j++)
+				{
+					out[j+int64_t(k)*num_range]=SGVector<float64_t>::dot(
+							&X[int64_t(j)*num_features], &W[int64_t(k)*dim], num_features);
+				}
+			}
+#endif
+			if (b)
+			{
+				for (int32_t k=0; k<num_w; k++)
+				{
+					for (int32_t j=0; j<len; j++)
+						out[j+int64_t(k)*num_range]+=b[k];
+				}
+			}
+		}
+
+		SG_FREE(buffer);
+	}
+}
+
 template<class ST> int32_t CDenseFeatures<ST>::get_nnz_features_for_vector(int32_t num)
 {
 	return num_features;
@@ -606,6 +714,14 @@ template<class ST> CFeatures* CDenseFeatures<ST>::copy_subset(SGVector<index_t>
 	return result;
 }
 
+template<class ST> int64_t CDenseFeatures<ST>::get_subset_copy_size()
+{
+	if (!feature_matrix.matrix)
+		return -1;
+
+	return ((int64_t) num_features)*get_num_vectors()*sizeof(ST);
+}
+
 template<class ST> ST* CDenseFeatures<ST>::compute_feature_vector(int32_t num, int32_t& len,
 		ST* target)
 {
@@ -614,6 +730,11 @@ template<class ST> ST* CDenseFeatures<ST>::compute_feature_vector(int32_t num, i
 	return NULL;
 }
 
+template<class ST> int64_t CDenseFeatures<ST>::get_unregistered_memory_footprint()
+{
+	return feature_cache ? feature_cache->get_memory_footprint() : 0;
+}
+
 template<class ST> void CDenseFeatures<ST>::init()
 {
 	num_vectors = 0;
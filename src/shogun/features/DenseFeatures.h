@@ -386,6 +386,27 @@ public:
 	virtual void add_to_dense_vec(float64_t alpha, int32_t vec_idx1,
 			float64_t* vec2, int32_t vec2_len, bool abs_val = false);
 
+	/** Compute the dot products of a range of vectors with several dense
+	 * vectors at once, see CDotFeatures::dense_dot_range_multi
+	 *
+	 * Feature vectors are processed in blocks which are multiplied with
+	 * all dense vectors in one matrix-matrix product. Blocks are gathered
+	 * into contiguous memory first unless they already are (no subset,
+	 * float64_t matrix in memory).
+	 *
+	 * possible with subset
+	 *
+	 * @param output result matrix of size (stop-start) x num_w
+	 * @param start start vector range from this idx
+	 * @param stop stop vector range at this idx
+	 * @param W dense vectors stored as columns of a dim x num_w matrix
+	 * @param dim length of the dense vectors
+	 * @param num_w number of dense vectors
+	 * @param b biases, one per dense vector, may be NULL
+	 */
+	virtual void dense_dot_range_multi(float64_t* output, int32_t start, int32_t stop,
+			const float64_t* W, int32_t dim, int32_t num_w, const float64_t* b);
+
 	/** get number of non-zero features in vector
 	 *
 	 * @param num which vector
@@ -468,6 +489,10 @@ public:
 	 */
 	virtual CFeatures* copy_subset(SGVector<index_t> indices);
 
+	/** @return number of bytes copy_subset() needs for the vectors of the
+	 * active subset, -1 if the feature matrix is not held in memory */
+	virtual int64_t get_subset_copy_size();
+
 	/** checks if the contents of this CDenseFeatures object are the same to
 	 * the contents of rhs
 	 *
@@ -517,6 +542,19 @@ protected:
 	virtual ST* compute_feature_vector(int32_t num, int32_t& len,
 			ST* target = NULL);
 
+	/** get a block of consecutive feature vectors as a contiguous
+	 * num_features x len float64_t matrix
+	 *
+	 * @param first index of first vector in the block
+	 * @param len number of vectors in the block
+	 * @param buffer num_features x len buffer to gather into if needed
+	 * @return pointer to the block, either into the feature matrix or buffer
+	 */
+	const float64_t* get_dense_block(int32_t first, int32_t len, float64_t* buffer);
+
+	/** @return bytes held by the feature cache */
+	virtual int64_t get_unregistered_memory_footprint();
+
 private:
 	void init();
 
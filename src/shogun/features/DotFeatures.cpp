@@ -228,6 +228,39 @@ void CDotFeatures::dense_dot_range_subset(int32_t* sub_index, int32_t num, float
 #endif
 }
 
+void CDotFeatures::dense_dot_range_multi(float64_t* output, int32_t start, int32_t stop,
+		const float64_t* W, int32_t dim, int32_t num_w, const float64_t* b)
+{
+	ASSERT(output)
+	ASSERT(W)
+	ASSERT(start>=0)
+	ASSERT(start<stop)
+	ASSERT(stop<=get_num_vectors())
+	ASSERT(num_w>0)
+
+	/* dense_dot_range implementations disagree on whether output is
+	 * indexed from start or from zero, so only ranges from zero are
+	 * passed on */
+	if (num_w==1 && start==0)
+	{
+		dense_dot_range(output, start, stop, NULL, (float64_t*) W, dim,
+				b ? b[0] : 0.0);
+		return;
+	}
+
+	int32_t num_vectors=stop-start;
+
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		for (int32_t k=0; k<num_w; k++)
+		{
+			output[i+int64_t(k)*num_vectors]=
+				dense_dot(start+i, W+int64_t(k)*dim, dim)+(b ? b[k] : 0.0);
+		}
+	}
+}
+
 void* CDotFeatures::dense_dot_range_helper(void* p)
 {
 	DF_THREAD_PARAM* par=(DF_THREAD_PARAM*) p;
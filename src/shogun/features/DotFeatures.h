@@ -131,6 +131,28 @@ class CDotFeatures : public CFeatures
 		virtual void dense_dot_range_subset(int32_t* sub_index, int32_t num,
 				float64_t* output, float64_t* alphas, float64_t* vec, int32_t dim, float64_t b);
 
+		/** Compute the dot products of a range of vectors with several dense
+		 * vectors at once
+		 * W[:,k]^T * x_i + b[k]
+		 *
+		 * The default implementation passes a single dense vector and a
+		 * range starting at zero on to dense_dot_range, so that its
+		 * overrides are used. Otherwise it calls dense_dot for every pair,
+		 * in parallel over blocks of vectors. Subclasses override this
+		 * with batched (GEMV/GEMM or SpMV) implementations.
+		 *
+		 * @param output result matrix of size (stop-start) x num_w in
+		 * column-major order, i.e. the outputs for W[:,k] are contiguous
+		 * @param start start vector range from this idx
+		 * @param stop stop vector range at this idx
+		 * @param W dense vectors stored as columns of a dim x num_w matrix
+		 * @param dim length of the dense vectors
+		 * @param num_w number of dense vectors
+		 * @param b biases, one per dense vector, may be NULL
+		 */
+		virtual void dense_dot_range_multi(float64_t* output, int32_t start, int32_t stop,
+				const float64_t* W, int32_t dim, int32_t num_w, const float64_t* b);
+
 		/** Compute the dot product for a range of vectors. This function is
 		 * called by the threads created in dense_dot_range */
 		static void* dense_dot_range_helper(void* p);
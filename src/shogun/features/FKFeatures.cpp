@@ -30,7 +30,8 @@ CFKFeatures::CFKFeatures(int32_t size, CHMM* p, CHMM* n)
 }
 
 CFKFeatures::CFKFeatures(const CFKFeatures &orig)
-: CDenseFeatures<float64_t>(orig), pos(orig.pos), neg(orig.neg), weight_a(orig.weight_a)
+: CDenseFeatures<float64_t>(orig), pos(orig.pos), neg(orig.neg),
+  pos_prob(NULL), neg_prob(NULL), weight_a(orig.weight_a)
 {
 }
 
@@ -72,8 +73,8 @@ float64_t CFKFeatures::deriv_a(float64_t a, int32_t dimension)
 		} ;
 	} else
 	{
-		float64_t pp=pos->model_probability(i) ;
-		float64_t pn=neg->model_probability(i) ;
+		float64_t pp=(pos_prob) ? pos_prob[i] : pos->model_probability(i);
+		float64_t pn=(neg_prob) ? neg_prob[i] : neg->model_probability(i);
 		float64_t sub=pp ;
 		if (pn>pp) sub=pn ;
 		pp-=sub ;
@@ -93,13 +94,7 @@ float64_t CFKFeatures::set_opt_a(float64_t a)
 	if (a==-1)
 	{
 		SG_INFO("estimating a.\n")
-		pos_prob=SG_MALLOC(float64_t, pos->get_observations()->get_num_vectors());
-		neg_prob=SG_MALLOC(float64_t, pos->get_observations()->get_num_vectors());
-		for (int32_t i=0; i<pos->get_observations()->get_num_vectors(); i++)
-		{
-			pos_prob[i]=pos->model_probability(i) ;
-			neg_prob[i]=neg->model_probability(i) ;
-		}
+		compute_model_probabilities();
 
 		float64_t la=0;
 		float64_t ua=1;
@@ -114,10 +109,7 @@ float64_t CFKFeatures::set_opt_a(float64_t a)
 			a=(la+ua)/2;
 			SG_INFO("opt_a: a=%1.3e  deriv=%1.3e  la=%1.3e  ua=%1.3e\n", a, da, la ,ua)
 		}
-		SG_FREE(pos_prob);
-		SG_FREE(neg_prob);
-		pos_prob=NULL;
-		neg_prob=NULL;
+		free_model_probabilities();
 	}
 
 	weight_a=a;
@@ -170,8 +162,8 @@ void CFKFeatures::compute_feature_vector(
 {
 	int32_t i,j,p=0,x=num;
 
-	float64_t posx=pos->model_probability(x);
-	float64_t negx=neg->model_probability(x);
+	float64_t posx=(pos_prob) ? pos_prob[x] : pos->model_probability(x);
+	float64_t negx=(neg_prob) ? neg_prob[x] : neg->model_probability(x);
 
 	len=1+pos->get_N()*(1+pos->get_N()+1+pos->get_M()) + neg->get_N()*(1+neg->get_N()+1+neg->get_M());
 
@@ -229,6 +221,7 @@ float64_t* CFKFeatures::set_feature_matrix()
 	feature_matrix=SGMatrix<float64_t>(num_features,num_vectors);
 
 	SG_INFO("calculating FK feature matrix\n")
+	compute_model_probabilities();
 
 	for (int32_t x=0; x<num_vectors; x++)
 	{
@@ -240,6 +233,7 @@ float64_t* CFKFeatures::set_feature_matrix()
 		compute_feature_vector(&feature_matrix.matrix[x*num_features], x, len);
 	}
 
+	free_model_probabilities();
 	SG_DONE()
 
 	num_vectors=get_num_vectors();
@@ -248,6 +242,31 @@ float64_t* CFKFeatures::set_feature_matrix()
 	return feature_matrix.matrix;
 }
 
+void CFKFeatures::compute_model_probabilities()
+{
+	CStringFeatures<uint16_t>* obs=pos->get_observations();
+	int32_t num=obs->get_num_vectors();
+	SG_UNREF(obs);
+
+	SGVector<index_t> idx(num);
+	idx.range_fill();
+
+	SG_FREE(pos_prob);
+	SG_FREE(neg_prob);
+	pos_prob=SG_MALLOC(float64_t, num);
+	neg_prob=SG_MALLOC(float64_t, num);
+	pos->get_log_likelihood(idx, SGVector<float64_t>(pos_prob, num, false));
+	neg->get_log_likelihood(idx, SGVector<float64_t>(neg_prob, num, false));
+}
+
+void CFKFeatures::free_model_probabilities()
+{
+	SG_FREE(pos_prob);
+	SG_FREE(neg_prob);
+	pos_prob=NULL;
+	neg_prob=NULL;
+}
+
 void CFKFeatures::init()
 {
 	pos = NULL;
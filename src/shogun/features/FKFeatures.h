@@ -130,6 +130,15 @@ class CFKFeatures: public CDenseFeatures<float64_t>
 		 */
 		float64_t deriv_a(float64_t a, int32_t dimension=-1) ;
 
+		/** compute the model probabilities of all observations under both
+		 * HMMs in batches, they are used instead of the per observation
+		 * ones until free_model_probabilities() is called
+		 */
+		void compute_model_probabilities();
+
+		/** free the model probabilities */
+		void free_model_probabilities();
+
 	private:
 		void init();
 
@@ -63,5 +63,16 @@ namespace shogun
 		FP_DOT = 1,
 		FP_STREAMING_DOT = 2
 	};
+
+	/// when CFeatures::materialize_subset() copies the active subset
+	enum ESubsetMaterialization
+	{
+		/// never copy, always use the subset indirection
+		SM_NEVER = 0,
+		/// copy if the size of the copy is known and small enough
+		SM_AUTO = 1,
+		/// copy whenever the feature class supports it
+		SM_ALWAYS = 2
+	};
 }
 #endif // _FEATURE_TYPES__H__
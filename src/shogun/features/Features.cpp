@@ -32,10 +32,15 @@ CFeatures::CFeatures(const CFeatures& orig)
 {
 	init();
 
+	SG_UNREF(preproc);
+	SG_UNREF(preprocessed);
 	preproc = orig.preproc;
 	preprocessed = orig.preprocessed;
 	SG_REF(preproc);
 	SG_REF(preprocessed);
+
+	m_subset_materialization = orig.m_subset_materialization;
+	m_materialize_max_bytes = orig.m_materialize_max_bytes;
 }
 
 CFeatures::CFeatures(CFile* loader)
@@ -68,8 +73,15 @@ void CFeatures::init()
 	SG_ADD((CSGObject**)&m_subset_stack, "subset_stack", "Stack of subsets",
 	       MS_NOT_AVAILABLE);
 
+	SG_ADD((machine_int_t*) &m_subset_materialization, "subset_materialization",
+			"When subsets are materialized", MS_NOT_AVAILABLE);
+	SG_ADD(&m_materialize_max_bytes, "materialize_max_bytes",
+			"Size limit of materialized subsets", MS_NOT_AVAILABLE);
+
 	m_subset_stack=new CSubsetStack();
 	SG_REF(m_subset_stack);
+	m_subset_materialization = SM_AUTO;
+	m_materialize_max_bytes = 128*1024*1024;
 
 	properties = FP_NONE;
 	cache_size = 0;
@@ -334,3 +346,35 @@ CFeatures* CFeatures::copy_subset(SGVector<index_t> indices)
 			"not yet implemented yet. Ask developers!\n", get_name());
 	return NULL;
 }
+
+CFeatures* CFeatures::materialize_subset(int32_t num_copies)
+{
+	if (m_subset_materialization!=SM_NEVER && m_subset_stack->has_subsets() &&
+			get_num_preprocessors()==0)
+	{
+		int64_t size=get_subset_copy_size();
+		if (num_copies<1)
+			num_copies=1;
+
+		if (size>=0 && (m_subset_materialization==SM_ALWAYS ||
+				size<=m_materialize_max_bytes/num_copies))
+		{
+			SG_DEBUG("materializing subset of %d vectors (%lld bytes)\n",
+					get_num_vectors(), (long long int) size)
+
+			SGVector<index_t> indices(get_num_vectors());
+			indices.range_fill();
+			return copy_subset(indices);
+		}
+	}
+
+	SG_REF(this);
+	return this;
+}
+
+void CFeatures::set_subset_materialization(ESubsetMaterialization mode,
+		int64_t max_bytes)
+{
+	m_subset_materialization=mode;
+	m_materialize_max_bytes=max_bytes;
+}
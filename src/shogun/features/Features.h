@@ -281,6 +281,39 @@ class CFeatures : public CSGObject
 		 */
 		virtual CFeatures* copy_subset(SGVector<index_t> indices);
 
+		/** Returns the vectors of the active subset for code that iterates
+		 * over the same subset many times, like training on a
+		 * cross-validation fold or a bag. Depending on the materialization
+		 * mode this is a compacted copy made by copy_subset(), which avoids
+		 * the index indirection and random memory access of the subset, or
+		 * this instance itself. No copy is made if there is no subset or
+		 * preprocessors are attached.
+		 *
+		 * @param num_copies number of materialized subsets the caller keeps
+		 * alive at the same time, the size limit of SM_AUTO is shared among
+		 * them
+		 * @return SG_REF'ed features holding the vectors of the subset
+		 */
+		CFeatures* materialize_subset(int32_t num_copies=1);
+
+		/** sets when materialize_subset() copies the active subset
+		 *
+		 * @param mode materialization mode
+		 * @param max_bytes maximum size of a copy in SM_AUTO mode
+		 */
+		void set_subset_materialization(ESubsetMaterialization mode,
+				int64_t max_bytes=128*1024*1024);
+
+		/** @return materialization mode of materialize_subset() */
+		ESubsetMaterialization get_subset_materialization() const
+		{
+			return m_subset_materialization;
+		}
+
+		/** @return number of bytes copy_subset() needs for the vectors of the
+		 * active subset, -1 if unknown or copy_subset() is not supported */
+		virtual int64_t get_subset_copy_size() { return -1; }
+
 	private:
 		void init();
 
@@ -297,6 +330,12 @@ class CFeatures : public CSGObject
 		/** i'th entry is true if features were already preprocessed with preproc i */
 		CDynamicArray<bool>* preprocessed;
 
+		/** when materialize_subset() copies */
+		ESubsetMaterialization m_subset_materialization;
+
+		/** size limit of materialized subsets in SM_AUTO mode */
+		int64_t m_materialize_max_bytes;
+
 	protected:
 		/** subset used for index transformations */
 		CSubsetStack* m_subset_stack;
@@ -5,6 +5,7 @@
 #include <shogun/lib/DataType.h>
 #include <shogun/labels/RegressionLabels.h>
 #include <shogun/io/SGIO.h>
+#include <shogun/base/Parallel.h>
 
 #include <string.h>
 #include <stdlib.h>
@@ -514,6 +515,85 @@ template<> float64_t CSparseFeatures<complex128_t>::dense_dot(int32_t vec_idx1,
 	return 0.0;
 }
 
+template<class ST> void CSparseFeatures<ST>::dense_dot_range_multi(float64_t* output,
+		int32_t start, int32_t stop, const float64_t* W, int32_t dim, int32_t num_w,
+		const float64_t* b)
+{
+	REQUIRE(output && W, "dense_dot_range_multi(): output and W must not be NULL\n");
+	REQUIRE(dim>=get_num_features(),
+		"dense_dot_range_multi(dim=%d): dim should contain number of features %d\n",
+		dim, get_num_features());
+	ASSERT(start>=0)
+	ASSERT(start<stop)
+	ASSERT(stop<=get_num_vectors())
+	ASSERT(num_w>0)
+
+	int32_t num_vectors=stop-start;
+
+	// all weights of one feature adjacent in memory (W is its own
+	// interleaved form for a single vector)
+	SGMatrix<float64_t> Wt;
+	const float64_t* weights=W;
+	if (num_w>1)
+	{
+		Wt=SGMatrix<float64_t>(num_w, dim);
+		for (int32_t k=0; k<num_w; k++)
+		{
+			for (int32_t i=0; i<dim; i++)
+				Wt(k,i)=W[i+int64_t(k)*dim];
+		}
+		weights=Wt.matrix;
+	}
+
+	// distance in non-zero entries at which weight rows are prefetched
+	const int32_t prefetch_distance=8;
+
+	#pragma omp parallel num_threads(parallel->get_num_threads())
+	{
+		float64_t* acc=SG_MALLOC(float64_t, num_w);
+
+		#pragma omp for schedule(static)
+		for (int32_t i=0; i<num_vectors; i++)
+		{
+			for (int32_t k=0; k<num_w; k++)
+				acc[k]=b ? b[k] : 0.0;
+
+			SGSparseVector<ST> sv=get_sparse_feature_vector(start+i);
+			SGSparseVectorEntry<ST>* entries=sv.features;
+			int32_t num_entries=sv.num_feat_entries;
+
+			for (int32_t j=0; j<num_entries; j++)
+			{
+#ifdef __GNUC__
+				if (j+prefetch_distance<num_entries)
+				{
+					__builtin_prefetch(&weights[int64_t(
+							entries[j+prefetch_distance].feat_index)*num_w]);
+				}
+#endif
+				const float64_t* row=&weights[int64_t(entries[j].feat_index)*num_w];
+				float64_t v=entries[j].entry;
+				for (int32_t k=0; k<num_w; k++)
+					acc[k]+=v*row[k];
+			}
+
+			free_sparse_feature_vector(start+i);
+
+			for (int32_t k=0; k<num_w; k++)
+				output[i+int64_t(k)*num_vectors]=acc[k];
+		}
+
+		SG_FREE(acc);
+	}
+}
+
+template<> void CSparseFeatures<complex128_t>::dense_dot_range_multi(float64_t* output,
+		int32_t start, int32_t stop, const float64_t* W, int32_t dim, int32_t num_w,
+		const float64_t* b)
+{
+	SG_NOTIMPLEMENTED;
+}
+
 template<class ST> void* CSparseFeatures<ST>::get_feature_iterator(int32_t vector_index)
 {
 	if (vector_index>=get_num_vectors())
@@ -581,9 +661,18 @@ template<class ST> CFeatures* CSparseFeatures<ST>::copy_subset(SGVector<index_t>
 	}
 
 	CFeatures* result=new CSparseFeatures<ST>(matrix_copy);
+	SG_REF(result);
 	return result;
 }
 
+template<class ST> int64_t CSparseFeatures<ST>::get_subset_copy_size()
+{
+	if (!sparse_feature_matrix.sparse_matrix)
+		return -1;
+
+	return ((int64_t) get_num_vectors())*sizeof(SGSparseVector<ST>);
+}
+
 template<class ST> SGSparseVectorEntry<ST>* CSparseFeatures<ST>::compute_sparse_feature_vector(int32_t num,
 	int32_t& len, SGSparseVectorEntry<ST>* target)
 {
@@ -416,6 +416,27 @@ template <class ST> class CSparseFeatures : public CDotFeatures
 		 */
 		virtual float64_t dense_dot(int32_t vec_idx1, const float64_t* vec2, int32_t vec2_len);
 
+		/** Compute the dot products of a range of vectors with several dense
+		 * vectors at once, see CDotFeatures::dense_dot_range_multi
+		 *
+		 * Each sparse vector is traversed once for all dense vectors (SpMV
+		 * style). For more than one dense vector, W is interleaved such that
+		 * the weights of one feature are adjacent and the rows of upcoming
+		 * non-zero entries are prefetched.
+		 *
+		 * possible with subset
+		 *
+		 * @param output result matrix of size (stop-start) x num_w
+		 * @param start start vector range from this idx
+		 * @param stop stop vector range at this idx
+		 * @param W dense vectors stored as columns of a dim x num_w matrix
+		 * @param dim length of the dense vectors
+		 * @param num_w number of dense vectors
+		 * @param b biases, one per dense vector, may be NULL
+		 */
+		virtual void dense_dot_range_multi(float64_t* output, int32_t start, int32_t stop,
+				const float64_t* W, int32_t dim, int32_t num_w, const float64_t* b);
+
 		#ifndef DOXYGEN_SHOULD_SKIP_THIS
 		/** iterator for sparse features */
 		struct sparse_feature_iterator
@@ -478,6 +499,11 @@ template <class ST> class CSparseFeatures : public CDotFeatures
 		 */
 		virtual CFeatures* copy_subset(SGVector<index_t> indices);
 
+		/** @return number of bytes copy_subset() needs for the vectors of
+		 * the active subset. The sparse vectors are shared with the copy,
+		 * only their headers are copied. */
+		virtual int64_t get_subset_copy_size();
+
 		/** @return object name */
 		virtual const char* get_name() const { return "SparseFeatures"; }
 
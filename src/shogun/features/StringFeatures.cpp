@@ -99,6 +99,9 @@ template<class ST> CStringFeatures<ST>::CStringFeatures(const CStringFeatures &
 		}
 	}
 
+	packed_string=orig.packed_string.clone();
+	packed_offsets=orig.packed_offsets.clone();
+
 	if (orig.symbol_mask_table)
 	{
 		symbol_mask_table=SG_MALLOC(ST, 256);
@@ -138,9 +141,13 @@ template<class ST> void CStringFeatures<ST>::cleanup()
 {
 	remove_all_subsets();
 
+	packed_string=SGVector<uint64_t>();
+	packed_offsets=SGVector<int64_t>();
+
 	if (single_string)
 	{
-		SG_FREE(single_string);
+		if (!in_arena(single_string))
+			SG_FREE(single_string);
 		single_string=NULL;
 	}
 	else
@@ -159,8 +166,11 @@ template<class ST> void CStringFeatures<ST>::cleanup()
 	num_vectors=0;
 	SG_FREE(features);
 	SG_FREE(symbol_mask_table);
+	SG_FREE(string_arena);
 	features=NULL;
 	symbol_mask_table=NULL;
+	string_arena=NULL;
+	string_arena_len=0;
 
 	/* start with a fresh alphabet, but instead of emptying the histogram
 	 * create a new object (to leave the alphabet object alone if it is used
@@ -176,10 +186,13 @@ template<class ST> void CStringFeatures<ST>::cleanup_feature_vector(int32_t num)
 {
 	ASSERT(num<get_num_vectors())
 
+	unpack();
+
 	if (features)
 	{
 		int32_t real_num=m_subset_stack->subset_idx_conversion(num);
-		SG_FREE(features[real_num].string);
+		if (!in_arena(features[real_num].string))
+			SG_FREE(features[real_num].string);
 		features[real_num].string=NULL;
 		features[real_num].slen=0;
 
@@ -189,6 +202,8 @@ template<class ST> void CStringFeatures<ST>::cleanup_feature_vector(int32_t num)
 
 template<class ST> void CStringFeatures<ST>::cleanup_feature_vectors(int32_t start, int32_t stop)
 {
+	unpack();
+
 	if (features && get_num_vectors())
 	{
 		ASSERT(start<get_num_vectors())
@@ -197,7 +212,8 @@ template<class ST> void CStringFeatures<ST>::cleanup_feature_vectors(int32_t sta
 		for (int32_t i=start; i<=stop; i++)
 		{
 			int32_t real_num=m_subset_stack->subset_idx_conversion(i);
-			SG_FREE(features[real_num].string);
+			if (!in_arena(features[real_num].string))
+				SG_FREE(features[real_num].string);
 			features[real_num].string=NULL;
 			features[real_num].slen=0;
 		}
@@ -222,7 +238,7 @@ template<class ST> CFeatures* CStringFeatures<ST>::duplicate() const
 
 template<class ST> SGVector<ST> CStringFeatures<ST>::get_feature_vector(int32_t num)
 {
-	ASSERT(features)
+	ASSERT(features || is_packed())
 	if (num>=get_num_vectors())
 	{
 		SG_ERROR("Index out of bounds (number of strings %d, you "
@@ -240,6 +256,7 @@ template<class ST> SGVector<ST> CStringFeatures<ST>::get_feature_vector(int32_t
 
 template<class ST> void CStringFeatures<ST>::set_feature_vector(SGVector<ST> vector, int32_t num)
 {
+	unpack();
 	ASSERT(features)
 
 	if (m_subset_stack->has_subsets())
@@ -274,13 +291,18 @@ template<class ST> void CStringFeatures<ST>::disable_on_the_fly_preprocessing()
 
 template<class ST> ST* CStringFeatures<ST>::get_feature_vector(int32_t num, int32_t& len, bool& dofree)
 {
-	ASSERT(features)
+	ASSERT(features || is_packed())
 	if (num>=get_num_vectors())
 		SG_ERROR("Requested feature vector with index %d while total num is", num, get_num_vectors())
 
 	int32_t real_num=m_subset_stack->subset_idx_conversion(num);
 
-	if (!preprocess_on_get)
+	if (!preprocess_on_get && is_packed())
+	{
+		dofree=true;
+		return compute_feature_vector(num, len);
+	}
+	else if (!preprocess_on_get)
 	{
 		dofree=false;
 		len=features[real_num].slen;
@@ -405,6 +427,12 @@ template<class ST> int32_t CStringFeatures<ST>::get_vector_length(int32_t vec_nu
 {
 	ASSERT(vec_num<get_num_vectors())
 
+	if (is_packed())
+	{
+		int32_t real_num=m_subset_stack->subset_idx_conversion(vec_num);
+		return packed_offsets[real_num+1]-packed_offsets[real_num];
+	}
+
 	int32_t len;
 	bool free_vec;
 	ST* vec=get_feature_vector(vec_num, len, free_vec);
@@ -581,196 +609,404 @@ template<class ST> void CStringFeatures<ST>::load_ascii_file(char* fname, bool r
 	num_symbols=alphabet->get_num_symbols();
 }
 
-template<class ST> bool CStringFeatures<ST>::load_fasta_file(const char* fname, bool ignore_invalid)
+/** OR len 2-bit codes into a packed stream starting at symbol offset, the
+ * first and last word may be shared with other strings written in parallel */
+static void write_packed_codes(uint64_t* packed, int64_t offset,
+		const uint8_t* codes, int32_t len)
 {
-	remove_all_subsets();
+	int64_t pos=offset;
+	int32_t j=0;
 
-	int32_t i=0;
-	uint64_t len=0;
-	uint64_t offs=0;
-	int32_t num=0;
-	int32_t max_len=0;
+	while (j<len)
+	{
+		int64_t w=pos>>5;
+		int32_t shift=(pos&31)<<1;
+		uint64_t word=0;
 
-	CMemoryMappedFile<char> f(fname);
+		for (; j<len && shift<64; j++, pos++, shift+=2)
+			word|=((uint64_t) (codes[j] & 3))<<shift;
+
+		#pragma omp atomic
+		packed[w]|=word;
+	}
+}
 
-	while (true)
+/** @return position of the first line starting with '>' in [pos, end) or
+ * end if there is none */
+static int64_t next_fasta_header(const char* data, int64_t pos, int64_t end)
+{
+	while (pos<end)
 	{
-		char* s=f.get_line(len, offs);
-		if (!s)
+		const char* q=(const char*) memchr(&data[pos], '>', end-pos);
+		if (!q)
 			break;
 
-		if (len>0 && s[0]=='>')
-			num++;
+		pos=q-data;
+		if (pos==0 || data[pos-1]=='\n')
+			return pos;
+		pos++;
+	}
+
+	return end;
+}
+
+template<class ST> bool CStringFeatures<ST>::load_fasta_file(const char* fname,
+		bool ignore_invalid, bool packed)
+{
+	remove_all_subsets();
+
+	CMemoryMappedFile<char> f(fname);
+	const char* data=f.get_map();
+	int64_t size=f.get_size();
+	int32_t num_threads=parallel->get_num_threads();
+
+	/* index the record boundaries, every thread scans one chunk of the file
+	 * for lines starting with '>', first counting and then recording them */
+	int64_t chunk_size=size/num_threads+1;
+	SGVector<int64_t> chunk_num(num_threads+1);
+	chunk_num.zero();
+
+	#pragma omp parallel for num_threads(num_threads)
+	for (int32_t t=0; t<num_threads; t++)
+	{
+		int64_t end=CMath::min(size, (t+1)*chunk_size);
+		for (int64_t p=next_fasta_header(data, t*chunk_size, end); p<end;
+				p=next_fasta_header(data, p+1, end))
+			chunk_num[t+1]++;
 	}
 
+	for (int32_t t=0; t<num_threads; t++)
+		chunk_num[t+1]+=chunk_num[t];
+
+	int32_t num=chunk_num[num_threads];
 	if (num==0)
 		SG_ERROR("No fasta hunks (lines starting with '>') found\n")
 
-	cleanup();
-	SG_UNREF(alphabet);
-	alphabet=new CAlphabet(DNA);
-	num_symbols=alphabet->get_num_symbols();
-
-	SGString<ST>* strings=SG_MALLOC(SGString<ST>, num);
-	offs=0;
+	SGVector<int64_t> starts(num+1);
+	starts[num]=size;
 
-	for (i=0;i<num; i++)
+	#pragma omp parallel for num_threads(num_threads)
+	for (int32_t t=0; t<num_threads; t++)
 	{
-		uint64_t id_len=0;
-		char* id=f.get_line(id_len, offs);
+		int64_t end=CMath::min(size, (t+1)*chunk_size);
+		int64_t idx=chunk_num[t];
+		for (int64_t p=next_fasta_header(data, t*chunk_size, end); p<end;
+				p=next_fasta_header(data, p+1, end))
+			starts[idx++]=p;
+	}
 
-		char* fasta=f.get_line(len, offs);
-		char* s=fasta;
-		int32_t fasta_len=0;
-		int32_t spanned_lines=0;
+	/* the sequence follows the id line and may span several lines */
+	SGVector<int64_t> seq_starts(num);
+	SGVector<int32_t> lengths(num);
+
+	#pragma omp parallel for schedule(dynamic, 64) num_threads(num_threads)
+	for (int32_t i=0; i<num; i++)
+	{
+		const char* id_end=(const char*) memchr(&data[starts[i]], '\n',
+				starts[i+1]-starts[i]);
+		seq_starts[i]=id_end ? id_end-data+1 : starts[i+1];
 
-		while (true)
+		int32_t len=0;
+		for (int64_t p=seq_starts[i]; p<starts[i+1]; p++)
 		{
-			if (!s || len==0)
-				SG_ERROR("Error reading fasta entry in line %d len=%ld", 4*i+1, len)
+			if (data[p]!='\n')
+				len++;
+		}
+		lengths[i]=len;
+	}
 
-			if (s[0]=='>' || offs==f.get_size())
-			{
-				offs-=len+1; // seek to beginning
-				if (offs==f.get_size())
-				{
-					SG_DEBUG("at EOF\n")
-					fasta_len+=len;
-				}
+	int32_t max_len=0;
+	for (int32_t i=0; i<num; i++)
+	{
+		if (lengths[i]==0)
+			SG_ERROR("Error reading fasta entry %d, it has no sequence\n", i)
+		max_len=CMath::max(max_len, lengths[i]);
+	}
 
-				len=fasta_len-spanned_lines;
-				strings[i].string=SG_MALLOC(ST, len);
-				strings[i].slen=len;
+	cleanup();
+	SG_UNREF(alphabet);
+	alphabet=new CAlphabet(DNA);
+	SG_REF(alphabet);
+	num_symbols=alphabet->get_num_symbols();
 
-				ST* str=strings[i].string;
-				int32_t idx=0;
-				SG_DEBUG("'%.*s', len=%d, spanned_lines=%d\n", (int32_t) id_len, id, (int32_t) len, (int32_t) spanned_lines)
+	SGString<ST>* strings=NULL;
+	ST* arena=NULL;
+	int64_t arena_len=0;
+	SGVector<int64_t> offsets;
+	SGVector<uint64_t> packed_seq;
 
-				for (int32_t j=0; j<fasta_len; j++)
-				{
-					if (fasta[j]=='\n')
-						continue;
+	if (packed)
+	{
+		offsets=SGVector<int64_t>(num+1);
+		offsets[0]=0;
+		for (int32_t i=0; i<num; i++)
+			offsets[i+1]=offsets[i]+lengths[i];
 
-					ST c=(ST) fasta[j];
+		packed_seq=SGVector<uint64_t>((offsets[num]+31)/32+1);
+		packed_seq.zero();
+	}
+	else
+		strings=create_arena_strings(lengths.vector, num, arena, arena_len);
 
-					if (ignore_invalid  && !alphabet->is_valid((uint8_t) fasta[j]))
-						c=(ST) 'A';
+	#pragma omp parallel num_threads(num_threads)
+	{
+		int64_t hist[256];
+		memset(hist, 0, sizeof(hist));
+		uint8_t* codes=packed ? SG_MALLOC(uint8_t, max_len) : NULL;
 
-					if (uint64_t(idx)>=len)
-						SG_ERROR("idx=%d j=%d fasta_len=%d, spanned_lines=%d str='%.*s'\n", idx, j, fasta_len, spanned_lines, idx, str)
-					str[idx++]=c;
-				}
-				max_len=CMath::max(max_len, strings[i].slen);
+		#pragma omp for schedule(dynamic, 64)
+		for (int32_t i=0; i<num; i++)
+		{
+			ST* str=packed ? NULL : strings[i].string;
+			int32_t idx=0;
+			for (int64_t p=seq_starts[i]; p<starts[i+1]; p++)
+			{
+				uint8_t c=(uint8_t) data[p];
+				if (c=='\n')
+					continue;
+
+				if (ignore_invalid && !alphabet->is_valid(c))
+					c='A';
+
+				hist[c]++;
+				if (packed)
+					codes[idx++]=alphabet->remap_to_bin(c);
+				else
+					str[idx++]=(ST) c;
+			}
 
+			if (packed)
+				write_packed_codes(packed_seq.vector, offsets[i], codes, idx);
+		}
 
-				break;
-			}
+		SG_FREE(codes);
 
-			spanned_lines++;
-			fasta_len+=len+1; // including '\n'
-			s=f.get_line(len, offs);
+		#pragma omp critical
+		for (int32_t c=0; c<256; c++)
+		{
+			if (hist[c])
+				alphabet->add_byte_to_histogram((uint8_t) c, hist[c]);
 		}
 	}
-	return set_features(strings, num, max_len);
+
+	num_vectors=num;
+	max_string_length=max_len;
+	features=strings;
+	string_arena=arena;
+	string_arena_len=arena_len;
+	packed_string=packed_seq;
+	packed_offsets=offsets;
+
+	if (!alphabet->check_alphabet(false))
+	{
+		alphabet->print_histogram();
+		cleanup();
+		SG_ERROR("%s contains symbols other than A,C,G,T\n", fname)
+		return false;
+	}
+
+	return true;
 }
 
 template<class ST> bool CStringFeatures<ST>::load_fastq_file(const char* fname,
-		bool ignore_invalid, bool bitremap_in_single_string)
+		bool ignore_invalid, bool bitremap_in_single_string, bool packed)
 {
+	REQUIRE(!packed || !bitremap_in_single_string, "Reads embedded into a "
+			"single string cannot be packed\n")
+
 	remove_all_subsets();
 
 	CMemoryMappedFile<char> f(fname);
+	const char* data=f.get_map();
+	int64_t size=f.get_size();
+	int32_t num_threads=parallel->get_num_threads();
+
+	/* count the lines of every chunk of the file to know where the records
+	 * of four lines each start */
+	int64_t chunk_size=size/num_threads+1;
+	SGVector<int64_t> chunk_lines(num_threads+1);
+	chunk_lines.zero();
+
+	#pragma omp parallel for num_threads(num_threads)
+	for (int32_t t=0; t<num_threads; t++)
+	{
+		int64_t end=CMath::min(size, (t+1)*chunk_size);
+		for (int64_t p=t*chunk_size; p<end; p++)
+		{
+			if (data[p]=='\n')
+				chunk_lines[t+1]++;
+		}
+	}
 
-	int32_t i=0;
-	uint64_t len=0;
-	uint64_t offs=0;
+	for (int32_t t=0; t<num_threads; t++)
+		chunk_lines[t+1]+=chunk_lines[t];
+
+	int64_t num_lines=chunk_lines[num_threads];
+	if (num_lines%4)
+		SG_ERROR("Number of lines must be divisible by 4 in fastq files\n")
+	int32_t num=num_lines/4;
+
+	SGVector<int64_t> starts(num);
+	if (num>0)
+		starts[0]=0;
+
+	#pragma omp parallel for num_threads(num_threads)
+	for (int32_t t=0; t<num_threads; t++)
+	{
+		int64_t end=CMath::min(size, (t+1)*chunk_size);
+		int64_t line=chunk_lines[t];
+		for (int64_t p=t*chunk_size; p<end; p++)
+		{
+			if (data[p]=='\n')
+			{
+				line++;
+				if (line%4==0 && line<num_lines)
+					starts[line/4]=p+1;
+			}
+		}
+	}
+
+	/* the read is the second line of each record */
+	SGVector<int64_t> seq_starts(num);
+	SGVector<int32_t> lengths(num);
+
+	#pragma omp parallel for schedule(dynamic, 256) num_threads(num_threads)
+	for (int32_t i=0; i<num; i++)
+	{
+		const char* id_end=(const char*) memchr(&data[starts[i]], '\n',
+				size-starts[i]);
+		seq_starts[i]=id_end-data+1;
+		const char* seq_end=(const char*) memchr(&data[seq_starts[i]], '\n',
+				size-seq_starts[i]);
+		lengths[i]=seq_end-data-seq_starts[i];
+	}
 
-	int32_t num=f.get_num_lines();
 	int32_t max_len=0;
+	for (int32_t i=0; i<num; i++)
+	{
+		if (lengths[i]==0)
+			SG_ERROR("Error reading 'read' in line %d len=%d", 4*i+1, lengths[i])
 
-	if (num%4)
-		SG_ERROR("Number of lines must be divisible by 4 in fastq files\n")
-	num/=4;
+		if (bitremap_in_single_string && lengths[i]!=lengths[0])
+			SG_ERROR("read in line %d not of length %d (is %d)\n", 4*i+1, lengths[0], lengths[i])
+
+		max_len=CMath::max(max_len, lengths[i]);
+	}
 
 	cleanup();
 	SG_UNREF(alphabet);
 	alphabet=new CAlphabet(DNA);
+	SG_REF(alphabet);
 
-	SGString<ST>* strings;
-
-	ST* str=NULL;
 	if (bitremap_in_single_string)
 	{
-		strings=SG_MALLOC(SGString<ST>, 1);
+		order=num>0 ? lengths[0] : 0;
+		original_num_symbols=alphabet->get_num_symbols();
+
+		SGString<ST>* strings=SG_MALLOC(SGString<ST>, 1);
 		strings[0].string=SG_MALLOC(ST, num);
 		strings[0].slen=num;
-		f.get_line(len, offs);
-		f.get_line(len, offs);
-		order=len;
-		max_len=num;
-		offs=0;
-		original_num_symbols=alphabet->get_num_symbols();
-		str=SG_MALLOC(ST, len);
+
+		#pragma omp parallel num_threads(num_threads)
+		{
+			ST* str=SG_MALLOC(ST, order);
+
+			#pragma omp for schedule(dynamic, 256)
+			for (int32_t i=0; i<num; i++)
+			{
+				const char* s=&data[seq_starts[i]];
+				for (int32_t j=0; j<order; j++)
+					str[j]=(ST) alphabet->remap_to_bin((uint8_t) s[j]);
+
+				strings[0].string[i]=embed_word(str, order);
+			}
+
+			SG_FREE(str);
+		}
+
+		num_vectors=1;
+		max_string_length=num;
+		features=strings;
+
+		return true;
 	}
-	else
-		strings=SG_MALLOC(SGString<ST>, num);
 
-	for (i=0;i<num; i++)
+	SGString<ST>* strings=NULL;
+	ST* arena=NULL;
+	int64_t arena_len=0;
+	SGVector<int64_t> offsets;
+	SGVector<uint64_t> packed_seq;
+
+	if (packed)
 	{
-		if (!f.get_line(len, offs))
-			SG_ERROR("Error reading 'read' identifier in line %d", 4*i)
+		offsets=SGVector<int64_t>(num+1);
+		offsets[0]=0;
+		for (int32_t i=0; i<num; i++)
+			offsets[i+1]=offsets[i]+lengths[i];
 
-		char* s=f.get_line(len, offs);
-		if (!s || len==0)
-			SG_ERROR("Error reading 'read' in line %d len=%ld", 4*i+1, len)
+		packed_seq=SGVector<uint64_t>((offsets[num]+31)/32+1);
+		packed_seq.zero();
+	}
+	else
+		strings=create_arena_strings(lengths.vector, num, arena, arena_len);
 
-		if (bitremap_in_single_string)
-		{
-			if (len!=(uint64_t) order)
-				SG_ERROR("read in line %d not of length %d (is %d)\n", 4*i+1, order, len)
-			for (int32_t j=0; j<order; j++)
-				str[j]=(ST) alphabet->remap_to_bin((uint8_t) s[j]);
+	#pragma omp parallel num_threads(num_threads)
+	{
+		int64_t hist[256];
+		memset(hist, 0, sizeof(hist));
+		uint8_t* codes=packed ? SG_MALLOC(uint8_t, max_len) : NULL;
 
-			strings[0].string[i]=embed_word(str, order);
-		}
-		else
+		#pragma omp for schedule(dynamic, 256)
+		for (int32_t i=0; i<num; i++)
 		{
-			strings[i].string=SG_MALLOC(ST, len);
-			strings[i].slen=len;
-			str=strings[i].string;
+			const char* s=&data[seq_starts[i]];
+			ST* str=packed ? NULL : strings[i].string;
 
-			if (ignore_invalid)
+			for (int32_t j=0; j<lengths[i]; j++)
 			{
-				for (uint64_t j=0; j<len; j++)
-				{
-					if (alphabet->is_valid((uint8_t) s[j]))
-						str[j]= (ST) s[j];
-					else
-						str[j]= (ST) 'A';
-				}
-			}
-			else
-			{
-				for (uint64_t j=0; j<len; j++)
-					str[j]= (ST) s[j];
+				uint8_t c=(uint8_t) s[j];
+				if (ignore_invalid && !alphabet->is_valid(c))
+					c='A';
+
+				hist[c]++;
+				if (packed)
+					codes[j]=alphabet->remap_to_bin(c);
+				else
+					str[j]=(ST) c;
 			}
-			max_len=CMath::max(max_len, (int32_t) len);
-		}
 
+			if (packed)
+				write_packed_codes(packed_seq.vector, offsets[i], codes, lengths[i]);
+		}
 
-		if (!f.get_line(len, offs))
-			SG_ERROR("Error reading 'read' quality identifier in line %d", 4*i+2)
+		SG_FREE(codes);
 
-		if (!f.get_line(len, offs))
-			SG_ERROR("Error reading 'read' quality in line %d", 4*i+3)
+		#pragma omp critical
+		for (int32_t c=0; c<256; c++)
+		{
+			if (hist[c])
+				alphabet->add_byte_to_histogram((uint8_t) c, hist[c]);
+		}
 	}
 
-	if (bitremap_in_single_string)
-		num=1;
-
 	num_vectors=num;
 	max_string_length=max_len;
 	features=strings;
+	string_arena=arena;
+	string_arena_len=arena_len;
+	packed_string=packed_seq;
+	packed_offsets=offsets;
+
+	/* unpacked reads are kept as they are, but invalid symbols cannot be
+	 * packed */
+	if (packed && !alphabet->check_alphabet(false))
+	{
+		alphabet->print_histogram();
+		cleanup();
+		SG_ERROR("%s contains symbols other than A,C,G,T, they can only be "
+				"packed with ignore_invalid\n", fname)
+		return false;
+	}
 
 	return true;
 }
@@ -901,10 +1137,16 @@ template<class ST> bool CStringFeatures<ST>::append_features(CStringFeatures<ST>
 	index_t sf_num_str=sf->get_num_vectors();
 	for (int32_t i=0; i<sf_num_str; i++)
 	{
-		int32_t real_i = sf->m_subset_stack->subset_idx_conversion(i);
-		int32_t length=sf->features[real_i].slen;
-		new_features[i].string=SG_MALLOC(ST, length);
-		memcpy(new_features[i].string, sf->features[real_i].string, length);
+		int32_t length;
+		if (sf->is_packed())
+			new_features[i].string=sf->compute_feature_vector(i, length);
+		else
+		{
+			int32_t real_i = sf->m_subset_stack->subset_idx_conversion(i);
+			length=sf->features[real_i].slen;
+			new_features[i].string=SG_MALLOC(ST, length);
+			memcpy(new_features[i].string, sf->features[real_i].string, length);
+		}
 		new_features[i].slen=length;
 	}
 	return append_features(new_features, sf_num_str,
@@ -916,6 +1158,8 @@ template<class ST> bool CStringFeatures<ST>::append_features(SGString<ST>* p_fea
 	if (m_subset_stack->has_subsets())
 		SG_ERROR("Cannot call set_features() with subset.\n")
 
+	unpack();
+
 	if (!features)
 		return set_features(p_features, p_num_vectors, p_max_string_length);
 
@@ -977,6 +1221,8 @@ template<class ST> SGString<ST>* CStringFeatures<ST>::get_features(int32_t& num_
 	if (m_subset_stack->has_subsets())
 		SG_ERROR("get features() is not possible on subset")
 
+	unpack();
+
 	num_str=num_vectors;
 	max_str_len=max_string_length;
 	return features;
@@ -1196,6 +1442,8 @@ template<class ST> int32_t CStringFeatures<ST>::obtain_by_sliding_window(int32_t
 	if (m_subset_stack->has_subsets())
 		SG_NOTIMPLEMENTED
 
+	unpack();
+
 	ASSERT(step_size>0)
 	ASSERT(window_size>0)
 	ASSERT(num_vectors==1 || single_string)
@@ -1234,6 +1482,8 @@ template<class ST> int32_t CStringFeatures<ST>::obtain_by_position_list(int32_t
 	if (m_subset_stack->has_subsets())
 		SG_NOTIMPLEMENTED
 
+	unpack();
+
 	ASSERT(positions)
 	ASSERT(window_size>0)
 	ASSERT(num_vectors==1 || single_string)
@@ -1315,6 +1565,8 @@ template<class ST> void CStringFeatures<ST>::embed_features(int32_t p_order)
 	if (m_subset_stack->has_subsets())
 		SG_NOTIMPLEMENTED
 
+	unpack();
+
 	ASSERT(alphabet->get_num_symbols_in_histogram() > 0)
 
 	order=p_order;
@@ -1337,11 +1589,14 @@ template<class ST> void CStringFeatures<ST>::embed_features(int32_t p_order)
 
 	for (int32_t i=0; i<num_vectors; i++)
 	{
-		int32_t len=features[i].slen;
-
-		if (len < p_order)
-			SG_ERROR("Sequence must be longer than order (%d vs. %d)\n", len, p_order)
+		if (features[i].slen < p_order)
+			SG_ERROR("Sequence must be longer than order (%d vs. %d)\n", features[i].slen, p_order)
+	}
 
+	#pragma omp parallel for schedule(dynamic, 256) num_threads(parallel->get_num_threads())
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		int32_t len=features[i].slen;
 		ST* str=features[i].string;
 
 		// convert first word
@@ -1428,8 +1683,10 @@ template<class ST> void CStringFeatures<ST>::determine_maximum_string_length()
 
 	for (int32_t i=0; i<num_str; i++)
 	{
-		max_string_length=CMath::max(max_string_length,
-			features[m_subset_stack->subset_idx_conversion(i)].slen);
+		int32_t real_num=m_subset_stack->subset_idx_conversion(i);
+		int32_t len=is_packed() ? packed_offsets[real_num+1]-packed_offsets[real_num] :
+			features[real_num].slen;
+		max_string_length=CMath::max(max_string_length, len);
 	}
 }
 
@@ -1444,6 +1701,7 @@ template<class ST> ST* CStringFeatures<ST>::get_zero_terminated_string_copy(SGSt
 
 template<class ST> void CStringFeatures<ST>::set_feature_vector(int32_t num, ST* string, int32_t len)
 {
+	unpack();
 	ASSERT(features)
 	ASSERT(num<get_num_vectors())
 
@@ -1603,25 +1861,37 @@ CStringFeatures<SSKFeature>* obtain_sssk_double_from_char(int **S, int *len, int
 template<class ST> CFeatures* CStringFeatures<ST>::copy_subset(
 		SGVector<index_t> indices)
 {
-	/* string list to create new CStringFeatures from */
-	SGStringList<ST> list_copy(indices.vlen, max_string_length);
+	if (is_packed())
+		return copy_packed_subset(indices);
 
-	/* copy all features */
+	/* index with respect to possible subset */
+	SGVector<index_t> real_idx(indices.vlen);
+	SGVector<int32_t> lengths(indices.vlen);
 	for (index_t i=0; i<indices.vlen; ++i)
 	{
-		/* index with respect to possible subset */
-		index_t real_idx=m_subset_stack->subset_idx_conversion(indices.vector[i]);
+		real_idx[i]=m_subset_stack->subset_idx_conversion(indices.vector[i]);
+		lengths[i]=features[real_idx[i]].slen;
+	}
+
+	/* string list to create new CStringFeatures from, the copies are
+	 * stored back to back in one arena */
+	ST* arena;
+	int64_t arena_len;
+	SGStringList<ST> list_copy(create_arena_strings(lengths.vector,
+				indices.vlen, arena, arena_len), indices.vlen, max_string_length);
 
-		/* copy string */
-		SGString<ST> current_string=features[real_idx];
-		SGString<ST> string_copy(current_string.slen);
-		memcpy(string_copy.string, current_string.string,
-			current_string.slen*sizeof(ST));
-		list_copy.strings[i]=string_copy;
+	/* copy all features */
+	#pragma omp parallel for schedule(dynamic, 256) num_threads(parallel->get_num_threads())
+	for (index_t i=0; i<indices.vlen; ++i)
+	{
+		memcpy(list_copy.strings[i].string, features[real_idx[i]].string,
+			lengths[i]*sizeof(ST));
 	}
 
 	/* create copy instance */
 	CStringFeatures* result=new CStringFeatures(list_copy, alphabet);
+	result->string_arena=arena;
+	result->string_arena_len=arena_len;
 
 	/* max string length may have changed */
 	result->determine_maximum_string_length();
@@ -1635,18 +1905,336 @@ template<class ST> CFeatures* CStringFeatures<ST>::copy_subset(
 	return result;
 }
 
+template<class ST> int64_t CStringFeatures<ST>::get_subset_copy_size()
+{
+	index_t num_vec=get_num_vectors();
+
+	if (is_packed())
+	{
+		int64_t num_sym=0;
+		for (index_t i=0; i<num_vec; i++)
+			num_sym+=get_vector_length(i);
+
+		return (num_vec+1)*sizeof(int64_t)+((num_sym+31)/32+1)*sizeof(uint64_t);
+	}
+
+	if (!features)
+		return -1;
+
+	int64_t size=((int64_t) num_vec)*sizeof(SGString<ST>);
+	for (index_t i=0; i<num_vec; i++)
+		size+=features[m_subset_stack->subset_idx_conversion(i)].slen*sizeof(ST);
+
+	return size;
+}
+
 template<class ST> void CStringFeatures<ST>::subset_changed_post()
 {
 	/* max string length has to be updated */
 	determine_maximum_string_length();
 }
 
+template<class ST> SGString<ST>* CStringFeatures<ST>::create_arena_strings(
+		const int32_t* lengths, int32_t num, ST*& arena, int64_t& arena_len)
+{
+	arena_len=0;
+	for (int32_t i=0; i<num; i++)
+		arena_len+=lengths[i];
+
+	arena=SG_MALLOC(ST, CMath::max(arena_len, (int64_t) 1));
+	SGString<ST>* strings=SG_MALLOC(SGString<ST>, num);
+
+	int64_t offset=0;
+	/* empty strings do not point into the arena, as the end of the arena
+	 * may be the start of another allocation */
+	for (int32_t i=0; i<num; i++)
+	{
+		strings[i].string=lengths[i] ? &arena[offset] : NULL;
+		strings[i].slen=lengths[i];
+		offset+=lengths[i];
+	}
+
+	return strings;
+}
+
+template<class ST> void CStringFeatures<ST>::move_to_arena()
+{
+	unpack();
+
+	if (single_string)
+		SG_ERROR("Strings created by sliding window cannot be moved\n")
+
+	if (!features)
+		return;
+
+	SGVector<int32_t> lengths(num_vectors);
+	for (int32_t i=0; i<num_vectors; i++)
+		lengths[i]=features[i].slen;
+
+	ST* arena;
+	int64_t arena_len;
+	SGString<ST>* strings=create_arena_strings(lengths.vector, num_vectors,
+			arena, arena_len);
+
+	#pragma omp parallel for schedule(dynamic, 256) num_threads(parallel->get_num_threads())
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		memcpy(strings[i].string, features[i].string, sizeof(ST)*features[i].slen);
+		if (!in_arena(features[i].string))
+			SG_FREE(features[i].string);
+	}
+
+	SG_FREE(features);
+	SG_FREE(string_arena);
+	features=strings;
+	string_arena=arena;
+	string_arena_len=arena_len;
+}
+
+template<class ST> void CStringFeatures<ST>::release_arena()
+{
+	if (!string_arena)
+		return;
+
+	if (single_string && in_arena(single_string))
+	{
+		ST* str=SG_MALLOC(ST, CMath::max(max_string_length, 1));
+		memcpy(str, single_string, sizeof(ST)*max_string_length);
+		single_string=str;
+	}
+
+	for (int32_t i=0; features && i<num_vectors; i++)
+	{
+		if (in_arena(features[i].string))
+		{
+			ST* str=SG_MALLOC(ST, CMath::max(features[i].slen, 1));
+			memcpy(str, features[i].string, sizeof(ST)*features[i].slen);
+			features[i].string=str;
+		}
+	}
+
+	SG_FREE(string_arena);
+	string_arena=NULL;
+	string_arena_len=0;
+}
+
+template<class ST> void CStringFeatures<ST>::pack()
+{
+	if (is_packed())
+		return;
+
+	if (m_subset_stack->has_subsets())
+		SG_ERROR("pack() is not possible on subset\n")
+
+	if (single_string)
+		SG_ERROR("Strings created by sliding window cannot be packed\n")
+
+	REQUIRE(alphabet->get_num_bits()==2, "Only alphabets with 2 bit symbols "
+			"can be packed, %s has %d bits\n",
+			CAlphabet::get_alphabet_name(alphabet->get_alphabet()),
+			alphabet->get_num_bits());
+
+	SGVector<int64_t> offsets(num_vectors+1);
+	offsets[0]=0;
+	for (int32_t i=0; i<num_vectors; i++)
+		offsets[i+1]=offsets[i]+features[i].slen;
+
+	SGVector<uint64_t> packed((offsets[num_vectors]+31)/32+1);
+	packed.zero();
+
+	int64_t num_invalid=0;
+
+	#pragma omp parallel num_threads(parallel->get_num_threads())
+	{
+		uint8_t* codes=SG_MALLOC(uint8_t, max_string_length);
+
+		#pragma omp for schedule(dynamic, 64) reduction(+:num_invalid)
+		for (int32_t i=0; i<num_vectors; i++)
+		{
+			for (int32_t j=0; j<features[i].slen; j++)
+			{
+				uint8_t c=(uint8_t) features[i].string[j];
+				if (!alphabet->is_valid(c))
+					num_invalid++;
+				codes[j]=alphabet->remap_to_bin(c);
+			}
+
+			write_packed_codes(packed.vector, offsets[i], codes, features[i].slen);
+		}
+
+		SG_FREE(codes);
+	}
+
+	if (num_invalid)
+		SG_ERROR("Cannot pack strings with %lld invalid symbols\n", num_invalid)
+
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		if (!in_arena(features[i].string))
+			SG_FREE(features[i].string);
+	}
+	SG_FREE(features);
+	SG_FREE(string_arena);
+	features=NULL;
+	string_arena=NULL;
+	string_arena_len=0;
+
+	packed_string=packed;
+	packed_offsets=offsets;
+}
+
+template<class ST> void CStringFeatures<ST>::unpack()
+{
+	if (!is_packed())
+		return;
+
+	SGVector<int32_t> lengths(num_vectors);
+	for (int32_t i=0; i<num_vectors; i++)
+		lengths[i]=packed_offsets[i+1]-packed_offsets[i];
+
+	SG_FREE(string_arena);
+	SGString<ST>* strings=create_arena_strings(lengths.vector, num_vectors,
+			string_arena, string_arena_len);
+
+	#pragma omp parallel for schedule(dynamic, 64) num_threads(parallel->get_num_threads())
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		int64_t offset=packed_offsets[i];
+
+		for (int32_t j=0; j<strings[i].slen; j++)
+		{
+			strings[i].string[j]=(ST) alphabet->remap_to_char(
+					get_packed_symbol(packed_string.vector, offset+j));
+		}
+	}
+
+	features=strings;
+	packed_string=SGVector<uint64_t>();
+	packed_offsets=SGVector<int64_t>();
+}
+
+template<class ST> uint64_t* CStringFeatures<ST>::get_packed_string(int32_t num,
+		int64_t& offset, int32_t& len)
+{
+	REQUIRE(is_packed(), "Strings are not packed\n")
+
+	if (num>=get_num_vectors())
+	{
+		SG_ERROR("Index out of bounds (number of strings %d, you "
+				"requested %d)\n", get_num_vectors(), num);
+	}
+
+	int32_t real_num=m_subset_stack->subset_idx_conversion(num);
+	offset=packed_offsets[real_num];
+	len=packed_offsets[real_num+1]-offset;
+
+	return packed_string.vector;
+}
+
+template<class ST> CFeatures* CStringFeatures<ST>::copy_packed_subset(
+		SGVector<index_t> indices)
+{
+	SGVector<int64_t> offsets(indices.vlen+1);
+	offsets[0]=0;
+	for (index_t i=0; i<indices.vlen; i++)
+		offsets[i+1]=offsets[i]+get_vector_length(indices.vector[i]);
+
+	SGVector<uint64_t> packed((offsets[indices.vlen]+31)/32+1);
+	packed.zero();
+
+	CAlphabet* alpha=new CAlphabet(alphabet->get_alphabet());
+
+	#pragma omp parallel num_threads(parallel->get_num_threads())
+	{
+		int64_t hist[4]={0, 0, 0, 0};
+		uint8_t* codes=SG_MALLOC(uint8_t, max_string_length);
+
+		#pragma omp for schedule(dynamic, 64)
+		for (index_t i=0; i<indices.vlen; i++)
+		{
+			int64_t offset;
+			int32_t len;
+			get_packed_string(indices.vector[i], offset, len);
+
+			for (int32_t j=0; j<len; j++)
+			{
+				codes[j]=get_packed_symbol(packed_string.vector, offset+j);
+				hist[codes[j]]++;
+			}
+
+			write_packed_codes(packed.vector, offsets[i], codes, len);
+		}
+
+		SG_FREE(codes);
+
+		#pragma omp critical
+		for (int32_t c=0; c<4; c++)
+		{
+			if (hist[c])
+				alpha->add_byte_to_histogram(alpha->remap_to_char(c), hist[c]);
+		}
+	}
+
+	CStringFeatures* result=new CStringFeatures(alpha);
+	result->num_vectors=indices.vlen;
+	result->packed_string=packed;
+	result->packed_offsets=offsets;
+	result->determine_maximum_string_length();
+
+	/* keep things from original features (otherwise assertions in x-val) */
+	result->order=order;
+	result->compute_symbol_mask_table(result->alphabet->get_num_symbols());
+
+	SG_REF(result);
+
+	return result;
+}
+
+template<class ST> void CStringFeatures<ST>::save_serializable_pre() throw (ShogunException)
+{
+	CFeatures::save_serializable_pre();
+
+	/* serialized features always hold unpacked strings */
+	repack_after_save=is_packed();
+	unpack();
+}
+
+template<class ST> void CStringFeatures<ST>::load_serializable_pre() throw (ShogunException)
+{
+	CFeatures::load_serializable_pre();
+
+	/* loading frees the current strings one by one */
+	release_arena();
+}
+
+template<class ST> void CStringFeatures<ST>::save_serializable_post() throw (ShogunException)
+{
+	CFeatures::save_serializable_post();
+
+	if (repack_after_save)
+		pack();
+	repack_after_save=false;
+}
+
 template<class ST> ST* CStringFeatures<ST>::compute_feature_vector(int32_t num, int32_t& len)
 {
-	ASSERT(features && num<get_num_vectors())
+	ASSERT((features || is_packed()) && num<get_num_vectors())
 
 	int32_t real_num=m_subset_stack->subset_idx_conversion(num);
 
+	if (is_packed())
+	{
+		int64_t offset=packed_offsets[real_num];
+		len=packed_offsets[real_num+1]-offset;
+		if (len<=0)
+			return NULL;
+
+		ST* target=SG_MALLOC(ST, len);
+		for (int32_t j=0; j<len; j++)
+			target[j]=(ST) alphabet->remap_to_char(get_packed_symbol(packed_string.vector, offset+j));
+		return target;
+	}
+
 	len=features[real_num].slen;
 	if (len<=0)
 		return NULL;
@@ -1672,6 +2260,9 @@ template<class ST> void CStringFeatures<ST>::init()
 	symbol_mask_table=NULL;
 	symbol_mask_table_len=0;
 	num_symbols=0.0;
+	repack_after_save=false;
+	string_arena=NULL;
+	string_arena_len=0;
 	original_num_symbols=0;
 
 	m_parameters->add((CSGObject**) &alphabet, "alphabet");
@@ -1693,6 +2284,10 @@ template<class ST> void CStringFeatures<ST>::init()
 			"Preprocess on-the-fly?");
 
 	m_parameters->add_vector(&symbol_mask_table, &symbol_mask_table_len, "mask_table", "Symbol mask table - using in higher order mapping");
+	m_parameters->add(&packed_string, "packed_string",
+			"2-bit packed strings.");
+	m_parameters->add(&packed_offsets, "packed_offsets",
+			"Start of each string in packed_string.");
 }
 
 /** get feature type the char feature can deal with
@@ -1947,7 +2542,18 @@ template<> void CStringFeatures<sg_type>::save(CFile* writer)		\
 		SG_ERROR("save() is not possible on subset")						\
 	SG_SET_LOCALE_C;													\
 	ASSERT(writer)															\
-	writer->f_write(features, num_vectors);									\
+	if (is_packed())														\
+	{																		\
+		int32_t num_str;													\
+		int32_t max_len;													\
+		SGString<sg_type>* strs=copy_features(num_str, max_len);			\
+		writer->f_write(strs, num_str);										\
+		for (int32_t i=0; i<num_str; i++)									\
+			SG_FREE(strs[i].string);										\
+		SG_FREE(strs);														\
+	}																		\
+	else																	\
+		writer->f_write(features, num_vectors);								\
 	SG_RESET_LOCALE;													\
 }
 
@@ -1982,20 +2588,54 @@ bool CStringFeatures<ST>::obtain_from_char_features(CStringFeatures<CT>* sf, int
 	num_vectors=sf->get_num_vectors();
 	ASSERT(num_vectors>0)
 	max_string_length=sf->get_max_vector_length()-start;
-	features=SG_MALLOC(SGString<ST>, num_vectors);
+
+	SGVector<int32_t> lengths(num_vectors);
+	for (int32_t i=0; i<num_vectors; i++)
+		lengths[i]=sf->get_vector_length(i);
+
+	/* errors cannot leave the parallel loops below, so the vectors are
+	 * checked here */
+	ASSERT(!preprocess_on_get) // won't work when preprocessors are attached
+	if (!sf->is_packed())
+	{
+		for (int32_t i=0; i<num_vectors; i++)
+		{
+			int32_t len=-1;
+			bool vfree;
+			CT* c=sf->get_feature_vector(i, len, vfree);
+			sf->free_feature_vector(c, i, vfree);
+			ASSERT(!vfree) // won't work when preprocessors are attached
+			ASSERT(len==lengths[i])
+		}
+	}
+
+	features=create_arena_strings(lengths.vector, num_vectors, string_arena,
+			string_arena_len);
 
 	SG_DEBUG("%1.0llf symbols in StringFeatures<*> %d symbols in histogram\n", sf->get_num_symbols(),
 			alpha->get_num_symbols_in_histogram());
 
+	int32_t num_threads=parallel->get_num_threads();
+
+	#pragma omp parallel for schedule(dynamic, 64) num_threads(num_threads)
 	for (int32_t i=0; i<num_vectors; i++)
 	{
 		int32_t len=-1;
+
+		/* packed strings already hold the binary symbols */
+		if (sf->is_packed())
+		{
+			int64_t offset;
+			uint64_t* packed=sf->get_packed_string(i, offset, len);
+
+			ST* str=features[i].string;
+			for (int32_t j=0; j<len; j++)
+				str[j]=(ST) get_packed_symbol(packed, offset+j);
+			continue;
+		}
+
 		bool vfree;
 		CT* c=sf->get_feature_vector(i, len, vfree);
-		ASSERT(!vfree) // won't work when preprocessors are attached
-
-		features[i].string=SG_MALLOC(ST, len);
-		features[i].slen=len;
 
 		ST* str=features[i].string;
 		for (int32_t j=0; j<len; j++)
@@ -2020,12 +2660,11 @@ bool CStringFeatures<ST>::obtain_from_char_features(CStringFeatures<CT>* sf, int
 	}
 
 	SG_DEBUG("translate: start=%i order=%i gap=%i(size:%i)\n", start, p_order, gap, sizeof(ST))
+	#pragma omp parallel for schedule(dynamic, 64) num_threads(num_threads)
 	for (int32_t line=0; line<num_vectors; line++)
 	{
-		int32_t len=0;
-		bool vfree;
-		ST* fv=get_feature_vector(line, len, vfree);
-		ASSERT(!vfree) // won't work when preprocessors are attached
+		int32_t len=features[line].slen;
+		ST* fv=features[line].string;
 
 		if (rev)
 			CAlphabet::translate_from_single_order_reversed(fv, len, start+gap, p_order+gap, max_val, gap);
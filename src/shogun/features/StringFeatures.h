@@ -355,23 +355,35 @@ template <class ST> class CStringFeatures : public CFeatures
 		 *
 		 * any subset is removed before
 		 *
+		 * the file is memory mapped, the record boundaries are indexed and
+		 * the records are parsed in parallel
+		 *
 		 * @param fname filename to load from
 		 * @param ignore_invalid if set to true, characters other than A,C,G,T are converted to A
+		 * @param packed if set to true, the sequences are stored 2-bit packed
+		 * (see pack())
 		 * @return if loading was successful
 		 */
-		bool load_fasta_file(const char* fname, bool ignore_invalid=false);
+		bool load_fasta_file(const char* fname, bool ignore_invalid=false,
+				bool packed=false);
 
 		/** load fastq file as string features
 		 *
 		 * removes subset beforehand
 		 *
+		 * the file is memory mapped, the record boundaries are indexed and
+		 * the records are parsed in parallel
+		 *
 		 * @param fname filename to load from
 		 * @param ignore_invalid if set to true, characters other than A,C,G,T are converted to A
 		 * @param bitremap_in_single_string if set to true, do binary embedding of symbols
+		 * @param packed if set to true, the reads are stored 2-bit packed
+		 * (see pack()), cannot be combined with bitremap_in_single_string
 		 * @return if loading was successful
 		 */
 		bool load_fastq_file(const char* fname,
-				bool ignore_invalid=false, bool bitremap_in_single_string=false);
+				bool ignore_invalid=false, bool bitremap_in_single_string=false,
+				bool packed=false);
 
 		/** load features from directory
 		 *
@@ -644,6 +656,85 @@ template <class ST> class CStringFeatures : public CFeatures
 		 */
 		virtual CFeatures* copy_subset(SGVector<index_t> indices);
 
+		/** @return number of bytes copy_subset() needs for the strings of
+		 * the active subset, -1 if the strings are not held in memory */
+		virtual int64_t get_subset_copy_size();
+
+		/** @return whether (some of) the strings are stored in one
+		 * contiguous arena */
+		bool has_arena() const { return string_arena!=NULL; }
+
+		/** move all strings into one contiguous arena, i.e. one buffer
+		 * holding the strings back to back, which replaces the separate
+		 * allocation of every string
+		 *
+		 * the strings stay accessible as before, strings set afterwards
+		 * are allocated separately again
+		 */
+		void move_to_arena();
+
+		/** @return whether the strings are stored 2-bit packed */
+		bool is_packed() const { return packed_offsets.vlen>0; }
+
+		/** store the strings 2-bit packed, i.e. as a single stream of
+		 * 32 symbols per 64-bit word (first symbol in the lowest bits)
+		 *
+		 * only possible for alphabets with 2 bit symbols (DNA, RNA, RAWDNA)
+		 * whose strings contain valid characters only. get_feature_vector()
+		 * returns unpacked copies of packed strings, methods that modify the
+		 * strings unpack them first.
+		 *
+		 * not possible with subset
+		 */
+		void pack();
+
+		/** store packed strings as one array per string again */
+		void unpack();
+
+		/** get packed string for selected example num
+		 *
+		 * possible with subset
+		 *
+		 * @param num index of the string
+		 * @param offset position of the first symbol in the packed stream
+		 * (returned)
+		 * @param len length of the string (returned)
+		 * @return packed stream, read symbols with get_packed_symbol() and
+		 * get_packed_word()
+		 */
+		uint64_t* get_packed_string(int32_t num, int64_t& offset, int32_t& len);
+
+		/** get a symbol of a packed stream
+		 *
+		 * @param packed packed stream
+		 * @param pos position of the symbol
+		 * @return 2-bit code of the symbol
+		 */
+		static inline uint8_t get_packed_symbol(const uint64_t* packed, int64_t pos)
+		{
+			return (packed[pos>>5]>>((pos&31)<<1)) & 3;
+		}
+
+		/** get 32 consecutive symbols of a packed stream
+		 *
+		 * symbols past the end of a string belong to the following strings
+		 * and have to be masked by the caller
+		 *
+		 * @param packed packed stream
+		 * @param pos position of the first symbol
+		 * @return word holding the symbols pos..pos+31, first in lowest bits
+		 */
+		static inline uint64_t get_packed_word(const uint64_t* packed, int64_t pos)
+		{
+			int64_t w=pos>>5;
+			int32_t shift=(pos&31)<<1;
+
+			if (!shift)
+				return packed[w];
+
+			return (packed[w]>>shift) | (packed[w+1]<<(64-shift));
+		}
+
 		/** @return object name */
 		virtual const char* get_name() const { return "StringFeatures"; }
 
@@ -663,6 +754,46 @@ template <class ST> class CStringFeatures : public CFeatures
 		 */
 		virtual ST* compute_feature_vector(int32_t num, int32_t& len);
 
+		/** allocate strings of the given lengths as views into one arena
+		 *
+		 * @param lengths lengths of the strings
+		 * @param num number of strings
+		 * @param arena the arena (returned)
+		 * @param arena_len length of the arena (returned)
+		 * @return strings pointing into the arena, NULL for empty strings
+		 */
+		static SGString<ST>* create_arena_strings(const int32_t* lengths,
+				int32_t num, ST*& arena, int64_t& arena_len);
+
+		/** @return whether str points into the arena, such strings must
+		 * not be freed on their own. empty strings of the arena are NULL,
+		 * see create_arena_strings() */
+		inline bool in_arena(const ST* str) const
+		{
+			return string_arena && str>=string_arena &&
+				str<string_arena+string_arena_len;
+		}
+
+		/** creates a packed copy of the given strings, see copy_subset()
+		 *
+		 * @param indices indices of the strings to copy
+		 * @return new packed CStringFeatures instance
+		 */
+		CFeatures* copy_packed_subset(SGVector<index_t> indices);
+
+		/** copies the strings of the arena into separate allocations and
+		 * frees the arena, as TParameter frees the strings one by one */
+		void release_arena();
+
+		/** releases the arena before the strings are replaced */
+		virtual void load_serializable_pre() throw (ShogunException);
+
+		/** unpacks the strings, the serialized form is always unpacked */
+		virtual void save_serializable_pre() throw (ShogunException);
+
+		/** packs the strings again if they were packed before saving */
+		virtual void save_serializable_post() throw (ShogunException);
+
 	private:
 		void init();
 
@@ -705,6 +836,23 @@ template <class ST> class CStringFeatures : public CFeatures
 
 		/** feature cache */
 		CCache<ST>* feature_cache;
+
+		/** 2-bit packed strings, one padding word at the end */
+		SGVector<uint64_t> packed_string;
+
+		/** position of the first symbol of each packed string in
+		 * packed_string, num_vectors+1 entries */
+		SGVector<int64_t> packed_offsets;
+
+		/** whether the strings were unpacked for saving */
+		bool repack_after_save;
+
+		/** strings stored back to back, not serialized as the strings
+		 * themselves are */
+		ST* string_arena;
+
+		/** length of the arena */
+		int64_t string_arena_len;
 };
 }
 #endif // _CSTRINGFEATURES__H__
@@ -24,8 +24,12 @@ CSubsetStack::CSubsetStack(const CSubsetStack& other)
 
 	for (int32_t i=0; i < other.m_active_subsets_stack->get_num_elements(); ++i)
 	{
-		m_active_subset=(CSubset*)other.m_active_subsets_stack->get_element(i);
-		m_active_subsets_stack->append_element(m_active_subset);
+		CSubset* subset=(CSubset*)other.m_active_subsets_stack->get_element(i);
+		m_active_subsets_stack->append_element(subset);
+
+		/* the reference of get_element is held by m_active_subset */
+		SG_UNREF(m_active_subset);
+		m_active_subset=subset;
 	}
 }
 
@@ -12,6 +12,7 @@
 #include <shogun/features/TOPFeatures.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/base/Parallel.h>
 
 using namespace shogun;
 
@@ -105,10 +106,10 @@ void CTOPFeatures::compute_feature_vector(
 	int32_t i,j,p=0,x=num;
 	int32_t idx=0;
 
-	float64_t posx=(poslinear) ?
-		(pos->linear_model_probability(x)) : (pos->model_probability(x));
-	float64_t negx=(neglinear) ?
-		(neg->linear_model_probability(x)) : (neg->model_probability(x));
+	float64_t posx=(pos_prob) ? pos_prob[x] : ((poslinear) ?
+		(pos->linear_model_probability(x)) : (pos->model_probability(x)));
+	float64_t negx=(neg_prob) ? neg_prob[x] : ((neglinear) ?
+		(neg->linear_model_probability(x)) : (neg->model_probability(x)));
 
 	len=get_num_features();
 
@@ -207,6 +208,7 @@ float64_t* CTOPFeatures::set_feature_matrix()
 	} ;
 
 	SG_INFO("calculating top feature matrix\n")
+	compute_model_probabilities();
 
 	for (int32_t x=0; x<num_vectors; x++)
 	{
@@ -218,6 +220,7 @@ float64_t* CTOPFeatures::set_feature_matrix()
 		compute_feature_vector(&feature_matrix[x*num_features], x, len);
 	}
 
+	free_model_probabilities();
 	SG_DONE()
 
 	num_vectors=get_num_vectors() ;
@@ -226,6 +229,43 @@ float64_t* CTOPFeatures::set_feature_matrix()
 	return feature_matrix.matrix;
 }
 
+void CTOPFeatures::compute_model_probabilities()
+{
+	CStringFeatures<uint16_t>* obs=pos->get_observations();
+	int32_t num=obs->get_num_vectors();
+	SG_UNREF(obs);
+
+	SGVector<index_t> idx(num);
+	idx.range_fill();
+
+	free_model_probabilities();
+	pos_prob=SG_MALLOC(float64_t, num);
+	neg_prob=SG_MALLOC(float64_t, num);
+	compute_model_probabilities(pos, poslinear, idx, pos_prob);
+	compute_model_probabilities(neg, neglinear, idx, neg_prob);
+}
+
+void CTOPFeatures::compute_model_probabilities(CHMM* hmm, bool linear,
+		SGVector<index_t> idx, float64_t* prob)
+{
+	if (linear)
+	{
+		#pragma omp parallel for num_threads(parallel->get_num_threads())
+		for (index_t i=0; i<idx.vlen; i++)
+			prob[i]=hmm->linear_model_probability(idx[i]);
+	}
+	else
+		hmm->get_log_likelihood(idx, SGVector<float64_t>(prob, idx.vlen, false));
+}
+
+void CTOPFeatures::free_model_probabilities()
+{
+	SG_FREE(pos_prob);
+	SG_FREE(neg_prob);
+	pos_prob=NULL;
+	neg_prob=NULL;
+}
+
 bool CTOPFeatures::compute_relevant_indizes(CHMM* hmm, T_HMM_INDIZES* hmm_idx)
 {
 	int32_t i=0;
@@ -364,6 +404,8 @@ void CTOPFeatures::init()
 	neg = NULL;
 	neglinear = false;
 	poslinear = false;
+	pos_prob = NULL;
+	neg_prob = NULL;
 
 	memset(&pos_relevant_indizes, 0, sizeof(pos_relevant_indizes));
 	memset(&neg_relevant_indizes, 0, sizeof(neg_relevant_indizes));
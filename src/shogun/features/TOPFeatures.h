@@ -135,6 +135,26 @@ class CTOPFeatures : public CDenseFeatures<float64_t>
 		 */
 		void compute_feature_vector(float64_t* addr, int32_t num, int32_t& len);
 
+		/** compute the model probabilities of all observations under both
+		 * HMMs in batches, they are used instead of the per observation
+		 * ones until free_model_probabilities() is called
+		 */
+		void compute_model_probabilities();
+
+		/** compute model probabilities of several observations
+		 *
+		 * @param hmm HMM
+		 * @param linear if hmm is a LinearHMM
+		 * @param idx indices of the observations
+		 * @param prob model probability of observation idx[i] is stored in
+		 * prob[i]
+		 */
+		void compute_model_probabilities(CHMM* hmm, bool linear,
+				SGVector<index_t> idx, float64_t* prob);
+
+		/** free the model probabilities */
+		void free_model_probabilities();
+
 	private:
 		void init();
 
@@ -147,6 +167,10 @@ class CTOPFeatures : public CDenseFeatures<float64_t>
 		bool neglinear;
 		/** if positive HMM is a LinearHMM */
 		bool poslinear;
+		/** positive prob */
+		float64_t* pos_prob;
+		/** negative prob */
+		float64_t* neg_prob;
 
 		/** positive relevant indices */
 		T_HMM_INDIZES pos_relevant_indizes;
@@ -59,6 +59,8 @@ void CStreamingAsciiFile::get_vector(sg_type*& vector, int32_t& num_feat)	\
 		char* ptr_item=NULL;												\
 		char* ptr_data=buffer;												\
 		DynArray<char*>* items=new DynArray<char*>();						\
+		/* the items live in the arena until the end of the call */		\
+		SGArenaScope items_scope(&m_items_arena);							\
 																			\
 		while (*ptr_data)													\
 		{																	\
@@ -99,7 +101,6 @@ void CStreamingAsciiFile::get_vector(sg_type*& vector, int32_t& num_feat)	\
 		{																	\
 				char* item=items->get_element(i);							\
 				vector[i]=conv(item);										\
-				SG_FREE(item);												\
 		}																	\
 		delete items;														\
 		SG_RESET_LOCALE;													\
@@ -182,6 +183,7 @@ GET_FLOAT_VECTOR(float64_t)
 				char* ptr_item=NULL;									\
 				char* ptr_data=buffer;									\
 				DynArray<char*>* items=new DynArray<char*>();			\
+				SGArenaScope items_scope(&m_items_arena);				\
 																		\
 				while (*ptr_data)										\
 				{														\
@@ -223,7 +225,6 @@ GET_FLOAT_VECTOR(float64_t)
 				{														\
 						char* item=items->get_element(i);				\
 						vector[i-1]=conv(item);							\
-						SG_FREE(item);									\
 				}														\
 				delete items;											\
 				num_feat--;												\
@@ -613,9 +614,9 @@ void CStreamingAsciiFile::append_item(
 		REQUIRE(ptr_data && ptr_item, "Data and Item to append should not be NULL\n");
 
 		size_t len=(ptr_data-ptr_item)/sizeof(char);
-		char* item=SG_MALLOC(char, len+1);
-		memset(item, 0, sizeof(char)*(len+1));
-		item=strncpy(item, ptr_item, len);
+		char* item=m_items_arena.allocate<char>(len+1);
+		memcpy(item, ptr_item, sizeof(char)*len);
+		item[len]='\0';
 
 		SG_DEBUG("current %c, len %d, item %s\n", *ptr_data, len, item)
 		items->append_element(item);
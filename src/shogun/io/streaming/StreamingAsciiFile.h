@@ -13,6 +13,7 @@
 #include <shogun/io/CSVFile.h>
 #include <shogun/io/streaming/StreamingFile.h>
 #include <shogun/features/SparseFeatures.h>
+#include <shogun/lib/MemoryArena.h>
 
 namespace shogun
 {
@@ -102,7 +103,8 @@ public:
 	}
 
 private:
-	/** helper function to read vectors / matrices
+	/** helper function to read vectors / matrices, the item is copied
+	 * into m_items_arena
 	 *
 	 * @param items dynamic array of values
 	 * @param ptr_data
@@ -115,6 +117,9 @@ private:
 
 	/** delimiter */
 	char m_delimiter;
+
+	/** holds the items of the line being parsed */
+	SGArena m_items_arena;
 };
 }
 #endif //__STREAMING_ASCIIFILE_H__
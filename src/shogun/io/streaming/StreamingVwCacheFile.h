@@ -14,6 +14,7 @@
 #include <shogun/classifier/vw/vw_common.h>
 #include <shogun/classifier/vw/cache/VwCacheReader.h>
 #include <shogun/classifier/vw/cache/VwNativeCacheReader.h>
+#include <shogun/classifier/vw/cache/VwChunkedCacheReader.h>
 
 namespace shogun
 {
@@ -40,7 +41,7 @@ public:
 	 * Constructor taking cache type
 	 * as an argument.
 	 *
-	 * @param cache_type cache type - C_NATIVE or C_PROTOBUF
+	 * @param cache_type cache type - C_NATIVE, C_PROTOBUF or C_CHUNKED
 	 */
 	CStreamingVwCacheFile(EVwCacheType cache_type);
 
@@ -49,7 +50,7 @@ public:
 	 *
 	 * @param fname file name
 	 * @param rw read/write mode
-	 * @param cache_type type of cache - C_NATIVE or C_PROTOBUF
+	 * @param cache_type type of cache - C_NATIVE, C_PROTOBUF or C_CHUNKED
 	 */
 	CStreamingVwCacheFile(char* fname, char rw='r', EVwCacheType cache_type = C_NATIVE);
 
@@ -0,0 +1,191 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society
+ */
+
+#include <shogun/kernel/ApproximateKernel.h>
+#include <shogun/kernel/normalizer/KernelNormalizer.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/lib/SGVector.h>
+
+using namespace shogun;
+
+CApproximateKernel::CApproximateKernel() : CKernel(0)
+{
+	init();
+}
+
+CApproximateKernel::CApproximateKernel(CKernel* kernel, int32_t dim)
+: CKernel(0)
+{
+	init();
+
+	REQUIRE(kernel, "No kernel to approximate given\n");
+	SG_REF(kernel);
+	m_kernel=kernel;
+	set_dim(dim);
+}
+
+CApproximateKernel::~CApproximateKernel()
+{
+	cleanup();
+	SG_UNREF(m_kernel);
+}
+
+void CApproximateKernel::init()
+{
+	m_kernel=NULL;
+	m_dim=0;
+	m_is_fitted=false;
+	properties|=KP_LINADD|KP_BATCHEVALUATION;
+
+	SG_ADD((CSGObject**) &m_kernel, "kernel", "Approximated kernel",
+			MS_AVAILABLE);
+	SG_ADD(&m_dim, "dim", "Dimension of the feature map", MS_AVAILABLE);
+	SG_ADD(&m_is_fitted, "is_fitted", "Whether the map was learned",
+			MS_NOT_AVAILABLE);
+}
+
+void CApproximateKernel::set_dim(int32_t dim)
+{
+	REQUIRE(dim>0, "Dimension of the feature map (%d) must be positive\n",
+			dim);
+	m_dim=dim;
+}
+
+CKernel* CApproximateKernel::get_kernel()
+{
+	SG_REF(m_kernel);
+	return m_kernel;
+}
+
+EFeatureClass CApproximateKernel::get_feature_class()
+{
+	return m_kernel ? m_kernel->get_feature_class() : C_ANY;
+}
+
+EFeatureType CApproximateKernel::get_feature_type()
+{
+	return m_kernel ? m_kernel->get_feature_type() : F_ANY;
+}
+
+bool CApproximateKernel::fit(CFeatures* data)
+{
+	REQUIRE(m_kernel, "No kernel to approximate set\n");
+	REQUIRE(data && data->get_num_vectors()>0, "No features to fit on\n");
+
+	m_is_fitted=fit_feature_map(data);
+	return m_is_fitted;
+}
+
+bool CApproximateKernel::init(CFeatures* l, CFeatures* r)
+{
+	if (!m_is_fitted && !fit(l))
+		return false;
+
+	CKernel::init(l, r);
+
+	m_lhs_map=compute_feature_map(l);
+	m_rhs_map=lhs_equals_rhs ? m_lhs_map : compute_feature_map(r);
+
+	return init_normalizer();
+}
+
+void CApproximateKernel::cleanup()
+{
+	delete_optimization();
+	m_lhs_map=SGMatrix<float64_t>();
+	m_rhs_map=SGMatrix<float64_t>();
+
+	CKernel::cleanup();
+}
+
+CDenseFeatures<float64_t>* CApproximateKernel::apply_feature_map(
+		CFeatures* data)
+{
+	if (!m_is_fitted)
+		fit(data);
+
+	return new CDenseFeatures<float64_t>(compute_feature_map(data));
+}
+
+float64_t CApproximateKernel::compute(int32_t idx_a, int32_t idx_b)
+{
+	return SGVector<float64_t>::dot(m_lhs_map.get_column_vector(idx_a),
+			m_rhs_map.get_column_vector(idx_b), m_lhs_map.num_rows);
+}
+
+void CApproximateKernel::clear_normal()
+{
+	m_normal=SGVector<float64_t>(m_lhs_map.num_rows);
+	m_normal.zero();
+	set_is_initialized(true);
+}
+
+void CApproximateKernel::add_to_normal(int32_t idx, float64_t weight)
+{
+	float64_t w=normalizer->normalize_lhs(weight, idx);
+	float64_t* z=m_lhs_map.get_column_vector(idx);
+	for (index_t k=0; k<m_normal.vlen; k++)
+		m_normal[k]+=w*z[k];
+
+	set_is_initialized(true);
+}
+
+bool CApproximateKernel::init_optimization(
+	int32_t num_suppvec, int32_t* sv_idx, float64_t* alphas)
+{
+	clear_normal();
+
+	for (int32_t i=0; i<num_suppvec; i++)
+		add_to_normal(sv_idx[i], alphas[i]);
+
+	return true;
+}
+
+bool CApproximateKernel::delete_optimization()
+{
+	m_normal=SGVector<float64_t>();
+	set_is_initialized(false);
+
+	return true;
+}
+
+float64_t CApproximateKernel::compute_optimized(int32_t idx)
+{
+	ASSERT(get_is_initialized())
+
+	float64_t result=SGVector<float64_t>::dot(m_normal.vector,
+			m_rhs_map.get_column_vector(idx), m_normal.vlen);
+	return normalizer->normalize_rhs(result, idx);
+}
+
+void CApproximateKernel::compute_batch(
+	int32_t num_vec, int32_t* vec_idx, float64_t* target,
+	int32_t num_suppvec, int32_t* IDX, float64_t* alphas, float64_t factor)
+{
+	ASSERT(m_lhs_map.matrix && m_rhs_map.matrix)
+
+	/* normal vector of the given support vectors */
+	SGVector<float64_t> normal(m_lhs_map.num_rows);
+	normal.zero();
+	for (int32_t i=0; i<num_suppvec; i++)
+	{
+		float64_t w=normalizer->normalize_lhs(alphas[i], IDX[i]);
+		float64_t* z=m_lhs_map.get_column_vector(IDX[i]);
+		for (index_t k=0; k<normal.vlen; k++)
+			normal[k]+=w*z[k];
+	}
+
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
+	for (int32_t i=0; i<num_vec; i++)
+	{
+		float64_t result=SGVector<float64_t>::dot(normal.vector,
+				m_rhs_map.get_column_vector(vec_idx[i]), normal.vlen);
+		target[i]+=factor*normalizer->normalize_rhs(result, vec_idx[i]);
+	}
+}
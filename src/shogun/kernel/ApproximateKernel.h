@@ -0,0 +1,210 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society
+ */
+
+#ifndef _APPROXIMATEKERNEL_H___
+#define _APPROXIMATEKERNEL_H___
+
+#include <shogun/lib/config.h>
+#include <shogun/lib/common.h>
+#include <shogun/kernel/Kernel.h>
+#include <shogun/lib/SGMatrix.h>
+
+namespace shogun
+{
+template <class T> class CDenseFeatures;
+
+/** @brief Base class of kernels that approximate another kernel by an
+ * explicit, finite dimensional feature map \f$z\f$, i.e.
+ *
+ * \f[
+ * k({\bf x},{\bf x'})\approx z({\bf x})\cdot z({\bf x'})
+ * \f]
+ *
+ * The map is learned by fit(). Unless fit() was called before, this is done
+ * on the left hand side features of the first init(). The map is kept when
+ * the kernel is initialised again later, e.g. with test data or with the
+ * support vectors only.
+ *
+ * Since the approximation is a kernel itself, it can replace the exact
+ * kernel of any kernel machine. Kernel evaluations then cost O(d) for a map
+ * of dimension d and outputs of kernel machines are computed by batch
+ * evaluation with the normal vector \f$w=\sum_i \alpha_i z({\bf x}_i)\f$,
+ * also in O(d) per example. CKernelRidgeRegression solves the problem in
+ * the feature space, which is linear in the number of training examples.
+ * apply_feature_map() returns the mapped features for linear machines.
+ */
+class CApproximateKernel : public CKernel
+{
+	public:
+		/** default constructor */
+		CApproximateKernel();
+
+		/** constructor
+		 *
+		 * @param kernel kernel to approximate
+		 * @param dim dimension of the feature map
+		 */
+		CApproximateKernel(CKernel* kernel, int32_t dim);
+
+		virtual ~CApproximateKernel();
+
+		/** initialize kernel, fits the feature map on l if it was not
+		 * fitted before and maps l and r
+		 *
+		 * @param l features of left-hand side
+		 * @param r features of right-hand side
+		 * @return if initializing was successful
+		 */
+		virtual bool init(CFeatures* l, CFeatures* r);
+
+		/** clean up kernel */
+		virtual void cleanup();
+
+		/** learn the feature map
+		 *
+		 * @param data features to learn the map on
+		 * @return if fitting was successful
+		 */
+		bool fit(CFeatures* data);
+
+		/** @return whether the feature map was learned */
+		bool is_fitted() const { return m_is_fitted; }
+
+		/** map features
+		 *
+		 * @param data features to map
+		 * @return mapped features, one vector per column
+		 */
+		virtual SGMatrix<float64_t> compute_feature_map(CFeatures* data)=0;
+
+		/** map features for use with linear machines, fits the map on data
+		 * if it was not fitted before
+		 *
+		 * @param data features to map
+		 * @return mapped features
+		 */
+		CDenseFeatures<float64_t>* apply_feature_map(CFeatures* data);
+
+		/** @return mapped left hand side features, one vector per column */
+		SGMatrix<float64_t> get_lhs_feature_map() const { return m_lhs_map; }
+
+		/** @return mapped right hand side features, one vector per column */
+		SGMatrix<float64_t> get_rhs_feature_map() const { return m_rhs_map; }
+
+		/** @return dimension of the feature map, which may be smaller than
+		 * the requested one after fitting */
+		virtual int32_t get_dim() const { return m_dim; }
+
+		/** @param dim dimension of the feature map, used by the next fit() */
+		void set_dim(int32_t dim);
+
+		/** @return approximated kernel */
+		CKernel* get_kernel();
+
+		/** return feature class the kernel can deal with
+		 *
+		 * @return feature class of the approximated kernel
+		 */
+		virtual EFeatureClass get_feature_class();
+
+		/** return feature type the kernel can deal with
+		 *
+		 * @return feature type of the approximated kernel
+		 */
+		virtual EFeatureType get_feature_type();
+
+		/** compute the normal vector in the feature space
+		 *
+		 * @param num_suppvec number of support vectors
+		 * @param sv_idx support vector index
+		 * @param alphas alphas
+		 * @return if optimization was successful
+		 */
+		virtual bool init_optimization(
+			int32_t num_suppvec, int32_t* sv_idx, float64_t* alphas);
+
+		/** delete optimization
+		 *
+		 * @return if deleting was successful
+		 */
+		virtual bool delete_optimization();
+
+		/** compute optimized
+		 *
+		 * @param idx index to compute
+		 * @return optimized value at given index
+		 */
+		virtual float64_t compute_optimized(int32_t idx);
+
+		/** clear normal vector */
+		virtual void clear_normal();
+
+		/** add to normal vector
+		 *
+		 * @param idx where to add
+		 * @param weight what to add
+		 */
+		virtual void add_to_normal(int32_t idx, float64_t weight);
+
+		/** computes the outputs of all given rhs examples with the normal
+		 * vector of the given support vectors, in parallel
+		 *
+		 * @param num_vec number of vectors
+		 * @param vec_idx indices of rhs vectors
+		 * @param target outputs are added here
+		 * @param num_suppvec number of support vectors
+		 * @param IDX support vector indices
+		 * @param alphas support vector weights
+		 * @param factor factor of the outputs
+		 */
+		virtual void compute_batch(
+			int32_t num_vec, int32_t* vec_idx, float64_t* target,
+			int32_t num_suppvec, int32_t* IDX, float64_t* alphas,
+			float64_t factor=1.0);
+
+	protected:
+		/** learn the feature map
+		 *
+		 * @param data features to learn the map on
+		 * @return if fitting was successful
+		 */
+		virtual bool fit_feature_map(CFeatures* data)=0;
+
+		/** compute kernel function for features a and b
+		 *
+		 * @param idx_a index of feature vector a
+		 * @param idx_b index of feature vector b
+		 * @return computed kernel function
+		 */
+		virtual float64_t compute(int32_t idx_a, int32_t idx_b);
+
+	private:
+		void init();
+
+	protected:
+		/** approximated kernel */
+		CKernel* m_kernel;
+
+		/** requested dimension of the feature map */
+		int32_t m_dim;
+
+		/** whether the map was learned */
+		bool m_is_fitted;
+
+		/** mapped lhs features */
+		SGMatrix<float64_t> m_lhs_map;
+
+		/** mapped rhs features */
+		SGMatrix<float64_t> m_rhs_map;
+
+		/** normal vector in the feature space */
+		SGVector<float64_t> m_normal;
+};
+}
+#endif /* _APPROXIMATEKERNEL_H___ */
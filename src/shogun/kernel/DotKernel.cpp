@@ -0,0 +1,147 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Written (W) 2009 Soeren Sonnenburg
+ * Copyright (C) 2010 Berlin Institute of Technology
+ */
+
+#include <shogun/kernel/DotKernel.h>
+#include <shogun/kernel/normalizer/KernelNormalizer.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/lib/SGVector.h>
+
+using namespace shogun;
+
+/** number of test vectors scored together */
+#define DOTKERNEL_BATCH_VECTORS 64
+/** bytes of support vectors scored together, fits into the L2 cache */
+#define DOTKERNEL_BATCH_BYTES (256*1024)
+
+void CDotKernel::compute_batch(
+	int32_t num_vec, int32_t* vec_idx, float64_t* target,
+	int32_t num_suppvec, int32_t* IDX, float64_t* alphas, float64_t factor)
+{
+	ASSERT(lhs && rhs)
+	ASSERT(vec_idx && target)
+
+	if (num_vec<=0 || num_suppvec<=0)
+		return;
+
+	CDotFeatures* lf=(CDotFeatures*) lhs;
+	CDotFeatures* rf=(CDotFeatures*) rhs;
+	bool dense=lhs->get_feature_class()==C_DENSE &&
+		lhs->get_feature_type()==F_DREAL &&
+		rhs->get_feature_class()==C_DENSE &&
+		rhs->get_feature_type()==F_DREAL;
+
+	int32_t dim=lf->get_dim_feature_space();
+	int32_t sv_block=CMath::max(16,
+			(int32_t) (DOTKERNEL_BATCH_BYTES/sizeof(float64_t)/CMath::max(dim, 1)));
+	sv_block=CMath::min(sv_block, num_suppvec);
+
+	/* support vectors are shared by all threads */
+	float64_t** sv=NULL;
+	bool* sv_free=NULL;
+	if (dense)
+	{
+		sv=SG_MALLOC(float64_t*, num_suppvec);
+		sv_free=SG_MALLOC(bool, num_suppvec);
+		for (int32_t j=0; j<num_suppvec; j++)
+		{
+			int32_t len;
+			sv[j]=((CDenseFeatures<float64_t>*) lhs)->get_feature_vector(IDX[j],
+					len, sv_free[j]);
+		}
+	}
+
+	int32_t num_blocks=(num_vec+DOTKERNEL_BATCH_VECTORS-1)/DOTKERNEL_BATCH_VECTORS;
+
+	#pragma omp parallel for schedule(dynamic) num_threads(parallel->get_num_threads())
+	for (int32_t b=0; b<num_blocks; b++)
+	{
+		int32_t start=b*DOTKERNEL_BATCH_VECTORS;
+		int32_t n=CMath::min(DOTKERNEL_BATCH_VECTORS, num_vec-start);
+		int32_t* idx=&vec_idx[start];
+
+		float64_t* values=SG_MALLOC(float64_t, sv_block);
+		float64_t* sums=SG_CALLOC(float64_t, n);
+		float64_t* vec[DOTKERNEL_BATCH_VECTORS];
+		bool vec_free[DOTKERNEL_BATCH_VECTORS];
+
+		if (dense)
+		{
+			for (int32_t i=0; i<n; i++)
+			{
+				int32_t len;
+				vec[i]=((CDenseFeatures<float64_t>*) rhs)->get_feature_vector(
+						idx[i], len, vec_free[i]);
+			}
+		}
+
+		/* the block of support vectors stays in cache while all test
+		 * vectors of the block are scored against it */
+		for (int32_t s=0; s<num_suppvec; s+=sv_block)
+		{
+			int32_t ns=CMath::min(sv_block, num_suppvec-s);
+
+			for (int32_t i=0; i<n; i++)
+			{
+				if (dense)
+				{
+					for (int32_t j=0; j<ns; j++)
+						values[j]=SGVector<float64_t>::dot(sv[s+j], vec[i], dim);
+				}
+				else
+				{
+					for (int32_t j=0; j<ns; j++)
+						values[j]=lf->dot(IDX[s+j], rf, idx[i]);
+				}
+
+				dot_to_kernel(values, ns, &IDX[s], idx[i]);
+
+				float64_t sum=0;
+				for (int32_t j=0; j<ns; j++)
+					sum+=alphas[s+j]*normalizer->normalize(values[j], IDX[s+j], idx[i]);
+
+				sums[i]+=sum;
+			}
+		}
+
+		for (int32_t i=0; i<n; i++)
+			target[start+i]+=factor*sums[i];
+
+		if (dense)
+		{
+			for (int32_t i=0; i<n; i++)
+			{
+				((CDenseFeatures<float64_t>*) rhs)->free_feature_vector(vec[i],
+						idx[i], vec_free[i]);
+			}
+		}
+
+		SG_FREE(values);
+		SG_FREE(sums);
+	}
+
+	if (dense)
+	{
+		for (int32_t j=0; j<num_suppvec; j++)
+		{
+			((CDenseFeatures<float64_t>*) lhs)->free_feature_vector(sv[j], IDX[j],
+					sv_free[j]);
+		}
+	}
+
+	SG_FREE(sv);
+	SG_FREE(sv_free);
+}
+
+void CDotKernel::dot_to_kernel(float64_t* values, int32_t num,
+		int32_t* lhs_idx, int32_t rhs_idx)
+{
+	SG_ERROR("%s does not support batch evaluation\n", get_name())
+}
@@ -109,7 +109,42 @@ class CDotKernel : public CKernel
 		 */
 		virtual EKernelType get_kernel_type()=0 ;
 
+		/** compute target[i]+=factor*sum_j alphas[j]*k(IDX[j], vec_idx[i])
+		 *
+		 * Test vectors are processed in blocks in parallel. Each block is
+		 * scored against cache sized blocks of support vectors, so that a
+		 * block of support vectors is read from memory once per block of
+		 * test vectors instead of once per test vector. Dot products of
+		 * dense real valued features are computed directly on the feature
+		 * vectors, other features use CDotFeatures::dot(). Only kernels
+		 * implementing dot_to_kernel() can be evaluated this way, they
+		 * announce it with the KP_BATCHEVALUATION property.
+		 *
+		 * @param num_vec number of test vectors
+		 * @param vec_idx indices of the test vectors (rhs)
+		 * @param target outputs the results are added to
+		 * @param num_suppvec number of support vectors
+		 * @param IDX indices of the support vectors (lhs)
+		 * @param alphas weights of the support vectors
+		 * @param factor factor the results are multiplied with
+		 */
+		virtual void compute_batch(
+			int32_t num_vec, int32_t* vec_idx, float64_t* target,
+			int32_t num_suppvec, int32_t* IDX, float64_t* alphas,
+			float64_t factor=1.0);
+
 	protected:
+		/** turn dot products between lhs vectors and one rhs vector into
+		 * (unnormalized) kernel values, used by compute_batch()
+		 *
+		 * @param values dot products, overwritten by the kernel values
+		 * @param num number of values
+		 * @param lhs_idx indices of the lhs vectors
+		 * @param rhs_idx index of the rhs vector
+		 */
+		virtual void dot_to_kernel(float64_t* values, int32_t num,
+				int32_t* lhs_idx, int32_t rhs_idx);
+
 		/** compute kernel function for features a and b
 		 * idx_{a,b} denote the index of the feature vectors
 		 * in the corresponding feature object
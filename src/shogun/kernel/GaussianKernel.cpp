@@ -128,6 +128,33 @@ float64_t CGaussianKernel::compute(int32_t idx_a, int32_t idx_b)
 	return result_multiplier*exp(-result/width);
 }
 
+void CGaussianKernel::dot_to_kernel(float64_t* values, int32_t num,
+		int32_t* lhs_idx, int32_t rhs_idx)
+{
+	int32_t power=0;
+	if (m_compact)
+	{
+		int32_t len_features=((CDenseFeatures<float64_t>*) lhs)->get_num_features();
+		power=(len_features%2==0) ? (len_features+1):len_features;
+	}
+
+	for (int32_t i=0; i<num; i++)
+	{
+		float64_t result=sq_lhs[lhs_idx[i]]+sq_rhs[rhs_idx]-2*values[i];
+		values[i]=CMath::exp(-result/width);
+
+		if (m_compact)
+		{
+			float64_t result_multiplier=1-(sqrt(result/width))/3;
+
+			if (result_multiplier<=0)
+				values[i]=0;
+			else
+				values[i]*=pow(result_multiplier, power);
+		}
+	}
+}
+
 void CGaussianKernel::load_serializable_post() throw (ShogunException)
 {
 	CKernel::load_serializable_post();
@@ -178,6 +205,7 @@ void CGaussianKernel::init()
 	set_compact_enabled(false);
 	sq_lhs=NULL;
 	sq_rhs=NULL;
+	properties|=KP_BATCHEVALUATION;
 	SG_ADD(&width, "width", "Kernel width", MS_AVAILABLE, GRADIENT_AVAILABLE);
 	SG_ADD(&m_compact, "compact", "Compact enabled option", MS_AVAILABLE);
 }
@@ -145,6 +145,16 @@ class CGaussianKernel: public CDotKernel
 		 */
 		virtual float64_t compute(int32_t idx_a, int32_t idx_b);
 
+		/** turn dot products into kernel values for compute_batch()
+		 *
+		 * @param values dot products, overwritten by the kernel values
+		 * @param num number of values
+		 * @param lhs_idx indices of the lhs vectors
+		 * @param rhs_idx index of the rhs vector
+		 */
+		virtual void dot_to_kernel(float64_t* values, int32_t num,
+				int32_t* lhs_idx, int32_t rhs_idx);
+
 		/** Can (optionally) be overridden to post-initialize some member
 		 * variables which are not PARAMETER::ADD'ed. Make sure that at first
 		 * the overridden method BASE_CLASS::LOAD_SERIALIZABLE_POST is called.
@@ -79,6 +79,9 @@ float64_t CGaussianShiftKernel::compute(int32_t idx_a, int32_t idx_b)
 
 void CGaussianShiftKernel::init()
 {
+	/* the shifted distances are not a function of the dot product */
+	properties&=((uint64_t) -1)^KP_BATCHEVALUATION;
+
 	SG_ADD(&max_shift, "max_shift", "Maximum shift.", MS_AVAILABLE);
 	SG_ADD(&shift_step, "shift_step", "Shift stepsize.", MS_AVAILABLE);
 }
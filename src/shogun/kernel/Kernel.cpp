@@ -565,6 +565,17 @@ void CKernel::kernel_cache_cleanup()
 	memset(&kernel_cache, 0x0, sizeof(KERNEL_CACHE));
 }
 
+int64_t CKernel::get_unregistered_memory_footprint()
+{
+	int64_t bytes=0;
+#ifdef USE_SVMLIGHT
+	if (kernel_cache.buffer)
+		bytes+=kernel_cache.buffsize*sizeof(KERNELCACHE_ELEM);
+#endif //USE_SVMLIGHT
+
+	return bytes;
+}
+
 int32_t CKernel::kernel_cache_malloc()
 {
   int32_t i;
@@ -762,6 +773,8 @@ void CKernel::list_kernel()
 		ENUM_CASE(K_LINEARARD)
 		ENUM_CASE(K_GAUSSIANARD)
 		ENUM_CASE(K_STREAMING)
+		ENUM_CASE(K_NYSTROM)
+		ENUM_CASE(K_RANDOMFOURIER)
 	}
 
 	switch (get_feature_class())
@@ -1078,7 +1091,25 @@ SGMatrix<T> CKernel::get_kernel_matrix()
 	result=SG_MALLOC(T, total_num);
 
 	int32_t num_threads=parallel->get_num_threads();
-	if (num_threads < 2)
+	if (has_property(KP_ROWEVALUATION) && m>0)
+	{
+		/* the first row sets up what the kernel needs for computing rows,
+		 * the others are computed in parallel */
+		SGVector<float64_t> first=get_kernel_row(0);
+		ASSERT(first.vlen==n)
+		for (int32_t j=0; j<n; j++)
+			result[int64_t(j)*m]=(T) first[j];
+
+		#pragma omp parallel for schedule(dynamic) num_threads(num_threads)
+		for (int32_t i=1; i<m; i++)
+		{
+			SGVector<float64_t> row=get_kernel_row(i);
+
+			for (int32_t j=0; j<n; j++)
+				result[i+int64_t(j)*m]=(T) row[j];
+		}
+	}
+	else if (num_threads < 2)
 	{
 		K_THREAD_PARAM<T> params;
 		params.kernel=this;
@@ -111,7 +111,9 @@ enum EKernelType
 	K_PRODUCT = 490,
 	K_LINEARARD = 500,
 	K_GAUSSIANARD = 510,
-	K_STREAMING = 520
+	K_STREAMING = 520,
+	K_NYSTROM = 530,
+	K_RANDOMFOURIER = 540
 };
 
 /** kernel property */
@@ -120,7 +122,8 @@ enum EKernelProperty
 	KP_NONE = 0,
 	KP_LINADD = 1,	// Kernels that can be optimized via doing normal updates w + dw
 	KP_KERNCOMBINATION = 2,	// Kernels that are infact a linear combination of subkernels K=\sum_i b_i*K_i
-	KP_BATCHEVALUATION = 4  // Kernels that can on the fly generate normals in linadd and more quickly/memory efficient process batches instead of single examples
+	KP_BATCHEVALUATION = 4,  // Kernels that can on the fly generate normals in linadd and more quickly/memory efficient process batches instead of single examples
+	KP_ROWEVALUATION = 8  // Kernels whose get_kernel_row() computes a whole row faster than one kernel() call per entry
 };
 
 class CSVM;
@@ -271,6 +274,9 @@ class CKernel : public CSGObject
 		/**
 		 * get row i
 		 *
+		 * kernels with property KP_ROWEVALUATION override this to compute
+		 * the whole row at once, get_kernel_matrix() then works row by row
+		 *
 		 * @return the ith row of the kernel matrix
 		 */
 		virtual SGVector<float64_t> get_kernel_row(int32_t i)
@@ -703,6 +709,9 @@ class CKernel : public CSGObject
 		 */
 		static CKernel* obtain_from_generic(CSGObject* kernel);
 	protected:
+		/** @return bytes held by the kernel cache */
+		virtual int64_t get_unregistered_memory_footprint();
+
 		/** set property
 		 *
 		 * @param p kernel property to set
@@ -0,0 +1,182 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society
+ */
+
+#include <shogun/kernel/NystromKernel.h>
+
+#ifdef HAVE_EIGEN3
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/lib/SGVector.h>
+
+using namespace shogun;
+using namespace Eigen;
+
+CNystromKernel::CNystromKernel() : CApproximateKernel()
+{
+	init_approximation();
+}
+
+CNystromKernel::CNystromKernel(CKernel* kernel, int32_t num_landmarks,
+		ELandmarkSelection selection)
+: CApproximateKernel(kernel, num_landmarks)
+{
+	init_approximation();
+	m_selection=selection;
+}
+
+CNystromKernel::~CNystromKernel()
+{
+	SG_UNREF(m_landmarks);
+}
+
+void CNystromKernel::init_approximation()
+{
+	m_selection=LS_UNIFORM;
+	m_landmarks=NULL;
+
+	SG_ADD((machine_int_t*) &m_selection, "selection",
+			"How landmarks are chosen", MS_NOT_AVAILABLE);
+	SG_ADD((CSGObject**) &m_landmarks, "landmarks", "Landmarks",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_landmark_indices, "landmark_indices", "Indices of landmarks",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_projection, "projection", "Projection of kernel values",
+			MS_NOT_AVAILABLE);
+}
+
+int32_t CNystromKernel::get_dim() const
+{
+	return m_is_fitted ? m_projection.num_rows : m_dim;
+}
+
+SGVector<index_t> CNystromKernel::select_farthest_points(CFeatures* data,
+		index_t num)
+{
+	index_t num_vectors=data->get_num_vectors();
+	m_kernel->init(data, data);
+
+	SGVector<float64_t> diag(num_vectors);
+	SGVector<float64_t> min_dist(num_vectors);
+	for (index_t i=0; i<num_vectors; i++)
+	{
+		diag[i]=m_kernel->kernel(i, i);
+		min_dist[i]=CMath::INFTY;
+	}
+
+	SGVector<index_t> landmarks(num);
+	landmarks[0]=CMath::random(0, num_vectors-1);
+	for (index_t l=1; l<num; l++)
+	{
+		index_t last=landmarks[l-1];
+
+		#pragma omp parallel for num_threads(parallel->get_num_threads())
+		for (index_t i=0; i<num_vectors; i++)
+		{
+			float64_t dist=diag[i]+diag[last]-2*m_kernel->kernel(last, i);
+			min_dist[i]=CMath::min(min_dist[i], dist);
+		}
+		min_dist[last]=-1;
+
+		landmarks[l]=SGVector<float64_t>::arg_max(min_dist.vector, 1,
+				num_vectors);
+		min_dist[landmarks[l]]=-1;
+	}
+
+	m_kernel->remove_lhs_and_rhs();
+	return landmarks;
+}
+
+bool CNystromKernel::fit_feature_map(CFeatures* data)
+{
+	index_t num_vectors=data->get_num_vectors();
+	index_t num=CMath::min(m_dim, num_vectors);
+
+	if (m_selection==LS_FARTHEST_POINT)
+		m_landmark_indices=select_farthest_points(data, num);
+	else
+	{
+		SGVector<index_t> perm(num_vectors);
+		perm.range_fill();
+		perm.permute();
+
+		m_landmark_indices=SGVector<index_t>(num);
+		for (index_t i=0; i<num; i++)
+			m_landmark_indices[i]=perm[i];
+	}
+
+	/* copy_subset returns a referenced object */
+	SG_UNREF(m_landmarks);
+	m_landmarks=data->copy_subset(m_landmark_indices);
+
+	m_kernel->init(m_landmarks, m_landmarks);
+	SGMatrix<float64_t> landmark_kernel=m_kernel->get_kernel_matrix();
+	m_kernel->remove_lhs_and_rhs();
+
+	Map<MatrixXd> K(landmark_kernel.matrix, num, num);
+	SelfAdjointEigenSolver<MatrixXd> solver(K);
+	if (solver.info()!=Success)
+	{
+		SG_WARNING("Eigendecomposition of the landmark kernel matrix failed\n")
+		return false;
+	}
+
+	/* eigenvalues are in increasing order, drop the (numerically) zero ones */
+	VectorXd eigenvalues=solver.eigenvalues();
+	float64_t max_eigenvalue=eigenvalues[num-1];
+	index_t first=0;
+	while (first<num && eigenvalues[first]<=max_eigenvalue*1e-10)
+		first++;
+
+	index_t dim=num-first;
+	REQUIRE(dim>0, "Kernel matrix of the landmarks is zero\n");
+
+	m_projection=SGMatrix<float64_t>(dim, num);
+	for (index_t k=0; k<dim; k++)
+	{
+		float64_t scale=1.0/CMath::sqrt(eigenvalues[first+k]);
+		for (index_t l=0; l<num; l++)
+			m_projection(k, l)=scale*solver.eigenvectors()(l, first+k);
+	}
+
+	SG_DEBUG("Nystrom map with %d of %d landmark dimensions\n", dim, num)
+	return true;
+}
+
+SGMatrix<float64_t> CNystromKernel::compute_feature_map(CFeatures* data)
+{
+	REQUIRE(m_is_fitted, "Feature map was not fitted\n");
+
+	index_t num_vectors=data->get_num_vectors();
+	index_t num_landmarks=m_projection.num_cols;
+	index_t dim=m_projection.num_rows;
+	SGMatrix<float64_t> result(dim, num_vectors);
+
+	m_kernel->init(m_landmarks, data);
+
+	#pragma omp parallel num_threads(parallel->get_num_threads())
+	{
+		SGVector<float64_t> kernel_values(num_landmarks);
+		Map<MatrixXd> P(m_projection.matrix, dim, num_landmarks);
+		Map<VectorXd> k(kernel_values.vector, num_landmarks);
+
+		#pragma omp for schedule(dynamic, 64)
+		for (index_t i=0; i<num_vectors; i++)
+		{
+			for (index_t l=0; l<num_landmarks; l++)
+				kernel_values[l]=m_kernel->kernel(l, i);
+
+			Map<VectorXd> z(result.get_column_vector(i), dim);
+			z=P*k;
+		}
+	}
+
+	m_kernel->remove_lhs_and_rhs();
+	return result;
+}
+#endif /* HAVE_EIGEN3 */
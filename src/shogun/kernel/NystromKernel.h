@@ -0,0 +1,134 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society
+ */
+
+#ifndef _NYSTROMKERNEL_H___
+#define _NYSTROMKERNEL_H___
+
+#include <shogun/lib/config.h>
+
+#ifdef HAVE_EIGEN3
+#include <shogun/kernel/ApproximateKernel.h>
+
+namespace shogun
+{
+
+/** how landmarks of CNystromKernel are chosen */
+enum ELandmarkSelection
+{
+	/** uniformly at random */
+	LS_UNIFORM=0,
+	/** greedily the example farthest (in the feature space of the kernel)
+	 * from all landmarks chosen so far */
+	LS_FARTHEST_POINT=1
+};
+
+/** @brief Nystrom approximation of an arbitrary kernel.
+ *
+ * For m landmarks \f${\bf l}_1,\dots,{\bf l}_m\f$ taken from the training
+ * data and the eigendecomposition \f$K_{mm}=U\Lambda U^T\f$ of their kernel
+ * matrix, the feature map is
+ *
+ * \f[
+ * z({\bf x})=\Lambda^{-1/2}U^T\left(k({\bf l}_1,{\bf x}),\dots,
+ * k({\bf l}_m,{\bf x})\right)^T
+ * \f]
+ *
+ * so \f$z({\bf x})\cdot z({\bf x'})\f$ is the kernel projected onto the span
+ * of the landmarks. Eigenvalues close to zero are dropped, so the map may
+ * have less than m dimensions. Mapping an example costs m evaluations of
+ * the approximated kernel.
+ */
+class CNystromKernel : public CApproximateKernel
+{
+	public:
+		/** default constructor */
+		CNystromKernel();
+
+		/** constructor
+		 *
+		 * @param kernel kernel to approximate
+		 * @param num_landmarks number of landmarks
+		 * @param selection how landmarks are chosen
+		 */
+		CNystromKernel(CKernel* kernel, int32_t num_landmarks,
+				ELandmarkSelection selection=LS_UNIFORM);
+
+		virtual ~CNystromKernel();
+
+		/** map features
+		 *
+		 * @param data features to map
+		 * @return mapped features, one vector per column
+		 */
+		virtual SGMatrix<float64_t> compute_feature_map(CFeatures* data);
+
+		/** @return dimension of the feature map */
+		virtual int32_t get_dim() const;
+
+		/** @param selection how landmarks are chosen by the next fit() */
+		void set_landmark_selection(ELandmarkSelection selection)
+		{
+			m_selection=selection;
+		}
+
+		/** @return how landmarks are chosen */
+		ELandmarkSelection get_landmark_selection() const
+		{
+			return m_selection;
+		}
+
+		/** @return indices of the landmarks in the features fitted on */
+		SGVector<index_t> get_landmark_indices() const
+		{
+			return m_landmark_indices;
+		}
+
+		/** return what type of kernel we are
+		 *
+		 * @return kernel type NYSTROM
+		 */
+		virtual EKernelType get_kernel_type() { return K_NYSTROM; }
+
+		/** @return name of the SGSerializable */
+		virtual const char* get_name() const { return "NystromKernel"; }
+
+	protected:
+		/** choose landmarks and compute the projection
+		 *
+		 * @param data features to choose landmarks from
+		 * @return if fitting was successful
+		 */
+		virtual bool fit_feature_map(CFeatures* data);
+
+		/** @return landmarks chosen greedily by distance
+		 *
+		 * @param data features to choose from
+		 * @param num number of landmarks
+		 */
+		SGVector<index_t> select_farthest_points(CFeatures* data, index_t num);
+
+	private:
+		void init_approximation();
+
+	protected:
+		/** how landmarks are chosen */
+		ELandmarkSelection m_selection;
+
+		/** landmarks */
+		CFeatures* m_landmarks;
+
+		/** indices of the landmarks */
+		SGVector<index_t> m_landmark_indices;
+
+		/** \f$\Lambda^{-1/2}U^T\f$ */
+		SGMatrix<float64_t> m_projection;
+};
+}
+#endif /* HAVE_EIGEN3 */
+#endif /* _NYSTROMKERNEL_H___ */
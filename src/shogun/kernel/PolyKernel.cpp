@@ -65,8 +65,23 @@ float64_t CPolyKernel::compute(int32_t idx_a, int32_t idx_b)
 	return CMath::pow(result, degree);
 }
 
+void CPolyKernel::dot_to_kernel(float64_t* values, int32_t num,
+		int32_t* lhs_idx, int32_t rhs_idx)
+{
+	for (int32_t i=0; i<num; i++)
+	{
+		float64_t result=values[i];
+
+		if (inhomogene)
+			result+=1;
+
+		values[i]=CMath::pow(result, degree);
+	}
+}
+
 void CPolyKernel::init()
 {
+	properties|=KP_BATCHEVALUATION;
 	set_normalizer(new CSqrtDiagKernelNormalizer());
 	SG_ADD(&degree, "degree", "Degree of polynomial kernel", MS_AVAILABLE);
 	SG_ADD(&inhomogene, "inhomogene", "If kernel is inhomogeneous.",
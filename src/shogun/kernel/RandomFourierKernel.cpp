@@ -0,0 +1,93 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society
+ */
+
+#include <shogun/kernel/RandomFourierKernel.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/features/DotFeatures.h>
+#include <shogun/mathematics/Math.h>
+
+using namespace shogun;
+
+CRandomFourierKernel::CRandomFourierKernel() : CApproximateKernel()
+{
+	init_approximation();
+}
+
+CRandomFourierKernel::CRandomFourierKernel(CKernel* kernel, int32_t dim)
+: CApproximateKernel(kernel, dim)
+{
+	init_approximation();
+	REQUIRE(kernel->get_kernel_type()==K_GAUSSIAN, "Random Fourier features "
+			"are only available for the Gaussian kernel, not for %s\n",
+			kernel->get_name());
+}
+
+CRandomFourierKernel::~CRandomFourierKernel()
+{
+}
+
+void CRandomFourierKernel::init_approximation()
+{
+	SG_ADD(&m_frequencies, "frequencies", "Random frequencies",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_phases, "phases", "Random phases", MS_NOT_AVAILABLE);
+}
+
+bool CRandomFourierKernel::fit_feature_map(CFeatures* data)
+{
+	CDotFeatures* features=dynamic_cast<CDotFeatures*>(data);
+	REQUIRE(features, "Random Fourier features need CDotFeatures, not %s\n",
+			data->get_name());
+
+	index_t num_features=features->get_dim_feature_space();
+	float64_t width=((CGaussianKernel*) m_kernel)->get_width();
+	float64_t std_dev=CMath::sqrt(2.0/width);
+
+	m_frequencies=SGMatrix<float64_t>(num_features, m_dim);
+	for (index_t i=0; i<num_features*m_dim; i++)
+		m_frequencies.matrix[i]=CMath::normal_random(0.0, std_dev);
+
+	m_phases=SGVector<float64_t>(m_dim);
+	for (index_t k=0; k<m_dim; k++)
+		m_phases[k]=CMath::random(0.0, 2*M_PI);
+
+	return true;
+}
+
+SGMatrix<float64_t> CRandomFourierKernel::compute_feature_map(CFeatures* data)
+{
+	REQUIRE(m_is_fitted, "Feature map was not fitted\n");
+
+	CDotFeatures* features=dynamic_cast<CDotFeatures*>(data);
+	REQUIRE(features, "Random Fourier features need CDotFeatures, not %s\n",
+			data->get_name());
+	REQUIRE(features->get_dim_feature_space()==m_frequencies.num_rows,
+			"Dimension of features (%d) differs from the one fitted on (%d)\n",
+			features->get_dim_feature_space(), m_frequencies.num_rows);
+
+	index_t num_vectors=features->get_num_vectors();
+	index_t dim=m_frequencies.num_cols;
+	float64_t scale=CMath::sqrt(2.0/dim);
+	SGMatrix<float64_t> result(dim, num_vectors);
+
+	#pragma omp parallel for num_threads(parallel->get_num_threads()) \
+		schedule(dynamic, 64)
+	for (index_t i=0; i<num_vectors; i++)
+	{
+		float64_t* z=result.get_column_vector(i);
+		for (index_t k=0; k<dim; k++)
+		{
+			float64_t projection=features->dense_dot(i,
+					m_frequencies.get_column_vector(k), m_frequencies.num_rows);
+			z[k]=scale*CMath::cos(projection+m_phases[k]);
+		}
+	}
+
+	return result;
+}
@@ -0,0 +1,90 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society
+ */
+
+#ifndef _RANDOMFOURIERKERNEL_H___
+#define _RANDOMFOURIERKERNEL_H___
+
+#include <shogun/lib/config.h>
+#include <shogun/kernel/ApproximateKernel.h>
+
+namespace shogun
+{
+
+/** @brief Random Fourier feature approximation of the Gaussian kernel on
+ * CDotFeatures (Rahimi and Recht, 2007).
+ *
+ * For the Gaussian kernel \f$k({\bf x},{\bf x'})=
+ * \exp(-\|{\bf x}-{\bf x'}\|^2/w)\f$ of width w, d frequencies
+ * \f${\bf \omega}_k\sim N(0, \frac{2}{w}I)\f$ and phases
+ * \f$b_k\sim U[0,2\pi]\f$ are drawn and the feature map is
+ *
+ * \f[
+ * z_k({\bf x})=\sqrt{\frac{2}{d}}\cos({\bf \omega}_k\cdot{\bf x}+b_k)
+ * \f]
+ *
+ * Fitting only needs the dimension of the features, mapping an example
+ * costs d dot products with it.
+ */
+class CRandomFourierKernel : public CApproximateKernel
+{
+	public:
+		/** default constructor */
+		CRandomFourierKernel();
+
+		/** constructor
+		 *
+		 * @param kernel CGaussianKernel to approximate
+		 * @param dim number of random features
+		 */
+		CRandomFourierKernel(CKernel* kernel, int32_t dim);
+
+		virtual ~CRandomFourierKernel();
+
+		/** map features
+		 *
+		 * @param data CDotFeatures to map
+		 * @return mapped features, one vector per column
+		 */
+		virtual SGMatrix<float64_t> compute_feature_map(CFeatures* data);
+
+		/** @return frequencies, one per column */
+		SGMatrix<float64_t> get_frequencies() const { return m_frequencies; }
+
+		/** @return phases */
+		SGVector<float64_t> get_phases() const { return m_phases; }
+
+		/** return what type of kernel we are
+		 *
+		 * @return kernel type RANDOMFOURIER
+		 */
+		virtual EKernelType get_kernel_type() { return K_RANDOMFOURIER; }
+
+		/** @return name of the SGSerializable */
+		virtual const char* get_name() const { return "RandomFourierKernel"; }
+
+	protected:
+		/** draw frequencies and phases
+		 *
+		 * @param data CDotFeatures, only their dimension is used
+		 * @return if fitting was successful
+		 */
+		virtual bool fit_feature_map(CFeatures* data);
+
+	private:
+		void init_approximation();
+
+	protected:
+		/** frequencies, one per column */
+		SGMatrix<float64_t> m_frequencies;
+
+		/** phases */
+		SGVector<float64_t> m_phases;
+};
+}
+#endif /* _RANDOMFOURIERKERNEL_H___ */
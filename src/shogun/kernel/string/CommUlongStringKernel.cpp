@@ -13,13 +13,15 @@
 #include <shogun/kernel/normalizer/SqrtDiagKernelNormalizer.h>
 #include <shogun/features/StringFeatures.h>
 #include <shogun/io/SGIO.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/mathematics/Math.h>
 
 using namespace shogun;
 
 CCommUlongStringKernel::CCommUlongStringKernel(int32_t size, bool us)
 : CStringKernel<uint64_t>(size), use_sign(us)
 {
-	properties |= KP_LINADD;
+	properties |= KP_LINADD | KP_ROWEVALUATION;
 	clear_normal();
 
 	set_normalizer(new CSqrtDiagKernelNormalizer());
@@ -30,7 +32,7 @@ CCommUlongStringKernel::CCommUlongStringKernel(
 	int32_t size)
 : CStringKernel<uint64_t>(size), use_sign(us)
 {
-	properties |= KP_LINADD;
+	properties |= KP_LINADD | KP_ROWEVALUATION;
 	clear_normal();
 	set_normalizer(new CSqrtDiagKernelNormalizer());
 	init(l,r);
@@ -67,6 +69,12 @@ void CCommUlongStringKernel::remove_rhs()
 bool CCommUlongStringKernel::init(CFeatures* l, CFeatures* r)
 {
 	CStringKernel<uint64_t>::init(l,r);
+
+	index_kmers=SGVector<uint64_t>();
+	index_offsets=SGVector<int32_t>();
+	index_vectors=SGVector<int32_t>();
+	index_counts=SGVector<int32_t>();
+
 	return init_normalizer();
 }
 
@@ -74,9 +82,140 @@ void CCommUlongStringKernel::cleanup()
 {
 	delete_optimization();
 	clear_normal();
+
+	index_kmers=SGVector<uint64_t>();
+	index_offsets=SGVector<int32_t>();
+	index_vectors=SGVector<int32_t>();
+	index_counts=SGVector<int32_t>();
+
 	CKernel::cleanup();
 }
 
+void CCommUlongStringKernel::init_inverted_index()
+{
+	if (index_offsets.vlen)
+		return;
+
+	CStringFeatures<uint64_t>* r=(CStringFeatures<uint64_t>*) rhs;
+	int32_t num_vec=r->get_num_vectors();
+
+	/* the vectors are sorted, every run of equal k-mers is one posting */
+	int32_t num_postings=0;
+	for (int32_t j=0; j<num_vec; j++)
+	{
+		int32_t len;
+		bool free_vec;
+		uint64_t* vec=r->get_feature_vector(j, len, free_vec);
+
+		for (int32_t k=0; k<len; k++)
+		{
+			if (k==0 || vec[k]!=vec[k-1])
+				num_postings++;
+		}
+
+		r->free_feature_vector(vec, j, free_vec);
+	}
+
+	SGVector<uint64_t> kmers(num_postings);
+	SGVector<int32_t> vectors(num_postings);
+	SGVector<int32_t> counts(num_postings);
+	SGVector<int32_t> perm(num_postings);
+	perm.range_fill();
+
+	for (int32_t j=0, p=-1; j<num_vec; j++)
+	{
+		int32_t len;
+		bool free_vec;
+		uint64_t* vec=r->get_feature_vector(j, len, free_vec);
+
+		for (int32_t k=0; k<len; k++)
+		{
+			if (k==0 || vec[k]!=vec[k-1])
+			{
+				p++;
+				kmers[p]=vec[k];
+				vectors[p]=j;
+				counts[p]=0;
+			}
+
+			counts[p]++;
+		}
+
+		r->free_feature_vector(vec, j, free_vec);
+	}
+
+	/* stable, so the postings of a k-mer stay ordered by vector */
+	CMath::radix_sort_index(kmers.vector, perm.vector, num_postings,
+			parallel->get_num_threads());
+
+	int32_t num_kmers=0;
+	for (int32_t p=0; p<num_postings; p++)
+	{
+		if (p==0 || kmers[p]!=kmers[p-1])
+			num_kmers++;
+	}
+
+	SG_DEBUG("inverted index with %d k-mers and %d postings\n", num_kmers,
+			num_postings);
+
+	index_kmers=SGVector<uint64_t>(num_kmers);
+	index_offsets=SGVector<int32_t>(num_kmers+1);
+	index_vectors=SGVector<int32_t>(num_postings);
+	index_counts=SGVector<int32_t>(num_postings);
+
+	for (int32_t p=0, w=-1; p<num_postings; p++)
+	{
+		if (p==0 || kmers[p]!=kmers[p-1])
+		{
+			w++;
+			index_kmers[w]=kmers[p];
+			index_offsets[w]=p;
+		}
+
+		index_vectors[p]=vectors[perm[p]];
+		index_counts[p]=counts[perm[p]];
+	}
+	index_offsets[num_kmers]=num_postings;
+}
+
+SGVector<float64_t> CCommUlongStringKernel::get_kernel_row(int32_t i)
+{
+	ASSERT(lhs && rhs)
+	init_inverted_index();
+
+	SGVector<float64_t> row(num_rhs);
+	row.zero();
+
+	int32_t len;
+	bool free_vec;
+	uint64_t* vec=((CStringFeatures<uint64_t>*) lhs)->get_feature_vector(i,
+			len, free_vec);
+
+	for (int32_t k=0; k<len && index_kmers.vlen;)
+	{
+		uint64_t kmer=vec[k];
+		int32_t count=0;
+		for (; k<len && vec[k]==kmer; k++)
+			count++;
+
+		int32_t w=CMath::binary_search(index_kmers.vector, index_kmers.vlen,
+				kmer);
+		if (w<0)
+			continue;
+
+		float64_t c=use_sign ? 1.0 : count;
+		for (int32_t p=index_offsets[w]; p<index_offsets[w+1]; p++)
+			row[index_vectors[p]]+=use_sign ? c : c*index_counts[p];
+	}
+
+	((CStringFeatures<uint64_t>*) lhs)->free_feature_vector(vec, i, free_vec);
+
+	for (int32_t j=0; j<num_rhs; j++)
+		row[j]=normalizer->normalize(row[j], i, j);
+
+	return row;
+}
+
 float64_t CCommUlongStringKernel::compute(int32_t idx_a, int32_t idx_b)
 {
 	int32_t alen, blen;
@@ -92,6 +92,18 @@ class CCommUlongStringKernel: public CStringKernel<uint64_t>
 		 */
 		virtual const char* get_name() const { return "CommUlongStringKernel"; }
 
+		/** compute row i of the kernel matrix
+		 *
+		 * Uses an inverted index of the rhs that lists for every k-mer the
+		 * vectors containing it, so only pairs sharing k-mers are visited.
+		 * The index is built on the first call, which hence must not be
+		 * made concurrently with others.
+		 *
+		 * @param i index of the lhs vector
+		 * @return kernel values of vector i with all rhs vectors
+		 */
+		virtual SGVector<float64_t> get_kernel_row(int32_t i);
+
 		/** initialize optimization
 		 *
 		 * @param count count
@@ -199,7 +211,19 @@ class CCommUlongStringKernel: public CStringKernel<uint64_t>
 		 */
 		float64_t compute(int32_t idx_a, int32_t idx_b);
 
+		/** build the inverted index of the rhs if not done yet */
+		void init_inverted_index();
+
 	protected:
+		/** sorted distinct k-mers of the inverted index */
+		SGVector<uint64_t> index_kmers;
+		/** start of the postings of every k-mer in index_kmers */
+		SGVector<int32_t> index_offsets;
+		/** rhs vectors of the postings */
+		SGVector<int32_t> index_vectors;
+		/** k-mer counts of the postings */
+		SGVector<int32_t> index_counts;
+
 		/** dictionary */
 		SGVector<uint64_t> dictionary;
 		/** dictionary weights */
@@ -12,6 +12,7 @@
 #include <shogun/io/SGIO.h>
 
 #include <shogun/base/Parameter.h>
+#include <shogun/base/Parallel.h>
 
 #include <shogun/kernel/string/CommWordStringKernel.h>
 #include <shogun/kernel/normalizer/SqrtDiagKernelNormalizer.h>
@@ -66,6 +67,10 @@ bool CCommWordStringKernel::init(CFeatures* l, CFeatures* r)
 {
 	CStringKernel<uint16_t>::init(l,r);
 
+	index_offsets=SGVector<int32_t>();
+	index_vectors=SGVector<int32_t>();
+	index_counts=SGVector<int32_t>();
+
 	if (use_dict_diagonal_optimization)
 	{
 		SG_FREE(dict_diagonal_optimization);
@@ -79,9 +84,106 @@ bool CCommWordStringKernel::init(CFeatures* l, CFeatures* r)
 void CCommWordStringKernel::cleanup()
 {
 	delete_optimization();
+
+	index_offsets=SGVector<int32_t>();
+	index_vectors=SGVector<int32_t>();
+	index_counts=SGVector<int32_t>();
+
 	CKernel::cleanup();
 }
 
+void CCommWordStringKernel::init_inverted_index()
+{
+	if (index_offsets.vlen)
+		return;
+
+	CStringFeatures<uint16_t>* r=(CStringFeatures<uint16_t>*) rhs;
+	int32_t num_vec=r->get_num_vectors();
+
+	/* the vectors are sorted, every run of equal k-mers is one posting */
+	index_offsets=SGVector<int32_t>(dictionary_size+1);
+	index_offsets.zero();
+	for (int32_t j=0; j<num_vec; j++)
+	{
+		int32_t len;
+		bool free_vec;
+		uint16_t* vec=r->get_feature_vector(j, len, free_vec);
+
+		for (int32_t k=0; k<len; k++)
+		{
+			if (k==0 || vec[k]!=vec[k-1])
+				index_offsets[vec[k]+1]++;
+		}
+
+		r->free_feature_vector(vec, j, free_vec);
+	}
+
+	for (int32_t w=0; w<dictionary_size; w++)
+		index_offsets[w+1]+=index_offsets[w];
+
+	int32_t num_postings=index_offsets[dictionary_size];
+	SG_DEBUG("inverted index with %d postings\n", num_postings)
+
+	index_vectors=SGVector<int32_t>(num_postings);
+	index_counts=SGVector<int32_t>(num_postings);
+	SGVector<int32_t> pos(dictionary_size);
+	memcpy(pos.vector, index_offsets.vector, sizeof(int32_t)*dictionary_size);
+
+	for (int32_t j=0; j<num_vec; j++)
+	{
+		int32_t len;
+		bool free_vec;
+		uint16_t* vec=r->get_feature_vector(j, len, free_vec);
+
+		for (int32_t k=0; k<len; k++)
+		{
+			if (k==0 || vec[k]!=vec[k-1])
+			{
+				int32_t p=pos[vec[k]]++;
+				index_vectors[p]=j;
+				index_counts[p]=0;
+			}
+
+			index_counts[pos[vec[k]]-1]++;
+		}
+
+		r->free_feature_vector(vec, j, free_vec);
+	}
+}
+
+SGVector<float64_t> CCommWordStringKernel::get_kernel_row(int32_t i)
+{
+	ASSERT(lhs && rhs)
+	init_inverted_index();
+
+	SGVector<float64_t> row(num_rhs);
+	row.zero();
+
+	int32_t len;
+	bool free_vec;
+	uint16_t* vec=((CStringFeatures<uint16_t>*) lhs)->get_feature_vector(i,
+			len, free_vec);
+
+	for (int32_t k=0; k<len;)
+	{
+		uint16_t w=vec[k];
+		int32_t count=0;
+		for (; k<len && vec[k]==w; k++)
+			count++;
+
+		float64_t c=use_sign ? 1.0 : count;
+		for (int32_t p=index_offsets[w]; p<index_offsets[w+1]; p++)
+			row[index_vectors[p]]+=use_sign ? c : c*index_counts[p];
+	}
+
+	((CStringFeatures<uint16_t>*) lhs)->free_feature_vector(vec, i, free_vec);
+
+	for (int32_t j=0; j<num_rhs; j++)
+		row[j]=normalizer->normalize(row[j], i, j);
+
+	return row;
+}
+
 float64_t CCommWordStringKernel::compute_diag(int32_t idx_a)
 {
 	int32_t alen;
@@ -239,6 +341,13 @@ float64_t CCommWordStringKernel::compute_helper(
 }
 
 void CCommWordStringKernel::add_to_normal(int32_t vec_idx, float64_t weight)
+{
+	if (add_to_dictionary(dictionary_weights, vec_idx, weight))
+		set_is_initialized(true);
+}
+
+bool CCommWordStringKernel::add_to_dictionary(float64_t* dictionary,
+		int32_t vec_idx, float64_t weight)
 {
 	int32_t len=-1;
 	bool free_vec;
@@ -255,11 +364,11 @@ void CCommWordStringKernel::add_to_normal(int32_t vec_idx, float64_t weight)
 				if (vec[j]==vec[j-1])
 					continue;
 
-				dictionary_weights[(int32_t) vec[j-1]]+=normalizer->
+				dictionary[(int32_t) vec[j-1]]+=normalizer->
 					normalize_lhs(weight, vec_idx);
 			}
 
-			dictionary_weights[(int32_t) vec[len-1]]+=normalizer->
+			dictionary[(int32_t) vec[len-1]]+=normalizer->
 				normalize_lhs(weight, vec_idx);
 		}
 		else
@@ -269,18 +378,18 @@ void CCommWordStringKernel::add_to_normal(int32_t vec_idx, float64_t weight)
 				if (vec[j]==vec[j-1])
 					continue;
 
-				dictionary_weights[(int32_t) vec[j-1]]+=normalizer->
+				dictionary[(int32_t) vec[j-1]]+=normalizer->
 					normalize_lhs(weight*(j-last_j), vec_idx);
 				last_j = j;
 			}
 
-			dictionary_weights[(int32_t) vec[len-1]]+=normalizer->
+			dictionary[(int32_t) vec[len-1]]+=normalizer->
 				normalize_lhs(weight*(len-last_j), vec_idx);
 		}
-		set_is_initialized(true);
 	}
 
 	((CStringFeatures<uint16_t>*) lhs)->free_feature_vector(vec, vec_idx, free_vec);
+	return len>0;
 }
 
 void CCommWordStringKernel::clear_normal()
@@ -331,6 +440,12 @@ float64_t CCommWordStringKernel::compute_optimized(int32_t i)
 		return 0 ;
 	}
 
+	return compute_with_dictionary(dictionary_weights, i);
+}
+
+float64_t CCommWordStringKernel::compute_with_dictionary(
+		const float64_t* dictionary, int32_t i)
+{
 	float64_t result = 0;
 	int32_t len = -1;
 	bool free_vec;
@@ -347,10 +462,10 @@ float64_t CCommWordStringKernel::compute_optimized(int32_t i)
 				if (vec[j]==vec[j-1])
 					continue;
 
-				result += dictionary_weights[(int32_t) vec[j-1]];
+				result += dictionary[(int32_t) vec[j-1]];
 			}
 
-			result += dictionary_weights[(int32_t) vec[len-1]];
+			result += dictionary[(int32_t) vec[len-1]];
 		}
 		else
 		{
@@ -359,11 +474,11 @@ float64_t CCommWordStringKernel::compute_optimized(int32_t i)
 				if (vec[j]==vec[j-1])
 					continue;
 
-				result += dictionary_weights[(int32_t) vec[j-1]]*(j-last_j);
+				result += dictionary[(int32_t) vec[j-1]]*(j-last_j);
 				last_j = j;
 			}
 
-			result += dictionary_weights[(int32_t) vec[len-1]]*(len-last_j);
+			result += dictionary[(int32_t) vec[len-1]]*(len-last_j);
 		}
 
 		result=normalizer->normalize_rhs(result, i);
@@ -372,6 +487,45 @@ float64_t CCommWordStringKernel::compute_optimized(int32_t i)
 	return result;
 }
 
+void CCommWordStringKernel::compute_batch(
+	int32_t num_vec, int32_t* vec_idx, float64_t* target,
+	int32_t num_suppvec, int32_t* IDX, float64_t* alphas, float64_t factor)
+{
+	ASSERT(lhs && rhs)
+	ASSERT(vec_idx && target)
+
+	if (num_vec<=0 || num_suppvec<=0)
+		return;
+
+	int32_t num_threads=parallel->get_num_threads();
+	float64_t* dictionary=SG_CALLOC(float64_t, dictionary_size);
+
+	/* every thread sums its share of support vectors into a dictionary of
+	 * its own, those are merged afterwards */
+	#pragma omp parallel num_threads(CMath::min(num_threads, num_suppvec/1024+1))
+	{
+		float64_t* local=SG_CALLOC(float64_t, dictionary_size);
+
+		#pragma omp for
+		for (int32_t i=0; i<num_suppvec; i++)
+			add_to_dictionary(local, IDX[i], alphas[i]);
+
+		#pragma omp critical
+		{
+			for (int32_t i=0; i<dictionary_size; i++)
+				dictionary[i]+=local[i];
+		}
+
+		SG_FREE(local);
+	}
+
+	#pragma omp parallel for num_threads(num_threads)
+	for (int32_t i=0; i<num_vec; i++)
+		target[i]+=factor*compute_with_dictionary(dictionary, vec_idx[i]);
+
+	SG_FREE(dictionary);
+}
+
 float64_t* CCommWordStringKernel::compute_scoring(
 	int32_t max_degree, int32_t& num_feat, int32_t& num_sym, float64_t* target,
 	int32_t num_suppvec, int32_t* IDX, float64_t* alphas, bool do_init)
@@ -609,7 +763,7 @@ void CCommWordStringKernel::init()
 	use_dict_diagonal_optimization=false;
 	dict_diagonal_optimization=NULL;
 
-	properties |= KP_LINADD;
+	properties |= KP_LINADD | KP_BATCHEVALUATION | KP_ROWEVALUATION;
 	init_dictionary(1<<(sizeof(uint16_t)*8));
 	set_normalizer(new CSqrtDiagKernelNormalizer(use_dict_diagonal_optimization));
 
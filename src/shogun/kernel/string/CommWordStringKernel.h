@@ -139,6 +139,37 @@ class CCommWordStringKernel : public CStringKernel<uint16_t>
 		/** clear normal */
 		virtual void clear_normal();
 
+		/** compute row i of the kernel matrix
+		 *
+		 * Uses an inverted index of the rhs that lists for every k-mer the
+		 * vectors containing it, so only pairs sharing k-mers are visited.
+		 * The index is built on the first call, which hence must not be
+		 * made concurrently with others.
+		 *
+		 * @param i index of the lhs vector
+		 * @return kernel values of vector i with all rhs vectors
+		 */
+		virtual SGVector<float64_t> get_kernel_row(int32_t i);
+
+		/** compute target[i]+=factor*sum_j alphas[j]*k(IDX[j], vec_idx[i])
+		 *
+		 * The support vectors are accumulated into a dictionary of their
+		 * own, so the normal used by compute_optimized() is not touched,
+		 * and all test vectors are scored against it in parallel.
+		 *
+		 * @param num_vec number of test vectors
+		 * @param vec_idx indices of the test vectors (rhs)
+		 * @param target outputs the results are added to
+		 * @param num_suppvec number of support vectors
+		 * @param IDX indices of the support vectors (lhs)
+		 * @param alphas weights of the support vectors
+		 * @param factor factor the results are multiplied with
+		 */
+		virtual void compute_batch(
+			int32_t num_vec, int32_t* vec_idx, float64_t* target,
+			int32_t num_suppvec, int32_t* IDX, float64_t* alphas,
+			float64_t factor=1.0);
+
 		/** return feature type the kernel can deal with
 		 *
 		 * @return feature type WORD
@@ -234,10 +265,39 @@ class CCommWordStringKernel : public CStringKernel<uint16_t>
 		 */
 		virtual float64_t compute_diag(int32_t idx_a);
 
+		/** add the weighted spectrum of a lhs vector to a dictionary
+		 *
+		 * @param dictionary dictionary of size dictionary_size
+		 * @param idx index of the lhs vector
+		 * @param weight weight
+		 * @return whether the vector was not empty
+		 */
+		bool add_to_dictionary(float64_t* dictionary, int32_t idx,
+				float64_t weight);
+
+		/** score a rhs vector against a dictionary
+		 *
+		 * @param dictionary dictionary of size dictionary_size
+		 * @param idx index of the rhs vector
+		 * @return normalized score
+		 */
+		float64_t compute_with_dictionary(const float64_t* dictionary,
+				int32_t idx);
+
+		/** build the inverted index of the rhs if not done yet */
+		void init_inverted_index();
+
 	private:
 		void init();
 
 	protected:
+		/** start of the postings of every k-mer in the inverted index */
+		SGVector<int32_t> index_offsets;
+		/** rhs vectors of the postings */
+		SGVector<int32_t> index_vectors;
+		/** k-mer counts of the postings */
+		SGVector<int32_t> index_counts;
+
 		/** size of dictionary (number of possible strings) */
 		int32_t dictionary_size;
 		/** dictionary weights - array to hold counters for all possible
@@ -132,28 +132,21 @@ void CSpectrumMismatchRBFKernel::compute_helper_all(const char *joint_seq,
 		unsigned int d)
 {
 	const char* AA="ACDEFGHIKLMNPQRSTVWY";
-	const unsigned int num_AA=strlen(AA);
+	const int32_t num_AA=strlen(AA);
 
 	assert(path.size()==d);
 
-	for (unsigned int i=0; i<num_AA; i++)
+	/* the subtrees below the first letter are independent, only their
+	 * contributions to the kernel matrix need to be synchronized */
+	#pragma omp parallel for schedule(dynamic) if (d==0) \
+		num_threads(parallel->get_num_threads())
+	for (int32_t i=0; i<num_AA; i++)
 	{
 		std::vector<struct joint_list_struct> joint_list_;
 
-		if (d==0)
-			SG_PRINT("i=%i: ", i);
-		if (d==0&&target_letter_0!=-1&&(int)i!=target_letter_0)
+		if (d==0&&target_letter_0!=-1&&i!=target_letter_0)
 			continue;
 
-		if (d==1)
-		{
-			SG_PRINT("*");
-		}
-		if (d==2)
-		{
-			SG_PRINT("+");
-		}
-
 		for (unsigned int j=0; j<joint_list.size(); j++)
 		{
 			if (joint_seq[joint_list[j].index+d]!=AA[i])
@@ -180,55 +173,51 @@ void CSpectrumMismatchRBFKernel::compute_helper_all(const char *joint_seq,
 			}
 			else
 			{
-				CDynamicArray<float64_t> feats;
-				feats.resize_array(kernel_matrix->get_dim1());
-				feats.set_const(0);
+				/* the list keeps the order of the examples, so the counts
+				 * of the leaf are aggregated over runs of equal ex_index */
+				std::vector<int32_t> idx;
+				std::vector<float64_t> feats;
 
 				for (unsigned int j=0; j<joint_list_.size(); j++)
 				{
-					if (width==0.0)
-					{
-						feats[joint_list_[j].ex_index]++;
-						//if (joint_mismatch_[j]==0)
-						//	feats[joint_ex_index_[j]]+=3 ;
-					}
-					else
+					float64_t value=1.0;
+					if (width!=0.0 && joint_list_[j].mismatch!=0)
+						value=AA_helper(path_, joint_seq, joint_list_[j].index);
+
+					if (idx.empty() || idx.back()!=(int32_t) joint_list_[j].ex_index)
 					{
-						if (joint_list_[j].mismatch!=0)
-							feats[joint_list_[j].ex_index]+=AA_helper(path_,
-									joint_seq, joint_list_[j].index);
-						else
-							feats[joint_list_[j].ex_index]++;
+						idx.push_back(joint_list_[j].ex_index);
+						feats.push_back(0.0);
 					}
+					feats.back()+=value;
 				}
 
-				std::vector<int> idx;
-				for (int r=0; r<feats.get_array_size(); r++)
-					if (feats[r]!=0.0)
-						idx.push_back(r);
+				float64_t* km=kernel_matrix->get_array();
+				int32_t n=kernel_matrix->get_dim1();
 
 				for (unsigned int r=0; r<idx.size(); r++)
+				{
+					if (feats[r]==0.0)
+						continue;
+
 					for (unsigned int s=r; s<idx.size(); s++)
-						if (s==r)
-							kernel_matrix->set_element(
-									feats[idx[r]]*feats[idx[s]]
-											+kernel_matrix->get_element(idx[r],
-													idx[s]), idx[r], idx[s]);
-						else
+					{
+						float64_t v=feats[r]*feats[s];
+						if (v==0.0)
+							continue;
+
+						#pragma omp atomic
+						km[idx[r]+int64_t(idx[s])*n]+=v;
+
+						if (s!=r)
 						{
-							kernel_matrix->set_element(
-									feats[idx[r]]*feats[idx[s]]
-											+kernel_matrix->get_element(idx[r],
-													idx[s]), idx[r], idx[s]);
-							kernel_matrix->set_element(
-									feats[idx[r]]*feats[idx[s]]
-											+kernel_matrix->get_element(idx[s],
-													idx[r]), idx[s], idx[r]);
+							#pragma omp atomic
+							km[idx[s]+int64_t(idx[r])*n]+=v;
 						}
+					}
+				}
 			}
 		}
-		if (d==0)
-			SG_PRINT("\n");
 	}
 }
 
@@ -240,9 +229,7 @@ void CSpectrumMismatchRBFKernel::compute_all()
 	assert(lhs->get_num_vectors()==rhs->get_num_vectors());
 	kernel_matrix->resize_array(lhs->get_num_vectors(), lhs->get_num_vectors());
 	kernel_matrix_length=lhs->get_num_vectors()*rhs->get_num_vectors();
-	for (int i=0; i<lhs->get_num_vectors(); i++)
-		for (int j=0; j<lhs->get_num_vectors(); j++)
-			kernel_matrix->set_element(0, i, j);
+	kernel_matrix->set_const(0);
 
 	for (int i=0; i<lhs->get_num_vectors(); i++)
 	{
@@ -312,6 +312,10 @@ void CWeightedCommWordStringKernel::init()
 	degree=0;
 	weights=NULL;
 
+	/* the batch and row evaluation of the base class ignore the degree
+	 * weights */
+	properties&=((uint64_t) -1)^(KP_BATCHEVALUATION | KP_ROWEVALUATION);
+
 	init_dictionary(1<<(sizeof(uint16_t)*9));
 
 	m_parameters->add_vector(&weights, &degree, "weights",
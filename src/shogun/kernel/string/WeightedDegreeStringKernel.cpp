@@ -313,6 +313,48 @@ float64_t CWeightedDegreeStringKernel::compute_using_block(
 	return sum;
 }
 
+float64_t CWeightedDegreeStringKernel::compute_using_block_packed(
+	uint64_t* avec, int64_t aoffs, int32_t alen,
+	uint64_t* bvec, int64_t boffs, int32_t blen)
+{
+	ASSERT(alen==blen)
+
+	float64_t sum=0;
+	int32_t match_len=-1;
+
+	for (int32_t i=0; i<alen; i+=32)
+	{
+		uint64_t x=CStringFeatures<char>::get_packed_word(avec, aoffs+i) ^
+			CStringFeatures<char>::get_packed_word(bvec, boffs+i);
+		int32_t n=CMath::min(32, alen-i);
+
+		/* lowest bit of each symbol is set where the symbols differ */
+		uint64_t mismatch=(x | (x>>1)) & 0x5555555555555555ULL;
+		if (!mismatch && n==32)
+		{
+			match_len+=32;
+			continue;
+		}
+
+		for (int32_t j=0; j<n; j++, mismatch>>=2)
+		{
+			if (mismatch & 1)
+			{
+				if (match_len>=0)
+					sum+=block_weights[match_len];
+				match_len=-1;
+			}
+			else
+				match_len++;
+		}
+	}
+
+	if (match_len>=0)
+		sum+=block_weights[match_len];
+
+	return sum;
+}
+
 float64_t CWeightedDegreeStringKernel::compute_without_mismatch(
 	char* avec, int32_t alen, char* bvec, int32_t blen)
 {
@@ -363,6 +405,19 @@ float64_t CWeightedDegreeStringKernel::compute_without_mismatch_matrix(
 float64_t CWeightedDegreeStringKernel::compute(int32_t idx_a, int32_t idx_b)
 {
 	int32_t alen, blen;
+	CStringFeatures<char>* lf=(CStringFeatures<char>*) lhs;
+	CStringFeatures<char>* rf=(CStringFeatures<char>*) rhs;
+
+	if (max_mismatch==0 && length==0 && block_computation &&
+			lf->is_packed() && rf->is_packed())
+	{
+		int64_t aoffs, boffs;
+		uint64_t* avec=lf->get_packed_string(idx_a, aoffs, alen);
+		uint64_t* bvec=rf->get_packed_string(idx_b, boffs, blen);
+
+		return compute_using_block_packed(avec, aoffs, alen, bvec, boffs, blen);
+	}
+
 	bool free_avec, free_bvec;
 	char* avec=((CStringFeatures<char>*) lhs)->get_feature_vector(idx_a, alen, free_avec);
 	char* bvec=((CStringFeatures<char>*) rhs)->get_feature_vector(idx_b, blen, free_bvec);
@@ -524,7 +579,7 @@ float64_t CWeightedDegreeStringKernel::compute_by_tree(int32_t idx)
 
 	for (int32_t i=0; i<len; i++)
 		vec[i]=alphabet->remap_to_bin(char_vec[i]);
-	((CStringFeatures<char>*) lhs)->free_feature_vector(char_vec, idx, free_vec);
+	((CStringFeatures<char>*) rhs)->free_feature_vector(char_vec, idx, free_vec);
 
 	float64_t sum=0;
 	ASSERT(tries)
@@ -549,7 +604,7 @@ void CWeightedDegreeStringKernel::compute_by_tree(
 
 	for (int32_t i=0; i<len; i++)
 		vec[i]=alphabet->remap_to_bin(char_vec[i]);
-	((CStringFeatures<char>*) lhs)->free_feature_vector(char_vec, idx, free_vec);
+	((CStringFeatures<char>*) rhs)->free_feature_vector(char_vec, idx, free_vec);
 
 	ASSERT(tries)
 	for (int32_t i=0; i<len; i++)
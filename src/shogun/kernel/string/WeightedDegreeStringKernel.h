@@ -699,6 +699,20 @@ class CWeightedDegreeStringKernel: public CStringKernel<char>
 		float64_t compute_using_block(char* avec, int32_t alen,
 			char* bvec, int32_t blen);
 
+		/** compute using block on 2-bit packed strings, compares 32
+		 * symbols at once
+		 *
+		 * @param avec packed stream of vector a
+		 * @param aoffs position of vector a in its stream
+		 * @param alen length of vector a
+		 * @param bvec packed stream of vector b
+		 * @param boffs position of vector b in its stream
+		 * @param blen length of vector b
+		 * @return computed value
+		 */
+		float64_t compute_using_block_packed(uint64_t* avec, int64_t aoffs,
+			int32_t alen, uint64_t* bvec, int64_t boffs, int32_t blen);
+
 		/** remove lhs from kernel */
 		virtual void remove_lhs();
 
@@ -0,0 +1,304 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society.
+ */
+
+#include <shogun/lib/config.h>
+#include <shogun/lib/AllocationSampler.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+#ifdef _MSC_VER
+#define SG_SAMPLER_THREAD_LOCAL __declspec(thread)
+#else
+#define SG_SAMPLER_THREAD_LOCAL __thread
+#endif
+
+/** number of slots of the sample table */
+#define SG_SAMPLER_TABLE_SIZE 65536
+/** slots probed for a pointer */
+#define SG_SAMPLER_PROBES 8
+
+using namespace shogun;
+
+volatile bool SGAllocationSampler::enabled=false;
+
+namespace
+{
+
+/** one sampled allocation */
+struct AllocationSample
+{
+	void* ptr;
+	size_t size;
+	size_t weight;
+	const char* file;
+	int32_t line;
+	const void* caller;
+};
+
+/** samples aggregated per site */
+struct AllocationSite
+{
+	const char* file;
+	int32_t line;
+	const void* caller;
+	int64_t num_samples;
+	int64_t bytes;
+};
+
+/* plain data only, the sampler is called from within sg_malloc and must
+ * never allocate through it */
+AllocationSample samples[SG_SAMPLER_TABLE_SIZE];
+volatile int32_t num_samples=0;
+int64_t num_dropped=0;
+int64_t estimated_bytes=0;
+size_t sample_interval=512*1024;
+
+SG_SAMPLER_THREAD_LOCAL int64_t bytes_until_sample=0;
+SG_SAMPLER_THREAD_LOCAL uint32_t rng_state=0;
+
+#ifdef HAVE_PTHREAD
+pthread_mutex_t sampler_mutex=PTHREAD_MUTEX_INITIALIZER;
+
+inline void sampler_lock() { pthread_mutex_lock(&sampler_mutex); }
+inline void sampler_unlock() { pthread_mutex_unlock(&sampler_mutex); }
+#else
+inline void sampler_lock() {}
+inline void sampler_unlock() {}
+#endif
+
+inline int32_t ptr_hash(const void* ptr)
+{
+	uint64_t h=(uint64_t) (uintptr_t) ptr;
+	h=(h>>4)*0x9E3779B97F4A7C15ull;
+	return (int32_t) (h>>48) & (SG_SAMPLER_TABLE_SIZE-1);
+}
+
+/** bytes until the next sample, uniform in [interval/2, 3*interval/2) so
+ * periodic allocation patterns are not sampled at the same spot */
+inline int64_t next_interval()
+{
+	if (rng_state==0)
+		rng_state=(uint32_t) (uintptr_t) &rng_state | 1;
+
+	rng_state^=rng_state<<13;
+	rng_state^=rng_state>>17;
+	rng_state^=rng_state<<5;
+
+	return sample_interval/2+rng_state%(sample_interval ? sample_interval : 1);
+}
+
+int compare_site_key(const void* a, const void* b)
+{
+	const AllocationSample* s1=(const AllocationSample*) a;
+	const AllocationSample* s2=(const AllocationSample*) b;
+
+	if (s1->file!=s2->file)
+		return s1->file<s2->file ? -1 : 1;
+	if (s1->line!=s2->line)
+		return s1->line<s2->line ? -1 : 1;
+	if (s1->caller!=s2->caller)
+		return s1->caller<s2->caller ? -1 : 1;
+
+	return 0;
+}
+
+int compare_site_bytes(const void* a, const void* b)
+{
+	const AllocationSite* s1=(const AllocationSite*) a;
+	const AllocationSite* s2=(const AllocationSite*) b;
+
+	if (s1->bytes!=s2->bytes)
+		return s1->bytes>s2->bytes ? -1 : 1;
+
+	return 0;
+}
+}
+
+void SGAllocationSampler::enable(size_t interval)
+{
+	sampler_lock();
+	memset(samples, 0, sizeof(samples));
+	num_samples=0;
+	num_dropped=0;
+	estimated_bytes=0;
+	sample_interval=interval>0 ? interval : 1;
+	enabled=true;
+	sampler_unlock();
+}
+
+void SGAllocationSampler::disable()
+{
+	sampler_lock();
+	enabled=false;
+	memset(samples, 0, sizeof(samples));
+	num_samples=0;
+	estimated_bytes=0;
+	sampler_unlock();
+}
+
+size_t SGAllocationSampler::get_interval()
+{
+	return sample_interval;
+}
+
+void SGAllocationSampler::record_allocation(void* ptr, size_t size,
+		const char* file, int32_t line, const void* caller)
+{
+	if (!ptr)
+		return;
+
+	bytes_until_sample-=size;
+	if (bytes_until_sample>0)
+		return;
+
+	bytes_until_sample=next_interval();
+
+	sampler_lock();
+	if (enabled)
+	{
+		int32_t h=ptr_hash(ptr);
+		int32_t i=0;
+		for (; i<SG_SAMPLER_PROBES; i++)
+		{
+			AllocationSample* s=&samples[(h+i) & (SG_SAMPLER_TABLE_SIZE-1)];
+			if (s->ptr==NULL)
+			{
+				s->size=size;
+				s->weight=size>sample_interval ? size : sample_interval;
+				s->file=file;
+				s->line=line;
+				s->caller=caller;
+				s->ptr=ptr;
+				num_samples++;
+				estimated_bytes+=s->weight;
+				break;
+			}
+		}
+
+		if (i==SG_SAMPLER_PROBES)
+			num_dropped++;
+	}
+	sampler_unlock();
+}
+
+void SGAllocationSampler::record_free(void* ptr)
+{
+	if (!ptr || num_samples==0)
+		return;
+
+	// probe without the lock, almost all freed blocks were not sampled
+	int32_t h=ptr_hash(ptr);
+	for (int32_t i=0; i<SG_SAMPLER_PROBES; i++)
+	{
+		AllocationSample* s=&samples[(h+i) & (SG_SAMPLER_TABLE_SIZE-1)];
+		if (s->ptr!=ptr)
+			continue;
+
+		sampler_lock();
+		if (s->ptr==ptr)
+		{
+			estimated_bytes-=s->weight;
+			num_samples--;
+			s->ptr=NULL;
+		}
+		sampler_unlock();
+		return;
+	}
+}
+
+int32_t SGAllocationSampler::get_num_samples()
+{
+	return num_samples;
+}
+
+int64_t SGAllocationSampler::get_num_dropped()
+{
+	return num_dropped;
+}
+
+int64_t SGAllocationSampler::get_estimated_bytes()
+{
+	sampler_lock();
+	int64_t bytes=estimated_bytes;
+	sampler_unlock();
+
+	return bytes;
+}
+
+void SGAllocationSampler::print_samples(int32_t max_sites)
+{
+	sampler_lock();
+	int32_t num=0;
+	AllocationSample* live=(AllocationSample*) malloc(
+			sizeof(AllocationSample)*(num_samples>0 ? num_samples : 1));
+	for (int32_t i=0; i<SG_SAMPLER_TABLE_SIZE && live; i++)
+	{
+		if (samples[i].ptr)
+			live[num++]=samples[i];
+	}
+	int64_t dropped=num_dropped;
+	int64_t total=estimated_bytes;
+	sampler_unlock();
+
+	if (!live)
+		return;
+
+	qsort(live, num, sizeof(AllocationSample), compare_site_key);
+
+	int32_t num_sites=0;
+	AllocationSite* sites=(AllocationSite*) malloc(
+			sizeof(AllocationSite)*(num>0 ? num : 1));
+	for (int32_t i=0; i<num && sites; i++)
+	{
+		if (i==0 || compare_site_key(&live[i-1], &live[i])!=0)
+		{
+			AllocationSite site={live[i].file, live[i].line, live[i].caller, 0, 0};
+			sites[num_sites++]=site;
+		}
+
+		sites[num_sites-1].num_samples++;
+		sites[num_sites-1].bytes+=live[i].weight;
+	}
+
+	printf("%d sampled allocations (%lld dropped), approx. %lld bytes live "
+			"at %d sites, sample interval %lld bytes\n", num,
+			(long long int) dropped, (long long int) total, num_sites,
+			(long long int) sample_interval);
+
+	if (sites)
+	{
+		qsort(sites, num_sites, sizeof(AllocationSite), compare_site_bytes);
+		for (int32_t i=0; i<num_sites && i<max_sites; i++)
+		{
+			if (sites[i].file)
+			{
+				printf("%12lld bytes in %6lld samples allocated in %s line %d\n",
+						(long long int) sites[i].bytes,
+						(long long int) sites[i].num_samples,
+						sites[i].file, sites[i].line);
+			}
+			else
+			{
+				printf("%12lld bytes in %6lld samples allocated from %p\n",
+						(long long int) sites[i].bytes,
+						(long long int) sites[i].num_samples,
+						sites[i].caller);
+			}
+		}
+	}
+
+	free(sites);
+	free(live);
+}
@@ -0,0 +1,93 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society.
+ */
+
+#ifndef __ALLOCATIONSAMPLER_H__
+#define __ALLOCATIONSAMPLER_H__
+
+#include <shogun/lib/config.h>
+#include <shogun/lib/common.h>
+
+namespace shogun
+{
+
+/** @brief Sampling tracer for allocations made with SG_MALLOC, SG_CALLOC
+ * and SG_REALLOC.
+ *
+ * Unlike TRACE_MEMORY_ALLOCS, which records every block in a global map,
+ * the sampler records on average one allocation per sample interval bytes
+ * and can be switched on and off at runtime in regular builds. While it is
+ * disabled, the cost per allocation is a single branch. While enabled,
+ * allocations only decrement a thread local byte counter, so tracing can be
+ * left on under production load.
+ *
+ * Each sample stands for max(size, interval) bytes, which gives an unbiased
+ * estimate of the live memory per allocation site. Sites are identified by
+ * file and line in TRACE_MEMORY_ALLOCS builds and by the return address
+ * (resolve with addr2line) otherwise.
+ */
+class SGAllocationSampler
+{
+public:
+	/** start sampling
+	 *
+	 * @param interval average number of allocated bytes between samples
+	 */
+	static void enable(size_t interval=512*1024);
+
+	/** stop sampling and drop all samples */
+	static void disable();
+
+	/** @return whether sampling is enabled */
+	static inline bool is_enabled()
+	{
+		return enabled;
+	}
+
+	/** @return average number of bytes between samples */
+	static size_t get_interval();
+
+	/** account an allocation, called by sg_malloc and friends
+	 *
+	 * @param ptr allocated memory
+	 * @param size size in bytes
+	 * @param file file of the allocation or NULL
+	 * @param line line of the allocation
+	 * @param caller return address of the allocating function
+	 */
+	static void record_allocation(void* ptr, size_t size, const char* file,
+			int32_t line, const void* caller);
+
+	/** account a free, called by sg_free and sg_realloc
+	 *
+	 * @param ptr freed memory
+	 */
+	static void record_free(void* ptr);
+
+	/** @return number of live samples */
+	static int32_t get_num_samples();
+
+	/** @return number of samples dropped because the table was full */
+	static int64_t get_num_dropped();
+
+	/** @return estimated number of bytes held by sampled allocations
+	 * that were not freed yet */
+	static int64_t get_estimated_bytes();
+
+	/** print the estimated live bytes per allocation site
+	 *
+	 * @param max_sites number of sites to print, largest first
+	 */
+	static void print_samples(int32_t max_sites=20);
+
+private:
+	/** whether sampling is enabled */
+	static volatile bool enabled;
+};
+}
+#endif // __ALLOCATIONSAMPLER_H__
@@ -248,6 +248,12 @@ template<class T> class CCache : public CSGObject
 	virtual const char* get_name() const { return "Cache"; }
 
 	protected:
+	/** @return bytes held by the cache lines */
+	virtual int64_t get_unregistered_memory_footprint()
+	{
+		return nr_cache_lines*(entry_size*sizeof(T)+sizeof(TEntry*));
+	}
+
 	/** if cache is full */
 	bool cache_is_full;
 	/** size of one entry */
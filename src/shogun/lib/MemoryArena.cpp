@@ -0,0 +1,140 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society.
+ */
+
+#include <shogun/lib/MemoryArena.h>
+#include <shogun/lib/memory.h>
+
+using namespace shogun;
+
+namespace
+{
+/** header of every block, the data follows directly */
+struct ArenaBlock
+{
+	ArenaBlock* next;
+	size_t size;
+	size_t used;
+	size_t padding;
+};
+
+inline char* block_data(ArenaBlock* b)
+{
+	return ((char*) b)+sizeof(ArenaBlock);
+}
+}
+
+SGArena::SGArena(size_t bsize) : first(NULL), current(NULL), block_size(bsize)
+{
+}
+
+SGArena::~SGArena()
+{
+	ArenaBlock* b=(ArenaBlock*) first;
+	while (b)
+	{
+		ArenaBlock* next=b->next;
+		SG_FREE(b);
+		b=next;
+	}
+}
+
+void SGArena::add_block(size_t size)
+{
+	ArenaBlock* b=(ArenaBlock*) SG_MALLOC(char, sizeof(ArenaBlock)+size);
+	b->size=size;
+	b->used=0;
+
+	ArenaBlock* cur=(ArenaBlock*) current;
+	if (cur)
+	{
+		b->next=cur->next;
+		cur->next=b;
+	}
+	else
+	{
+		b->next=(ArenaBlock*) first;
+		first=b;
+	}
+	current=b;
+}
+
+void* SGArena::allocate(size_t size, size_t alignment)
+{
+	ArenaBlock* b=(ArenaBlock*) current;
+	while (b)
+	{
+		uintptr_t start=(uintptr_t) (block_data(b)+b->used);
+		size_t offset=b->used+(((start+alignment-1) & ~(uintptr_t) (alignment-1))-start);
+		if (offset+size<=b->size)
+		{
+			b->used=offset+size;
+			current=b;
+			return block_data(b)+offset;
+		}
+
+		// only blocks emptied by rewind() or reset() follow the current one
+		if (!b->next || b->next->size<size+alignment)
+			break;
+
+		b=b->next;
+		current=b;
+	}
+
+	add_block(size+alignment>block_size ? size+alignment : block_size);
+	return allocate(size, alignment);
+}
+
+SGArena::Mark SGArena::get_mark() const
+{
+	Mark m;
+	m.block=current;
+	m.used=current ? ((ArenaBlock*) current)->used : 0;
+	return m;
+}
+
+void SGArena::rewind(const Mark& mark)
+{
+	if (!mark.block)
+	{
+		reset();
+		return;
+	}
+
+	ArenaBlock* b=(ArenaBlock*) mark.block;
+	b->used=mark.used;
+	current=b;
+	for (b=b->next; b; b=b->next)
+		b->used=0;
+}
+
+void SGArena::reset()
+{
+	for (ArenaBlock* b=(ArenaBlock*) first; b; b=b->next)
+		b->used=0;
+
+	current=first;
+}
+
+size_t SGArena::get_used() const
+{
+	size_t used=0;
+	for (ArenaBlock* b=(ArenaBlock*) first; b; b=b->next)
+		used+=b->used;
+
+	return used;
+}
+
+size_t SGArena::get_capacity() const
+{
+	size_t capacity=0;
+	for (ArenaBlock* b=(ArenaBlock*) first; b; b=b->next)
+		capacity+=b->size;
+
+	return capacity;
+}
@@ -0,0 +1,140 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society.
+ */
+
+#ifndef __MEMORYARENA_H__
+#define __MEMORYARENA_H__
+
+#include <shogun/lib/config.h>
+#include <shogun/lib/common.h>
+
+namespace shogun
+{
+
+/** @brief Bump allocator for scratch memory.
+ *
+ * Allocations are carved from a list of blocks and are never released
+ * individually. Instead the whole arena is reset() or rewound to a
+ * previously taken mark, which makes the memory of the blocks available
+ * again without returning it to the system. A loop that needs several
+ * temporary buffers per iteration would use it as
+ *
+ * @code
+ * SGArena arena;
+ * for (int32_t i=0; i<num_vectors; i++)
+ * {
+ *     SGArenaScope scope(&arena);
+ *     float64_t* dists=arena.allocate<float64_t>(num_train);
+ *     index_t* idx=arena.allocate<index_t>(num_train);
+ *     ...
+ * }
+ * @endcode
+ *
+ * so after the first iteration no allocation touches the heap. Only plain
+ * data may be placed in an arena, no destructors are called. An arena must
+ * not be shared between threads, use one per thread instead.
+ */
+class SGArena
+{
+public:
+	/** position in the arena as returned by get_mark() */
+	struct Mark
+	{
+		/** block */
+		void* block;
+		/** bytes used in block */
+		size_t used;
+	};
+
+	/** constructor
+	 *
+	 * @param block_size size of the blocks requested from the system,
+	 * larger allocations get a block of their own
+	 */
+	SGArena(size_t block_size=65536);
+
+	/** destructor, releases all blocks */
+	~SGArena();
+
+	/** allocate uninitialised memory
+	 *
+	 * @param size number of bytes
+	 * @param alignment alignment, a power of two
+	 * @return pointer to memory valid until reset() or rewind() past it
+	 */
+	void* allocate(size_t size, size_t alignment=16);
+
+	/** allocate uninitialised memory for len elements of type T
+	 *
+	 * @param len number of elements
+	 * @return pointer to memory valid until reset() or rewind() past it
+	 */
+	template <class T> T* allocate(index_t len)
+	{
+		return (T*) allocate(sizeof(T)*len);
+	}
+
+	/** @return current position, see rewind() */
+	Mark get_mark() const;
+
+	/** release everything allocated after mark was taken
+	 *
+	 * @param mark position returned by get_mark()
+	 */
+	void rewind(const Mark& mark);
+
+	/** release all allocations, keeping the blocks for reuse */
+	void reset();
+
+	/** @return bytes handed out since the last reset */
+	size_t get_used() const;
+
+	/** @return bytes held by the arena */
+	size_t get_capacity() const;
+
+private:
+	/** append a block of at least size bytes after the current one */
+	void add_block(size_t size);
+
+private:
+	/** first block */
+	void* first;
+	/** block allocations are served from */
+	void* current;
+	/** default block size */
+	size_t block_size;
+};
+
+/** @brief Rewinds an SGArena to the position it had on construction when
+ * going out of scope.
+ */
+class SGArenaScope
+{
+public:
+	/** constructor
+	 *
+	 * @param arena arena to rewind
+	 */
+	SGArenaScope(SGArena* arena) : m_arena(arena), m_mark(arena->get_mark())
+	{
+	}
+
+	/** destructor, rewinds the arena */
+	~SGArenaScope()
+	{
+		m_arena->rewind(m_mark);
+	}
+
+private:
+	/** arena */
+	SGArena* m_arena;
+	/** position on construction */
+	SGArena::Mark m_mark;
+};
+}
+#endif // __MEMORYARENA_H__
@@ -0,0 +1,485 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society.
+ */
+
+#include <shogun/lib/config.h>
+#include <shogun/lib/MemoryPool.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+#ifdef HAVE_CXX11_ATOMIC
+#include <atomic>
+#endif
+
+#ifdef _MSC_VER
+#define SG_POOL_THREAD_LOCAL __declspec(thread)
+#else
+#define SG_POOL_THREAD_LOCAL __thread
+#endif
+
+/** bytes at the start of every slab reserved for its header */
+#define SG_POOL_SLAB_HEADER 64
+/** number of slots of the slab table, at most half of them are used */
+#define SG_POOL_TABLE_SIZE 65536
+/** bytes a thread may cache per size class before returning blocks */
+#define SG_POOL_CACHE_BYTES (256*1024)
+
+using namespace shogun;
+
+namespace
+{
+
+/** header at the start of every slab */
+struct SlabHeader
+{
+	int32_t size_class;
+};
+
+#ifdef HAVE_CXX11_ATOMIC
+typedef std::atomic<uint64_t> PoolCounter;
+
+/* each counter has a single writer, so a relaxed load and store is as
+ * cheap as a plain increment while readers still see whole values */
+inline void counter_add(PoolCounter& c, uint64_t v)
+{
+	c.store(c.load(std::memory_order_relaxed)+v, std::memory_order_relaxed);
+}
+
+inline uint64_t counter_get(const PoolCounter& c)
+{
+	return c.load(std::memory_order_relaxed);
+}
+#else
+typedef volatile uint64_t PoolCounter;
+
+inline void counter_add(PoolCounter& c, uint64_t v)
+{
+	__sync_fetch_and_add(&c, v);
+}
+
+inline uint64_t counter_get(PoolCounter& c)
+{
+	return __sync_fetch_and_add(&c, 0);
+}
+#endif
+
+/** counters behind MemoryPoolStatistics */
+struct PoolCounters
+{
+	PoolCounter num_allocs;
+	PoolCounter num_frees;
+	PoolCounter num_cache_hits;
+	PoolCounter num_large_allocs;
+	PoolCounter bytes_requested;
+};
+
+/** per-thread free lists and counters */
+struct ThreadCache
+{
+	void* free_list[SG_POOL_NUM_CLASSES];
+	int32_t num_free[SG_POOL_NUM_CLASSES];
+	char* bump[SG_POOL_NUM_CLASSES];
+	char* bump_end[SG_POOL_NUM_CLASSES];
+	PoolCounters stats;
+	ThreadCache* prev;
+	ThreadCache* next;
+};
+
+/* all globals are plain data so the pool is usable during static
+ * initialisation and destruction of other translation units */
+SG_POOL_THREAD_LOCAL ThreadCache* thread_cache=NULL;
+
+void* volatile slab_table[SG_POOL_TABLE_SIZE];
+int32_t num_slabs=0;
+
+void* global_free[SG_POOL_NUM_CLASSES];
+ThreadCache* cache_list=NULL;
+PoolCounters retired_stats;
+
+#ifdef HAVE_PTHREAD
+pthread_mutex_t pool_mutex=PTHREAD_MUTEX_INITIALIZER;
+pthread_key_t cache_key;
+pthread_once_t cache_key_once=PTHREAD_ONCE_INIT;
+
+inline void pool_lock() { pthread_mutex_lock(&pool_mutex); }
+inline void pool_unlock() { pthread_mutex_unlock(&pool_mutex); }
+#else
+inline void pool_lock() {}
+inline void pool_unlock() {}
+#endif
+
+inline uintptr_t slab_base(const void* ptr)
+{
+	return ((uintptr_t) ptr) & ~((uintptr_t) SG_POOL_SLAB_SIZE-1);
+}
+
+inline int32_t slab_hash(uintptr_t base)
+{
+	return (int32_t) (((base/SG_POOL_SLAB_SIZE)*2654435761u) & (SG_POOL_TABLE_SIZE-1));
+}
+
+inline int32_t cache_limit(int32_t c)
+{
+	int32_t limit=SG_POOL_CACHE_BYTES/SGMemoryPool::get_class_size(c);
+	return limit<64 ? 64 : limit;
+}
+
+void add_stats(MemoryPoolStatistics& to, PoolCounters& from)
+{
+	to.num_allocs+=counter_get(from.num_allocs);
+	to.num_frees+=counter_get(from.num_frees);
+	to.num_cache_hits+=counter_get(from.num_cache_hits);
+	to.num_large_allocs+=counter_get(from.num_large_allocs);
+	to.bytes_requested+=counter_get(from.bytes_requested);
+}
+
+/** add the counters of a thread cache to the retired ones, the pool lock
+ * must be held */
+void retire_stats(PoolCounters& from)
+{
+	counter_add(retired_stats.num_allocs, counter_get(from.num_allocs));
+	counter_add(retired_stats.num_frees, counter_get(from.num_frees));
+	counter_add(retired_stats.num_cache_hits, counter_get(from.num_cache_hits));
+	counter_add(retired_stats.num_large_allocs, counter_get(from.num_large_allocs));
+	counter_add(retired_stats.bytes_requested, counter_get(from.bytes_requested));
+}
+
+/** move up to num blocks of list into the global list of class c, the
+ * pool lock must be held. @return rest of list */
+void* release_blocks(void* list, int32_t num, int32_t c)
+{
+	while (list && num>0)
+	{
+		void* next=*(void**) list;
+		*(void**) list=global_free[c];
+		global_free[c]=list;
+		list=next;
+		num--;
+	}
+
+	return list;
+}
+
+/** return everything cached by tc to the global lists, the pool lock must
+ * be held */
+void release_cache(ThreadCache* tc)
+{
+	for (int32_t c=0; c<SG_POOL_NUM_CLASSES; c++)
+	{
+		release_blocks(tc->free_list[c], tc->num_free[c], c);
+		tc->free_list[c]=NULL;
+		tc->num_free[c]=0;
+
+		size_t size=SGMemoryPool::get_class_size(c);
+		while (tc->bump[c] && tc->bump[c]+size<=tc->bump_end[c])
+		{
+			*(void**) tc->bump[c]=global_free[c];
+			global_free[c]=tc->bump[c];
+			tc->bump[c]+=size;
+		}
+		tc->bump[c]=NULL;
+		tc->bump_end[c]=NULL;
+	}
+}
+
+#ifdef HAVE_PTHREAD
+void destroy_cache(void* ptr)
+{
+	ThreadCache* tc=(ThreadCache*) ptr;
+
+	pool_lock();
+	release_cache(tc);
+	retire_stats(tc->stats);
+	if (tc->prev)
+		tc->prev->next=tc->next;
+	else
+		cache_list=tc->next;
+	if (tc->next)
+		tc->next->prev=tc->prev;
+	pool_unlock();
+
+	thread_cache=NULL;
+	::free(tc);
+}
+
+void create_cache_key()
+{
+	pthread_key_create(&cache_key, destroy_cache);
+}
+#endif
+
+ThreadCache* get_cache()
+{
+	if (thread_cache)
+		return thread_cache;
+
+	ThreadCache* tc=(ThreadCache*) calloc(1, sizeof(ThreadCache));
+	if (!tc)
+		return NULL;
+
+#ifdef HAVE_PTHREAD
+	pthread_once(&cache_key_once, create_cache_key);
+	pthread_setspecific(cache_key, tc);
+#endif
+
+	pool_lock();
+	tc->next=cache_list;
+	if (cache_list)
+		cache_list->prev=tc;
+	cache_list=tc;
+	pool_unlock();
+
+	thread_cache=tc;
+	return tc;
+}
+
+/** get a fresh slab for class c, the pool lock must be held */
+char* new_slab(ThreadCache* tc, int32_t c)
+{
+	if (num_slabs>=SG_POOL_TABLE_SIZE/2)
+		return NULL;
+
+	void* slab=NULL;
+#ifdef _MSC_VER
+	slab=_aligned_malloc(SG_POOL_SLAB_SIZE, SG_POOL_SLAB_SIZE);
+#else
+	if (posix_memalign(&slab, SG_POOL_SLAB_SIZE, SG_POOL_SLAB_SIZE)!=0)
+		slab=NULL;
+#endif
+	if (!slab)
+		return NULL;
+
+	((SlabHeader*) slab)->size_class=c;
+
+	uintptr_t base=(uintptr_t) slab;
+	int32_t h=slab_hash(base);
+	while (slab_table[h])
+		h=(h+1) & (SG_POOL_TABLE_SIZE-1);
+	slab_table[h]=slab;
+	num_slabs++;
+
+	tc->bump[c]=((char*) slab)+SG_POOL_SLAB_HEADER;
+	tc->bump_end[c]=((char*) slab)+SG_POOL_SLAB_SIZE;
+	return tc->bump[c];
+}
+
+/** slow path of allocate(): refill the cache of class c */
+void* refill(ThreadCache* tc, int32_t c)
+{
+	size_t size=SGMemoryPool::get_class_size(c);
+	if (tc->bump[c] && tc->bump[c]+size<=tc->bump_end[c])
+	{
+		void* p=tc->bump[c];
+		tc->bump[c]+=size;
+		return p;
+	}
+
+	void* p=NULL;
+	pool_lock();
+	if (global_free[c])
+	{
+		// take half a cache worth of blocks at once
+		p=global_free[c];
+		void* last=p;
+		int32_t n=1;
+		int32_t wanted=cache_limit(c)/2;
+		while (n<wanted && *(void**) last)
+		{
+			last=*(void**) last;
+			n++;
+		}
+		global_free[c]=*(void**) last;
+		*(void**) last=NULL;
+
+		tc->free_list[c]=*(void**) p;
+		tc->num_free[c]=n-1;
+	}
+	else if (new_slab(tc, c))
+	{
+		p=tc->bump[c];
+		tc->bump[c]+=size;
+	}
+	pool_unlock();
+
+	return p;
+}
+}
+
+void* SGMemoryPool::allocate(size_t size)
+{
+	ThreadCache* tc=get_cache();
+	if (!tc)
+		return NULL;
+
+	counter_add(tc->stats.num_allocs, 1);
+	counter_add(tc->stats.bytes_requested, size);
+
+	int32_t c=get_size_class(size);
+	if (c<0)
+	{
+		counter_add(tc->stats.num_large_allocs, 1);
+		return malloc(size);
+	}
+
+	void* p=tc->free_list[c];
+	if (p)
+	{
+		tc->free_list[c]=*(void**) p;
+		tc->num_free[c]--;
+		counter_add(tc->stats.num_cache_hits, 1);
+		return p;
+	}
+
+	p=refill(tc, c);
+	if (!p)
+	{
+		// slab table exhausted or no aligned memory left
+		counter_add(tc->stats.num_large_allocs, 1);
+		return malloc(size);
+	}
+
+	return p;
+}
+
+void* SGMemoryPool::allocate_zeroed(size_t num, size_t size)
+{
+	void* p=allocate(num*size);
+	if (p)
+		memset(p, 0, num*size);
+
+	return p;
+}
+
+void* SGMemoryPool::reallocate(void* ptr, size_t size)
+{
+	if (!ptr)
+		return allocate(size);
+
+	if (!owns(ptr))
+		return realloc(ptr, size);
+
+	size_t old_size=get_block_size(ptr);
+	if (size<=old_size && (size>old_size/2 || old_size==16))
+		return ptr;
+
+	void* p=allocate(size);
+	if (!p)
+		return NULL;
+
+	memcpy(p, ptr, size<old_size ? size : old_size);
+	free(ptr);
+
+	return p;
+}
+
+void SGMemoryPool::free(void* ptr)
+{
+	if (!ptr)
+		return;
+
+	ThreadCache* tc=get_cache();
+	if (tc)
+		counter_add(tc->stats.num_frees, 1);
+
+	if (!owns(ptr))
+	{
+		::free(ptr);
+		return;
+	}
+
+	int32_t c=((SlabHeader*) slab_base(ptr))->size_class;
+
+	if (!tc)
+	{
+		pool_lock();
+		*(void**) ptr=global_free[c];
+		global_free[c]=ptr;
+		pool_unlock();
+		return;
+	}
+
+	*(void**) ptr=tc->free_list[c];
+	tc->free_list[c]=ptr;
+
+	int32_t limit=cache_limit(c);
+	if (++tc->num_free[c]>limit)
+	{
+		pool_lock();
+		tc->free_list[c]=release_blocks(tc->free_list[c], limit/2, c);
+		pool_unlock();
+		tc->num_free[c]-=limit/2;
+	}
+}
+
+bool SGMemoryPool::owns(const void* ptr)
+{
+	uintptr_t base=slab_base(ptr);
+	int32_t h=slab_hash(base);
+
+	// slabs are never removed, so probing without the lock is safe
+	for (void* s=slab_table[h]; s; s=slab_table[h])
+	{
+		if ((uintptr_t) s==base)
+			return true;
+
+		h=(h+1) & (SG_POOL_TABLE_SIZE-1);
+	}
+
+	return false;
+}
+
+size_t SGMemoryPool::get_block_size(const void* ptr)
+{
+	return get_class_size(((SlabHeader*) slab_base(ptr))->size_class);
+}
+
+void SGMemoryPool::flush_thread_cache()
+{
+	if (!thread_cache)
+		return;
+
+	pool_lock();
+	release_cache(thread_cache);
+	pool_unlock();
+}
+
+MemoryPoolStatistics SGMemoryPool::get_statistics()
+{
+	MemoryPoolStatistics stats;
+	memset(&stats, 0, sizeof(stats));
+
+	pool_lock();
+	add_stats(stats, retired_stats);
+	for (ThreadCache* tc=cache_list; tc; tc=tc->next)
+		add_stats(stats, tc->stats);
+	stats.num_slabs=num_slabs;
+	pool_unlock();
+
+	return stats;
+}
+
+void SGMemoryPool::print_statistics()
+{
+	MemoryPoolStatistics stats=get_statistics();
+
+	printf("Memory pool: %llu allocations (%llu from thread caches, "
+			"%llu large), %llu frees, %llu bytes requested, %llu slabs "
+			"of %d bytes\n",
+			(unsigned long long) stats.num_allocs,
+			(unsigned long long) stats.num_cache_hits,
+			(unsigned long long) stats.num_large_allocs,
+			(unsigned long long) stats.num_frees,
+			(unsigned long long) stats.bytes_requested,
+			(unsigned long long) stats.num_slabs, SG_POOL_SLAB_SIZE);
+}
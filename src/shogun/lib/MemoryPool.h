@@ -0,0 +1,145 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society.
+ */
+
+#ifndef __MEMORYPOOL_H__
+#define __MEMORYPOOL_H__
+
+#include <shogun/lib/config.h>
+#include <shogun/lib/common.h>
+
+namespace shogun
+{
+
+/** number of size classes served by the pool (16 bytes ... 32 kilobytes) */
+#define SG_POOL_NUM_CLASSES 12
+/** size of the slabs the pool carves blocks from, slabs are aligned to it */
+#define SG_POOL_SLAB_SIZE (1<<20)
+
+/** @brief Counters of SGMemoryPool.
+ *
+ * The counters are kept per thread and only summed up when requested.
+ * Each is written by its own thread only, with relaxed atomic stores, so
+ * they cost no more than plain increments and are always enabled.
+ */
+struct MemoryPoolStatistics
+{
+	/** number of allocations */
+	uint64_t num_allocs;
+	/** number of frees */
+	uint64_t num_frees;
+	/** number of allocations served from a thread cache */
+	uint64_t num_cache_hits;
+	/** number of allocations larger than the biggest size class */
+	uint64_t num_large_allocs;
+	/** bytes requested by all allocations */
+	uint64_t bytes_requested;
+	/** number of slabs obtained from the system */
+	uint64_t num_slabs;
+};
+
+/** @brief Size-class pool allocator with per-thread caches.
+ *
+ * Requests of up to 32 kilobytes are rounded up to a power of two and
+ * served from per-thread free lists, so the common pattern of a loop
+ * allocating and freeing a temporary buffer of the same size per example
+ * never touches the system allocator nor takes a lock. Blocks are carved
+ * from slabs of SG_POOL_SLAB_SIZE bytes that hold a single size class.
+ * Whenever a thread cache grows too large, half of it is handed over to a
+ * global list from which other threads refill their caches; caches of
+ * exiting threads are returned in the same way. Slabs are never given back
+ * to the system.
+ *
+ * Larger requests are forwarded to malloc. owns() tells pooled from
+ * malloc'ed memory by looking up the slab address in a lock-free table,
+ * hence free() and realloc() accept either kind of pointer.
+ *
+ * When shogun is configured with MALLOC_REPLACEMENT=Pool, SG_MALLOC,
+ * SG_CALLOC, SG_REALLOC and SG_FREE are routed through this pool. Memory
+ * obtained from SG_MALLOC must then never be released with the system's
+ * free().
+ */
+class SGMemoryPool
+{
+public:
+	/** allocate memory
+	 *
+	 * @param size number of bytes
+	 * @return pointer to memory, NULL if the system is out of memory
+	 */
+	static void* allocate(size_t size);
+
+	/** allocate zeroed memory
+	 *
+	 * @param num number of elements
+	 * @param size size of one element
+	 * @return pointer to memory, NULL if the system is out of memory
+	 */
+	static void* allocate_zeroed(size_t num, size_t size);
+
+	/** resize memory obtained from allocate() or malloc()
+	 *
+	 * @param ptr memory to resize, may be NULL
+	 * @param size new size in bytes
+	 * @return pointer to memory, NULL if the system is out of memory
+	 */
+	static void* reallocate(void* ptr, size_t size);
+
+	/** release memory obtained from allocate() or malloc()
+	 *
+	 * @param ptr memory to release, may be NULL
+	 */
+	static void free(void* ptr);
+
+	/** @param ptr pointer
+	 * @return whether ptr points into a slab of the pool
+	 */
+	static bool owns(const void* ptr);
+
+	/** @param ptr pointer into a slab of the pool
+	 * @return usable size of the block
+	 */
+	static size_t get_block_size(const void* ptr);
+
+	/** return the cached blocks of the calling thread to the global lists,
+	 * e.g. before a worker thread goes idle for a long time
+	 */
+	static void flush_thread_cache();
+
+	/** @return counters summed over all threads */
+	static MemoryPoolStatistics get_statistics();
+
+	/** print counters */
+	static void print_statistics();
+
+	/** @param size_class size class
+	 * @return size of the blocks of the class in bytes
+	 */
+	static inline size_t get_class_size(int32_t size_class)
+	{
+		return ((size_t) 16) << size_class;
+	}
+
+	/** @param size number of bytes
+	 * @return smallest size class holding size bytes or -1 if too large
+	 */
+	static inline int32_t get_size_class(size_t size)
+	{
+		int32_t c=0;
+		size_t s=16;
+		while (s<size)
+		{
+			s<<=1;
+			c++;
+		}
+
+		return c<SG_POOL_NUM_CLASSES ? c : -1;
+	}
+};
+}
+#endif // __MEMORYPOOL_H__
@@ -1880,6 +1880,10 @@ static void solve_c_svc(
 	{
 		alpha[i] = 0;
 		if(prob->y[i] > 0) y[i] = +1; else y[i]=-1;
+
+		// the caller is responsible for sum_i y_i alpha0_i=0
+		if (prob->alpha0)
+			alpha[i] = CMath::min(prob->alpha0[i], y[i]>0 ? Cp : Cn);
 	}
 
 	Solver s;
@@ -2392,6 +2396,9 @@ svm_model *svm_train(const svm_problem *prob, const svm_parameter *param)
 		svm_node **x = SG_MALLOC(svm_node *,l);
 		float64_t *C = SG_MALLOC(float64_t,l);
 		float64_t *pv = SG_MALLOC(float64_t,l);
+		float64_t *alpha0 = NULL;
+		if (prob->alpha0 && param->svm_type==C_SVC)
+			alpha0 = SG_MALLOC(float64_t,l);
 
 
 		int32_t i;
@@ -2399,6 +2406,9 @@ svm_model *svm_train(const svm_problem *prob, const svm_parameter *param)
 			x[i] = prob->x[perm[i]];
             C[i] = prob->C[perm[i]];
 
+			if (alpha0)
+				alpha0[i] = CMath::abs(prob->alpha0[perm[i]]);
+
             if (prob->pv)
             {
 	pv[i] = prob->pv[perm[i]];
@@ -2447,6 +2457,12 @@ svm_model *svm_train(const svm_problem *prob, const svm_parameter *param)
 				sub_prob.y = SG_MALLOC(float64_t,sub_prob.l+1); //dirty hack to surpress valgrind err
 				sub_prob.C = SG_MALLOC(float64_t,sub_prob.l+1);
 				sub_prob.pv = SG_MALLOC(float64_t,sub_prob.l+1);
+				if (alpha0)
+				{
+					sub_prob.alpha0 = SG_MALLOC(float64_t,sub_prob.l);
+					memcpy(sub_prob.alpha0, &alpha0[si], sizeof(float64_t)*ci);
+					memcpy(&sub_prob.alpha0[ci], &alpha0[sj], sizeof(float64_t)*cj);
+				}
 
 				int32_t k;
 				for(k=0;k<ci;k++)
@@ -2479,6 +2495,7 @@ svm_model *svm_train(const svm_problem *prob, const svm_parameter *param)
 				SG_FREE(sub_prob.y);
 				SG_FREE(sub_prob.C);
 				SG_FREE(sub_prob.pv);
+				SG_FREE(sub_prob.alpha0);
 				++p;
 			}
 
@@ -2560,6 +2577,7 @@ svm_model *svm_train(const svm_problem *prob, const svm_parameter *param)
 		SG_FREE(x);
 		SG_FREE(C);
 		SG_FREE(pv);
+		SG_FREE(alpha0);
 		SG_FREE(weighted_C);
 		SG_FREE(nonzero);
 		for(i=0;i<nr_class*(nr_class-1)/2;i++)
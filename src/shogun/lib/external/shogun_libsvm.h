@@ -62,6 +62,7 @@ public:
 		x = NULL;
 		C = NULL;
 		pv = NULL;
+		alpha0 = NULL;
 	}
 
 
@@ -75,6 +76,9 @@ public:
     float64_t *C;
     /** precomputed p */
 	float64_t *pv;
+	/** signed initial alphas (y_i*alpha_i) for warm starts, NULL to start
+	 * from zero (C_SVC only) */
+	float64_t *alpha0;
 
 };
 
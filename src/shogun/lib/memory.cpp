@@ -16,6 +16,7 @@
 #include <shogun/lib/SGSparseVector.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/base/SGObject.h>
+#include <shogun/lib/AllocationSampler.h>
 
 #include <string.h>
 
@@ -23,10 +24,24 @@
 #include <jemalloc/jemalloc.h>
 #elif USE_TCMALLOC
 #include <gperftools/tcmalloc.h>
+#elif USE_MEMORY_POOL
+#include <shogun/lib/MemoryPool.h>
 #endif
 
 using namespace shogun;
 
+#ifdef __GNUC__
+#define SG_RETURN_ADDRESS __builtin_return_address(0)
+#else
+#define SG_RETURN_ADDRESS NULL
+#endif
+
+#ifdef TRACE_MEMORY_ALLOCS
+#define SG_ALLOCATION_SITE file, line, NULL
+#else
+#define SG_ALLOCATION_SITE NULL, 0, SG_RETURN_ADDRESS
+#endif
+
 #ifdef TRACE_MEMORY_ALLOCS
 extern CMap<void*, shogun::MemoryBlock>* sg_mallocs;
 
@@ -200,6 +215,8 @@ void* sg_malloc(size_t size
 	void* p=je_malloc(size);
 #elif defined(USE_TCMALLOC)
 	void *p=tc_malloc(size);
+#elif defined(USE_MEMORY_POOL)
+	void* p=SGMemoryPool::allocate(size);
 #else
 	void* p=malloc(size);
 #endif
@@ -207,6 +224,8 @@ void* sg_malloc(size_t size
 	if (sg_mallocs)
 		sg_mallocs->add(p, MemoryBlock(p,size, file, line));
 #endif
+	if (SGAllocationSampler::is_enabled())
+		SGAllocationSampler::record_allocation(p, size, SG_ALLOCATION_SITE);
 
 	if (!p)
 	{
@@ -233,6 +252,8 @@ void* sg_calloc(size_t num, size_t size
 	void* p=je_calloc(num, size);
 #elif defined(USE_TCMALLOC)
 	void* p=tc_calloc(num, size);
+#elif defined(USE_MEMORY_POOL)
+	void* p=SGMemoryPool::allocate_zeroed(num, size);
 #else
 	void* p=calloc(num, size);
 #endif
@@ -241,6 +262,8 @@ void* sg_calloc(size_t num, size_t size
 	if (sg_mallocs)
 		sg_mallocs->add(p, MemoryBlock(p,size, file, line));
 #endif
+	if (SGAllocationSampler::is_enabled())
+		SGAllocationSampler::record_allocation(p, num*size, SG_ALLOCATION_SITE);
 
 	if (!p)
 	{
@@ -265,11 +288,15 @@ void  sg_free(void* ptr)
 	if (sg_mallocs)
 		sg_mallocs->remove(ptr);
 #endif
+	if (SGAllocationSampler::is_enabled())
+		SGAllocationSampler::record_free(ptr);
 
 #if defined(USE_JEMALLOC)
 	je_free(ptr);
 #elif defined(USE_TCMALLOC)
 	tc_free(ptr);
+#elif defined(USE_MEMORY_POOL)
+	SGMemoryPool::free(ptr);
 #else
 	free(ptr);
 #endif
@@ -285,6 +312,8 @@ void* sg_realloc(void* ptr, size_t size
 	void* p=je_realloc(ptr, size);
 #elif defined(USE_TCMALLOC)
 	void* p=tc_realloc(ptr, size);
+#elif defined(USE_MEMORY_POOL)
+	void* p=SGMemoryPool::reallocate(ptr, size);
 #else
 	void* p=realloc(ptr, size);
 #endif
@@ -296,6 +325,18 @@ void* sg_realloc(void* ptr, size_t size
 	if (sg_mallocs)
 		sg_mallocs->add(p, MemoryBlock(p,size, file, line));
 #endif
+	/* a failed realloc leaves the block alive, realloc to zero bytes may
+	 * free it without returning a new one */
+	if (SGAllocationSampler::is_enabled())
+	{
+		if (p)
+		{
+			SGAllocationSampler::record_free(ptr);
+			SGAllocationSampler::record_allocation(p, size, SG_ALLOCATION_SITE);
+		}
+		else if (!size)
+			SGAllocationSampler::record_free(ptr);
+	}
 
 	if (!p && (size || !ptr))
 	{
@@ -317,34 +317,27 @@ private:
 			select_landmarks_random(begin,end,ratio);
 		DenseMatrix distance_matrix =
 			compute_shortest_distances_matrix(begin,end,landmarks,neighbors,distance);
-		distance_matrix = distance_matrix.array().square();
-
-		DenseVector col_means = distance_matrix.colwise().mean();
-		DenseVector row_means = distance_matrix.rowwise().mean();
-		ScalarType grand_mean = distance_matrix.mean();
-		distance_matrix.array() += grand_mean;
-		distance_matrix.colwise() -= row_means;
-		distance_matrix.rowwise() -= col_means.transpose();
-		distance_matrix.array() *= -0.5;
-
-		EigendecompositionResult landmarks_embedding;
-
-		if (eigen_method.is(Dense))
-		{
-			DenseMatrix distance_matrix_sym = distance_matrix*distance_matrix.transpose();
-			landmarks_embedding = eigendecomposition<DenseSymmetricMatrix,DenseImplicitSquareMatrixOperation>
-				(eigen_method,distance_matrix_sym,target_dimension,SkipNoEigenvalues);
-		}
-		else
-		{
-			landmarks_embedding = eigendecomposition<DenseSymmetricMatrix,DenseImplicitSquareMatrixOperation>
-				(eigen_method,distance_matrix,target_dimension,SkipNoEigenvalues);
-		}
-
-		DenseMatrix embedding = distance_matrix.transpose()*landmarks_embedding.first;
+		distance_matrix.array() = distance_matrix.array().square();
+
+		// classic scaling of the landmarks
+		const IndexType n_landmarks = landmarks.size();
+		DenseSymmetricMatrix landmarks_distance_matrix(n_landmarks,n_landmarks);
+		for (IndexType i=0; i<n_landmarks; i++)
+			landmarks_distance_matrix.col(i) = distance_matrix.col(landmarks[i]);
+		DenseVector landmark_distances_squared = landmarks_distance_matrix.colwise().mean();
+		centerMatrix(landmarks_distance_matrix);
+		landmarks_distance_matrix.array() *= -0.5;
+		EigendecompositionResult landmarks_embedding =
+			eigendecomposition<DenseSymmetricMatrix,DenseMatrixOperation>(eigen_method,
+				landmarks_distance_matrix,target_dimension,SkipNoEigenvalues);
 
+		// all vectors are triangulated from their geodesic distances
+		// to the landmarks
 		for (IndexType i=0; i<static_cast<IndexType>(target_dimension); i++)
-			embedding.col(i).array() /= sqrt(sqrt(landmarks_embedding.second(i)));
+			landmarks_embedding.first.col(i).array() /= sqrt(landmarks_embedding.second(i));
+		distance_matrix.colwise() -= landmark_distances_squared;
+		DenseMatrix embedding = -0.5*distance_matrix.transpose()*landmarks_embedding.first;
+
 		return TapkeeOutput(embedding,unimplementedProjectingFunction());
 	}
 
@@ -8,29 +8,148 @@
 
 /* Tapkee includes */
 #include <shogun/lib/tapkee/defines.hpp>
-#include <shogun/lib/tapkee/utils/fibonacci_heap.hpp>
-#include <shogun/lib/tapkee/utils/reservable_priority_queue.hpp>
+#include <shogun/lib/tapkee/utils/binary_heap.hpp>
 #include <shogun/lib/tapkee/utils/time.hpp>
 /* End of Tapkee includes */
 
 #include <limits>
+#include <vector>
+#include <algorithm>
 
 namespace tapkee
 {
 namespace tapkee_internal
 {
 
-#ifdef TAPKEE_USE_PRIORITY_QUEUE
-typedef std::pair<IndexType,ScalarType> HeapElement;
+//! Undirected neighborhood graph in compressed sparse row form.
+//! The edges of the i-th vector are stored at positions
+//! offsets[i],...,offsets[i+1]-1 of targets and lengths.
+struct NeighborhoodGraph
+{
+	std::vector<IndexType> offsets;
+	std::vector<IndexType> targets;
+	std::vector<ScalarType> lengths;
+};
 
-struct HeapElementComparator
+//! Builds the undirected neighborhood graph: vectors are connected
+//! if either of them is a neighbor of the other. Each edge length
+//! is computed only once.
+//!
+//! @param begin begin data iterator
+//! @param end end data iterator
+//! @param neighbors neighbors of each vector
+//! @param callback distance callback
+//!
+template <class RandomAccessIterator, class DistanceCallback>
+NeighborhoodGraph neighborhood_graph(const RandomAccessIterator& begin, const RandomAccessIterator& end,
+		const Neighbors& neighbors, DistanceCallback callback)
 {
-	inline bool operator()(const HeapElement& l, const HeapElement& r) const
+	const IndexType N = (end-begin);
+
+	// lengths of the neighbor relations, list after list
+	std::vector<IndexType> list_offsets(N+1,0);
+	for (IndexType i=0; i<N; i++)
+		list_offsets[i+1] = list_offsets[i] + neighbors[i].size();
+	std::vector<ScalarType> list_lengths(list_offsets[N]);
+
+#pragma omp parallel shared(begin,neighbors,callback,list_offsets,list_lengths) default(none)
 	{
-		return l.second > r.second;
+		IndexType i;
+#pragma omp for nowait
+		for (i=0; i<N; i++)
+		{
+			for (IndexType j=0; j<static_cast<IndexType>(neighbors[i].size()); j++)
+				list_lengths[list_offsets[i]+j] = callback.distance(begin[i],begin[neighbors[i][j]]);
+		}
 	}
-};
-#endif
+
+	// a reversed relation is an edge unless it is a relation itself
+	std::vector<char> reversed(list_offsets[N],0);
+	std::vector<IndexType> degrees(N,0);
+	for (IndexType i=0; i<N; i++)
+	{
+		for (IndexType j=0; j<static_cast<IndexType>(neighbors[i].size()); j++)
+		{
+			IndexType w = neighbors[i][j];
+			if (w == i)
+				continue;
+			degrees[i]++;
+			if (std::find(neighbors[w].begin(),neighbors[w].end(),i) == neighbors[w].end())
+			{
+				reversed[list_offsets[i]+j] = 1;
+				degrees[w]++;
+			}
+		}
+	}
+
+	NeighborhoodGraph graph;
+	graph.offsets.resize(N+1);
+	graph.offsets[0] = 0;
+	for (IndexType i=0; i<N; i++)
+		graph.offsets[i+1] = graph.offsets[i] + degrees[i];
+	graph.targets.resize(graph.offsets[N]);
+	graph.lengths.resize(graph.offsets[N]);
+
+	std::vector<IndexType> filled(graph.offsets.begin(),graph.offsets.end()-1);
+	for (IndexType i=0; i<N; i++)
+	{
+		for (IndexType j=0; j<static_cast<IndexType>(neighbors[i].size()); j++)
+		{
+			IndexType w = neighbors[i][j];
+			if (w == i)
+				continue;
+			ScalarType length = list_lengths[list_offsets[i]+j];
+			graph.targets[filled[i]] = w;
+			graph.lengths[filled[i]++] = length;
+			if (reversed[list_offsets[i]+j])
+			{
+				graph.targets[filled[w]] = i;
+				graph.lengths[filled[w]++] = length;
+			}
+		}
+	}
+	return graph;
+}
+
+//! Computes shortest distances from one vector to all vectors
+//! using Dijkstra algorithm. Vectors that are not reachable get
+//! the maximal scalar value.
+//!
+//! @param graph neighborhood graph
+//! @param source vector to compute distances from
+//! @param heap empty heap of graph size, it is empty again on return
+//! @param distances array of graph size the distances are stored to
+//!
+inline void compute_shortest_distances(const NeighborhoodGraph& graph, IndexType source,
+		binary_heap& heap, ScalarType* distances)
+{
+	const IndexType N = graph.offsets.size()-1;
+	std::fill(distances,distances+N,std::numeric_limits<ScalarType>::max());
+	distances[source] = 0.0;
+	heap.insert(source,0.0);
+
+	while (!heap.empty())
+	{
+		// vectors leaving the heap are settled: no edge can
+		// lower their distance anymore
+		ScalarType min_item_d;
+		IndexType min_item = heap.extract_min(min_item_d);
+
+		for (IndexType e=graph.offsets[min_item]; e<graph.offsets[min_item+1]; e++)
+		{
+			IndexType w = graph.targets[e];
+			ScalarType dist = min_item_d + graph.lengths[e];
+			if (dist < distances[w])
+			{
+				if (heap.contains(w))
+					heap.decrease_key(w,dist);
+				else
+					heap.insert(w,dist);
+				distances[w] = dist;
+			}
+		}
+	}
+}
 
 //! Computes shortest distances (so-called geodesic distances)
 //! using Dijkstra algorithm.
@@ -45,111 +164,31 @@ DenseSymmetricMatrix compute_shortest_distances_matrix(const RandomAccessIterato
 		const Neighbors& neighbors, DistanceCallback callback)
 {
 	timed_context context("Distances shortest path relaxing");
-	const IndexType n_neighbors = neighbors[0].size();
 	const IndexType N = (end-begin);
 
+	NeighborhoodGraph graph = neighborhood_graph(begin,end,neighbors,callback);
 	DenseSymmetricMatrix shortest_distances(N,N);
 
-#pragma omp parallel shared(shortest_distances,neighbors,begin,callback) default(none)
+#pragma omp parallel shared(shortest_distances,graph) default(none)
 	{
-		bool* f = new bool[N];
-		bool* s = new bool[N];
+		binary_heap heap(N);
 		IndexType k;
 
-#ifdef TAPKEE_USE_PRIORITY_QUEUE
-		reservable_priority_queue<HeapElement,HeapElementComparator> heap(N);
-#else
-		fibonacci_heap heap(N);
-#endif
-
 #pragma omp for nowait
 		for (k=0; k<N; k++)
 		{
-			// fill s and f with false, fill shortest_D with infinity
-			for (IndexType j=0; j<N; j++)
-			{
-				shortest_distances(k,j) = std::numeric_limits<DenseMatrix::Scalar>::max();
-				s[j] = false;
-				f[j] = false;
-			}
-			// set distance from k to k as zero
-			shortest_distances(k,k) = 0.0;
-
-			// insert kth object to heap with zero distance and set f[k] true
-#ifdef TAPKEE_USE_PRIORITY_QUEUE
-			HeapElement heap_element_of_self(k,0.0);
-			heap.push(heap_element_of_self);
-#else
-			heap.insert(k,0.0);
-#endif
-			f[k] = true;
-
-			// while heap is not empty
-			while (!heap.empty())
-			{
-				// extract min and set (s)olution state as true and (f)rontier as false
-#ifdef TAPKEE_USE_PRIORITY_QUEUE
-				int min_item = heap.top().first;
-				ScalarType min_item_d = heap.top().second;
-				heap.pop();
-				if (min_item_d > shortest_distances(k,min_item))
-					continue;
-#else
-				ScalarType tmp;
-				int min_item = heap.extract_min(tmp);
-#endif
-
-				s[min_item] = true;
-				f[min_item] = false;
-
-				// for-each edge (min_item->w)
-				for (IndexType i=0; i<n_neighbors; i++)
-				{
-					// get w idx
-					int w = neighbors[min_item][i];
-					// if w is not in solution yet
-					if (s[w] == false)
-					{
-						// get distance from k to i through min_item
-						ScalarType dist = shortest_distances(k,min_item) + callback.distance(begin[min_item],begin[w]);
-						// if distance can be relaxed
-						if (dist < shortest_distances(k,w))
-						{
-							// relax distance
-							shortest_distances(k,w) = dist;
-#ifdef TAPKEE_USE_PRIORITY_QUEUE
-							HeapElement relaxed_heap_element(w,dist);
-							heap.push(relaxed_heap_element);
-							f[w] = true;
-#else
-							// if w is in (f)rontier
-							if (f[w])
-							{
-								// decrease distance in heap
-								heap.decrease_key(w, dist);
-							}
-							else
-							{
-								// insert w to heap and set (f)rontier as true
-								heap.insert(w, dist);
-								f[w] = true;
-							}
-#endif
-						}
-					}
-				}
-			}
-			heap.clear();
+			// the graph is undirected, so the distances from the
+			// kth vector are its column as well as its row
+			compute_shortest_distances(graph,k,heap,shortest_distances.col(k).data());
 		}
-
-		delete[] s;
-		delete[] f;
 	}
 	return shortest_distances;
 }
 
 //! Computes shortest distances (so-called geodesic distances)
-//! using Dijkstra algorithm with landmarks.
+//! using Dijkstra algorithm with landmarks. Only distances from
+//! the landmarks are computed and stored, so the memory needed
+//! is linear in the number of vectors.
 //!
 //! @param begin begin data iterator
 //! @param end end data iterator
@@ -162,106 +201,24 @@ DenseMatrix compute_shortest_distances_matrix(const RandomAccessIterator& begin,
 		const Landmarks& landmarks, const Neighbors& neighbors, DistanceCallback callback)
 {
 	timed_context context("Distances shortest path relaxing");
-	const IndexType n_neighbors = neighbors[0].size();
 	const IndexType N = end-begin;
 	const IndexType N_landmarks = landmarks.size();
 
-	DenseMatrix shortest_distances(landmarks.size(),N);
+	NeighborhoodGraph graph = neighborhood_graph(begin,end,neighbors,callback);
+	DenseMatrix shortest_distances(N_landmarks,N);
 
-#pragma omp parallel shared(shortest_distances,begin,landmarks,neighbors,callback) default(none)
+#pragma omp parallel shared(shortest_distances,landmarks,graph) default(none)
 	{
-		bool* f = new bool[N];
-		bool* s = new bool[N];
+		binary_heap heap(N);
+		DenseVector distances(N);
 		IndexType k;
 
-#ifdef TAPKEE_USE_PRIORITY_QUEUE
-		reservable_priority_queue<HeapElement,HeapElementComparator> heap(N);
-#else
-		fibonacci_heap heap(N);
-#endif
-
 #pragma omp for nowait
 		for (k=0; k<N_landmarks; k++)
 		{
-			// fill s and f with false, fill shortest_D with infinity
-			for (IndexType j=0; j<N; j++)
-			{
-				shortest_distances(k,j) = std::numeric_limits<DenseMatrix::Scalar>::max();
-				s[j] = false;
-				f[j] = false;
-			}
-			// set distance from k to k as zero
-			shortest_distances(k,landmarks[k]) = 0.0;
-
-			// insert kth object to heap with zero distance and set f[k] true
-#ifdef TAPKEE_USE_PRIORITY_QUEUE
-			HeapElement heap_element_of_self(landmarks[k],0.0);
-			heap.push(heap_element_of_self);
-#else
-			heap.insert(landmarks[k],0.0);
-#endif
-			f[k] = true;
-
-			// while heap is not empty
-			while (!heap.empty())
-			{
-				// extract min and set (s)olution state as true and (f)rontier as false
-#ifdef TAPKEE_USE_PRIORITY_QUEUE
-				int min_item = heap.top().first;
-				ScalarType min_item_d = heap.top().second;
-				heap.pop();
-				if (min_item_d > shortest_distances(k,min_item))
-					continue;
-#else
-				ScalarType tmp;
-				int min_item = heap.extract_min(tmp);
-#endif
-
-				s[min_item] = true;
-				f[min_item] = false;
-
-				// for-each edge (min_item->w)
-				for (IndexType i=0; i<n_neighbors; i++)
-				{
-					// get w idx
-					int w = neighbors[min_item][i];
-					// if w is not in solution yet
-					if (s[w] == false)
-					{
-						// get distance from k to i through min_item
-						ScalarType dist = shortest_distances(k,min_item) + callback.distance(begin[min_item],begin[w]);
-						// if distance can be relaxed
-						if (dist < shortest_distances(k,w))
-						{
-							// relax distance
-							shortest_distances(k,w) = dist;
-#ifdef TAPKEE_USE_PRIORITY_QUEUE
-							HeapElement relaxed_heap_element(w,dist);
-							heap.push(relaxed_heap_element);
-							f[w] = true;
-#else
-							// if w is in (f)rontier
-							if (f[w])
-							{
-								// decrease distance in heap
-								heap.decrease_key(w, dist);
-							}
-							else
-							{
-								// insert w to heap and set (f)rontier as true
-								heap.insert(w, dist);
-								f[w] = true;
-							}
-#endif
-						}
-					}
-				}
-			}
-			heap.clear();
+			compute_shortest_distances(graph,landmarks[k],heap,distances.data());
+			shortest_distances.row(k) = distances.transpose();
 		}
-
-		delete[] s;
-		delete[] f;
 	}
 	return shortest_distances;
 }
@@ -0,0 +1,163 @@
+/* This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Copyright (c) 2014 Berlin Institute of Technology and Max-Planck-Society
+ */
+
+#ifndef TAPKEE_BINARY_HEAP_H_
+#define TAPKEE_BINARY_HEAP_H_
+
+/* Tapkee includes */
+#include <shogun/lib/tapkee/defines.hpp>
+/* End of Tapkee includes */
+
+#include <vector>
+
+namespace tapkee
+{
+namespace tapkee_internal
+{
+
+//! Indexed binary min-heap of items 0..capacity-1 supporting
+//! decrease-key. Items and their keys are kept in two flat arrays
+//! and the position of every item is tracked, so there are no
+//! per-item allocations as in @ref fibonacci_heap.
+class binary_heap
+{
+public:
+
+	//! Constructs an empty heap
+	//! @param capacity number of possible items
+	binary_heap(IndexType capacity) :
+		items(), keys(), positions(capacity,-1)
+	{
+		items.reserve(capacity);
+		keys.reserve(capacity);
+	}
+
+	//! Inserts an item that is not contained in the heap
+	inline void insert(IndexType index, ScalarType key)
+	{
+		positions[index] = items.size();
+		items.push_back(index);
+		keys.push_back(key);
+		sift_up(items.size()-1);
+	}
+
+	//! Returns true if the heap is empty
+	inline bool empty() const
+	{
+		return items.empty();
+	}
+
+	//! Returns true if the item is contained in the heap
+	inline bool contains(IndexType index) const
+	{
+		return positions[index] >= 0;
+	}
+
+	//! Removes the item with the minimal key
+	//! @param ret_key the minimal key
+	//! @return the item with the minimal key
+	inline IndexType extract_min(ScalarType& ret_key)
+	{
+		IndexType result = items[0];
+		ret_key = keys[0];
+		positions[result] = -1;
+
+		IndexType last = items.size()-1;
+		if (last > 0)
+		{
+			items[0] = items[last];
+			keys[0] = keys[last];
+			positions[items[0]] = 0;
+		}
+		items.pop_back();
+		keys.pop_back();
+		if (last > 0)
+			sift_down(0);
+		return result;
+	}
+
+	//! Lowers the key of an item contained in the heap
+	inline void decrease_key(IndexType index, ScalarType key)
+	{
+		IndexType position = positions[index];
+		keys[position] = key;
+		sift_up(position);
+	}
+
+	//! Removes all items
+	inline void clear()
+	{
+		for (IndexType i=0; i<static_cast<IndexType>(items.size()); i++)
+			positions[items[i]] = -1;
+		items.clear();
+		keys.clear();
+	}
+
+private:
+
+	inline void sift_up(IndexType position)
+	{
+		IndexType item = items[position];
+		ScalarType key = keys[position];
+		while (position > 0)
+		{
+			IndexType parent = (position-1)/2;
+			if (keys[parent] <= key)
+				break;
+			move(parent,position);
+			position = parent;
+		}
+		place(item,key,position);
+	}
+
+	inline void sift_down(IndexType position)
+	{
+		IndexType item = items[position];
+		ScalarType key = keys[position];
+		IndexType size = items.size();
+		while (true)
+		{
+			IndexType child = 2*position+1;
+			if (child >= size)
+				break;
+			if (child+1 < size && keys[child+1] < keys[child])
+				child++;
+			if (key <= keys[child])
+				break;
+			move(child,position);
+			position = child;
+		}
+		place(item,key,position);
+	}
+
+	inline void move(IndexType from, IndexType to)
+	{
+		items[to] = items[from];
+		keys[to] = keys[from];
+		positions[items[to]] = to;
+	}
+
+	inline void place(IndexType item, ScalarType key, IndexType position)
+	{
+		items[position] = item;
+		keys[position] = key;
+		positions[item] = position;
+	}
+
+private:
+
+	//! items in heap order
+	std::vector<IndexType> items;
+	//! keys of the items in heap order
+	std::vector<ScalarType> keys;
+	//! position of each item in the heap, -1 if it is not contained
+	std::vector<IndexType> positions;
+
+};
+
+}
+}
+
+#endif
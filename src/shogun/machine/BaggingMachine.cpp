@@ -10,9 +10,16 @@
 
 #include <shogun/machine/BaggingMachine.h>
 #include <shogun/base/Parameter.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/lib/ShogunException.h>
+#include <shogun/machine/DecisionTree.h>
+#include <shogun/mathematics/Random.h>
 
 using namespace shogun;
 
+/** bytes of bag outputs kept at once while applying the bags */
+#define BAGGING_BATCH_BYTES (64*1024*1024)
+
 CBaggingMachine::CBaggingMachine()
 	: CMachine()
 {
@@ -38,7 +45,6 @@ CBaggingMachine::~CBaggingMachine()
 	SG_UNREF(m_features);
 	SG_UNREF(m_combination_rule);
 	SG_UNREF(m_bags);
-	SG_UNREF(m_oob_indices);
 }
 
 CBinaryLabels* CBaggingMachine::apply_binary(CFeatures* data)
@@ -72,23 +78,64 @@ SGVector<float64_t> CBaggingMachine::apply_get_outputs(CFeatures* data)
 	REQUIRE(m_combination_rule != NULL, "Combination rule is not set!");
 	ASSERT(m_num_bags == m_bags->get_num_elements());
 
-	SGMatrix<float64_t> output(data->get_num_vectors(), m_num_bags);
-	output.zero();
+	int32_t num_vectors = data->get_num_vectors();
+	int32_t batch_size = get_batch_size(num_vectors);
+	SGVector<float64_t> combined(num_vectors);
 
-	#pragma omp parallel for num_threads(parallel->get_num_threads())
-	for (int32_t i = 0; i < m_num_bags; ++i)
+	for (int32_t start = 0; start < num_vectors; start += batch_size)
 	{
-		CMachine* m = dynamic_cast<CMachine*>(m_bags->get_element(i));
-		CLabels* l = m->apply(data);
-		SGVector<float64_t> lv = l->get_values();
-		float64_t* bag_results = output.get_column_vector(i);
-		memcpy(bag_results, lv.vector, lv.vlen*sizeof(float64_t));
-
-		SG_UNREF(l);
-		SG_UNREF(m);
-	}
+		int32_t n = CMath::min(batch_size, num_vectors-start);
+		CFeatures* batch = data;
+		if (n < num_vectors)
+		{
+			SGVector<index_t> idx(n);
+			idx.range_fill(start);
+			batch = get_view(data, idx);
+		}
+
+		SGMatrix<float64_t> output(n, m_num_bags);
+		output.zero();
+
+		bool failed = false;
+		char error[1024];
+		memset(error, 0, sizeof(error));
+
+		#pragma omp parallel for schedule(dynamic) num_threads(get_num_bag_threads())
+		for (int32_t i = 0; i < m_num_bags; ++i)
+		{
+			if (failed)
+				continue;
+
+			CMachine* m = dynamic_cast<CMachine*>(m_bags->get_element(i));
+			try
+			{
+				CLabels* l = m->apply(batch);
+				SGVector<float64_t> lv = l->get_values();
+				float64_t* bag_results = output.get_column_vector(i);
+				memcpy(bag_results, lv.vector, lv.vlen*sizeof(float64_t));
+				SG_UNREF(l);
+			}
+			catch (ShogunException& e)
+			{
+				#pragma omp critical (bagging_error)
+				{
+					if (!failed)
+						strncpy(error, e.get_exception_string(), sizeof(error)-1);
+					failed = true;
+				}
+			}
+			SG_UNREF(m);
+		}
 
-	SGVector<float64_t> combined = m_combination_rule->combine(output);
+		if (batch != data)
+			SG_UNREF(batch);
+
+		if (failed)
+			SG_ERROR("%s", error)
+
+		SGVector<float64_t> part = m_combination_rule->combine(output);
+		memcpy(&combined[start], part.vector, n*sizeof(float64_t));
+	}
 
 	return combined;
 }
@@ -108,64 +155,165 @@ bool CBaggingMachine::train_machine(CFeatures* data)
 		ASSERT(m_features->get_num_vectors() == m_labels->get_num_labels());
 	}
 
+	int32_t num_vectors = m_features->get_num_vectors();
+
 	// bag size << number of feature vector
-	ASSERT(m_bag_size < m_features->get_num_vectors());
+	ASSERT(m_bag_size < num_vectors);
 
 	// clear the array, if previously trained
 	m_bags->reset_array();
 
-	// reset the oob index vector
-	m_all_oob_idx = SGVector<bool>(m_features->get_num_vectors());
-	m_all_oob_idx.zero();
+	// the bags are drawn from their own generators, which keeps them
+	// independent of the order in which the threads train them
+	m_bag_seeds = SGVector<int32_t>(m_num_bags);
+	for (int32_t i = 0; i < m_num_bags; ++i)
+		m_bag_seeds[i] = (int32_t) CMath::random();
 
-	SG_UNREF(m_oob_indices);
-	m_oob_indices = new CDynamicObjectArray();
+	// number of bags each vector is in
+	SGVector<int32_t> in_bags(num_vectors);
+	in_bags.zero();
 
-	/*
-	  TODO: enable multi-threaded learning. This requires views support
-		on CFeatures
-	#pragma omp parallel for num_threads(parallel->get_num_threads())
-	*/
+	CMachine** machines = SG_MALLOC(CMachine*, m_num_bags);
+	for (int32_t i = 0; i < m_num_bags; ++i)
+		machines[i] = NULL;
+
+	// errors must not leave the parallel region, the first one is raised
+	// once all bags are done
+	bool failed = false;
+	char error[1024];
+	memset(error, 0, sizeof(error));
+
+	#pragma omp parallel for schedule(dynamic) num_threads(get_num_bag_threads())
 	for (int32_t i = 0; i < m_num_bags; ++i)
 	{
-		CMachine* c = dynamic_cast<CMachine*>(m_machine->clone());
-		ASSERT(c != NULL);
-		SGVector<index_t> idx(m_bag_size);
-		idx.random(0, m_features->get_num_vectors()-1);
-		m_labels->add_subset(idx);
-		/* TODO:
-		   if it's a binary labeling ensure that
-		   there's always samples of both classes
-		if ((m_labels->get_label_type() == LT_BINARY))
+		if (failed)
+			continue;
+
+		CFeatures* bag_features = NULL;
+		try
 		{
-			while (true) {
-				if (!m_labels->ensure_valid()) {
-					m_labels->remove_subset();
-					idx.random(0, m_features->get_num_vectors());
-					m_labels->add_subset(idx);
-					continue;
+			int32_t machine_seed;
+			SGVector<index_t> idx = get_bag_indices(i, &machine_seed);
+
+			CMachine* c;
+			CLabels* labels;
+			#pragma omp critical (bagging_clone)
+			{
+				c = dynamic_cast<CMachine*>(m_machine->clone());
+				labels = (CLabels*) m_labels->shared_clone();
+			}
+			REQUIRE(c != NULL, "Could not clone %s\n", m_machine->get_name());
+			REQUIRE(labels != NULL, "Could not create a view on %s\n",
+					m_labels->get_name());
+			machines[i] = c;
+
+			labels->add_subset(idx);
+			c->set_labels(labels);
+			SG_UNREF(labels);
+
+			// trees of a forest are grown from the seed of their bag
+			CDecisionTree* tree = dynamic_cast<CDecisionTree*>(c);
+			if (tree != NULL)
+				tree->set_seed(machine_seed);
+
+			/* the bag is a view on the shared training data, unless it is
+			 * small enough to be compacted. trained machines may keep their
+			 * features, so the size limit of the compacted copies is shared
+			 * among all bags */
+			CFeatures* view = get_view(m_features, idx);
+			bag_features = view->materialize_subset(m_num_bags);
+			SG_UNREF(view);
+			c->train(bag_features);
+			SG_UNREF(bag_features);
+
+			// the indices are sorted, count every vector once
+			for (index_t j = 0; j < idx.vlen; ++j)
+			{
+				if (j == 0 || idx[j] != idx[j-1])
+				{
+					#pragma omp atomic
+					in_bags[idx[j]]++;
 				}
-				break;
 			}
 		}
-		*/
-		m_features->add_subset(idx);
-		c->set_labels(m_labels);
-		c->train(m_features);
-		m_features->remove_subset();
-		m_labels->remove_subset();
-
-		// get out of bag indexes
-		CDynamicArray<index_t>* oob = get_oob_indices(idx);
-		m_oob_indices->push_back(oob);
-
-		// add trained machine to bag array
-		m_bags->append_element(c);
+		catch (ShogunException& e)
+		{
+			SG_UNREF(bag_features);
+			#pragma omp critical (bagging_error)
+			{
+				if (!failed)
+					strncpy(error, e.get_exception_string(), sizeof(error)-1);
+				failed = true;
+			}
+		}
 	}
 
+	if (failed)
+	{
+		for (int32_t i = 0; i < m_num_bags; ++i)
+			SG_UNREF(machines[i]);
+		SG_FREE(machines);
+		SG_ERROR("%s", error)
+	}
+
+	// add trained machines to bag array
+	for (int32_t i = 0; i < m_num_bags; ++i)
+	{
+		m_bags->append_element(machines[i]);
+		SG_UNREF(machines[i]);
+	}
+	SG_FREE(machines);
+
+	// vectors that are out of at least one bag
+	m_all_oob_idx = SGVector<bool>(num_vectors);
+	for (index_t i = 0; i < num_vectors; ++i)
+		m_all_oob_idx[i] = in_bags[i] < m_num_bags;
+
 	return true;
 }
 
+SGVector<index_t> CBaggingMachine::get_bag_indices(int32_t bag,
+		int32_t* machine_seed) const
+{
+	CRandom prng((uint32_t) m_bag_seeds[bag]);
+	int32_t num_vectors = m_features->get_num_vectors();
+
+	SGVector<index_t> idx(m_bag_size);
+	for (index_t j = 0; j < m_bag_size; ++j)
+		idx[j] = prng.random(0, num_vectors-1);
+
+	if (machine_seed)
+		*machine_seed = prng.random_s32();
+
+	// ascending indices access the shared data in order
+	CMath::qsort(idx.vector, idx.vlen);
+
+	return idx;
+}
+
+CFeatures* CBaggingMachine::get_view(CFeatures* features, SGVector<index_t> idx)
+{
+	CFeatures* view;
+	#pragma omp critical (bagging_clone)
+	view = (CFeatures*) features->shared_clone();
+	REQUIRE(view != NULL, "Could not create a view on %s\n",
+			features->get_name());
+
+	view->add_subset(idx);
+	return view;
+}
+
+int32_t CBaggingMachine::get_num_bag_threads() const
+{
+	return m_parallel_bags ? parallel->get_num_threads() : 1;
+}
+
+int32_t CBaggingMachine::get_batch_size(int32_t num_vectors) const
+{
+	int64_t batch = BAGGING_BATCH_BYTES/(sizeof(float64_t)*CMath::max(m_num_bags, 1));
+	return (int32_t) CMath::max(CMath::min(batch, (int64_t) num_vectors), (int64_t) 1);
+}
+
 void CBaggingMachine::register_parameters()
 {
 	SG_ADD((CSGObject**)&m_features, "features", "Train features for bagging",
@@ -177,8 +325,10 @@ void CBaggingMachine::register_parameters()
 		"Combination rule to use for aggregating", MS_AVAILABLE);
 	SG_ADD(&m_all_oob_idx, "all_oob_idx", "Indices of all oob vectors",
 			MS_NOT_AVAILABLE);
-	SG_ADD((CSGObject**)&m_oob_indices, "oob_indices",
-			"OOB indices for each machine", MS_NOT_AVAILABLE);
+	SG_ADD(&m_bag_seeds, "bag_seeds", "Random seed of each bag",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_parallel_bags, "parallel_bags",
+			"Whether bags are trained and applied in parallel", MS_NOT_AVAILABLE);
 }
 
 void CBaggingMachine::set_num_bags(int32_t num_bags)
@@ -201,6 +351,16 @@ int32_t CBaggingMachine::get_bag_size() const
 	return m_bag_size;
 }
 
+void CBaggingMachine::set_parallel_bags(bool parallel_bags)
+{
+	m_parallel_bags = parallel_bags;
+}
+
+bool CBaggingMachine::get_parallel_bags() const
+{
+	return m_parallel_bags;
+}
+
 CMachine* CBaggingMachine::get_machine() const
 {
 	SG_REF(m_machine);
@@ -224,7 +384,8 @@ void CBaggingMachine::init()
 	m_num_bags = 0;
 	m_bag_size = 0;
 	m_all_oob_idx = SGVector<bool>();
-	m_oob_indices = NULL;
+	m_bag_seeds = SGVector<int32_t>();
+	m_parallel_bags = false;
 }
 
 void CBaggingMachine::set_combination_rule(CCombinationRule* rule)
@@ -245,48 +406,107 @@ float64_t CBaggingMachine::get_oob_error(CEvaluation* eval) const
 	REQUIRE(m_combination_rule != NULL, "Combination rule is not set!");
 	REQUIRE(m_bags->get_num_elements() > 0, "BaggingMachine is not trained!");
 
-	SGMatrix<float64_t> output(m_features->get_num_vectors(), m_bags->get_num_elements());
-	if (m_labels->get_label_type() == LT_REGRESSION)
-		output.zero();
-	else
-		output.set_const(NAN);
+	int32_t num_vectors = m_features->get_num_vectors();
+	int32_t num_bags = m_bags->get_num_elements();
+
+	DynArray<index_t> idx;
+	for (index_t i = 0; i < num_vectors; i++)
+	{
+		if (m_all_oob_idx[i])
+			idx.push_back(i);
+	}
+	int32_t num_oob = idx.get_num_elements();
+	REQUIRE(num_oob > 0, "No vector is out of bag!");
+
+	// in-bag vectors of every bag, one bit per vector
+	int32_t num_words = (num_vectors+63)/64;
+	SGMatrix<uint64_t> in_bag(num_words, num_bags);
+	in_bag.zero();
 
-	/* TODO: add parallel support of applying the OOBs
-	  only possible when add_subset is thread-safe
 	#pragma omp parallel for num_threads(parallel->get_num_threads())
-	*/
-	for (index_t i = 0; i < m_bags->get_num_elements(); i++)
+	for (index_t i = 0; i < num_bags; i++)
 	{
-		CMachine* m = dynamic_cast<CMachine*>(m_bags->get_element(i));
-		CDynamicArray<index_t>* current_oob
-			= dynamic_cast<CDynamicArray<index_t>*>(m_oob_indices->get_element(i));
+		SGVector<index_t> bag = get_bag_indices(i);
+		uint64_t* bits = in_bag.get_column_vector(i);
+		for (index_t j = 0; j < bag.vlen; j++)
+			bits[bag[j]/64] |= uint64_t(1) << (bag[j]%64);
+	}
 
-		SGVector<index_t> oob(current_oob->get_array(), current_oob->get_num_elements(), false);
-		oob.display_vector();
-		m_features->add_subset(oob);
+	int32_t batch_size = get_batch_size(num_oob);
+	SGVector<float64_t> combined(num_oob);
 
-		CLabels* l = m->apply(m_features);
-		SGVector<float64_t> lv = l->get_values();
+	for (int32_t start = 0; start < num_oob; start += batch_size)
+	{
+		int32_t n = CMath::min(batch_size, num_oob-start);
 
 		// assign the values in the matrix (NAN) that are in-bag!
-		for (index_t j = 0; j < oob.vlen; j++)
-			output(oob[j], i) = lv[j];
+		SGMatrix<float64_t> output(n, num_bags);
+		if (m_labels->get_label_type() == LT_REGRESSION)
+			output.zero();
+		else
+			output.set_const(NAN);
+
+		bool failed = false;
+		char error[1024];
+		memset(error, 0, sizeof(error));
+
+		#pragma omp parallel for schedule(dynamic) num_threads(get_num_bag_threads())
+		for (index_t i = 0; i < num_bags; i++)
+		{
+			if (failed)
+				continue;
+
+			const uint64_t* bits = in_bag.get_column_vector(i);
+			DynArray<index_t> rows;
+			DynArray<index_t> oob;
+			for (index_t j = start; j < start+n; j++)
+			{
+				index_t v = idx[j];
+				if (!(bits[v/64] & (uint64_t(1) << (v%64))))
+				{
+					rows.push_back(j-start);
+					oob.push_back(v);
+				}
+			}
 
-		m_features->remove_subset();
-		SG_UNREF(current_oob);
-		SG_UNREF(m);
-		SG_UNREF(l);
-	}
-	output.display_matrix();
+			if (oob.get_num_elements() == 0)
+				continue;
 
-	DynArray<index_t> idx;
-	for (index_t i = 0; i < m_features->get_num_vectors(); i++)
-	{
-		if (m_all_oob_idx[i])
-			idx.push_back(i);
+			CMachine* m = dynamic_cast<CMachine*>(m_bags->get_element(i));
+			CFeatures* view = NULL;
+			try
+			{
+				view = get_view(m_features, SGVector<index_t>(
+							oob.get_array(), oob.get_num_elements(), false));
+
+				CLabels* l = m->apply(view);
+				SGVector<float64_t> lv = l->get_values();
+
+				// every bag writes its own column
+				for (index_t j = 0; j < rows.get_num_elements(); j++)
+					output(rows[j], i) = lv[j];
+				SG_UNREF(l);
+			}
+			catch (ShogunException& e)
+			{
+				#pragma omp critical (bagging_error)
+				{
+					if (!failed)
+						strncpy(error, e.get_exception_string(), sizeof(error)-1);
+					failed = true;
+				}
+			}
+			SG_UNREF(view);
+			SG_UNREF(m);
+		}
+
+		if (failed)
+			SG_ERROR("%s", error)
+
+		SGVector<float64_t> part = m_combination_rule->combine(output);
+		memcpy(&combined[start], part.vector, n*sizeof(float64_t));
 	}
 
-	SGVector<float64_t> combined = m_combination_rule->combine(output);
 	CLabels* predicted = NULL;
 	switch (m_labels->get_label_type())
 	{
@@ -305,41 +525,12 @@ float64_t CBaggingMachine::get_oob_error(CEvaluation* eval) const
 		default:
 			SG_ERROR("Unsupported label type\n");
 	}
+	SG_REF(predicted);
 
-	m_labels->add_subset(SGVector<index_t>(idx.get_array(), idx.get_num_elements(), false));
+	m_labels->add_subset(SGVector<index_t>(idx.get_array(), num_oob, false));
 	float64_t res = eval->evaluate(predicted, m_labels);
 	m_labels->remove_subset();
+	SG_UNREF(predicted);
 
 	return res;
 }
-
-CDynamicArray<index_t>* CBaggingMachine::get_oob_indices(const SGVector<index_t>& in_bag)
-{
-	SGVector<bool> out_of_bag(m_features->get_num_vectors());
-	out_of_bag.set_const(true);
-
-	// mark the ones that are in_bag
-	index_t oob_count = m_features->get_num_vectors();
-	for (index_t i = 0; i < in_bag.vlen; i++)
-	{
-		if (out_of_bag[in_bag[i]])
-		{
-			out_of_bag[in_bag[i]] = false;
-			oob_count--;
-		}
-	}
-
-	CDynamicArray<index_t>* oob = new CDynamicArray<index_t>();
-	// store the indicies of vectors that are out of the bag
-	for (index_t i = 0; i < out_of_bag.vlen; i++)
-	{
-		if (out_of_bag[i])
-		{
-			oob->push_back(i);
-			m_all_oob_idx[i] = true;
-		}
-	}
-
-	return oob;
-}
-
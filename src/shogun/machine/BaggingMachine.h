@@ -20,7 +20,22 @@ namespace shogun
 	/**
 	 * @brief: Bagging algorithm
 	 * i.e. bootstrap aggregating
-     */
+	 *
+	 * A bag is a view on the training features and labels, i.e. a
+	 * shared_clone() with the bootstrap sample as subset, so the data is not
+	 * copied per bag unless CFeatures::materialize_subset() decides to
+	 * compact a small bag. Only the random seed of each bag is stored, its
+	 * vectors are drawn again from it when needed. Applying the ensemble and
+	 * computing the out-of-bag error work on batches of vectors, so the
+	 * memory for the outputs grows with the number of bags but not with the
+	 * number of vectors.
+	 *
+	 * The bags can be trained and applied in parallel, see
+	 * set_parallel_bags(). This is off by default, as the machine is then
+	 * trained and applied from several threads at once. A CDecisionTree
+	 * gets a random seed derived from the seed of its bag, so a random
+	 * forest is the same whatever the number of threads.
+	 */
 	class CBaggingMachine : public CMachine
 	{
 		public:
@@ -100,6 +115,23 @@ namespace shogun
 			 */
 			CCombinationRule* get_combination_rule() const;
 
+			/**
+			 * Set whether the bags are trained and applied in parallel. Only
+			 * enable this for machines that can be trained and applied from
+			 * several threads at once, and that do not draw from the global
+			 * random generator.
+			 *
+			 * @param parallel_bags whether to process the bags in parallel
+			 */
+			void set_parallel_bags(bool parallel_bags);
+
+			/**
+			 * Get whether the bags are trained and applied in parallel
+			 *
+			 * @return whether the bags are processed in parallel
+			 */
+			bool get_parallel_bags() const;
+
 			/** get classifier type
 			 *
 			 * @return classifier type CT_BAGGING
@@ -133,15 +165,36 @@ namespace shogun
 			void init();
 
 			/**
-			 * get the vector of indices for feature vectors that are out of bag
+			 * get the vectors of a bag, drawn with replacement from its seed
 			 *
-			 * @param in_bag vector of indices that are in bag.
-			 * NOTE: in_bag is a randomly generated with replacement
-			 * @return
+			 * @param bag index of the bag
+			 * @param machine_seed random seed for the machine of the bag,
+			 * drawn after the vectors (returned, optional)
+			 * @return sorted indices of the vectors in the bag
 			 */
-			CDynamicArray<index_t>* get_oob_indices(const SGVector<index_t>& in_bag);
+			SGVector<index_t> get_bag_indices(int32_t bag,
+					int32_t* machine_seed=NULL) const;
 
-			void clear_oob_indicies();
+			/** @return number of threads the bags are processed with */
+			int32_t get_num_bag_threads() const;
+
+			/**
+			 * get a view on the features of a subset of vectors
+			 *
+			 * @param features features to view
+			 * @param idx indices of the vectors
+			 * @return SG_REF'ed shared_clone() of features with idx as subset
+			 */
+			static CFeatures* get_view(CFeatures* features, SGVector<index_t> idx);
+
+			/**
+			 * get number of vectors applied at once, such that the outputs
+			 * of all bags fit into a bounded amount of memory
+			 *
+			 * @param num_vectors total number of vectors
+			 * @return batch size
+			 */
+			int32_t get_batch_size(int32_t num_vectors) const;
 
 		private:
 			/** bags array */
@@ -165,8 +218,11 @@ namespace shogun
 			/** indices of all feature vectors that are out of bag */
 			SGVector<bool> m_all_oob_idx;
 
-			/** array of oob indices */
-			CDynamicObjectArray* m_oob_indices;
+			/** random seed the vectors of each bag are drawn from */
+			SGVector<int32_t> m_bag_seeds;
+
+			/** whether the bags are trained and applied in parallel */
+			bool m_parallel_bags;
 	};
 }
 
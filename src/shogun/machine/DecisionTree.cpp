@@ -0,0 +1,272 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society
+ */
+
+#include <shogun/machine/DecisionTree.h>
+#include <shogun/machine/HistogramTreeBuilder.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/mathematics/Random.h>
+#include <shogun/base/Parallel.h>
+
+using namespace shogun;
+
+CDecisionTree::CDecisionTree() : CMachine()
+{
+	init();
+}
+
+CDecisionTree::CDecisionTree(int32_t max_depth, int32_t min_node_size)
+	: CMachine()
+{
+	init();
+	set_max_depth(max_depth);
+	set_min_node_size(min_node_size);
+}
+
+CDecisionTree::~CDecisionTree()
+{
+}
+
+void CDecisionTree::init()
+{
+	m_problem_type=PT_BINARY;
+	m_max_depth=0;
+	m_min_node_size=1;
+	m_num_random_features=0;
+	m_num_bins=256;
+	m_num_outputs=0;
+	m_seed=-1;
+
+	SG_ADD((machine_int_t*) &m_problem_type, "problem_type",
+			"Problem type of the training labels", MS_NOT_AVAILABLE);
+	SG_ADD(&m_max_depth, "max_depth", "Maximum depth of the tree",
+			MS_AVAILABLE);
+	SG_ADD(&m_min_node_size, "min_node_size",
+			"Minimum number of vectors in a leaf", MS_AVAILABLE);
+	SG_ADD(&m_num_random_features, "num_random_features",
+			"Number of split candidates per node", MS_AVAILABLE);
+	SG_ADD(&m_num_bins, "num_bins", "Maximum number of bins per feature",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_num_outputs, "num_outputs", "Number of values per node",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_seed, "seed", "Seed of the random split candidates",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_feature, "feature", "Split feature of each node",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_threshold, "threshold", "Split threshold of each node",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_child, "child", "Left child of each node", MS_NOT_AVAILABLE);
+	SG_ADD(&m_value, "value", "Values of each node", MS_NOT_AVAILABLE);
+}
+
+bool CDecisionTree::is_label_valid(CLabels *lab) const
+{
+	ELabelType type=lab->get_label_type();
+	return type==LT_BINARY || type==LT_MULTICLASS || type==LT_REGRESSION;
+}
+
+bool CDecisionTree::train_machine(CFeatures* data)
+{
+	REQUIRE(data, "No training features given\n")
+	REQUIRE(data->get_feature_class()==C_DENSE &&
+			data->get_feature_type()==F_DREAL,
+			"%s only works with dense real valued features\n", get_name())
+
+	int32_t num_vectors=data->get_num_vectors();
+	REQUIRE(m_labels->get_num_labels()==num_vectors, "Number of labels (%d) "
+			"and training vectors (%d) differ\n", m_labels->get_num_labels(),
+			num_vectors)
+
+	SGVector<float64_t> labels=((CDenseLabels*) m_labels)->get_labels();
+	SGVector<float64_t> targets;
+	switch (m_labels->get_label_type())
+	{
+		case LT_BINARY:
+		case LT_REGRESSION:
+			m_problem_type=m_labels->get_label_type()==LT_BINARY ?
+				PT_BINARY : PT_REGRESSION;
+			m_num_outputs=1;
+			targets=labels;
+			break;
+		case LT_MULTICLASS:
+			m_problem_type=PT_MULTICLASS;
+			/* classes missing in a bag still get their own output */
+			m_num_outputs=int32_t(SGVector<float64_t>::max(labels.vector,
+						labels.vlen))+1;
+			targets=SGVector<float64_t>(int64_t(num_vectors)*m_num_outputs);
+			targets.zero();
+			for (int32_t i=0; i<num_vectors; i++)
+				targets[int64_t(i)*m_num_outputs+int32_t(labels[i])]=1;
+			break;
+		default:
+			SG_ERROR("Unsupported label type\n")
+	}
+
+	HistogramTreeParams params;
+	params.max_depth=m_max_depth;
+	params.min_node_size=CMath::max(m_min_node_size, 1);
+	params.num_random_features=m_num_random_features;
+
+	HistogramTreeBuilder builder((CDenseFeatures<float64_t>*) data, m_num_bins,
+			parallel->get_num_threads());
+	SGVector<index_t> vectors(num_vectors);
+	vectors.range_fill();
+	uint32_t seed=(uint32_t) m_seed;
+	if (m_seed<0)
+		seed=(uint32_t) CMath::random();
+	CRandom prng(seed);
+	HistogramTreeNodes nodes;
+	builder.grow(targets.vector, NULL, m_num_outputs, vectors, params, &prng,
+			nodes);
+
+	m_feature=HistogramTreeBuilder::to_vector(nodes.feature);
+	m_threshold=HistogramTreeBuilder::to_vector(nodes.threshold);
+	m_child=HistogramTreeBuilder::to_vector(nodes.child);
+	m_value=HistogramTreeBuilder::to_vector(nodes.value);
+
+	SG_DEBUG("%s grew %d nodes\n", get_name(), m_feature.vlen)
+
+	return true;
+}
+
+SGMatrix<float64_t> CDecisionTree::apply_get_outputs(CFeatures* data)
+{
+	REQUIRE(data, "No features given\n")
+	REQUIRE(data->get_feature_class()==C_DENSE &&
+			data->get_feature_type()==F_DREAL,
+			"%s only works with dense real valued features\n", get_name())
+	REQUIRE(m_feature.vlen>0, "%s is not trained\n", get_name())
+
+	SGMatrix<float64_t> outputs(m_num_outputs, data->get_num_vectors());
+	outputs.zero();
+
+	SGVector<int32_t> roots(1);
+	roots[0]=0;
+	SGVector<int32_t> rows(1);
+	rows[0]=0;
+	HistogramTreeBuilder::apply_trees((CDenseFeatures<float64_t>*) data,
+			m_feature, m_threshold, m_child, m_value, m_num_outputs, roots, rows,
+			outputs, parallel->get_num_threads());
+
+	return outputs;
+}
+
+CBinaryLabels* CDecisionTree::apply_binary(CFeatures* data)
+{
+	REQUIRE(m_problem_type==PT_BINARY, "%s was not trained on binary "
+			"labels\n", get_name())
+
+	SGMatrix<float64_t> outputs=apply_get_outputs(data);
+	SGVector<float64_t> values(outputs.num_cols);
+	memcpy(values.vector, outputs.matrix, sizeof(float64_t)*values.vlen);
+
+	return new CBinaryLabels(values);
+}
+
+CRegressionLabels* CDecisionTree::apply_regression(CFeatures* data)
+{
+	REQUIRE(m_problem_type==PT_REGRESSION, "%s was not trained on regression "
+			"labels\n", get_name())
+
+	SGMatrix<float64_t> outputs=apply_get_outputs(data);
+	SGVector<float64_t> values(outputs.num_cols);
+	memcpy(values.vector, outputs.matrix, sizeof(float64_t)*values.vlen);
+
+	CRegressionLabels* result=new CRegressionLabels(values);
+	result->set_values(values);
+	return result;
+}
+
+CMulticlassLabels* CDecisionTree::apply_multiclass(CFeatures* data)
+{
+	REQUIRE(m_problem_type==PT_MULTICLASS, "%s was not trained on multiclass "
+			"labels\n", get_name())
+
+	SGMatrix<float64_t> outputs=apply_get_outputs(data);
+	int32_t num_vectors=outputs.num_cols;
+	SGVector<float64_t> labels(num_vectors);
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		labels[i]=SGVector<float64_t>::arg_max(outputs.get_column_vector(i), 1,
+				m_num_outputs);
+	}
+
+	CMulticlassLabels* result=new CMulticlassLabels(labels);
+	/* the values are the labels, which is what CMajorityVote combines */
+	result->set_values(labels);
+	result->allocate_confidences_for(m_num_outputs);
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		result->set_multiclass_confidences(i, SGVector<float64_t>(
+					outputs.get_column_vector(i), m_num_outputs, false));
+	}
+
+	return result;
+}
+
+void CDecisionTree::set_max_depth(int32_t max_depth)
+{
+	REQUIRE(max_depth>=0, "Maximum depth (%d) has to be non-negative\n",
+			max_depth)
+	m_max_depth=max_depth;
+}
+
+int32_t CDecisionTree::get_max_depth() const
+{
+	return m_max_depth;
+}
+
+void CDecisionTree::set_min_node_size(int32_t min_node_size)
+{
+	REQUIRE(min_node_size>0, "Minimum node size (%d) has to be positive\n",
+			min_node_size)
+	m_min_node_size=min_node_size;
+}
+
+int32_t CDecisionTree::get_min_node_size() const
+{
+	return m_min_node_size;
+}
+
+void CDecisionTree::set_num_random_features(int32_t num_features)
+{
+	REQUIRE(num_features>=0, "Number of random features (%d) has to be "
+			"non-negative\n", num_features)
+	m_num_random_features=num_features;
+}
+
+int32_t CDecisionTree::get_num_random_features() const
+{
+	return m_num_random_features;
+}
+
+void CDecisionTree::set_seed(int32_t seed)
+{
+	REQUIRE(seed>=-1, "Seed (%d) has to be non-negative or -1\n", seed)
+	m_seed=seed;
+}
+
+int32_t CDecisionTree::get_seed() const
+{
+	return m_seed;
+}
+
+void CDecisionTree::set_num_bins(int32_t num_bins)
+{
+	REQUIRE(num_bins>=2 && num_bins<=256, "Number of bins (%d) has to be "
+			"between 2 and 256\n", num_bins)
+	m_num_bins=num_bins;
+}
+
+int32_t CDecisionTree::get_num_bins() const
+{
+	return m_num_bins;
+}
@@ -0,0 +1,188 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society
+ */
+
+#ifndef DECISIONTREE_H
+#define DECISIONTREE_H
+
+#include <shogun/lib/config.h>
+#include <shogun/machine/Machine.h>
+
+namespace shogun
+{
+template <class ST> class CDenseFeatures;
+
+/** @brief CART-style decision tree on binned dense features.
+ *
+ * The features are quantized into at most 256 bins each (see
+ * HistogramTreeBuilder), and the tree greedily takes the split with the
+ * largest decrease of the squared error of the targets. For regression the
+ * targets are the labels and a leaf predicts their mean, for binary
+ * classification the targets are the +1/-1 labels, so a leaf predicts
+ * \f$2p-1\f$ with \f$p\f$ the fraction of positive vectors, and for
+ * multiclass classification the targets are indicators of the classes,
+ * which makes the criterion the Gini impurity and a leaf predicts the
+ * class fractions. The problem type follows the labels of the last
+ * training.
+ *
+ * The trained tree is stored as flat arrays with the children of a node
+ * next to each other, and test vectors are passed through it in parallel
+ * blocks.
+ *
+ * A random forest is a CBaggingMachine of decision trees with
+ * set_num_random_features() set, e.g. to the square root of the number of
+ * features. Use CMajorityVote to combine multiclass trees and CMeanRule to
+ * combine binary or regression trees.
+ */
+class CDecisionTree : public CMachine
+{
+	public:
+		/** default constructor */
+		CDecisionTree();
+
+		/** constructor
+		 *
+		 * @param max_depth maximum depth of the tree, 0 for unlimited
+		 * @param min_node_size minimum number of vectors in a leaf
+		 */
+		CDecisionTree(int32_t max_depth, int32_t min_node_size=1);
+
+		virtual ~CDecisionTree();
+
+		virtual CBinaryLabels* apply_binary(CFeatures* data=NULL);
+		virtual CMulticlassLabels* apply_multiclass(CFeatures* data=NULL);
+		virtual CRegressionLabels* apply_regression(CFeatures* data=NULL);
+
+		/** @return problem type of the labels the tree was trained on */
+		virtual EProblemType get_machine_problem_type() const
+		{
+			return m_problem_type;
+		}
+
+		/** get classifier type
+		 *
+		 * @return classifier type CT_DECISIONTREE
+		 */
+		virtual EMachineType get_classifier_type() { return CT_DECISIONTREE; }
+
+		/** set maximum depth
+		 *
+		 * @param max_depth maximum depth of the tree, 0 for unlimited
+		 */
+		void set_max_depth(int32_t max_depth);
+
+		/** @return maximum depth of the tree */
+		int32_t get_max_depth() const;
+
+		/** set minimum node size
+		 *
+		 * @param min_node_size minimum number of vectors in a leaf
+		 */
+		void set_min_node_size(int32_t min_node_size);
+
+		/** @return minimum number of vectors in a leaf */
+		int32_t get_min_node_size() const;
+
+		/** set number of random features
+		 *
+		 * @param num_features number of features drawn at random as split
+		 * candidates in each node, 0 for all features
+		 */
+		void set_num_random_features(int32_t num_features);
+
+		/** @return number of random features per node */
+		int32_t get_num_random_features() const;
+
+		/** set seed of the random split candidates, so that training is
+		 * reproducible and does not touch the global random generator
+		 *
+		 * @param seed non-negative seed, -1 to draw one from the global
+		 * generator in every training
+		 */
+		void set_seed(int32_t seed);
+
+		/** @return seed of the random split candidates, -1 if none */
+		int32_t get_seed() const;
+
+		/** set number of bins
+		 *
+		 * @param num_bins maximum number of bins per feature (2..256)
+		 */
+		void set_num_bins(int32_t num_bins);
+
+		/** @return maximum number of bins per feature */
+		int32_t get_num_bins() const;
+
+		/** @return number of nodes of the trained tree */
+		int32_t get_num_nodes() const { return m_feature.vlen; }
+
+		/** @return object name */
+		virtual const char* get_name() const { return "DecisionTree"; }
+
+	protected:
+		/** train tree
+		 *
+		 * @param data dense real valued training features
+		 * @return whether training was successful
+		 */
+		virtual bool train_machine(CFeatures* data=NULL);
+
+		/** check whether labels are binary, multiclass or regression
+		 * labels
+		 *
+		 * @param lab labels to check
+		 * @return whether the tree can learn them
+		 */
+		virtual bool is_label_valid(CLabels *lab) const;
+
+		/** pass vectors through the tree
+		 *
+		 * @param data dense real valued features
+		 * @return values of the leaves, one column per vector
+		 */
+		SGMatrix<float64_t> apply_get_outputs(CFeatures* data);
+
+	private:
+		void init();
+
+	protected:
+		/** problem type of the training labels */
+		EProblemType m_problem_type;
+
+		/** maximum depth */
+		int32_t m_max_depth;
+
+		/** minimum number of vectors in a leaf */
+		int32_t m_min_node_size;
+
+		/** number of split candidates per node */
+		int32_t m_num_random_features;
+
+		/** maximum number of bins per feature */
+		int32_t m_num_bins;
+
+		/** number of values per node */
+		int32_t m_num_outputs;
+
+		/** seed of the random split candidates, -1 for none */
+		int32_t m_seed;
+
+		/** split feature of each node, -1 for leaves */
+		SGVector<int32_t> m_feature;
+
+		/** split threshold of each node */
+		SGVector<float64_t> m_threshold;
+
+		/** left child of each node, the right child follows it */
+		SGVector<int32_t> m_child;
+
+		/** m_num_outputs values of each node */
+		SGVector<float64_t> m_value;
+};
+}
+#endif //DECISIONTREE_H
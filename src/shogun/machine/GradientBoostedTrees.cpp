@@ -0,0 +1,395 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society
+ */
+
+#include <shogun/machine/GradientBoostedTrees.h>
+#include <shogun/machine/HistogramTreeBuilder.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/base/Parallel.h>
+
+using namespace shogun;
+
+/** smallest probability and hessian used in the logistic losses */
+#define GRADIENTBOOSTEDTREES_EPS 1e-12
+
+CGradientBoostedTrees::CGradientBoostedTrees() : CMachine()
+{
+	init();
+}
+
+CGradientBoostedTrees::CGradientBoostedTrees(int32_t num_iterations,
+		float64_t learning_rate, int32_t max_depth) : CMachine()
+{
+	init();
+	set_num_iterations(num_iterations);
+	set_learning_rate(learning_rate);
+	set_max_depth(max_depth);
+}
+
+CGradientBoostedTrees::~CGradientBoostedTrees()
+{
+}
+
+void CGradientBoostedTrees::init()
+{
+	m_problem_type=PT_BINARY;
+	m_num_iterations=100;
+	m_learning_rate=0.1;
+	m_max_depth=6;
+	m_min_node_size=1;
+	m_lambda=1.0;
+	m_num_bins=256;
+	m_num_outputs=0;
+
+	SG_ADD((machine_int_t*) &m_problem_type, "problem_type",
+			"Problem type of the training labels", MS_NOT_AVAILABLE);
+	SG_ADD(&m_num_iterations, "num_iterations",
+			"Number of boosting iterations", MS_AVAILABLE);
+	SG_ADD(&m_learning_rate, "learning_rate", "Shrinkage of every tree",
+			MS_AVAILABLE);
+	SG_ADD(&m_max_depth, "max_depth", "Maximum depth of every tree",
+			MS_AVAILABLE);
+	SG_ADD(&m_min_node_size, "min_node_size",
+			"Minimum number of vectors in a leaf", MS_AVAILABLE);
+	SG_ADD(&m_lambda, "lambda", "L2 regularization of the leaf values",
+			MS_AVAILABLE);
+	SG_ADD(&m_num_bins, "num_bins", "Maximum number of bins per feature",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_num_outputs, "num_outputs", "Number of outputs",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_bias, "bias", "Initial prediction of each output",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_roots, "roots", "Root node of each tree", MS_NOT_AVAILABLE);
+	SG_ADD(&m_tree_output, "tree_output", "Output each tree adds to",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_feature, "feature", "Split feature of each node",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_threshold, "threshold", "Split threshold of each node",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_child, "child", "Left child of each node", MS_NOT_AVAILABLE);
+	SG_ADD(&m_value, "value", "Value of each node", MS_NOT_AVAILABLE);
+}
+
+bool CGradientBoostedTrees::is_label_valid(CLabels *lab) const
+{
+	ELabelType type=lab->get_label_type();
+	return type==LT_BINARY || type==LT_MULTICLASS || type==LT_REGRESSION;
+}
+
+void CGradientBoostedTrees::softmax(const float64_t* f, float64_t* p,
+		int32_t num)
+{
+	float64_t max=SGVector<float64_t>::max((float64_t*) f, num);
+	float64_t sum=0;
+	for (int32_t k=0; k<num; k++)
+	{
+		p[k]=CMath::exp(f[k]-max);
+		sum+=p[k];
+	}
+	for (int32_t k=0; k<num; k++)
+		p[k]/=sum;
+}
+
+bool CGradientBoostedTrees::train_machine(CFeatures* data)
+{
+	REQUIRE(data, "No training features given\n")
+	REQUIRE(data->get_feature_class()==C_DENSE &&
+			data->get_feature_type()==F_DREAL,
+			"%s only works with dense real valued features\n", get_name())
+
+	int32_t num_vectors=data->get_num_vectors();
+	REQUIRE(m_labels->get_num_labels()==num_vectors, "Number of labels (%d) "
+			"and training vectors (%d) differ\n", m_labels->get_num_labels(),
+			num_vectors)
+
+	SGVector<float64_t> labels=((CDenseLabels*) m_labels)->get_labels();
+	int32_t K=1;
+	switch (m_labels->get_label_type())
+	{
+		case LT_BINARY:
+			m_problem_type=PT_BINARY;
+			break;
+		case LT_REGRESSION:
+			m_problem_type=PT_REGRESSION;
+			break;
+		case LT_MULTICLASS:
+			m_problem_type=PT_MULTICLASS;
+			K=int32_t(SGVector<float64_t>::max(labels.vector, labels.vlen))+1;
+			break;
+		default:
+			SG_ERROR("Unsupported label type\n")
+	}
+	m_num_outputs=K;
+
+	/* constant model that minimizes the loss */
+	m_bias=SGVector<float64_t>(K);
+	m_bias.zero();
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		if (m_problem_type==PT_BINARY)
+			m_bias[0]+=labels[i]>0 ? 1 : 0;
+		else if (m_problem_type==PT_REGRESSION)
+			m_bias[0]+=labels[i];
+		else
+			m_bias[int32_t(labels[i])]+=1;
+	}
+	for (int32_t k=0; k<K; k++)
+	{
+		m_bias[k]/=num_vectors;
+		if (m_problem_type==PT_BINARY)
+		{
+			float64_t p=CMath::clamp(m_bias[k], GRADIENTBOOSTEDTREES_EPS,
+					1-GRADIENTBOOSTEDTREES_EPS);
+			m_bias[k]=CMath::log(p/(1-p));
+		}
+		else if (m_problem_type==PT_MULTICLASS)
+		{
+			m_bias[k]=CMath::log(CMath::max(m_bias[k],
+						GRADIENTBOOSTEDTREES_EPS));
+		}
+	}
+
+	HistogramTreeParams params;
+	params.max_depth=m_max_depth;
+	params.min_node_size=CMath::max(m_min_node_size, 1);
+	params.lambda=m_lambda;
+	params.leaf_scale=m_learning_rate;
+
+	int32_t num_threads=parallel->get_num_threads();
+	HistogramTreeBuilder builder((CDenseFeatures<float64_t>*) data, m_num_bins,
+			num_threads);
+	SGVector<index_t> vectors(num_vectors);
+	vectors.range_fill();
+
+	/* current predictions, and gradients and hessians of each output */
+	SGMatrix<float64_t> F(K, num_vectors);
+	for (int32_t i=0; i<num_vectors; i++)
+		memcpy(F.get_column_vector(i), m_bias.vector, sizeof(float64_t)*K);
+	SGMatrix<float64_t> gradients(num_vectors, K);
+	SGMatrix<float64_t> hessians(num_vectors, K);
+	SGVector<int32_t> leaf_of_vector(num_vectors);
+
+	HistogramTreeNodes nodes;
+	DynArray<int32_t> roots;
+	DynArray<int32_t> tree_output;
+
+	for (int32_t iter=0; iter<m_num_iterations; iter++)
+	{
+		/* negative gradients, the leaf values then are Newton steps */
+		#pragma omp parallel num_threads(num_threads)
+		{
+			float64_t* p=SG_MALLOC(float64_t, K);
+
+			#pragma omp for
+			for (int32_t i=0; i<num_vectors; i++)
+			{
+				const float64_t* f=F.get_column_vector(i);
+				switch (m_problem_type)
+				{
+					case PT_REGRESSION:
+						gradients(i, 0)=labels[i]-f[0];
+						hessians(i, 0)=1;
+						break;
+					case PT_BINARY:
+						p[0]=1/(1+CMath::exp(-f[0]));
+						gradients(i, 0)=(labels[i]>0 ? 1 : 0)-p[0];
+						hessians(i, 0)=CMath::max(p[0]*(1-p[0]),
+								GRADIENTBOOSTEDTREES_EPS);
+						break;
+					default:
+						softmax(f, p, K);
+						for (int32_t k=0; k<K; k++)
+						{
+							gradients(i, k)=(int32_t(labels[i])==k ? 1 : 0)-p[k];
+							hessians(i, k)=CMath::max(p[k]*(1-p[k]),
+									GRADIENTBOOSTEDTREES_EPS);
+						}
+						break;
+				}
+			}
+
+			SG_FREE(p);
+		}
+
+		/* all trees of an iteration fit the same predictions */
+		for (int32_t k=0; k<K; k++)
+		{
+			int32_t root=builder.grow(gradients.get_column_vector(k),
+					hessians.get_column_vector(k), 1, vectors, params, NULL,
+					nodes, leaf_of_vector.vector);
+			roots.push_back(root);
+			tree_output.push_back(k);
+
+			for (int32_t i=0; i<num_vectors; i++)
+				F(k, i)+=nodes.value[leaf_of_vector[i]];
+		}
+	}
+
+	m_roots=HistogramTreeBuilder::to_vector(roots);
+	m_tree_output=HistogramTreeBuilder::to_vector(tree_output);
+	m_feature=HistogramTreeBuilder::to_vector(nodes.feature);
+	m_threshold=HistogramTreeBuilder::to_vector(nodes.threshold);
+	m_child=HistogramTreeBuilder::to_vector(nodes.child);
+	m_value=HistogramTreeBuilder::to_vector(nodes.value);
+
+	SG_DEBUG("%s grew %d trees with %d nodes\n", get_name(), m_roots.vlen,
+			m_feature.vlen)
+
+	return true;
+}
+
+SGMatrix<float64_t> CGradientBoostedTrees::apply_get_outputs(CFeatures* data)
+{
+	REQUIRE(data, "No features given\n")
+	REQUIRE(data->get_feature_class()==C_DENSE &&
+			data->get_feature_type()==F_DREAL,
+			"%s only works with dense real valued features\n", get_name())
+	REQUIRE(m_bias.vlen>0, "%s is not trained\n", get_name())
+
+	int32_t num_vectors=data->get_num_vectors();
+	SGMatrix<float64_t> outputs(m_num_outputs, num_vectors);
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		memcpy(outputs.get_column_vector(i), m_bias.vector,
+				sizeof(float64_t)*m_num_outputs);
+	}
+
+	HistogramTreeBuilder::apply_trees((CDenseFeatures<float64_t>*) data,
+			m_feature, m_threshold, m_child, m_value, 1, m_roots, m_tree_output,
+			outputs, parallel->get_num_threads());
+
+	return outputs;
+}
+
+CBinaryLabels* CGradientBoostedTrees::apply_binary(CFeatures* data)
+{
+	REQUIRE(m_problem_type==PT_BINARY, "%s was not trained on binary "
+			"labels\n", get_name())
+
+	SGMatrix<float64_t> outputs=apply_get_outputs(data);
+	SGVector<float64_t> values(outputs.num_cols);
+	memcpy(values.vector, outputs.matrix, sizeof(float64_t)*values.vlen);
+
+	return new CBinaryLabels(values);
+}
+
+CRegressionLabels* CGradientBoostedTrees::apply_regression(CFeatures* data)
+{
+	REQUIRE(m_problem_type==PT_REGRESSION, "%s was not trained on regression "
+			"labels\n", get_name())
+
+	SGMatrix<float64_t> outputs=apply_get_outputs(data);
+	SGVector<float64_t> values(outputs.num_cols);
+	memcpy(values.vector, outputs.matrix, sizeof(float64_t)*values.vlen);
+
+	CRegressionLabels* result=new CRegressionLabels(values);
+	result->set_values(values);
+	return result;
+}
+
+CMulticlassLabels* CGradientBoostedTrees::apply_multiclass(CFeatures* data)
+{
+	REQUIRE(m_problem_type==PT_MULTICLASS, "%s was not trained on multiclass "
+			"labels\n", get_name())
+
+	SGMatrix<float64_t> outputs=apply_get_outputs(data);
+	int32_t num_vectors=outputs.num_cols;
+	SGVector<float64_t> labels(num_vectors);
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		float64_t* f=outputs.get_column_vector(i);
+		labels[i]=SGVector<float64_t>::arg_max(f, 1, m_num_outputs);
+		softmax(f, f, m_num_outputs);
+	}
+
+	CMulticlassLabels* result=new CMulticlassLabels(labels);
+	result->set_values(labels);
+	result->allocate_confidences_for(m_num_outputs);
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		result->set_multiclass_confidences(i, SGVector<float64_t>(
+					outputs.get_column_vector(i), m_num_outputs, false));
+	}
+
+	return result;
+}
+
+void CGradientBoostedTrees::set_num_iterations(int32_t num_iterations)
+{
+	REQUIRE(num_iterations>0, "Number of iterations (%d) has to be "
+			"positive\n", num_iterations)
+	m_num_iterations=num_iterations;
+}
+
+int32_t CGradientBoostedTrees::get_num_iterations() const
+{
+	return m_num_iterations;
+}
+
+void CGradientBoostedTrees::set_learning_rate(float64_t learning_rate)
+{
+	REQUIRE(learning_rate>0, "Learning rate (%f) has to be positive\n",
+			learning_rate)
+	m_learning_rate=learning_rate;
+}
+
+float64_t CGradientBoostedTrees::get_learning_rate() const
+{
+	return m_learning_rate;
+}
+
+void CGradientBoostedTrees::set_max_depth(int32_t max_depth)
+{
+	REQUIRE(max_depth>=0, "Maximum depth (%d) has to be non-negative\n",
+			max_depth)
+	m_max_depth=max_depth;
+}
+
+int32_t CGradientBoostedTrees::get_max_depth() const
+{
+	return m_max_depth;
+}
+
+void CGradientBoostedTrees::set_min_node_size(int32_t min_node_size)
+{
+	REQUIRE(min_node_size>0, "Minimum node size (%d) has to be positive\n",
+			min_node_size)
+	m_min_node_size=min_node_size;
+}
+
+int32_t CGradientBoostedTrees::get_min_node_size() const
+{
+	return m_min_node_size;
+}
+
+void CGradientBoostedTrees::set_lambda(float64_t lambda)
+{
+	REQUIRE(lambda>=0, "Regularization constant (%f) has to be "
+			"non-negative\n", lambda)
+	m_lambda=lambda;
+}
+
+float64_t CGradientBoostedTrees::get_lambda() const
+{
+	return m_lambda;
+}
+
+void CGradientBoostedTrees::set_num_bins(int32_t num_bins)
+{
+	REQUIRE(num_bins>=2 && num_bins<=256, "Number of bins (%d) has to be "
+			"between 2 and 256\n", num_bins)
+	m_num_bins=num_bins;
+}
+
+int32_t CGradientBoostedTrees::get_num_bins() const
+{
+	return m_num_bins;
+}
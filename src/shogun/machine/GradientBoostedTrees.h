@@ -0,0 +1,208 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society
+ */
+
+#ifndef GRADIENTBOOSTEDTREES_H
+#define GRADIENTBOOSTEDTREES_H
+
+#include <shogun/lib/config.h>
+#include <shogun/machine/Machine.h>
+
+namespace shogun
+{
+/** @brief Gradient boosted regression trees on binned dense features.
+ *
+ * The model is a sum \f$F(x)=b+\sum_t f_t(x)\f$ of regression trees, each
+ * grown by HistogramTreeBuilder on the gradients \f$g_i\f$ and hessians
+ * \f$h_i\f$ of the loss at the current predictions, with leaf values
+ * \f$\eta\,G/(H+\lambda)\f$ (a Newton step shrunk by the learning rate
+ * \f$\eta\f$). The features are binned only once for all trees.
+ *
+ * The loss follows the labels:
+ *  - regression: squared loss, \f$F\f$ is the prediction
+ *  - binary: logistic loss, \f$F\f$ is the log-odds of the positive
+ *  class and the value of the binary labels
+ *  - multiclass: softmax loss with one tree per class and iteration,
+ *  the confidences of the multiclass labels are the class probabilities
+ *
+ * All trees are stored in one set of flat arrays, and test vectors are
+ * passed through them in parallel blocks.
+ */
+class CGradientBoostedTrees : public CMachine
+{
+	public:
+		/** default constructor */
+		CGradientBoostedTrees();
+
+		/** constructor
+		 *
+		 * @param num_iterations number of boosting iterations
+		 * @param learning_rate shrinkage of every tree
+		 * @param max_depth maximum depth of every tree
+		 */
+		CGradientBoostedTrees(int32_t num_iterations, float64_t learning_rate=0.1,
+				int32_t max_depth=6);
+
+		virtual ~CGradientBoostedTrees();
+
+		virtual CBinaryLabels* apply_binary(CFeatures* data=NULL);
+		virtual CMulticlassLabels* apply_multiclass(CFeatures* data=NULL);
+		virtual CRegressionLabels* apply_regression(CFeatures* data=NULL);
+
+		/** @return problem type of the labels the model was trained on */
+		virtual EProblemType get_machine_problem_type() const
+		{
+			return m_problem_type;
+		}
+
+		/** get classifier type
+		 *
+		 * @return classifier type CT_GRADIENTBOOSTEDTREES
+		 */
+		virtual EMachineType get_classifier_type()
+		{
+			return CT_GRADIENTBOOSTEDTREES;
+		}
+
+		/** set number of boosting iterations
+		 *
+		 * @param num_iterations number of iterations
+		 */
+		void set_num_iterations(int32_t num_iterations);
+
+		/** @return number of boosting iterations */
+		int32_t get_num_iterations() const;
+
+		/** set learning rate
+		 *
+		 * @param learning_rate shrinkage of every tree
+		 */
+		void set_learning_rate(float64_t learning_rate);
+
+		/** @return learning rate */
+		float64_t get_learning_rate() const;
+
+		/** set maximum depth
+		 *
+		 * @param max_depth maximum depth of every tree, 0 for unlimited
+		 */
+		void set_max_depth(int32_t max_depth);
+
+		/** @return maximum depth of every tree */
+		int32_t get_max_depth() const;
+
+		/** set minimum node size
+		 *
+		 * @param min_node_size minimum number of vectors in a leaf
+		 */
+		void set_min_node_size(int32_t min_node_size);
+
+		/** @return minimum number of vectors in a leaf */
+		int32_t get_min_node_size() const;
+
+		/** set L2 regularization of the leaf values
+		 *
+		 * @param lambda regularization constant
+		 */
+		void set_lambda(float64_t lambda);
+
+		/** @return L2 regularization of the leaf values */
+		float64_t get_lambda() const;
+
+		/** set number of bins
+		 *
+		 * @param num_bins maximum number of bins per feature (2..256)
+		 */
+		void set_num_bins(int32_t num_bins);
+
+		/** @return maximum number of bins per feature */
+		int32_t get_num_bins() const;
+
+		/** @return number of trees of the trained model */
+		int32_t get_num_trees() const { return m_roots.vlen; }
+
+		/** @return object name */
+		virtual const char* get_name() const { return "GradientBoostedTrees"; }
+
+	protected:
+		/** train model
+		 *
+		 * @param data dense real valued training features
+		 * @return whether training was successful
+		 */
+		virtual bool train_machine(CFeatures* data=NULL);
+
+		/** check whether labels are binary, multiclass or regression
+		 * labels
+		 *
+		 * @param lab labels to check
+		 * @return whether the model can learn them
+		 */
+		virtual bool is_label_valid(CLabels *lab) const;
+
+		/** compute \f$F(x)\f$
+		 *
+		 * @param data dense real valued features
+		 * @return one column of m_num_outputs values per vector
+		 */
+		SGMatrix<float64_t> apply_get_outputs(CFeatures* data);
+
+	private:
+		void init();
+
+		/** turn a column of \f$F\f$ into class probabilities */
+		static void softmax(const float64_t* f, float64_t* p, int32_t num);
+
+	protected:
+		/** problem type of the training labels */
+		EProblemType m_problem_type;
+
+		/** number of boosting iterations */
+		int32_t m_num_iterations;
+
+		/** shrinkage of every tree */
+		float64_t m_learning_rate;
+
+		/** maximum depth of every tree */
+		int32_t m_max_depth;
+
+		/** minimum number of vectors in a leaf */
+		int32_t m_min_node_size;
+
+		/** L2 regularization of the leaf values */
+		float64_t m_lambda;
+
+		/** maximum number of bins per feature */
+		int32_t m_num_bins;
+
+		/** number of outputs, the number of classes for multiclass */
+		int32_t m_num_outputs;
+
+		/** initial prediction of each output */
+		SGVector<float64_t> m_bias;
+
+		/** root node of each tree */
+		SGVector<int32_t> m_roots;
+
+		/** output each tree adds to */
+		SGVector<int32_t> m_tree_output;
+
+		/** split feature of each node, -1 for leaves */
+		SGVector<int32_t> m_feature;
+
+		/** split threshold of each node */
+		SGVector<float64_t> m_threshold;
+
+		/** left child of each node, the right child follows it */
+		SGVector<int32_t> m_child;
+
+		/** value of each node */
+		SGVector<float64_t> m_value;
+};
+}
+#endif //GRADIENTBOOSTEDTREES_H
@@ -0,0 +1,473 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society
+ */
+
+#include <shogun/machine/HistogramTreeBuilder.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/Random.h>
+#include <shogun/io/SGIO.h>
+
+using namespace shogun;
+
+/** maximum number of values per feature the bin edges are computed from */
+#define HISTOGRAM_TREE_BIN_SAMPLES 200000
+/** number of vectors passed through the trees together */
+#define HISTOGRAM_TREE_BLOCK_VECTORS 64
+
+/** node waiting to be split */
+struct HistogramTreeTask
+{
+	/** index of the node */
+	int32_t node;
+	/** first vector of the node in the vector array */
+	int32_t begin;
+	/** number of vectors of the node */
+	int32_t num;
+	/** depth of the node */
+	int32_t depth;
+	/** histograms of the node */
+	float64_t* hist;
+};
+
+HistogramTreeBuilder::HistogramTreeBuilder(CDenseFeatures<float64_t>* features,
+		int32_t max_bins, int32_t num_threads)
+	: m_num_vectors(0), m_num_features(0), m_max_bins(max_bins),
+	m_num_threads(CMath::max(num_threads, 1)), m_bins(NULL), m_num_outputs(0),
+	m_stride(0)
+{
+	REQUIRE(features, "No features given\n")
+	REQUIRE(max_bins>=2 && max_bins<=256, "Number of bins (%d) has to be "
+			"between 2 and 256\n", max_bins)
+
+	bin_features(features);
+}
+
+HistogramTreeBuilder::~HistogramTreeBuilder()
+{
+	for (int32_t i=0; i<m_free_histograms.get_num_elements(); i++)
+		SG_FREE(m_free_histograms[i]);
+
+	SG_FREE(m_bins);
+}
+
+void HistogramTreeBuilder::bin_features(CDenseFeatures<float64_t>* features)
+{
+	SGMatrix<float64_t> matrix=features->get_feature_matrix();
+	REQUIRE(matrix.matrix, "Features have no feature matrix\n")
+	REQUIRE(matrix.num_rows>0, "Features have no dimensions\n")
+
+	m_num_vectors=matrix.num_cols;
+	m_num_features=matrix.num_rows;
+	m_num_bins=SGVector<int32_t>(m_num_features);
+	m_edges=SGVector<float64_t>(int64_t(m_num_features)*(m_max_bins-1));
+	m_bins=SG_MALLOC(uint8_t, int64_t(m_num_vectors)*m_num_features);
+
+	int32_t step=m_num_vectors/HISTOGRAM_TREE_BIN_SAMPLES+1;
+
+	#pragma omp parallel for schedule(dynamic) num_threads(m_num_threads)
+	for (int32_t f=0; f<m_num_features; f++)
+	{
+		float64_t* sorted=SG_MALLOC(float64_t, m_num_vectors/step+1);
+		int32_t num=0;
+		for (int32_t i=0; i<m_num_vectors; i+=step)
+		{
+			float64_t x=matrix(f, i);
+			if (!CMath::is_nan(x))
+				sorted[num++]=x;
+		}
+		CMath::qsort(sorted, num);
+
+		int32_t num_distinct=num ? 1 : 0;
+		for (int32_t i=1; i<num; i++)
+		{
+			if (sorted[i]>sorted[i-1])
+				num_distinct++;
+		}
+
+		/* few distinct values are separated in the middle, otherwise the
+		 * edges are quantiles */
+		float64_t* edges=&m_edges[int64_t(f)*(m_max_bins-1)];
+		int32_t num_edges=0;
+		if (num_distinct<=m_max_bins)
+		{
+			for (int32_t i=1; i<num; i++)
+			{
+				if (sorted[i]>sorted[i-1])
+					edges[num_edges++]=(sorted[i-1]+sorted[i])/2;
+			}
+		}
+		else
+		{
+			for (int32_t b=1; b<m_max_bins; b++)
+			{
+				float64_t q=sorted[int64_t(b)*num/m_max_bins];
+				if ((num_edges==0 || q>edges[num_edges-1]) && q<sorted[num-1])
+					edges[num_edges++]=q;
+			}
+		}
+		m_num_bins[f]=num_edges+1;
+		SG_FREE(sorted);
+
+		/* bin b holds the values in (edges[b-1], edges[b]] */
+		uint8_t* bins=&m_bins[int64_t(f)*m_num_vectors];
+		for (int32_t i=0; i<m_num_vectors; i++)
+		{
+			float64_t x=matrix(f, i);
+			int32_t lo=0;
+			int32_t hi=num_edges;
+			while (lo<hi)
+			{
+				int32_t mid=(lo+hi)/2;
+				if (edges[mid]<x)
+					lo=mid+1;
+				else
+					hi=mid;
+			}
+			bins[i]=(uint8_t) lo;
+		}
+	}
+}
+
+float64_t* HistogramTreeBuilder::get_histogram()
+{
+	if (m_free_histograms.get_num_elements())
+	{
+		float64_t* hist=m_free_histograms.back();
+		m_free_histograms.pop_back();
+		return hist;
+	}
+
+	return SG_MALLOC(float64_t, int64_t(m_num_features)*m_max_bins*m_stride);
+}
+
+void HistogramTreeBuilder::build_histogram(const index_t* vectors, int32_t num,
+		const float64_t* targets, const float64_t* weights, float64_t* hist) const
+{
+	int32_t K=m_num_outputs;
+
+	#pragma omp parallel for schedule(dynamic) num_threads(m_num_threads)
+	for (int32_t f=0; f<m_num_features; f++)
+	{
+		float64_t* h=&hist[int64_t(f)*m_max_bins*m_stride];
+		const uint8_t* bins=&m_bins[int64_t(f)*m_num_vectors];
+		memset(h, 0, sizeof(float64_t)*m_num_bins[f]*m_stride);
+
+		for (int32_t j=0; j<num; j++)
+		{
+			index_t i=vectors[j];
+			float64_t* entry=&h[bins[i]*m_stride];
+			const float64_t* t=&targets[int64_t(i)*K];
+			entry[0]+=1;
+			entry[1]+=weights ? weights[i] : 1;
+			for (int32_t k=0; k<K; k++)
+				entry[2+k]+=t[k];
+		}
+	}
+}
+
+float64_t HistogramTreeBuilder::score(const float64_t* entry,
+		float64_t lambda) const
+{
+	float64_t denom=entry[1]+lambda;
+	if (denom<=0)
+		return 0;
+
+	float64_t sum=0;
+	for (int32_t k=0; k<m_num_outputs; k++)
+		sum+=entry[2+k]*entry[2+k];
+
+	return sum/denom;
+}
+
+float64_t HistogramTreeBuilder::find_split(const float64_t* hist,
+		const int32_t* features, int32_t num_features,
+		const HistogramTreeParams& params, int32_t& split_feature,
+		int32_t& split_bin) const
+{
+	float64_t* gains=SG_MALLOC(float64_t, num_features);
+	int32_t* bins=SG_MALLOC(int32_t, num_features);
+
+	#pragma omp parallel for schedule(dynamic) num_threads(m_num_threads)
+	for (int32_t c=0; c<num_features; c++)
+	{
+		int32_t f=features[c];
+		const float64_t* h=&hist[int64_t(f)*m_max_bins*m_stride];
+		float64_t* left=SG_CALLOC(float64_t, m_stride);
+		float64_t* right=SG_MALLOC(float64_t, m_stride);
+		float64_t* total=SG_CALLOC(float64_t, m_stride);
+
+		for (int32_t b=0; b<m_num_bins[f]; b++)
+		{
+			for (int32_t j=0; j<m_stride; j++)
+				total[j]+=h[b*m_stride+j];
+		}
+		float64_t parent=score(total, params.lambda);
+
+		gains[c]=-1;
+		bins[c]=-1;
+		for (int32_t b=0; b<m_num_bins[f]-1; b++)
+		{
+			for (int32_t j=0; j<m_stride; j++)
+			{
+				left[j]+=h[b*m_stride+j];
+				right[j]=total[j]-left[j];
+			}
+
+			if (left[0]<params.min_node_size || right[0]<params.min_node_size)
+				continue;
+
+			/* rounding errors must not split nodes with constant targets */
+			float64_t children=score(left, params.lambda)+
+				score(right, params.lambda);
+			float64_t gain=children-parent;
+			if (gain>gains[c] && gain>1e-10*children)
+			{
+				gains[c]=gain;
+				bins[c]=b;
+			}
+		}
+
+		SG_FREE(left);
+		SG_FREE(right);
+		SG_FREE(total);
+	}
+
+	/* reduce in the order of the features to stay deterministic */
+	float64_t best=-1;
+	for (int32_t c=0; c<num_features; c++)
+	{
+		if (bins[c]>=0 && gains[c]>params.min_gain && gains[c]>best)
+		{
+			best=gains[c];
+			split_feature=features[c];
+			split_bin=bins[c];
+		}
+	}
+
+	SG_FREE(gains);
+	SG_FREE(bins);
+
+	return best;
+}
+
+int32_t HistogramTreeBuilder::grow(const float64_t* targets,
+		const float64_t* weights, int32_t num_outputs,
+		SGVector<index_t> vectors, const HistogramTreeParams& params,
+		CRandom* prng, HistogramTreeNodes& nodes, int32_t* leaf_of_vector)
+{
+	REQUIRE(num_outputs>0, "Number of outputs (%d) has to be positive\n",
+			num_outputs)
+	REQUIRE(vectors.vlen>0, "No vectors to grow the tree on\n")
+
+	/* the buffers only fit trees with the same number of outputs */
+	if (num_outputs!=m_num_outputs)
+	{
+		for (int32_t i=0; i<m_free_histograms.get_num_elements(); i++)
+			SG_FREE(m_free_histograms[i]);
+		m_free_histograms.reset(NULL);
+		m_num_outputs=num_outputs;
+		m_stride=num_outputs+2;
+	}
+
+	index_t* idx=SG_MALLOC(index_t, vectors.vlen);
+	index_t* right=SG_MALLOC(index_t, vectors.vlen);
+	memcpy(idx, vectors.vector, sizeof(index_t)*vectors.vlen);
+
+	int32_t* features=SG_MALLOC(int32_t, m_num_features);
+	int32_t num_candidates=m_num_features;
+	if (params.num_random_features>0 &&
+			params.num_random_features<m_num_features)
+		num_candidates=params.num_random_features;
+
+	DynArray<HistogramTreeTask> tasks;
+	HistogramTreeTask root;
+	root.node=nodes.feature.get_num_elements();
+	root.begin=0;
+	root.num=vectors.vlen;
+	root.depth=0;
+	root.hist=get_histogram();
+	build_histogram(idx, root.num, targets, weights, root.hist);
+	tasks.push_back(root);
+
+	nodes.feature.push_back(-1);
+	nodes.threshold.push_back(0);
+	nodes.child.push_back(-1);
+	for (int32_t k=0; k<num_outputs; k++)
+		nodes.value.push_back(0);
+
+	while (tasks.get_num_elements())
+	{
+		HistogramTreeTask task=tasks.back();
+		tasks.pop_back();
+
+		/* all vectors of the node are in the bins of any feature */
+		float64_t* total=SG_CALLOC(float64_t, m_stride);
+		for (int32_t b=0; b<m_num_bins[0]; b++)
+		{
+			for (int32_t j=0; j<m_stride; j++)
+				total[j]+=task.hist[b*m_stride+j];
+		}
+		float64_t denom=total[1]+params.lambda;
+		for (int32_t k=0; k<num_outputs; k++)
+		{
+			nodes.value.set_element(
+					denom>0 ? params.leaf_scale*total[2+k]/denom : 0,
+					task.node*num_outputs+k);
+		}
+		SG_FREE(total);
+
+		int32_t split_feature=-1;
+		int32_t split_bin=-1;
+		if ((params.max_depth<=0 || task.depth<params.max_depth) &&
+				task.num>=2*params.min_node_size)
+		{
+			for (int32_t f=0; f<m_num_features; f++)
+				features[f]=f;
+			/* partial Fisher-Yates shuffle to draw the candidates */
+			for (int32_t c=0; c<num_candidates && num_candidates<m_num_features; c++)
+			{
+				int32_t j=prng->random(c, m_num_features-1);
+				CMath::swap(features[c], features[j]);
+			}
+
+			find_split(task.hist, features, num_candidates, params,
+					split_feature, split_bin);
+		}
+
+		if (split_feature<0)
+		{
+			if (leaf_of_vector)
+			{
+				for (int32_t j=task.begin; j<task.begin+task.num; j++)
+					leaf_of_vector[idx[j]]=task.node;
+			}
+			m_free_histograms.push_back(task.hist);
+			continue;
+		}
+
+		/* stable partition keeps the vectors in ascending order */
+		const uint8_t* bins=&m_bins[int64_t(split_feature)*m_num_vectors];
+		int32_t num_left=0;
+		int32_t num_right=0;
+		for (int32_t j=task.begin; j<task.begin+task.num; j++)
+		{
+			if (bins[idx[j]]<=split_bin)
+				idx[task.begin+num_left++]=idx[j];
+			else
+				right[num_right++]=idx[j];
+		}
+		memcpy(&idx[task.begin+num_left], right, sizeof(index_t)*num_right);
+
+		int32_t child=nodes.feature.get_num_elements();
+		nodes.feature.set_element(split_feature, task.node);
+		nodes.threshold.set_element(
+				m_edges[int64_t(split_feature)*(m_max_bins-1)+split_bin],
+				task.node);
+		nodes.child.set_element(child, task.node);
+		for (int32_t c=0; c<2; c++)
+		{
+			nodes.feature.push_back(-1);
+			nodes.threshold.push_back(0);
+			nodes.child.push_back(-1);
+			for (int32_t k=0; k<num_outputs; k++)
+				nodes.value.push_back(0);
+		}
+
+		HistogramTreeTask left_task;
+		left_task.node=child;
+		left_task.begin=task.begin;
+		left_task.num=num_left;
+		left_task.depth=task.depth+1;
+
+		HistogramTreeTask right_task;
+		right_task.node=child+1;
+		right_task.begin=task.begin+num_left;
+		right_task.num=num_right;
+		right_task.depth=task.depth+1;
+
+		/* histograms of the smaller child are built, the ones of the larger
+		 * child are what remains of the parent */
+		HistogramTreeTask& small=num_left<=num_right ? left_task : right_task;
+		HistogramTreeTask& large=num_left<=num_right ? right_task : left_task;
+		small.hist=get_histogram();
+		build_histogram(&idx[small.begin], small.num, targets, weights,
+				small.hist);
+		large.hist=task.hist;
+
+		#pragma omp parallel for num_threads(m_num_threads)
+		for (int32_t f=0; f<m_num_features; f++)
+		{
+			int64_t offs=int64_t(f)*m_max_bins*m_stride;
+			for (int32_t j=0; j<m_num_bins[f]*m_stride; j++)
+				large.hist[offs+j]-=small.hist[offs+j];
+		}
+
+		tasks.push_back(right_task);
+		tasks.push_back(left_task);
+	}
+
+	SG_FREE(features);
+	SG_FREE(right);
+	SG_FREE(idx);
+
+	return root.node;
+}
+
+void HistogramTreeBuilder::apply_trees(CDenseFeatures<float64_t>* data,
+		SGVector<int32_t> feature, SGVector<float64_t> threshold,
+		SGVector<int32_t> child, SGVector<float64_t> value,
+		int32_t num_outputs, SGVector<int32_t> roots, SGVector<int32_t> rows,
+		SGMatrix<float64_t> result, int32_t num_threads)
+{
+	REQUIRE(data, "No features given\n")
+	REQUIRE(roots.vlen==rows.vlen, "Number of trees (%d) and of output rows "
+			"(%d) differ\n", roots.vlen, rows.vlen)
+
+	int32_t num_vectors=data->get_num_vectors();
+	REQUIRE(result.num_cols==num_vectors, "Result has %d columns but there "
+			"are %d vectors\n", result.num_cols, num_vectors)
+
+	int32_t num_blocks=(num_vectors+HISTOGRAM_TREE_BLOCK_VECTORS-1)/
+		HISTOGRAM_TREE_BLOCK_VECTORS;
+
+	#pragma omp parallel for schedule(dynamic) num_threads(num_threads)
+	for (int32_t b=0; b<num_blocks; b++)
+	{
+		int32_t start=b*HISTOGRAM_TREE_BLOCK_VECTORS;
+		int32_t n=CMath::min(HISTOGRAM_TREE_BLOCK_VECTORS, num_vectors-start);
+		float64_t* vec[HISTOGRAM_TREE_BLOCK_VECTORS];
+		bool vec_free[HISTOGRAM_TREE_BLOCK_VECTORS];
+
+		for (int32_t i=0; i<n; i++)
+		{
+			int32_t len;
+			vec[i]=data->get_feature_vector(start+i, len, vec_free[i]);
+		}
+
+		/* the upper nodes of a tree stay in cache for the whole block */
+		for (int32_t t=0; t<roots.vlen; t++)
+		{
+			for (int32_t i=0; i<n; i++)
+			{
+				const float64_t* x=vec[i];
+				int32_t node=roots[t];
+				while (feature[node]>=0)
+					node=child[node]+(x[feature[node]]>threshold[node]);
+
+				float64_t* out=result.get_column_vector(start+i)+rows[t];
+				const float64_t* v=&value[int64_t(node)*num_outputs];
+				for (int32_t k=0; k<num_outputs; k++)
+					out[k]+=v[k];
+			}
+		}
+
+		for (int32_t i=0; i<n; i++)
+			data->free_feature_vector(vec[i], start+i, vec_free[i]);
+	}
+}
@@ -0,0 +1,215 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society
+ */
+
+#ifndef HISTOGRAMTREEBUILDER_H
+#define HISTOGRAMTREEBUILDER_H
+
+#include <shogun/lib/config.h>
+#include <shogun/lib/common.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/base/DynArray.h>
+
+namespace shogun
+{
+template <class ST> class CDenseFeatures;
+class CRandom;
+
+/** settings used while growing a tree */
+struct HistogramTreeParams
+{
+	/** default settings: unlimited depth, all features, no regularization */
+	HistogramTreeParams()
+		: max_depth(0), min_node_size(1), min_gain(0), lambda(0),
+		num_random_features(0), leaf_scale(1)
+	{
+	}
+
+	/** maximum depth of the tree, 0 for unlimited */
+	int32_t max_depth;
+	/** minimum number of vectors in a leaf */
+	int32_t min_node_size;
+	/** minimum gain of a split */
+	float64_t min_gain;
+	/** L2 regularization of the leaf values */
+	float64_t lambda;
+	/** number of features drawn at random in each node, 0 for all */
+	int32_t num_random_features;
+	/** factor applied to all node values, e.g. the learning rate */
+	float64_t leaf_scale;
+};
+
+/** nodes of one or several trees, flattened into arrays
+ *
+ * The two children of a node are always stored next to each other, the
+ * right child directly after the left one. Node i is a leaf if
+ * feature[i]<0, otherwise vectors with x[feature[i]]>threshold[i] go to
+ * the right child.
+ */
+struct HistogramTreeNodes
+{
+	/** split feature of each node, -1 for leaves */
+	DynArray<int32_t> feature;
+	/** split threshold of each node */
+	DynArray<float64_t> threshold;
+	/** index of the left child of each node */
+	DynArray<int32_t> child;
+	/** num_outputs values of each node, node after node */
+	DynArray<float64_t> value;
+};
+
+/** @brief Grows regression trees on features that are binned once.
+ *
+ * Every feature is quantized into at most 256 bins given by quantiles of
+ * its values, so the training data is stored as one byte per entry,
+ * feature after feature. Each vector i carries num_outputs targets
+ * \f$g_{ik}\f$ and a weight \f$h_i\f$ (a hessian, or 1). A node
+ * accumulates the histograms \f$(n, H, G_1, \dots, G_K)\f$ of all
+ * features over its vectors; its value is \f$G_k/(H+\lambda)\f$ and a
+ * split maximizes
+ * \f[
+ *	\sum_k \frac{G_{Lk}^2}{H_L+\lambda}+\frac{G_{Rk}^2}{H_R+\lambda}
+ *		-\frac{G_k^2}{H+\lambda}
+ * \f]
+ * over all bin boundaries. With unit weights this is the reduction of
+ * the squared error (and of the Gini impurity for one-hot targets), with
+ * gradients and hessians it is the second order boosting gain.
+ *
+ * The histograms are built in parallel over the features, and only for
+ * the smaller child of each split; the one of the larger child is the
+ * difference of the parent and its sibling.
+ */
+class HistogramTreeBuilder
+{
+	public:
+		/** bin features
+		 *
+		 * @param features features to grow the trees on
+		 * @param max_bins maximum number of bins per feature (2..256)
+		 * @param num_threads number of threads to use
+		 */
+		HistogramTreeBuilder(CDenseFeatures<float64_t>* features,
+				int32_t max_bins=256, int32_t num_threads=1);
+
+		/** destructor */
+		~HistogramTreeBuilder();
+
+		/** @return number of vectors */
+		int32_t get_num_vectors() const { return m_num_vectors; }
+
+		/** @return number of features */
+		int32_t get_num_features() const { return m_num_features; }
+
+		/** grow a tree and append it to nodes
+		 *
+		 * @param targets num_outputs targets of each vector, vector after
+		 * vector
+		 * @param weights weight of each vector, NULL for unit weights
+		 * @param num_outputs number of targets per vector
+		 * @param vectors vectors to grow the tree on, each index at most
+		 * once
+		 * @param params settings
+		 * @param prng random generator to draw the features from, may be
+		 * NULL if all features are split candidates
+		 * @param nodes nodes the tree is appended to
+		 * @param leaf_of_vector if not NULL, the leaf of vectors[i] is
+		 * stored in leaf_of_vector[vectors[i]]
+		 * @return index of the root node
+		 */
+		int32_t grow(const float64_t* targets, const float64_t* weights,
+				int32_t num_outputs, SGVector<index_t> vectors,
+				const HistogramTreeParams& params, CRandom* prng,
+				HistogramTreeNodes& nodes, int32_t* leaf_of_vector=NULL);
+
+		/** sum up the leaf values of several flattened trees
+		 *
+		 * Blocks of vectors are processed in parallel, and each tree is
+		 * applied to all vectors of a block before the next one.
+		 *
+		 * @param data dense features
+		 * @param feature split feature of each node
+		 * @param threshold split threshold of each node
+		 * @param child left child of each node
+		 * @param value num_outputs values of each node
+		 * @param num_outputs number of values per node
+		 * @param roots root of each tree
+		 * @param rows tree t adds its values to rows rows[t] to
+		 * rows[t]+num_outputs-1 of the result
+		 * @param result num_rows x num_vectors matrix the values are
+		 * added to
+		 * @param num_threads number of threads to use
+		 */
+		static void apply_trees(CDenseFeatures<float64_t>* data,
+				SGVector<int32_t> feature, SGVector<float64_t> threshold,
+				SGVector<int32_t> child, SGVector<float64_t> value,
+				int32_t num_outputs, SGVector<int32_t> roots,
+				SGVector<int32_t> rows, SGMatrix<float64_t> result,
+				int32_t num_threads);
+
+		/** copy a dynamic array into a vector
+		 *
+		 * @param array array to copy
+		 * @return copy of array
+		 */
+		template <class T>
+		static SGVector<T> to_vector(const DynArray<T>& array)
+		{
+			SGVector<T> v(array.get_num_elements());
+			if (v.vlen)
+				memcpy(v.vector, array.get_array(), sizeof(T)*v.vlen);
+			return v;
+		}
+
+	private:
+		/** quantize the features into bins */
+		void bin_features(CDenseFeatures<float64_t>* features);
+
+		/** @return a histogram buffer */
+		float64_t* get_histogram();
+
+		/** build the histograms of all features over a set of vectors */
+		void build_histogram(const index_t* vectors, int32_t num,
+				const float64_t* targets, const float64_t* weights,
+				float64_t* hist) const;
+
+		/** find the best split of a node
+		 *
+		 * @return gain of the split, or a negative number if there is none
+		 */
+		float64_t find_split(const float64_t* hist, const int32_t* features,
+				int32_t num_features, const HistogramTreeParams& params,
+				int32_t& split_feature, int32_t& split_bin) const;
+
+		/** score \f$\sum_k G_k^2/(H+\lambda)\f$ of a histogram entry */
+		float64_t score(const float64_t* entry, float64_t lambda) const;
+
+	private:
+		/** number of vectors */
+		int32_t m_num_vectors;
+		/** number of features */
+		int32_t m_num_features;
+		/** maximum number of bins per feature */
+		int32_t m_max_bins;
+		/** number of threads */
+		int32_t m_num_threads;
+		/** bin of each entry, feature after feature */
+		uint8_t* m_bins;
+		/** number of bins of each feature */
+		SGVector<int32_t> m_num_bins;
+		/** upper edges of the bins, m_max_bins-1 per feature */
+		SGVector<float64_t> m_edges;
+		/** number of targets of the tree being grown */
+		int32_t m_num_outputs;
+		/** doubles per histogram entry (num_outputs+2) */
+		int32_t m_stride;
+		/** histogram buffers ready for reuse */
+		DynArray<float64_t*> m_free_histograms;
+};
+}
+#endif //HISTOGRAMTREEBUILDER_H
@@ -66,6 +66,7 @@ CKernelMachine::CKernelMachine(CKernelMachine* machine) : CMachine()
 	set_support_vectors(svs);
 	set_bias(bias);
 	set_kernel(ker);
+	SG_UNREF(ker);
 }
 
 CKernelMachine::~CKernelMachine()
@@ -11,6 +11,12 @@
 
 #include <shogun/lib/Set.h>
 #include <shogun/machine/KernelMulticlassMachine.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/kernel/CustomKernel.h>
+
+#ifdef HAVE_EIGEN3
+#include <shogun/mathematics/eigen3.h>
+#endif
 
 using namespace shogun;
 
@@ -80,9 +86,132 @@ void CKernelMulticlassMachine::store_model_features()
 	SG_UNREF(rhs);
 }
 
-CKernelMulticlassMachine::CKernelMulticlassMachine() : CMulticlassMachine(), m_kernel(NULL)
+void CKernelMulticlassMachine::get_all_submachine_outputs(CBinaryLabels** outputs)
+{
+	int32_t num_machines=m_machines->get_num_elements();
+
+	/* machines using linadd are cheaper to evaluate separately */
+	bool shared=m_kernel && num_machines>1;
+	for (int32_t i=0; i<num_machines && shared; i++)
+	{
+		CKernelMachine* machine=(CKernelMachine*)m_machines->get_element(i);
+		if (machine->get_linadd_enabled() && m_kernel->has_property(KP_LINADD))
+			shared=false;
+		SG_UNREF(machine);
+	}
+
+	if (!shared)
+	{
+		CMulticlassMachine::get_all_submachine_outputs(outputs);
+		return;
+	}
+
+	int32_t num_lhs=m_kernel->get_num_vec_lhs();
+	int32_t num_rhs=m_kernel->get_num_vec_rhs();
+
+	/* position of every lhs vector in the union of SV, -1 if no SV */
+	SGVector<index_t> sv_pos(num_lhs);
+	sv_pos.set_const(-1);
+	index_t num_sv=0;
+	for (int32_t i=0; i<num_machines; i++)
+	{
+		CKernelMachine* machine=(CKernelMachine*)m_machines->get_element(i);
+		for (int32_t j=0; j<machine->get_num_support_vectors(); j++)
+		{
+			index_t sv=machine->get_support_vector(j);
+			ASSERT(sv>=0 && sv<num_lhs)
+			if (sv_pos[sv]<0)
+				sv_pos[sv]=num_sv++;
+		}
+		SG_UNREF(machine);
+	}
+
+	/* SV coefficients of all machines w.r.t. the union of SV */
+	SGVector<index_t> sv_idx(num_sv);
+	for (index_t i=0; i<num_lhs; i++)
+	{
+		if (sv_pos[i]>=0)
+			sv_idx[sv_pos[i]]=i;
+	}
+
+	SGMatrix<float64_t> coef(num_sv, num_machines);
+	coef.zero();
+	SGVector<float64_t> bias(num_machines);
+	for (int32_t i=0; i<num_machines; i++)
+	{
+		CKernelMachine* machine=(CKernelMachine*)m_machines->get_element(i);
+		for (int32_t j=0; j<machine->get_num_support_vectors(); j++)
+			coef(sv_pos[machine->get_support_vector(j)], i)+=machine->get_alpha(j);
+		bias[i]=machine->get_bias();
+		SG_UNREF(machine);
+	}
+
+	SGMatrix<float64_t> out(num_rhs, num_machines);
+	const int32_t block_size=64;
+	int32_t num_blocks=(num_rhs+block_size-1)/block_size;
+
+	#pragma omp parallel num_threads(parallel->get_num_threads())
+	{
+		float64_t* krow=SG_MALLOC(float64_t, int64_t(num_sv)*block_size);
+
+		#pragma omp for schedule(dynamic)
+		for (int32_t blk=0; blk<num_blocks; blk++)
+		{
+			int32_t first=blk*block_size;
+			int32_t len=CMath::min(block_size, num_rhs-first);
+
+			/* one kernel row per test vector, shared by all machines */
+			for (int32_t j=0; j<len; j++)
+			{
+				for (index_t u=0; u<num_sv; u++)
+					krow[u+int64_t(j)*num_sv]=m_kernel->kernel(sv_idx[u], first+j);
+			}
+
+			float64_t* o=out.matrix+first;
+#ifdef HAVE_EIGEN3
+			if (num_sv>0)
+			{
+				Eigen::Map<Eigen::MatrixXd> eK(krow, num_sv, len);
+				Eigen::Map<Eigen::MatrixXd> eC(coef.matrix, num_sv, num_machines);
+				Eigen::Map<Eigen::MatrixXd, 0, Eigen::OuterStride<> > eO(o, len,
+						num_machines, Eigen::OuterStride<>(num_rhs));
+				eO.noalias()=eK.transpose()*eC;
+			}
+#endif
+			for (int32_t i=0; i<num_machines; i++)
+			{
+				for (int32_t j=0; j<len; j++)
+				{
+#ifdef HAVE_EIGEN3
+					if (num_sv==0)
+						o[j+int64_t(i)*num_rhs]=0;
+#else
+					o[j+int64_t(i)*num_rhs]=SGVector<float64_t>::dot(
+							&krow[int64_t(j)*num_sv], coef.get_column_vector(i), num_sv);
+#endif
+					o[j+int64_t(i)*num_rhs]+=bias[i];
+				}
+			}
+		}
+
+		SG_FREE(krow);
+	}
+
+	for (int32_t i=0; i<num_machines; i++)
+	{
+		SGVector<float64_t> values(num_rhs);
+		memcpy(values.vector, out.get_column_vector(i), sizeof(float64_t)*num_rhs);
+		outputs[i]=new CBinaryLabels(values);
+	}
+}
+
+CKernelMulticlassMachine::CKernelMulticlassMachine() : CMulticlassMachine(), m_kernel(NULL),
+	m_max_shared_kernel_size(1024)
 {
 	SG_ADD((CSGObject**)&m_kernel,"kernel", "The kernel to be used", MS_AVAILABLE);
+	SG_ADD(&m_max_shared_kernel_size, "max_shared_kernel_size",
+			"Maximal size of the kernel matrix for parallel training in MB",
+			MS_NOT_AVAILABLE);
 }
 
 /** standard constructor
@@ -92,10 +221,14 @@ CKernelMulticlassMachine::CKernelMulticlassMachine() : CMulticlassMachine(), m_k
  * @param labs labels
  */
 CKernelMulticlassMachine::CKernelMulticlassMachine(CMulticlassStrategy *strategy, CKernel* kernel, CKernelMachine* machine, CLabels* labs) :
-	CMulticlassMachine(strategy,(CMachine*)machine,labs), m_kernel(NULL)
+	CMulticlassMachine(strategy,(CMachine*)machine,labs), m_kernel(NULL),
+	m_max_shared_kernel_size(1024)
 {
 	set_kernel(kernel);
 	SG_ADD((CSGObject**)&m_kernel,"kernel", "The kernel to be used", MS_AVAILABLE);
+	SG_ADD(&m_max_shared_kernel_size, "max_shared_kernel_size",
+			"Maximal size of the kernel matrix for parallel training in MB",
+			MS_NOT_AVAILABLE);
 }
 
 /** destructor */
@@ -122,6 +255,18 @@ CKernel* CKernelMulticlassMachine::get_kernel()
 	return m_kernel;
 }
 
+void CKernelMulticlassMachine::set_max_shared_kernel_size(int32_t size)
+{
+	REQUIRE(size>=0, "Maximal kernel matrix size (%d) must not be negative\n",
+			size);
+	m_max_shared_kernel_size=size;
+}
+
+int32_t CKernelMulticlassMachine::get_max_shared_kernel_size() const
+{
+	return m_max_shared_kernel_size;
+}
+
 bool CKernelMulticlassMachine::init_machine_for_train(CFeatures* data)
 {
 	if (data)
@@ -164,7 +309,81 @@ bool CKernelMulticlassMachine::is_ready()
 
 CMachine* CKernelMulticlassMachine::get_machine_from_trained(CMachine* machine)
 {
-	return new CKernelMachine((CKernelMachine*)machine);
+	CKernelMachine* trained=new CKernelMachine((CKernelMachine*)machine);
+
+	/* machines trained in parallel hold a custom kernel on the training data */
+	trained->set_kernel(m_kernel);
+
+	return trained;
+}
+
+CDynamicObjectArray* CKernelMulticlassMachine::get_machines_for_workers(
+		int32_t num_workers)
+{
+	if (!m_kernel || !m_kernel->get_num_vec_lhs())
+		return NULL;
+
+	int64_t size=int64_t(m_kernel->get_num_vec_lhs())*
+			m_kernel->get_num_vec_rhs()*sizeof(float32_t);
+	if (size>int64_t(m_max_shared_kernel_size)*1024*1024)
+	{
+		SG_INFO("Kernel matrix of %d MB exceeds %d MB\n", (int32_t) (size/(1024*1024)),
+				m_max_shared_kernel_size);
+		return NULL;
+	}
+
+	SGMatrix<float32_t> km=m_kernel->get_kernel_matrix<float32_t>();
+
+	CKernelMachine* machine=(CKernelMachine*) m_machine;
+	machine->set_kernel(NULL);
+
+	CDynamicObjectArray* workers=new CDynamicObjectArray(num_workers);
+	for (int32_t i=0; i<num_workers; i++)
+	{
+		CKernelMachine* worker=(CKernelMachine*) machine->clone();
+		if (!worker)
+			break;
+
+		worker->set_kernel(new CCustomKernel(km));
+		workers->push_back(worker);
+		SG_UNREF(worker);
+	}
+
+	machine->set_kernel(m_kernel);
+
+	return workers;
+}
+
+void CKernelMulticlassMachine::add_worker_subset(CMachine* machine,
+		SGVector<index_t> subset)
+{
+	CKernel* kernel=((CKernelMachine*) machine)->get_kernel();
+	ASSERT(kernel && kernel->get_kernel_type()==K_CUSTOM)
+
+	((CCustomKernel*) kernel)->add_row_subset(subset);
+	((CCustomKernel*) kernel)->add_col_subset(subset);
+	SG_UNREF(kernel);
+}
+
+void CKernelMulticlassMachine::remove_worker_subset(CMachine* machine)
+{
+	CKernel* kernel=((CKernelMachine*) machine)->get_kernel();
+	ASSERT(kernel && kernel->get_kernel_type()==K_CUSTOM)
+
+	((CCustomKernel*) kernel)->remove_row_subset();
+	((CCustomKernel*) kernel)->remove_col_subset();
+	SG_UNREF(kernel);
+}
+
+CMachine* CKernelMulticlassMachine::get_machine_from_worker(CMachine* machine,
+		SGVector<index_t> subset)
+{
+	CKernelMachine* trained=(CKernelMachine*) get_machine_from_trained(machine);
+
+	for (int32_t i=0; subset.vlen && i<trained->get_num_support_vectors(); i++)
+		trained->set_support_vector(i, subset[trained->get_support_vector(i)]);
+
+	return trained;
 }
 
 int32_t CKernelMulticlassMachine::get_num_rhs_vectors()
@@ -60,6 +60,19 @@ class CKernelMulticlassMachine : public CMulticlassMachine
 		 */
 		CKernel* get_kernel();
 
+		/** set the largest kernel matrix that is computed to train the
+		 * submachines in parallel, see set_parallel_training(). The matrix
+		 * is stored in single precision, as in CCustomKernel, so results
+		 * can differ slightly from sequential training. Larger problems
+		 * are trained sequentially.
+		 *
+		 * @param size maximal size of the kernel matrix in MB
+		 */
+		void set_max_shared_kernel_size(int32_t size);
+
+		/** @return maximal size of the shared kernel matrix in MB */
+		int32_t get_max_shared_kernel_size() const;
+
 		/** Stores feature data of underlying model.
 		 *
 		 * Need to store the SVs for all sub-machines. We make a union of the
@@ -68,6 +81,19 @@ class CKernelMulticlassMachine : public CMulticlassMachine
 		 */
 		virtual void store_model_features();
 
+		/** get outputs of all submachines
+		 *
+		 * Computes the kernel values between each test vector and the union
+		 * of the support vectors of all submachines once and scores every
+		 * submachine from them, instead of evaluating each submachine
+		 * separately. Falls back to per-machine evaluation if the
+		 * submachines use linadd optimizations.
+		 *
+		 * @param outputs array of length number of machines to store
+		 * the outputs in
+		 */
+		virtual void get_all_submachine_outputs(CBinaryLabels** outputs);
+
 	protected:
 
 		/** init machine for training with kernel init */
@@ -82,6 +108,39 @@ class CKernelMulticlassMachine : public CMulticlassMachine
 		/** construct kernel machine from given kernel machine */
 		virtual CMachine* get_machine_from_trained(CMachine* machine);
 
+		/** create copies of the base machine that share the kernel matrix.
+		 * The matrix is computed once in single precision, each copy gets a
+		 * custom kernel on it.
+		 *
+		 * @param num_workers number of copies
+		 * @return the copies, NULL if the matrix would be larger than
+		 * get_max_shared_kernel_size()
+		 */
+		virtual CDynamicObjectArray* get_machines_for_workers(int32_t num_workers);
+
+		/** set row and column subset to the custom kernel of a copy
+		 *
+		 * @param machine the copy
+		 * @param subset subset indices to set
+		 */
+		virtual void add_worker_subset(CMachine* machine, SGVector<index_t> subset);
+
+		/** delete the subset of the custom kernel of a copy
+		 *
+		 * @param machine the copy
+		 */
+		virtual void remove_worker_subset(CMachine* machine);
+
+		/** construct kernel machine from a trained copy, its support vectors
+		 * are mapped from the subset to the training vectors
+		 *
+		 * @param machine the trained copy
+		 * @param subset indices of the training vectors it was trained on
+		 * @return the kernel machine
+		 */
+		virtual CMachine* get_machine_from_worker(CMachine* machine,
+				SGVector<index_t> subset);
+
 		/** return number of rhs feature vectors */
 		virtual int32_t get_num_rhs_vectors();
 
@@ -99,6 +158,9 @@ class CKernelMulticlassMachine : public CMulticlassMachine
 		/** kernel */
 		CKernel* m_kernel;
 
+		/** maximal size of the kernel matrix shared by parallel training in MB */
+		int32_t m_max_shared_kernel_size;
+
 };
 }
 #endif
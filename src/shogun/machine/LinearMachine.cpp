@@ -78,7 +78,7 @@ SGVector<float64_t> CLinearMachine::apply_get_outputs(CFeatures* data)
 	ASSERT(w.vlen==features->get_dim_feature_space())
 
 	float64_t* out=SG_MALLOC(float64_t, num);
-	features->dense_dot_range(out, 0, num, NULL, w.vector, w.vlen, bias);
+	features->dense_dot_range_multi(out, 0, num, w.vector, w.vlen, 1, &bias);
 	return SGVector<float64_t>(out,num);
 }
 
@@ -15,6 +15,7 @@
 #include <shogun/features/DotFeatures.h>
 #include <shogun/machine/LinearMachine.h>
 #include <shogun/machine/MulticlassMachine.h>
+#include <shogun/labels/BinaryLabels.h>
 
 namespace shogun
 {
@@ -88,6 +89,50 @@ class CLinearMulticlassMachine : public CMulticlassMachine
 			return m_features;
 		}
 
+		/** get outputs of all submachines
+		 *
+		 * stacks the normal vectors of all linear machines and scores them
+		 * in one pass over the features via
+		 * CDotFeatures::dense_dot_range_multi
+		 *
+		 * @param outputs array of length number of machines to store
+		 * the outputs in
+		 */
+		virtual void get_all_submachine_outputs(CBinaryLabels** outputs)
+		{
+			ASSERT(m_features)
+			int32_t num_machines=m_machines->get_num_elements();
+			int32_t num_vectors=m_features->get_num_vectors();
+			int32_t dim=m_features->get_dim_feature_space();
+
+			SGMatrix<float64_t> W(dim, num_machines);
+			SGVector<float64_t> b(num_machines);
+			for (int32_t i=0; i<num_machines; i++)
+			{
+				CLinearMachine* machine=(CLinearMachine*) m_machines->get_element(i);
+				ASSERT(machine)
+				SGVector<float64_t> w=machine->get_w();
+				ASSERT(w.vlen==dim)
+				memcpy(W.get_column_vector(i), w.vector, sizeof(float64_t)*dim);
+				b[i]=machine->get_bias();
+				SG_UNREF(machine);
+			}
+
+			SGMatrix<float64_t> out(num_vectors, num_machines);
+			if (num_vectors>0)
+			{
+				m_features->dense_dot_range_multi(out.matrix, 0, num_vectors,
+						W.matrix, dim, num_machines, b.vector);
+			}
+
+			for (int32_t i=0; i<num_machines; i++)
+			{
+				SGVector<float64_t> values(num_vectors);
+				memcpy(values.vector, out.get_column_vector(i), sizeof(float64_t)*num_vectors);
+				outputs[i]=new CBinaryLabels(values);
+			}
+		}
+
 	protected:
 
 		/** init machine for train with setting features */
@@ -143,6 +188,55 @@ class CLinearMulticlassMachine : public CMulticlassMachine
 			return m_features->get_num_vectors();
 		}
 
+		/** create copies of the base machine that share the features
+		 *
+		 * @param num_workers number of copies
+		 * @return the copies
+		 */
+		virtual CDynamicObjectArray* get_machines_for_workers(int32_t num_workers)
+		{
+			CLinearMachine* machine=(CLinearMachine*) m_machine;
+			machine->set_features(NULL);
+
+			CDynamicObjectArray* workers=new CDynamicObjectArray(num_workers);
+			for (int32_t i=0; i<num_workers; i++)
+			{
+				CLinearMachine* worker=(CLinearMachine*) machine->clone();
+				if (!worker)
+					break;
+
+				worker->set_features(m_features);
+				workers->push_back(worker);
+				SG_UNREF(worker);
+			}
+
+			machine->set_features(m_features);
+
+			return workers;
+		}
+
+		/** train a worker machine on a copy of the subset of the features,
+		 * as the shared features must not change
+		 *
+		 * @param machine the worker machine
+		 * @param subset subset indices to set
+		 */
+		virtual void add_worker_subset(CMachine* machine, SGVector<index_t> subset)
+		{
+			CDotFeatures* features=(CDotFeatures*) m_features->copy_subset(subset);
+			((CLinearMachine*) machine)->set_features(features);
+			SG_UNREF(features);
+		}
+
+		/** restore the shared features of a worker machine
+		 *
+		 * @param machine the worker machine
+		 */
+		virtual void remove_worker_subset(CMachine* machine)
+		{
+			((CLinearMachine*) machine)->set_features(m_features);
+		}
+
 		/** set subset to the features of the machine, deletes old one
 		 *
 		 * @param subset subset instance to set
@@ -87,7 +87,9 @@ enum EMachineType
 	CT_GAUSSIANPROCESSBINARY = 530,
 	CT_GAUSSIANPROCESSMULTICLASS = 540,
 	CT_STOCHASTICSOSVM = 550,
-	CT_BAGGING
+	CT_BAGGING,
+	CT_DECISIONTREE,
+	CT_GRADIENTBOOSTEDTREES
 };
 
 /** solver type */
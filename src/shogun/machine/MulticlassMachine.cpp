@@ -18,12 +18,13 @@
 #include <shogun/labels/MulticlassLabels.h>
 #include <shogun/labels/RegressionLabels.h>
 #include <shogun/mathematics/Statistics.h>
+#include <shogun/lib/ShogunException.h>
 
 using namespace shogun;
 
 CMulticlassMachine::CMulticlassMachine()
 : CBaseMulticlassMachine(), m_multiclass_strategy(new CMulticlassOneVsRestStrategy()),
-	m_machine(NULL)
+	m_machine(NULL), m_parallel_training(false)
 {
 	SG_REF(m_multiclass_strategy);
 	register_parameters();
@@ -32,7 +33,8 @@ CMulticlassMachine::CMulticlassMachine()
 CMulticlassMachine::CMulticlassMachine(
 		CMulticlassStrategy *strategy,
 		CMachine* machine, CLabels* labs)
-: CBaseMulticlassMachine(), m_multiclass_strategy(strategy)
+: CBaseMulticlassMachine(), m_multiclass_strategy(strategy),
+	m_parallel_training(false)
 {
 	SG_REF(strategy);
 	set_labels(labs);
@@ -61,6 +63,8 @@ void CMulticlassMachine::register_parameters()
 {
 	SG_ADD((CSGObject**)&m_multiclass_strategy,"m_multiclass_type", "Multiclass strategy", MS_NOT_AVAILABLE);
 	SG_ADD((CSGObject**)&m_machine, "m_machine", "The base machine", MS_NOT_AVAILABLE);
+	SG_ADD(&m_parallel_training, "parallel_training",
+			"Whether subproblems are trained concurrently", MS_NOT_AVAILABLE);
 }
 
 void CMulticlassMachine::init_strategy()
@@ -78,6 +82,12 @@ CBinaryLabels* CMulticlassMachine::get_submachine_outputs(int32_t i)
 	return output;
 }
 
+void CMulticlassMachine::get_all_submachine_outputs(CBinaryLabels** outputs)
+{
+	for (int32_t i=0; i<m_machines->get_num_elements(); i++)
+		outputs[i]=get_submachine_outputs(i);
+}
+
 float64_t CMulticlassMachine::get_submachine_output(int32_t i, int32_t num)
 {
 	CMachine *machine = get_machine(i);
@@ -128,10 +138,10 @@ CMulticlassLabels* CMulticlassMachine::apply_multiclass(CFeatures* data)
 		SGVector<float64_t> As(num_machines);
 		SGVector<float64_t> Bs(num_machines);
 
+		get_all_submachine_outputs(outputs);
+
 		for (int32_t i=0; i<num_machines; ++i)
 		{
-			outputs[i] = (CBinaryLabels*) get_submachine_outputs(i);
-
 			if (heuris==OVA_SOFTMAX)
 			{
 				CStatistics::SigmoidParamters params = CStatistics::fit_sigmoid(outputs[i]->get_values());
@@ -216,8 +226,7 @@ CMulticlassMultipleOutputLabels* CMulticlassMachine::apply_multiclass_multiple_o
 		CMulticlassMultipleOutputLabels* result=new CMulticlassMultipleOutputLabels(num_vectors);
 		CBinaryLabels** outputs=SG_MALLOC(CBinaryLabels*, num_machines);
 
-		for (int32_t i=0; i < num_machines; ++i)
-			outputs[i] = (CBinaryLabels*) get_submachine_outputs(i);
+		get_all_submachine_outputs(outputs);
 
 		SGVector<float64_t> output_for_i(num_machines);
 		for (int32_t i=0; i<num_vectors; i++)
@@ -251,6 +260,24 @@ bool CMulticlassMachine::train_machine(CFeatures* data)
 		init_machine_for_train(data);
 
 	m_machines->reset_array();
+
+	int32_t num_threads=parallel->get_num_threads();
+	if (m_parallel_training && num_threads>1)
+	{
+		CDynamicObjectArray* workers=get_machines_for_workers(num_threads);
+		if (workers && workers->get_num_elements()==num_threads)
+		{
+			SG_REF(workers);
+			bool result=train_machine_parallel(workers);
+			SG_UNREF(workers);
+			return result;
+		}
+
+		SG_UNREF(workers);
+		SG_WARNING("%s cannot train %s concurrently, training sequentially\n",
+				get_name(), m_machine ? m_machine->get_name() : "");
+	}
+
 	CBinaryLabels* train_labels = new CBinaryLabels(get_num_rhs_vectors());
 	SG_REF(train_labels);
 	m_machine->set_labels(train_labels);
@@ -281,6 +308,109 @@ bool CMulticlassMachine::train_machine(CFeatures* data)
 	return true;
 }
 
+bool CMulticlassMachine::train_machine_parallel(CDynamicObjectArray* workers)
+{
+	int32_t num_workers=workers->get_num_elements();
+	int32_t num_vectors=get_num_rhs_vectors();
+
+	CBinaryLabels* train_labels=new CBinaryLabels(num_vectors);
+	SG_REF(train_labels);
+
+	/* the strategy prepares the subproblems one by one, so a batch of them
+	 * is collected first and then trained concurrently */
+	SGVector<float64_t>* labels=new SGVector<float64_t>[num_workers];
+	SGVector<index_t>* subsets=new SGVector<index_t>[num_workers];
+	CMachine** trained=SG_MALLOC(CMachine*, num_workers);
+
+	/* exceptions must not leave the parallel region, the first error is
+	 * kept and raised after it */
+	bool failed=false;
+	char error[1024];
+	memset(error, 0, sizeof(error));
+
+	m_multiclass_strategy->train_start(CLabelsFactory::to_multiclass(m_labels), train_labels);
+	while (!failed && m_multiclass_strategy->train_has_more())
+	{
+		int32_t num_jobs=0;
+		for (; num_jobs<num_workers && m_multiclass_strategy->train_has_more(); num_jobs++)
+		{
+			SGVector<index_t> subset=m_multiclass_strategy->train_prepare_next();
+			SGVector<float64_t> lab=train_labels->get_labels();
+
+			if (subset.vlen)
+			{
+				labels[num_jobs]=SGVector<float64_t>(subset.vlen);
+				for (index_t i=0; i<subset.vlen; i++)
+					labels[num_jobs][i]=lab[subset[i]];
+			}
+			else
+				labels[num_jobs]=lab.clone();
+
+			subsets[num_jobs]=subset;
+			trained[num_jobs]=NULL;
+		}
+
+		#pragma omp parallel for schedule(dynamic, 1) num_threads(num_jobs)
+		for (int32_t j=0; j<num_jobs; j++)
+		{
+			if (failed)
+				continue;
+
+			CMachine* machine=(CMachine*) workers->get_element(j);
+
+			try
+			{
+				CBinaryLabels* lab=new CBinaryLabels(labels[j].vlen);
+				lab->set_labels(labels[j]);
+				machine->set_labels(lab);
+
+				if (subsets[j].vlen)
+					add_worker_subset(machine, subsets[j]);
+
+				machine->train();
+				trained[j]=get_machine_from_worker(machine, subsets[j]);
+
+				if (subsets[j].vlen)
+					remove_worker_subset(machine);
+			}
+			catch (ShogunException& e)
+			{
+				#pragma omp critical (multiclass_worker_error)
+				{
+					if (!failed)
+						strncpy(error, e.get_exception_string(), sizeof(error)-1);
+					failed=true;
+				}
+			}
+
+			SG_UNREF(machine);
+		}
+
+		for (int32_t j=0; j<num_jobs; j++)
+		{
+			if (failed)
+				SG_UNREF(trained[j])
+			else
+				m_machines->push_back(trained[j]);
+		}
+	}
+
+	m_multiclass_strategy->train_stop();
+
+	SG_FREE(trained);
+	delete[] subsets;
+	delete[] labels;
+	SG_UNREF(train_labels);
+
+	if (failed)
+	{
+		m_machines->reset_array();
+		SG_ERROR("%s", error)
+	}
+
+	return true;
+}
+
 float64_t CMulticlassMachine::apply_one(int32_t vec_idx)
 {
 	init_machines_for_apply(NULL);
@@ -80,6 +80,16 @@ class CMulticlassMachine : public CBaseMulticlassMachine
 		 */
 		virtual CBinaryLabels* get_submachine_outputs(int32_t i);
 
+		/** get outputs of all submachines
+		 *
+		 * calls get_submachine_outputs for every submachine, subclasses
+		 * may override this to score all submachines in one pass
+		 *
+		 * @param outputs array of length number of machines to store
+		 * the outputs in
+		 */
+		virtual void get_all_submachine_outputs(CBinaryLabels** outputs);
+
 		/** get output of i-th submachine for num-th vector
 		 * @param i number of submachine
 		 * @param num number of feature vector
@@ -139,6 +149,27 @@ class CMulticlassMachine : public CBaseMulticlassMachine
 			return "MulticlassMachine";
 		}
 
+		/** set whether the binary subproblems are trained concurrently
+		 *
+		 * Each thread trains subproblems with its own copy of the base
+		 * machine. The copies share the training data, see
+		 * get_machines_for_workers(). The submachines are stored in the
+		 * order of the strategy, as in sequential training. Machine types
+		 * that do not support this are trained sequentially.
+		 *
+		 * @param parallel_training whether to train in parallel
+		 */
+		inline void set_parallel_training(bool parallel_training)
+		{
+			m_parallel_training=parallel_training;
+		}
+
+		/** @return whether the binary subproblems are trained concurrently */
+		inline bool get_parallel_training() const
+		{
+			return m_parallel_training;
+		}
+
 		/** get prob output heuristic of multiclass strategy */
 		inline EProbHeuristicType get_prob_heuris()
 		{
@@ -163,6 +194,61 @@ class CMulticlassMachine : public CBaseMulticlassMachine
 		/** train machine */
 		virtual bool train_machine(CFeatures* data = NULL);
 
+		/** train the subproblems concurrently, called by train_machine
+		 *
+		 * @param workers machines, one per thread
+		 * @return whether training was successful
+		 */
+		bool train_machine_parallel(CDynamicObjectArray* workers);
+
+		/** create copies of the base machine that train subproblems
+		 * concurrently. They must share the training data with, but not
+		 * modify the base machine, and each must be usable from another
+		 * thread.
+		 *
+		 * @param num_workers number of copies
+		 * @return the copies, NULL if not supported
+		 */
+		virtual CDynamicObjectArray* get_machines_for_workers(int32_t num_workers)
+		{
+			return NULL;
+		}
+
+		/** set subset to the features of a machine created by
+		 * get_machines_for_workers()
+		 *
+		 * @param machine the machine
+		 * @param subset subset indices to set
+		 */
+		virtual void add_worker_subset(CMachine* machine, SGVector<index_t> subset)
+		{
+			SG_NOTIMPLEMENTED
+		}
+
+		/** deletes the subset of a machine created by get_machines_for_workers()
+		 *
+		 * @param machine the machine
+		 */
+		virtual void remove_worker_subset(CMachine* machine)
+		{
+			SG_NOTIMPLEMENTED
+		}
+
+		/** obtain a submachine from a machine created by
+		 * get_machines_for_workers() after training, while its subset is
+		 * still set. By default this is get_machine_from_trained().
+		 *
+		 * @param machine the trained machine
+		 * @param subset indices of the training vectors it was trained on,
+		 * empty if it was trained on all of them
+		 * @return the submachine
+		 */
+		virtual CMachine* get_machine_from_worker(CMachine* machine,
+				SGVector<index_t> subset)
+		{
+			return get_machine_from_trained(machine);
+		}
+
 		/** abstract init machine for training method */
 		virtual bool init_machine_for_train(CFeatures* data) = 0;
 
@@ -204,6 +290,9 @@ class CMulticlassMachine : public CBaseMulticlassMachine
 
 		/** machine */
 		CMachine* m_machine;
+
+		/** whether subproblems are trained concurrently */
+		bool m_parallel_training;
 };
 }
 #endif
@@ -33,6 +33,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <float.h>
+#include <string.h>
 #include <sys/types.h>
 #ifndef _WIN32
 #include <unistd.h>
@@ -1043,6 +1044,109 @@ class CMath : public CSGObject
 		template <class T1,class T2>
 			static void* parallel_qsort_index(void* p);
 
+		/** performs a stable radix sort on an array output of length size
+		 * it is sorted in ascending order (for type T1) and permutes the
+		 * index (type T2) alongside
+		 * matlab alike [sorted,index]=sort(output)
+		 *
+		 * Keys may be integers or floating point numbers, NaNs are sorted
+		 * to the end. Each pass over a byte of the keys is done by
+		 * num_threads threads on blocks of the array, equal keys keep
+		 * their order.
+		 */
+		template <class T1,class T2>
+			static void radix_sort_index(T1* output, T2* index, index_t size,
+				int32_t num_threads=1);
+
+		/** performs a merge sort on an array output of length size
+		 * it is sorted in ascending order (for type T1) and permutes the
+		 * index (type T2) alongside
+		 *
+		 * Works for any T1 with operator< and operator>. Blocks of the
+		 * array are sorted with qsort_index() by num_threads threads and
+		 * merged pairwise in parallel.
+		 */
+		template <class T1,class T2>
+			static void parallel_merge_sort_index(T1* output, T2* index,
+				index_t size, int32_t num_threads);
+
+		/** rearranges output of length size such that output[k] is the
+		 * element that would be there if output was sorted in ascending
+		 * order, no element before it is larger and no element after it is
+		 * smaller (quickselect, linear time on average)
+		 *
+		 * @param output array
+		 * @param index indices permuted alongside, may be NULL
+		 * @param size length of output
+		 * @param k position to select
+		 */
+		template <class T1,class T2>
+			static void select_index(T1* output, T2* index, index_t size,
+				index_t k);
+
+		/** @return k-th smallest element of output, output is rearranged
+		 * as in select_index()
+		 */
+		template <class T>
+			static T select(T* output, index_t size, index_t k)
+			{
+				select_index<T,index_t>(output, NULL, size, k);
+				return output[k];
+			}
+
+		/** moves the k smallest elements of output of length size to its
+		 * first k positions in ascending order and permutes the index
+		 * alongside, the remaining elements are in no particular order
+		 */
+		template <class T1,class T2>
+			static void partial_sort_index(T1* output, T2* index, index_t size,
+				index_t k);
+
+		/** @return radix sort key of the given value, ordered like the
+		 * value, in the lowest sizeof(value) bytes */
+		static inline uint64_t radix_key(float64_t value)
+		{
+			/* -0.0 and 0.0 are equal, all NaNs go to the end */
+			if (value==0.0)
+				value=0.0;
+			if (value!=value)
+				return ~((uint64_t) 0);
+
+			uint64_t bits;
+			memcpy(&bits, &value, sizeof(bits));
+			return (bits>>63) ? ~bits : bits|(((uint64_t) 1)<<63);
+		}
+
+		/** @return radix sort key of value */
+		static inline uint64_t radix_key(float32_t value)
+		{
+			if (value==0.0f)
+				value=0.0f;
+			if (value!=value)
+				return 0xffffffffu;
+
+			uint32_t bits;
+			memcpy(&bits, &value, sizeof(bits));
+			return (bits>>31) ? (uint32_t) ~bits : bits|0x80000000u;
+		}
+
+		/** @return radix sort key of value */
+		static inline uint64_t radix_key(int8_t value) { return (uint8_t) (value^0x80); }
+		/** @return radix sort key of value */
+		static inline uint64_t radix_key(uint8_t value) { return value; }
+		/** @return radix sort key of value */
+		static inline uint64_t radix_key(int16_t value) { return (uint16_t) (value^0x8000); }
+		/** @return radix sort key of value */
+		static inline uint64_t radix_key(uint16_t value) { return value; }
+		/** @return radix sort key of value */
+		static inline uint64_t radix_key(int32_t value) { return ((uint32_t) value)^0x80000000u; }
+		/** @return radix sort key of value */
+		static inline uint64_t radix_key(uint32_t value) { return value; }
+		/** @return radix sort key of value */
+		static inline uint64_t radix_key(int64_t value) { return ((uint64_t) value)^(((uint64_t) 1)<<63); }
+		/** @return radix sort key of value */
+		static inline uint64_t radix_key(uint64_t value) { return value; }
+
 
 		/* finds the smallest element in output and puts that element as the
 		   first element  */
@@ -1558,14 +1662,280 @@ void CMath::qsort_backward_index(T1* output, T2* index, int32_t size)
 		qsort_backward_index(&output[left],&index[left], size-left);
 }
 
+	template <class T1,class T2>
+void CMath::radix_sort_index(T1* output, T2* index, index_t size,
+	int32_t num_threads)
+{
+	if (size<=1)
+		return;
+
+	const int32_t num_bytes=sizeof(T1);
+	const index_t min_block_size=16384;
+	int32_t num_blocks=CMath::max(1, CMath::min(num_threads, size/min_block_size));
+
+	/* block b spans [start[b], start[b+1]) */
+	index_t* start=SG_MALLOC(index_t, num_blocks+1);
+	for (int32_t b=0; b<=num_blocks; b++)
+		start[b]=(index_t) (((int64_t) size)*b/num_blocks);
+
+	uint64_t* keys=SG_MALLOC(uint64_t, size);
+	uint64_t* keys_out=SG_MALLOC(uint64_t, size);
+	index_t* pos=SG_MALLOC(index_t, size);
+	index_t* pos_out=SG_MALLOC(index_t, size);
+	index_t* count=SG_MALLOC(index_t, 256*num_blocks);
+
+	#pragma omp parallel for num_threads(num_blocks)
+	for (int32_t b=0; b<num_blocks; b++)
+	{
+		for (index_t i=start[b]; i<start[b+1]; i++)
+		{
+			keys[i]=radix_key(output[i]);
+			pos[i]=i;
+		}
+	}
+
+	/* least significant byte first, each pass is stable */
+	for (int32_t byte_idx=0; byte_idx<num_bytes; byte_idx++)
+	{
+		const int32_t shift=8*byte_idx;
+
+		#pragma omp parallel for num_threads(num_blocks)
+		for (int32_t b=0; b<num_blocks; b++)
+		{
+			index_t* c=&count[256*b];
+			memset(c, 0, 256*sizeof(index_t));
+			for (index_t i=start[b]; i<start[b+1]; i++)
+				c[(keys[i]>>shift) & 0xff]++;
+		}
+
+		/* bytes equal for all keys need no pass */
+		bool trivial=false;
+		for (int32_t d=0; d<256 && !trivial; d++)
+		{
+			index_t total=0;
+			for (int32_t b=0; b<num_blocks; b++)
+				total+=count[256*b+d];
+			trivial=total==size;
+		}
+		if (trivial)
+			continue;
+
+		/* turn counts into the first output position of each block/digit */
+		index_t offset=0;
+		for (int32_t d=0; d<256; d++)
+		{
+			for (int32_t b=0; b<num_blocks; b++)
+			{
+				index_t c=count[256*b+d];
+				count[256*b+d]=offset;
+				offset+=c;
+			}
+		}
+
+		#pragma omp parallel for num_threads(num_blocks)
+		for (int32_t b=0; b<num_blocks; b++)
+		{
+			index_t* c=&count[256*b];
+			for (index_t i=start[b]; i<start[b+1]; i++)
+			{
+				index_t dst=c[(keys[i]>>shift) & 0xff]++;
+				keys_out[dst]=keys[i];
+				pos_out[dst]=pos[i];
+			}
+		}
+
+		swap(keys, keys_out);
+		swap(pos, pos_out);
+	}
+
+	/* apply the permutation, the key buffer holds the old values */
+	T1* output_copy=(T1*) keys_out;
+	T2* index_copy=SG_MALLOC(T2, size);
+	if (sizeof(T1)>sizeof(uint64_t))
+		output_copy=SG_MALLOC(T1, size);
+
+	memcpy(output_copy, output, size*sizeof(T1));
+	memcpy(index_copy, index, size*sizeof(T2));
+
+	#pragma omp parallel for num_threads(num_blocks)
+	for (index_t i=0; i<size; i++)
+	{
+		output[i]=output_copy[pos[i]];
+		index[i]=index_copy[pos[i]];
+	}
+
+	if ((void*) output_copy!=(void*) keys_out)
+		SG_FREE(output_copy);
+	SG_FREE(index_copy);
+	SG_FREE(count);
+	SG_FREE(pos_out);
+	SG_FREE(pos);
+	SG_FREE(keys_out);
+	SG_FREE(keys);
+	SG_FREE(start);
+}
+
+	template <class T1,class T2>
+void CMath::parallel_merge_sort_index(T1* output, T2* index, index_t size,
+	int32_t num_threads)
+{
+	if (size<=1)
+		return;
+
+	const index_t min_block_size=16384;
+	int32_t num_blocks=CMath::max(1, CMath::min(num_threads, size/min_block_size));
+
+	if (num_blocks==1)
+	{
+		qsort_index(output, index, size);
+		return;
+	}
+
+	index_t* start=SG_MALLOC(index_t, num_blocks+1);
+	for (int32_t b=0; b<=num_blocks; b++)
+		start[b]=(index_t) (((int64_t) size)*b/num_blocks);
+
+	#pragma omp parallel for num_threads(num_blocks)
+	for (int32_t b=0; b<num_blocks; b++)
+		qsort_index(&output[start[b]], &index[start[b]], start[b+1]-start[b]);
+
+	T1* output_buf=SG_MALLOC(T1, size);
+	T2* index_buf=SG_MALLOC(T2, size);
+	T1* out_src=output;
+	T2* idx_src=index;
+	T1* out_dst=output_buf;
+	T2* idx_dst=index_buf;
+
+	for (int32_t width=1; width<num_blocks; width*=2)
+	{
+		#pragma omp parallel for num_threads(num_blocks)
+		for (int32_t b=0; b<num_blocks; b+=2*width)
+		{
+			index_t i=start[b];
+			index_t middle=start[CMath::min(b+width, num_blocks)];
+			index_t j=middle;
+			index_t last=start[CMath::min(b+2*width, num_blocks)];
+			index_t k=i;
+
+			while (i<middle && j<last)
+			{
+				if (out_src[j]<out_src[i])
+				{
+					out_dst[k]=out_src[j];
+					idx_dst[k++]=idx_src[j++];
+				}
+				else
+				{
+					out_dst[k]=out_src[i];
+					idx_dst[k++]=idx_src[i++];
+				}
+			}
+			for (; i<middle; i++, k++)
+			{
+				out_dst[k]=out_src[i];
+				idx_dst[k]=idx_src[i];
+			}
+			for (; j<last; j++, k++)
+			{
+				out_dst[k]=out_src[j];
+				idx_dst[k]=idx_src[j];
+			}
+		}
+
+		swap(out_src, out_dst);
+		swap(idx_src, idx_dst);
+	}
+
+	if (out_src!=output)
+	{
+		memcpy(output, out_src, size*sizeof(T1));
+		memcpy(index, idx_src, size*sizeof(T2));
+	}
+
+	SG_FREE(index_buf);
+	SG_FREE(output_buf);
+	SG_FREE(start);
+}
+
+	template <class T1,class T2>
+void CMath::select_index(T1* output, T2* index, index_t size, index_t k)
+{
+	ASSERT(k>=0 && k<size)
+
+	index_t left=0;
+	index_t right=size-1;
+
+	while (right>left)
+	{
+		/* median of three as split */
+		index_t mid=left+(right-left)/2;
+		if (output[mid]<output[left])
+		{
+			swap(output[mid], output[left]);
+			if (index)
+				swap(index[mid], index[left]);
+		}
+		if (output[right]<output[left])
+		{
+			swap(output[right], output[left]);
+			if (index)
+				swap(index[right], index[left]);
+		}
+		if (output[right]<output[mid])
+		{
+			swap(output[right], output[mid]);
+			if (index)
+				swap(index[right], index[mid]);
+		}
+		T1 split=output[mid];
+
+		index_t i=left;
+		index_t j=right;
+		while (i<=j)
+		{
+			while (output[i]<split)
+				i++;
+			while (output[j]>split)
+				j--;
+
+			if (i<=j)
+			{
+				swap(output[i], output[j]);
+				if (index)
+					swap(index[i], index[j]);
+				i++;
+				j--;
+			}
+		}
+
+		/* [left,j] <= split <= [i,right], elements in between equal split */
+		if (k<=j)
+			right=j;
+		else if (k>=i)
+			left=i;
+		else
+			break;
+	}
+}
+
+	template <class T1,class T2>
+void CMath::partial_sort_index(T1* output, T2* index, index_t size, index_t k)
+{
+	if (k<=0)
+		return;
+
+	if (k<size)
+		select_index(output, index, size, k-1);
+	else
+		k=size;
+
+	qsort_index(output, index, k);
+}
+
 	template <class T>
 void CMath::nmin(float64_t* output, T* index, int32_t size, int32_t n)
 {
-	if (6*n*size<13*size*CMath::log(size))
-		for (int32_t i=0; i<n; i++)
-			min(&output[i], &index[i], size-i) ;
-	else
-		qsort_index(output, index, size) ;
+	partial_sort_index(output, index, size, n);
 }
 
 /* move the smallest entry in the array to the beginning */
@@ -19,6 +19,9 @@
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/SGSparseMatrix.h>
 #include <shogun/lib/SGSparseVector.h>
+#include <shogun/base/init.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 
 #ifdef HAVE_LAPACK
 #include <shogun/mathematics/lapack.h>
@@ -31,12 +34,115 @@ using namespace Eigen;
 
 using namespace shogun;
 
+namespace
+{
+
+/** vectors shorter than this are reduced by a single thread */
+const index_t min_parallel_length=65536;
+
+/** rows per block of the row wise reductions */
+const index_t row_block_size=512;
+
+int32_t get_num_threads()
+{
+	Parallel* parallel=shogun::get_global_parallel();
+	int32_t num_threads=parallel ? parallel->get_num_threads() : 1;
+	SG_UNREF(parallel);
+
+	return num_threads;
+}
+
+/** sum of x[i], or of (x[i]-shift)^2 if squared, with four independent
+ * accumulators so the loop can be vectorized */
+inline float64_t vector_sum(const float64_t* x, index_t len, float64_t shift,
+		bool squared)
+{
+	float64_t acc[4]={0, 0, 0, 0};
+	index_t i=0;
+
+	if (squared)
+	{
+		for (; i+4<=len; i+=4)
+		{
+			for (index_t k=0; k<4; k++)
+				acc[k]+=(x[i+k]-shift)*(x[i+k]-shift);
+		}
+		for (; i<len; i++)
+			acc[0]+=(x[i]-shift)*(x[i]-shift);
+	}
+	else
+	{
+		for (; i+4<=len; i+=4)
+		{
+			for (index_t k=0; k<4; k++)
+				acc[k]+=x[i+k];
+		}
+		for (; i<len; i++)
+			acc[0]+=x[i];
+	}
+
+	return (acc[0]+acc[1])+(acc[2]+acc[3]);
+}
+
+/** sums of the columns (col_wise) or rows of values, of squared differences
+ * to shift if it is given. Row sums are computed in blocks of rows, each
+ * swept over all columns, so the matrix is read contiguously. */
+void matrix_sums(const SGMatrix<float64_t>& values, bool col_wise,
+		const float64_t* shift, float64_t* result)
+{
+	index_t num_rows=values.num_rows;
+	index_t num_cols=values.num_cols;
+	int32_t num_threads=get_num_threads();
+
+	if (col_wise)
+	{
+		#pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+		for (index_t j=0; j<num_cols; j++)
+		{
+			result[j]=vector_sum(&values.matrix[int64_t(j)*num_rows],
+					num_rows, shift ? shift[j] : 0, shift!=NULL);
+		}
+	}
+	else
+	{
+		index_t num_blocks=(num_rows+row_block_size-1)/row_block_size;
+
+		#pragma omp parallel for num_threads(num_threads)
+		for (index_t b=0; b<num_blocks; b++)
+		{
+			index_t first=b*row_block_size;
+			index_t len=CMath::min(row_block_size, num_rows-first);
+			float64_t* acc=&result[first];
+			memset(acc, 0, len*sizeof(float64_t));
+
+			for (index_t j=0; j<num_cols; j++)
+			{
+				const float64_t* col=&values.matrix[int64_t(j)*num_rows+first];
+				if (shift)
+				{
+					const float64_t* s=&shift[first];
+					for (index_t i=0; i<len; i++)
+						acc[i]+=(col[i]-s[i])*(col[i]-s[i]);
+				}
+				else
+				{
+					for (index_t i=0; i<len; i++)
+						acc[i]+=col[i];
+				}
+			}
+		}
+	}
+}
+}
+
 float64_t CStatistics::mean(SGVector<float64_t> values)
 {
 	ASSERT(values.vlen>0)
 	ASSERT(values.vector)
 
 	float64_t sum=0;
+	#pragma omp parallel for reduction(+:sum) num_threads(get_num_threads()) \
+		if (values.vlen>=min_parallel_length)
 	for (index_t i=0; i<values.vlen; ++i)
 		sum+=values.vector[i];
 
@@ -206,6 +312,64 @@ float64_t CStatistics::matrix_median(SGMatrix<float64_t> values,
 	return median(as_vector, modify, in_place);
 }
 
+float64_t CStatistics::quantile(SGVector<float64_t> values, float64_t p,
+		bool modify)
+{
+	SGVector<float64_t> probabilities(1);
+	probabilities[0]=p;
+
+	return quantiles(values, probabilities, modify)[0];
+}
+
+SGVector<float64_t> CStatistics::quantiles(SGVector<float64_t> values,
+		SGVector<float64_t> probabilities, bool modify)
+{
+	REQUIRE(values.vlen>0, "No values given\n");
+
+	for (index_t i=0; i<probabilities.vlen; i++)
+	{
+		REQUIRE(probabilities[i]>=0 && probabilities[i]<=1, "Probability "
+				"%f is not in [0,1]\n", probabilities[i]);
+	}
+
+	SGVector<float64_t> x=modify ? values : values.clone();
+	index_t n=x.vlen;
+
+	/* visit the probabilities in increasing order so every selection only
+	 * needs to look right of the previous one */
+	SGVector<float64_t> sorted_probabilities=probabilities.clone();
+	SGVector<index_t> order(probabilities.vlen);
+	order.range_fill();
+	CMath::qsort_index(sorted_probabilities.vector, order.vector,
+			probabilities.vlen);
+
+	SGVector<float64_t> result(probabilities.vlen);
+	index_t first=0;
+	for (index_t i=0; i<probabilities.vlen; i++)
+	{
+		float64_t h=(n-1)*sorted_probabilities[i];
+		index_t k=CMath::min((index_t) CMath::floor(h), n-1);
+
+		CMath::select(&x.vector[first], n-first, k-first);
+		first=k;
+
+		/* next order statistic is the smallest of the elements right of k */
+		float64_t q=x[k];
+		if (h>k)
+		{
+			float64_t next=x[k+1];
+			for (index_t j=k+2; j<n; j++)
+				next=CMath::min(next, x[j]);
+
+			q+=(h-k)*(next-q);
+		}
+
+		result[order[i]]=q;
+	}
+
+	return result;
+}
+
 
 float64_t CStatistics::variance(SGVector<float64_t> values)
 {
@@ -215,8 +379,10 @@ float64_t CStatistics::variance(SGVector<float64_t> values)
 	float64_t mean=CStatistics::mean(values);
 
 	float64_t sum_squared_diff=0;
+	#pragma omp parallel for reduction(+:sum_squared_diff) \
+		num_threads(get_num_threads()) if (values.vlen>=min_parallel_length)
 	for (index_t i=0; i<values.vlen; ++i)
-		sum_squared_diff+=CMath::pow(values.vector[i]-mean, 2);
+		sum_squared_diff+=(values.vector[i]-mean)*(values.vector[i]-mean);
 
 	return sum_squared_diff/(values.vlen-1);
 }
@@ -228,32 +394,12 @@ SGVector<float64_t> CStatistics::matrix_mean(SGMatrix<float64_t> values,
 	ASSERT(values.num_cols>0)
 	ASSERT(values.matrix)
 
-	SGVector<float64_t> result;
+	SGVector<float64_t> result(col_wise ? values.num_cols : values.num_rows);
+	matrix_sums(values, col_wise, NULL, result.vector);
 
-	if (col_wise)
-	{
-		result=SGVector<float64_t>(values.num_cols);
-		for (index_t j=0; j<values.num_cols; ++j)
-		{
-			result[j]=0;
-			for (index_t i=0; i<values.num_rows; ++i)
-				result[j]+=values(i,j);
-
-			result[j]/=values.num_rows;
-		}
-	}
-	else
-	{
-		result=SGVector<float64_t>(values.num_rows);
-		for (index_t j=0; j<values.num_rows; ++j)
-		{
-			result[j]=0;
-			for (index_t i=0; i<values.num_cols; ++i)
-				result[j]+=values(j,i);
-
-			result[j]/=values.num_cols;
-		}
-	}
+	float64_t n=col_wise ? values.num_rows : values.num_cols;
+	for (index_t i=0; i<result.vlen; ++i)
+		result[i]/=n;
 
 	return result;
 }
@@ -268,32 +414,12 @@ SGVector<float64_t> CStatistics::matrix_variance(SGMatrix<float64_t> values,
 	/* first compute mean */
 	SGVector<float64_t> mean=CStatistics::matrix_mean(values, col_wise);
 
-	SGVector<float64_t> result;
+	SGVector<float64_t> result(mean.vlen);
+	matrix_sums(values, col_wise, mean.vector, result.vector);
 
-	if (col_wise)
-	{
-		result=SGVector<float64_t>(values.num_cols);
-		for (index_t j=0; j<values.num_cols; ++j)
-		{
-			result[j]=0;
-			for (index_t i=0; i<values.num_rows; ++i)
-				result[j]+=CMath::pow(values(i,j)-mean[j], 2);
-
-			result[j]/=(values.num_rows-1);
-		}
-	}
-	else
-	{
-		result=SGVector<float64_t>(values.num_rows);
-		for (index_t j=0; j<values.num_rows; ++j)
-		{
-			result[j]=0;
-			for (index_t i=0; i<values.num_cols; ++i)
-				result[j]+=CMath::pow(values(j,i)-mean[j], 2);
-
-			result[j]/=(values.num_cols-1);
-		}
-	}
+	float64_t n=col_wise ? values.num_rows : values.num_cols;
+	for (index_t i=0; i<result.vlen; ++i)
+		result[i]/=(n-1);
 
 	return result;
 }
@@ -313,26 +439,135 @@ SGVector<float64_t> CStatistics::matrix_std_deviation(
 	return var;
 }
 
+index_t CStatistics::streaming_mean_variance(
+		CStreamingDenseFeatures<float64_t>* features,
+		SGVector<float64_t>& mean, SGVector<float64_t>& variance,
+		index_t num_vectors, index_t block_size)
+{
+	REQUIRE(features, "No features given\n");
+	REQUIRE(block_size>0, "Block size (%d) must be positive\n", block_size);
+
+	/* running count, mean and sum of squared differences to the mean */
+	index_t num_read=0;
+	SGVector<float64_t> m2;
+	SGMatrix<float64_t> block;
+
+	features->start_parser();
+	while (num_vectors<0 || num_read<num_vectors)
+	{
+		index_t num_block=0;
+		while (num_block<block_size &&
+				(num_vectors<0 || num_read+num_block<num_vectors) &&
+				features->get_next_example())
+		{
+			SGVector<float64_t> vec=features->get_vector();
+			if (!block.matrix)
+			{
+				block=SGMatrix<float64_t>(vec.vlen, block_size);
+				mean=SGVector<float64_t>(vec.vlen);
+				m2=SGVector<float64_t>(vec.vlen);
+				mean.zero();
+				m2.zero();
+			}
+
+			REQUIRE(vec.vlen==block.num_rows, "Streamed vectors have different "
+					"dimensions (%d and %d)\n", vec.vlen, block.num_rows);
+
+			memcpy(&block.matrix[int64_t(num_block)*block.num_rows], vec.vector,
+					sizeof(float64_t)*vec.vlen);
+			features->release_example();
+			num_block++;
+		}
+
+		if (num_block==0)
+			break;
+
+		/* statistics of the block, one vector per column */
+		SGMatrix<float64_t> used(block.matrix, block.num_rows, num_block, false);
+		SGVector<float64_t> block_mean=matrix_mean(used, false);
+		SGVector<float64_t> block_m2(block_mean.vlen);
+		matrix_sums(used, false, block_mean.vector, block_m2.vector);
+
+		/* merge into the running statistics */
+		float64_t n_a=num_read;
+		float64_t n_b=num_block;
+		float64_t n=n_a+n_b;
+		for (index_t i=0; i<mean.vlen; i++)
+		{
+			float64_t delta=block_mean[i]-mean[i];
+			mean[i]+=delta*n_b/n;
+			m2[i]+=block_m2[i]+delta*delta*n_a*n_b/n;
+		}
+
+		num_read+=num_block;
+	}
+	features->end_parser();
+
+	variance=SGVector<float64_t>(mean.vlen);
+	for (index_t i=0; i<mean.vlen; i++)
+		variance[i]=num_read>1 ? m2[i]/(num_read-1) : 0;
+
+	return num_read;
+}
+
 #ifdef HAVE_LAPACK
 SGMatrix<float64_t> CStatistics::covariance_matrix(
 		SGMatrix<float64_t> observations, bool in_place)
 {
-	SGMatrix<float64_t> centered=
-			in_place ?
-					observations :
-					SGMatrix<float64_t>(observations.num_rows,
-							observations.num_cols);
+	index_t num_rows=observations.num_rows;
+	index_t num_cols=observations.num_cols;
+	int32_t num_threads=get_num_threads();
 
-	if (!in_place)
+	SGVector<float64_t> mean=matrix_mean(observations, true);
+	SGMatrix<float64_t> cov(num_cols, num_cols);
+	cov.zero();
+
+	/* compute 1/(m-1) * X' * X on the centered data, upper triangle only */
+	float64_t alpha=1.0/(num_rows-1);
+	if (in_place)
+	{
+		#pragma omp parallel for num_threads(num_threads)
+		for (index_t j=0; j<num_cols; j++)
+		{
+			float64_t* col=&observations.matrix[int64_t(j)*num_rows];
+			for (index_t i=0; i<num_rows; i++)
+				col[i]-=mean[j];
+		}
+
+		cblas_dsyrk(CblasColMajor, CblasUpper, CblasTrans, num_cols, num_rows,
+				alpha, observations.matrix, num_rows, 0.0, cov.matrix, num_cols);
+	}
+	else
 	{
-		memcpy(centered.matrix, observations.matrix,
-				sizeof(float64_t)*observations.num_rows*observations.num_cols);
+		/* blocks of about 4MB */
+		index_t block_size=CMath::min(num_rows,
+				CMath::max((index_t) 256, 524288/num_cols));
+		SGMatrix<float64_t> block(block_size, num_cols);
+
+		for (index_t first=0; first<num_rows; first+=block_size)
+		{
+			index_t len=CMath::min(block_size, num_rows-first);
+
+			#pragma omp parallel for num_threads(num_threads)
+			for (index_t j=0; j<num_cols; j++)
+			{
+				const float64_t* col=
+						&observations.matrix[int64_t(j)*num_rows+first];
+				float64_t* centered=&block.matrix[int64_t(j)*len];
+				for (index_t i=0; i<len; i++)
+					centered[i]=col[i]-mean[j];
+			}
+
+			cblas_dsyrk(CblasColMajor, CblasUpper, CblasTrans, num_cols, len,
+					alpha, block.matrix, len, 1.0, cov.matrix, num_cols);
+		}
 	}
-	centered.remove_column_mean();
 
-	/* compute 1/(m-1) * X' * X */
-	SGMatrix<float64_t> cov=SGMatrix<float64_t>::matrix_multiply(centered,
-			centered, true, false, 1.0/(observations.num_rows-1));
+	for (index_t j=0; j<num_cols; j++)
+	{
+		for (index_t i=j+1; i<num_cols; i++)
+			cov(i,j)=cov(j,i);
+	}
 
 	return cov;
 }
@@ -24,6 +24,7 @@ namespace shogun
 {
 template<class T> class SGMatrix;
 template<class T> class SGSparseMatrix;
+template<class T> class CStreamingDenseFeatures;
 
 /** @brief Class that contains certain functions related to statistics, such as
  * probability/cumulative distribution functions, different statistics, etc.
@@ -90,6 +91,35 @@ public:
 	static float64_t matrix_median(SGMatrix<float64_t> values,
 			bool modify=false, bool in_place=false);
 
+	/** Calculates the p-quantile of given values, interpolating linearly
+	 * between the two closest order statistics, i.e. with
+	 * \f$h=(m-1)p\f$ this is
+	 * \f$x_{(\lfloor h\rfloor)}+(h-\lfloor h\rfloor)
+	 * (x_{(\lfloor h\rfloor+1)}-x_{(\lfloor h\rfloor)})\f$.
+	 * Uses selection in linear time instead of sorting.
+	 *
+	 * @param values vector of values
+	 * @param p probability in [0,1]
+	 * @param modify if true, values are reordered while the quantile is
+	 * computed, otherwise a copy is made
+	 * @return p-quantile of given values
+	 */
+	static float64_t quantile(SGVector<float64_t> values, float64_t p,
+			bool modify=false);
+
+	/** Calculates several quantiles of given values at once, see
+	 * quantile(). Each selection only works on the part of the values
+	 * that is not ordered by the previous ones.
+	 *
+	 * @param values vector of values
+	 * @param probabilities probabilities in [0,1], in any order
+	 * @param modify if true, values are reordered while the quantiles are
+	 * computed, otherwise a copy is made
+	 * @return quantiles of given values, in the order of probabilities
+	 */
+	static SGVector<float64_t> quantiles(SGVector<float64_t> values,
+			SGVector<float64_t> probabilities, bool modify=false);
+
 	/** Calculates unbiased empirical variance estimator of given values. Given
 	 * \f$\{x_1, ..., x_m\}\f$, this is
 	 * \f$\frac{1}{m-1}\sum_{i=1}^m (x-\bar{x})^2\f$ where
@@ -113,7 +143,9 @@ public:
 	/** Calculates mean of given values. Given \f$\{x_1, ..., x_m\}\f$, this
 	 * is \f$\frac{1}{m}\sum_{i=1}^m x_i\f$
 	 *
-	 * Computes the mean for each row/col of matrix
+	 * Computes the mean for each row/col of matrix. Columns are summed
+	 * in parallel, rows in blocks that are swept over all columns, so the
+	 * matrix is always read contiguously.
 	 *
 	 * @param values vector of values
 	 * @param col_wise if true, every column vector will be used, row vectors
@@ -153,12 +185,36 @@ public:
 	static SGVector<float64_t> matrix_std_deviation(
 			SGMatrix<float64_t> values, bool col_wise=true);
 
+	/** Calculates mean and unbiased empirical variance of every dimension
+	 * of the vectors of a stream in a single pass. Vectors are read in
+	 * blocks, the statistics of a block are computed in parallel and merged
+	 * into the running ones with the update of Chan et al., the block
+	 * version of Welford's method, so the stream is never held in memory.
+	 *
+	 * Starts and ends the parser of the features.
+	 *
+	 * @param features stream of vectors of equal dimension
+	 * @param mean mean of every dimension is written here
+	 * @param variance variance of every dimension is written here, zero if
+	 * less than two vectors were read
+	 * @param num_vectors number of vectors to read, -1 for the whole stream
+	 * @param block_size number of vectors per block
+	 * @return number of vectors read
+	 */
+	static index_t streaming_mean_variance(
+			CStreamingDenseFeatures<float64_t>* features,
+			SGVector<float64_t>& mean, SGVector<float64_t>& variance,
+			index_t num_vectors=-1, index_t block_size=4096);
+
 #ifdef HAVE_LAPACK
 	/** Computes the empirical estimate of the covariance matrix of the given
 	 * data which is organized as num_cols variables with num_rows observations.
 	 *
 	 * Data is centered before matrix is computed. May be done in place.
 	 * In this case, the observation matrix is changed (centered).
+	 * Otherwise blocks of observations are centered one at a time and
+	 * accumulated with a symmetric rank-k update, so no copy of the
+	 * observations is made.
 	 *
 	 * Given sample matrix \f$X\f$, first, column mean is removed to create
 	 * \f$\bar X\f$. Then \f$\text{cov}(X)=(X-\bar X)^T(X - \bar X)\f$ is
@@ -0,0 +1,106 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society
+ */
+
+#include <shogun/lib/SGVector.h>
+#include <shogun/base/Parameter.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/kernel/Kernel.h>
+#include <shogun/mathematics/linalg/linop/KernelOperator.h>
+
+namespace shogun
+{
+
+CKernelOperator::CKernelOperator()
+	: CLinearOperator<float64_t>()
+{
+	init();
+
+	SG_GCDEBUG("%s created (%p)\n", this->get_name(), this)
+}
+
+CKernelOperator::CKernelOperator(CKernel* kernel, float64_t ridge)
+	: CLinearOperator<float64_t>()
+{
+	init();
+
+	REQUIRE(kernel, "Kernel is NULL!\n");
+	REQUIRE(kernel->has_features(), "Kernel is not initialised!\n");
+	REQUIRE(kernel->get_num_vec_lhs()==kernel->get_num_vec_rhs(),
+		"Kernel matrix is not square (%d x %d)!\n",
+		kernel->get_num_vec_lhs(), kernel->get_num_vec_rhs());
+
+	m_kernel=kernel;
+	SG_REF(m_kernel);
+	m_ridge=ridge;
+	m_dimension=kernel->get_num_vec_rhs();
+
+	SG_GCDEBUG("%s created (%p)\n", this->get_name(), this)
+}
+
+CKernelOperator::~CKernelOperator()
+{
+	SG_UNREF(m_kernel);
+
+	SG_GCDEBUG("%s destroyed (%p)\n", this->get_name(), this)
+}
+
+void CKernelOperator::init()
+{
+	m_kernel=NULL;
+	m_ridge=0.0;
+
+	SG_ADD((CSGObject**)&m_kernel, "kernel", "The kernel", MS_NOT_AVAILABLE);
+	SG_ADD(&m_ridge, "ridge", "Multiple of the identity added to the kernel matrix",
+		MS_NOT_AVAILABLE);
+}
+
+CKernel* CKernelOperator::get_kernel() const
+{
+	SG_REF(m_kernel);
+	return m_kernel;
+}
+
+SGVector<float64_t> CKernelOperator::apply(SGVector<float64_t> b) const
+{
+	REQUIRE(m_kernel, "Kernel is NULL!\n");
+	REQUIRE(m_dimension==b.vlen, "Dimension mismatch! %d vs %d\n",
+		m_dimension, b.vlen);
+
+	index_t n=m_dimension;
+	SGVector<float64_t> result(n);
+	for (index_t i=0; i<n; i++)
+		result[i]=m_ridge*b[i];
+
+	if (m_kernel->has_property(KP_BATCHEVALUATION))
+	{
+		SGVector<int32_t> idx(n);
+		idx.range_fill();
+		m_kernel->compute_batch(n, idx.vector, result.vector, n, idx.vector,
+			b.vector);
+	}
+	else
+	{
+		#pragma omp parallel for schedule(dynamic, 16) \
+			num_threads(m_kernel->parallel->get_num_threads())
+		for (index_t i=0; i<n; i++)
+		{
+			float64_t sum=0.0;
+			for (index_t j=0; j<n; j++)
+			{
+				if (b[j]!=0.0)
+					sum+=b[j]*m_kernel->kernel(j, i);
+			}
+			result[i]+=sum;
+		}
+	}
+
+	return result;
+}
+
+}
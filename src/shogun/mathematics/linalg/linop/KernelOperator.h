@@ -0,0 +1,83 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society
+ */
+
+#ifndef KERNEL_OPERATOR_H_
+#define KERNEL_OPERATOR_H_
+
+#include <shogun/lib/config.h>
+#include <shogun/mathematics/linalg/linop/LinearOperator.h>
+
+namespace shogun
+{
+class CKernel;
+template<class T> class SGVector;
+
+/** @brief Linear operator that applies the kernel matrix of a kernel,
+ * plus an optional multiple of the identity, without storing it, i.e.
+ * \f[
+ * {\bf b}\mapsto(K+\lambda I){\bf b}
+ * \f]
+ * for \f$K_{ij}=k({\bf x}_i,{\bf x}_j)\f$ over the (equal) lhs and rhs
+ * features of the kernel.
+ *
+ * Each application costs \f$O(n^2)\f$ kernel evaluations but only
+ * \f$O(n)\f$ memory. Kernels with KP_BATCHEVALUATION are applied through
+ * CKernel::compute_batch(), all others row by row in parallel.
+ */
+class CKernelOperator : public CLinearOperator<float64_t>
+{
+public:
+	/** default constructor */
+	CKernelOperator();
+
+	/**
+	 * constructor
+	 *
+	 * @param kernel kernel initialised with the same lhs and rhs features
+	 * @param ridge multiple of the identity that is added to the kernel matrix
+	 */
+	CKernelOperator(CKernel* kernel, float64_t ridge=0.0);
+
+	/** destructor */
+	virtual ~CKernelOperator();
+
+	/**
+	 * applies the kernel matrix plus ridge to a vector
+	 *
+	 * @param b the vector to which the operator applies
+	 * @return the result vector
+	 */
+	virtual SGVector<float64_t> apply(SGVector<float64_t> b) const;
+
+	/** @return the kernel */
+	CKernel* get_kernel() const;
+
+	/** @return multiple of the identity added to the kernel matrix */
+	float64_t get_ridge() const { return m_ridge; }
+
+	/** @return object name */
+	virtual const char* get_name() const
+	{
+		return "KernelOperator";
+	}
+
+private:
+	/** initialize with default values and register params */
+	void init();
+
+	/** the kernel */
+	CKernel* m_kernel;
+
+	/** multiple of the identity added to the kernel matrix */
+	float64_t m_ridge;
+};
+
+}
+
+#endif // KERNEL_OPERATOR_H_
@@ -0,0 +1,111 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society
+ */
+
+#include <shogun/lib/config.h>
+
+#ifdef HAVE_EIGEN3
+#include <shogun/base/Parameter.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/mathematics/linalg/linop/LowRankInverseOperator.h>
+
+using namespace Eigen;
+
+namespace shogun
+{
+
+CLowRankInverseOperator::CLowRankInverseOperator()
+	: CLinearOperator<float64_t>()
+{
+	init();
+
+	SG_GCDEBUG("%s created (%p)\n", this->get_name(), this)
+}
+
+CLowRankInverseOperator::CLowRankInverseOperator(SGVector<float64_t> diagonal,
+	SGMatrix<float64_t> z)
+	: CLinearOperator<float64_t>(diagonal.vlen)
+{
+	init();
+
+	REQUIRE(diagonal.vlen>0, "Diagonal is empty!\n");
+	REQUIRE(!z.matrix || z.num_cols==diagonal.vlen,
+		"Low rank factor has %d columns, expected %d!\n", z.num_cols,
+		diagonal.vlen);
+
+	m_inv_diagonal=SGVector<float64_t>(diagonal.vlen);
+	for (index_t i=0; i<diagonal.vlen; i++)
+	{
+		REQUIRE(diagonal[i]>0, "Diagonal entry %d is not positive (%f)!\n",
+			i, diagonal[i]);
+		m_inv_diagonal[i]=1.0/diagonal[i];
+	}
+
+	if (z.matrix && z.num_rows>0)
+	{
+		m_z=z;
+
+		Map<MatrixXd> Z(z.matrix, z.num_rows, z.num_cols);
+		Map<VectorXd> inv_d(m_inv_diagonal.vector, m_inv_diagonal.vlen);
+
+		MatrixXd C=MatrixXd::Identity(z.num_rows, z.num_rows);
+		C.noalias()+=Z*inv_d.asDiagonal()*Z.transpose();
+
+		LLT<MatrixXd> llt(C);
+		REQUIRE(llt.info()==Success, "Factorising the low rank update failed!\n");
+
+		m_factor=SGMatrix<float64_t>(z.num_rows, z.num_rows);
+		Map<MatrixXd> L(m_factor.matrix, m_factor.num_rows, m_factor.num_cols);
+		L=llt.matrixL();
+	}
+
+	SG_GCDEBUG("%s created (%p)\n", this->get_name(), this)
+}
+
+CLowRankInverseOperator::~CLowRankInverseOperator()
+{
+	SG_GCDEBUG("%s destroyed (%p)\n", this->get_name(), this)
+}
+
+void CLowRankInverseOperator::init()
+{
+	SG_ADD(&m_inv_diagonal, "inv_diagonal", "Inverse of the diagonal",
+		MS_NOT_AVAILABLE);
+	SG_ADD(&m_z, "z", "Low rank factor", MS_NOT_AVAILABLE);
+	SG_ADD(&m_factor, "factor", "Cholesky factor of the low rank update",
+		MS_NOT_AVAILABLE);
+}
+
+SGVector<float64_t> CLowRankInverseOperator::apply(SGVector<float64_t> b) const
+{
+	REQUIRE(m_dimension==b.vlen, "Dimension mismatch! %d vs %d\n",
+		m_dimension, b.vlen);
+
+	SGVector<float64_t> result(b.vlen);
+	Map<VectorXd> x(result.vector, result.vlen);
+	Map<VectorXd> b_map(b.vector, b.vlen);
+	Map<VectorXd> inv_d(m_inv_diagonal.vector, m_inv_diagonal.vlen);
+
+	x=inv_d.cwiseProduct(b_map);
+
+	if (m_factor.matrix)
+	{
+		Map<MatrixXd> Z(m_z.matrix, m_z.num_rows, m_z.num_cols);
+		Map<MatrixXd> L(m_factor.matrix, m_factor.num_rows, m_factor.num_cols);
+
+		VectorXd t=Z*x;
+		L.triangularView<Lower>().solveInPlace(t);
+		L.transpose().triangularView<Upper>().solveInPlace(t);
+		x-=inv_d.cwiseProduct(Z.transpose()*t);
+	}
+
+	return result;
+}
+
+}
+#endif // HAVE_EIGEN3
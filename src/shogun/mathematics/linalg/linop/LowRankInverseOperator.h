@@ -0,0 +1,88 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society
+ */
+
+#ifndef LOW_RANK_INVERSE_OPERATOR_H_
+#define LOW_RANK_INVERSE_OPERATOR_H_
+
+#include <shogun/lib/config.h>
+
+#ifdef HAVE_EIGEN3
+#include <shogun/lib/SGVector.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/mathematics/linalg/linop/LinearOperator.h>
+
+namespace shogun
+{
+
+/** @brief Linear operator that applies the inverse of a diagonal plus low
+ * rank matrix,
+ * \f[
+ * {\bf b}\mapsto(D+Z^TZ)^{-1}{\bf b}
+ * \f]
+ * for a positive diagonal \f$D\f$ of size \f$n\f$ and \f$Z\in R^{d\times n}\f$,
+ * e.g. the feature map of a CApproximateKernel for the training examples.
+ * By the Woodbury identity
+ * \f[
+ * (D+Z^TZ)^{-1}=D^{-1}-D^{-1}Z^T(I+ZD^{-1}Z^T)^{-1}ZD^{-1}
+ * \f]
+ * only a \f$d\times d\f$ matrix is factorised on construction and each
+ * application costs \f$O(nd)\f$. Meant as preconditioner of
+ * CConjugateGradientSolver, without Z it is the Jacobi preconditioner.
+ */
+class CLowRankInverseOperator : public CLinearOperator<float64_t>
+{
+public:
+	/** default constructor */
+	CLowRankInverseOperator();
+
+	/**
+	 * constructor
+	 *
+	 * @param diagonal the diagonal D, all entries must be positive
+	 * @param z the low rank factor Z with one column per dimension of the
+	 * operator, may be empty
+	 */
+	CLowRankInverseOperator(SGVector<float64_t> diagonal,
+		SGMatrix<float64_t> z=SGMatrix<float64_t>());
+
+	/** destructor */
+	virtual ~CLowRankInverseOperator();
+
+	/**
+	 * applies the inverse of the diagonal plus low rank matrix to a vector
+	 *
+	 * @param b the vector to which the operator applies
+	 * @return the result vector
+	 */
+	virtual SGVector<float64_t> apply(SGVector<float64_t> b) const;
+
+	/** @return object name */
+	virtual const char* get_name() const
+	{
+		return "LowRankInverseOperator";
+	}
+
+private:
+	/** initialize with default values and register params */
+	void init();
+
+	/** inverse of the diagonal */
+	SGVector<float64_t> m_inv_diagonal;
+
+	/** the low rank factor */
+	SGMatrix<float64_t> m_z;
+
+	/** lower Cholesky factor of \f$I+ZD^{-1}Z^T\f$ */
+	SGMatrix<float64_t> m_factor;
+};
+
+}
+
+#endif // HAVE_EIGEN3
+#endif // LOW_RANK_INVERSE_OPERATOR_H_
@@ -26,20 +26,48 @@ namespace shogun
 CConjugateGradientSolver::CConjugateGradientSolver()
 	: CIterativeLinearSolver<float64_t>()
 {
+	init();
+
 	SG_GCDEBUG("%s created (%p)\n", this->get_name(), this);
 }
 
 CConjugateGradientSolver::CConjugateGradientSolver(bool store_residuals)
 	: CIterativeLinearSolver<float64_t>(store_residuals)
 {
+	init();
+
 	SG_GCDEBUG("%s created (%p)\n", this->get_name(), this);
 }
 
 CConjugateGradientSolver::~CConjugateGradientSolver()
 {
+	SG_UNREF(m_preconditioner);
+
 	SG_GCDEBUG("%s destroyed (%p)\n", this->get_name(), this);
 }
 
+void CConjugateGradientSolver::init()
+{
+	m_preconditioner=NULL;
+
+	SG_ADD((CSGObject**)&m_preconditioner, "preconditioner",
+		"Inverse of the approximation of the operator", MS_NOT_AVAILABLE);
+}
+
+void CConjugateGradientSolver::set_preconditioner(
+	CLinearOperator<float64_t>* preconditioner)
+{
+	SG_REF(preconditioner);
+	SG_UNREF(m_preconditioner);
+	m_preconditioner=preconditioner;
+}
+
+CLinearOperator<float64_t>* CConjugateGradientSolver::get_preconditioner() const
+{
+	SG_REF(m_preconditioner);
+	return m_preconditioner;
+}
+
 SGVector<float64_t> CConjugateGradientSolver::solve(
 	CLinearOperator<float64_t>* A, SGVector<float64_t> b)
 {
@@ -48,6 +76,8 @@ SGVector<float64_t> CConjugateGradientSolver::solve(
 	// sanity check
 	REQUIRE(A, "Operator is NULL!\n");
 	REQUIRE(A->get_dimension()==b.vlen, "Dimension mismatch!\n");
+	REQUIRE(!m_preconditioner || m_preconditioner->get_dimension()==b.vlen,
+		"Preconditioner dimension mismatch!\n");
 
 	// the final solution vector, initial guess is 0
 	SGVector<float64_t> result(b.vlen);
@@ -64,15 +94,24 @@ SGVector<float64_t> CConjugateGradientSolver::solve(
 	// residual r_i=b-Ax_i, here x_0=[0], so r_0=b
 	VectorXd r=b_map;
 
-	// initial direction is same as residual
-	p=r;
+	// preconditioned residual z_i=M^{-1}r_i, without preconditioner z_i=r_i
+	SGVector<float64_t> r_(r.data(), r.rows(), false);
+	SGVector<float64_t> z_;
+	if (m_preconditioner)
+		z_=m_preconditioner->apply(r_);
+	else
+		z_=r_;
+	Map<VectorXd> z(z_.vector, z_.vlen);
+
+	// initial direction is same as (preconditioned) residual
+	p=z;
 
 	// the iterator for this iterative solver
 	IterativeSolverIterator<float64_t> it(b_map, m_max_iteration_limit,
 		m_relative_tolerence, m_absolute_tolerence);
 
 	// CG iteration begins
-	float64_t r_norm2=r.dot(r);
+	float64_t r_norm2=r.dot(z);
 
 	// start the timer
 	CTime time;
@@ -113,17 +152,24 @@ SGVector<float64_t> CConjugateGradientSolver::solve(
 		// r_{i}=r_{i-1}-\alpha_{i}p
 		r-=alpha*Ap;
 
-		// compute new ||r||_{2}, if zero, converged
-		float64_t r_norm2_i=r.dot(r);
+		// precondition the new residual
+		if (m_preconditioner)
+		{
+			z_=m_preconditioner->apply(r_);
+			new (&z) Map<VectorXd>(z_.vector, z_.vlen);
+		}
+
+		// compute new r^{T}z (||r||_{2} without preconditioner), if zero, converged
+		float64_t r_norm2_i=r.dot(z);
 		if (r_norm2_i==0.0)
 			break;
 
 		// compute the beta parameter of CG
 		float64_t beta=r_norm2_i/r_norm2;
 
-		// update direction, and ||r||_{2}
+		// update direction, and r^{T}z
 		r_norm2=r_norm2_i;
-		p=r+beta*p;
+		p=z+beta*p;
 	}
 
 	float64_t elapsed=time.cur_time_diff();
@@ -24,6 +24,11 @@ template<class T> class SGVector;
  * @brief class that uses conjugate gradient method of solving a linear system
  * involving a real valued linear operator and vector. Useful for large sparse
  * systems involving sparse symmetric and positive-definite matrices.
+ *
+ * If a preconditioner \f$M^{-1}\f$ (an operator applying the inverse of a
+ * symmetric positive definite approximation M of A) is set, the
+ * preconditioned conjugate gradient method is used, which converges in
+ * fewer iterations the better M approximates A.
  */
 class CConjugateGradientSolver : public CIterativeLinearSolver<float64_t, float64_t>
 {
@@ -48,12 +53,29 @@ public:
 	virtual SGVector<float64_t> solve(CLinearOperator<float64_t>* A,
 		SGVector<float64_t> b);
 
+	/**
+	 * set the preconditioner
+	 *
+	 * @param preconditioner operator applying the inverse of an approximation
+	 * of the system operator, NULL for none
+	 */
+	void set_preconditioner(CLinearOperator<float64_t>* preconditioner);
+
+	/** @return the preconditioner, NULL if none is set */
+	CLinearOperator<float64_t>* get_preconditioner() const;
+
 	/** @return object name */
 	virtual const char* get_name() const
 	{
 		return "ConjugateGradientSolver";
 	}
 
+private:
+	/** initialize with default values and register params */
+	void init();
+
+	/** the preconditioner */
+	CLinearOperator<float64_t>* m_preconditioner;
 };
 
 }
@@ -18,6 +18,7 @@
 #include <shogun/lib/Signal.h>
 #include <shogun/lib/JLCoverTree.h>
 #include <shogun/lib/Time.h>
+#include <shogun/lib/MemoryArena.h>
 #include <shogun/base/Parameter.h>
 
 //#define BENCHMARK_KNN
@@ -110,10 +111,12 @@ SGMatrix<index_t> CKNN::nearest_neighbors()
 {
 	//number of examples to which kNN is applied
 	int32_t n=distance->get_num_vec_rhs();
+	//scratch buffers, all released with the arena
+	SGArena arena;
 	//distances to train data
-	float64_t* dists=SG_MALLOC(float64_t, m_train_labels.vlen);
+	float64_t* dists=arena.allocate<float64_t>(m_train_labels.vlen);
 	//indices to train data
-	index_t* train_idxs=SG_MALLOC(index_t, m_train_labels.vlen);
+	index_t* train_idxs=arena.allocate<index_t>(m_train_labels.vlen);
 	//pre-allocation of the nearest neighbors
 	SGMatrix<index_t> NN(m_k, n);
 
@@ -129,8 +132,8 @@ SGMatrix<index_t> CKNN::nearest_neighbors()
 		for (int32_t j=0; j<m_train_labels.vlen; j++)
 			train_idxs[j]=j;
 
-		//sort the distance vector between test example i and all train examples
-		CMath::qsort_index(dists, train_idxs, m_train_labels.vlen);
+		//move the m_k closest train examples to the front, in sorted order
+		CMath::partial_sort_index(dists, train_idxs, m_train_labels.vlen, m_k);
 
 #ifdef DEBUG_KNN
 		SG_PRINT("\nQuick sort query %d\n", i)
@@ -144,9 +147,6 @@ SGMatrix<index_t> CKNN::nearest_neighbors()
 			NN(j,i) = train_idxs[j];
 	}
 
-	SG_FREE(train_idxs);
-	SG_FREE(dists);
-
 	return NN;
 }
 
@@ -168,14 +168,16 @@ CMulticlassLabels* CKNN::apply_multiclass(CFeatures* data)
 
 	CMulticlassLabels* output=new CMulticlassLabels(num_lab);
 
+	//scratch buffers, all released with the arena
+	SGArena arena;
 	//labels of the k nearest neighbors
-	int32_t* train_lab=SG_MALLOC(int32_t, m_k);
+	int32_t* train_lab=arena.allocate<int32_t>(m_k);
 
 	SG_INFO("%d test examples\n", num_lab)
 	CSignal::clear_cancel();
 
 	//histogram of classes and returned output
-	float64_t* classes=SG_MALLOC(float64_t, m_num_classes);
+	float64_t* classes=arena.allocate<float64_t>(m_num_classes);
 
 #ifdef BENCHMARK_KNN
 	CTime tstart;
@@ -279,9 +281,6 @@ CMulticlassLabels* CKNN::apply_multiclass(CFeatures* data)
 #endif
 	}
 
-	SG_FREE(classes);
-	SG_FREE(train_lab);
-
 	return output;
 }
 
@@ -294,7 +293,8 @@ CMulticlassLabels* CKNN::classify_NN()
 	ASSERT(num_lab)
 
 	CMulticlassLabels* output = new CMulticlassLabels(num_lab);
-	float64_t* distances = SG_MALLOC(float64_t, m_train_labels.vlen);
+	SGArena arena;
+	float64_t* distances = arena.allocate<float64_t>(m_train_labels.vlen);
 
 	SG_INFO("%d test examples\n", num_lab)
 	CSignal::clear_cancel();
@@ -326,7 +326,6 @@ CMulticlassLabels* CKNN::classify_NN()
 		output->set_label(i,m_train_labels.vector[out_idx]+m_min_label);
 	}
 
-	SG_FREE(distances);
 	return output;
 }
 
@@ -341,11 +340,13 @@ SGMatrix<int32_t> CKNN::classify_for_multiple_k()
 
 	int32_t* output=SG_MALLOC(int32_t, m_k*num_lab);
 
+	//scratch buffers, all released with the arena
+	SGArena arena;
 	//working buffer of m_train_labels
-	int32_t* train_lab=SG_MALLOC(int32_t, m_k);
+	int32_t* train_lab=arena.allocate<int32_t>(m_k);
 
 	//histogram of classes and returned output
-	int32_t* classes=SG_MALLOC(int32_t, m_num_classes);
+	int32_t* classes=arena.allocate<int32_t>(m_num_classes);
 
 	SG_INFO("%d test examples\n", num_lab)
 	CSignal::clear_cancel();
@@ -367,7 +368,7 @@ SGMatrix<int32_t> CKNN::classify_for_multiple_k()
 	else	// Use cover tree
 	{
 		//allocation for distances to nearest neighbors
-		float64_t* dists=SG_MALLOC(float64_t, m_k);
+		float64_t* dists=arena.allocate<float64_t>(m_k);
 
 		// From the sets of features (lhs and rhs) stored in distance,
 		// build arrays of cover tree points
@@ -409,13 +410,8 @@ SGMatrix<int32_t> CKNN::classify_for_multiple_k()
 			choose_class_for_multiple_k(output+res[i][0].m_index, classes,
 					train_lab, num_lab);
 		}
-
-		SG_FREE(dists);
 	}
 
-	SG_FREE(train_lab);
-	SG_FREE(classes);
-
 	return SGMatrix<int32_t>(output,num_lab,m_k,true);
 }
 
@@ -13,6 +13,7 @@
 #include <shogun/features/Features.h>
 #include <shogun/features/StringFeatures.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/base/Parallel.h>
 
 using namespace shogun;
 
@@ -60,22 +61,32 @@ bool CSortUlongString::save(FILE* f)
 /// return pointer to feature_matrix, i.e. f->get_feature_matrix();
 bool CSortUlongString::apply_to_string_features(CFeatures* f)
 {
-	int32_t i;
-	int32_t num_vec=((CStringFeatures<uint64_t>*)f)->get_num_vectors();
-
-	for (i=0; i<num_vec; i++)
+	CStringFeatures<uint64_t>* sf=(CStringFeatures<uint64_t>*) f;
+	int32_t num_vec=sf->get_num_vectors();
+
+	/* the vectors are sorted in place, independently of each other. errors
+	 * must not leave the parallel region, so they are raised after it */
+	bool not_in_memory=false;
+	#pragma omp parallel for schedule(dynamic, 64) num_threads(parallel->get_num_threads()) reduction(||:not_in_memory)
+	for (int32_t i=0; i<num_vec; i++)
 	{
 		int32_t len=0;
 		bool free_vec;
-		uint64_t* vec=((CStringFeatures<uint64_t>*)f)->
-			get_feature_vector(i, len, free_vec);
-		ASSERT(!free_vec) // won't work with non-in-memory string features
-
-		SG_DEBUG("sorting string of length %i\n", len)
+		uint64_t* vec=sf->get_feature_vector(i, len, free_vec);
+		if (free_vec)
+		{
+			sf->free_feature_vector(vec, i, free_vec);
+			not_in_memory=true;
+			continue;
+		}
 
 		//CMath::qsort(vec, len);
 		CMath::radix_sort(vec, len);
 	}
+
+	if (not_in_memory)
+		SG_ERROR("%s only works with in-memory string features\n", get_name())
+
 	return true;
 }
 
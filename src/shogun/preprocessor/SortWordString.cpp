@@ -12,6 +12,7 @@
 #include <shogun/features/Features.h>
 #include <shogun/features/StringFeatures.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/base/Parallel.h>
 
 using namespace shogun;
 
@@ -59,21 +60,33 @@ bool CSortWordString::save(FILE* f)
 /// return pointer to feature_matrix, i.e. f->get_feature_matrix();
 bool CSortWordString::apply_to_string_features(CFeatures* f)
 {
-	int32_t i;
-	int32_t num_vec=((CStringFeatures<uint16_t>*)f)->get_num_vectors() ;
-
-	for (i=0; i<num_vec; i++)
+	CStringFeatures<uint16_t>* sf=(CStringFeatures<uint16_t>*) f;
+	int32_t num_vec=sf->get_num_vectors();
+
+	/* the vectors are sorted in place, independently of each other. errors
+	 * must not leave the parallel region, so they are raised after it */
+	bool not_in_memory=false;
+	#pragma omp parallel for schedule(dynamic, 64) num_threads(parallel->get_num_threads()) reduction(||:not_in_memory)
+	for (int32_t i=0; i<num_vec; i++)
 	{
-		int32_t len = 0 ;
+		int32_t len=0;
 		bool free_vec;
-		uint16_t* vec = ((CStringFeatures<uint16_t>*)f)->get_feature_vector(i, len, free_vec);
-		ASSERT(!free_vec) // won't work with non-in-memory string features
+		uint16_t* vec=sf->get_feature_vector(i, len, free_vec);
+		if (free_vec)
+		{
+			sf->free_feature_vector(vec, i, free_vec);
+			not_in_memory=true;
+			continue;
+		}
 
 		//CMath::qsort(vec, len);
 		CMath::radix_sort(vec, len);
-
 	}
-	return true ;
+
+	if (not_in_memory)
+		SG_ERROR("%s only works with in-memory string features\n", get_name())
+
+	return true;
 }
 
 /// apply preproc on single feature vector
@@ -16,6 +16,11 @@
 #include <shogun/mathematics/lapack.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/labels/RegressionLabels.h>
+#include <shogun/kernel/ApproximateKernel.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/mathematics/linalg/linop/KernelOperator.h>
+#include <shogun/mathematics/linalg/linop/LowRankInverseOperator.h>
+#include <shogun/mathematics/linalg/linsolver/ConjugateGradientSolver.h>
 
 using namespace shogun;
 
@@ -36,11 +41,33 @@ CKernelRidgeRegression::CKernelRidgeRegression(float64_t tau, CKernel* k, CLabel
 	m_train_func=m;
 }
 
+CKernelRidgeRegression::~CKernelRidgeRegression()
+{
+	SG_UNREF(m_preconditioner);
+}
+
 void CKernelRidgeRegression::init()
 {
 	m_tau=1e-6;
 	m_epsilon=0.0001;
+	m_preconditioner=NULL;
 	SG_ADD(&m_tau, "tau", "Regularization parameter", MS_AVAILABLE);
+	SG_ADD((CSGObject**) &m_preconditioner, "preconditioner",
+			"Approximate kernel preconditioning conjugate gradient",
+			MS_NOT_AVAILABLE);
+}
+
+void CKernelRidgeRegression::set_preconditioner(CApproximateKernel* preconditioner)
+{
+	SG_REF(preconditioner);
+	SG_UNREF(m_preconditioner);
+	m_preconditioner=preconditioner;
+}
+
+CApproximateKernel* CKernelRidgeRegression::get_preconditioner()
+{
+	SG_REF(m_preconditioner);
+	return m_preconditioner;
 }
 
 bool CKernelRidgeRegression::train_machine_pinv()
@@ -73,6 +100,118 @@ bool CKernelRidgeRegression::train_machine_pinv()
 	return true;
 }
 
+bool CKernelRidgeRegression::train_machine_feature_map(
+		CApproximateKernel* approx_kernel)
+{
+	REQUIRE(m_tau>0, "Training with the feature map of %s needs a positive "
+			"regularization parameter tau (%f)\n", approx_kernel->get_name(),
+			m_tau);
+
+	SGMatrix<float64_t> z=approx_kernel->get_lhs_feature_map();
+	int32_t d=z.num_rows;
+	int32_t n=z.num_cols;
+	ASSERT(z.matrix && d>0 && n>0)
+
+	m_alpha=((CRegressionLabels*) m_labels)->get_labels_copy();
+	if (m_alpha.vlen!=n)
+	{
+		SG_ERROR("Number of labels does not match number of kernel"
+				" columns (num_labels=%d cols=%d\n", m_alpha.vlen, n);
+	}
+
+	m_svs=SGVector<index_t>(n);
+	m_svs.range_fill();
+
+	/* w=(Z*Z'+tau*I)^-1 * Z*y */
+	SGMatrix<float64_t> a(d, d);
+	cblas_dsyrk(CblasColMajor, CblasUpper, CblasNoTrans, d, n, 1.0, z.matrix,
+			d, 0.0, a.matrix, d);
+	for (int32_t i=0; i<d; i++)
+		a(i, i)+=m_tau;
+
+	SGVector<float64_t> w(d);
+	cblas_dgemv(CblasColMajor, CblasNoTrans, d, n, 1.0, z.matrix, d,
+			m_alpha.vector, 1, 0.0, w.vector, 1);
+
+	int32_t info=clapack_dposv(CblasColMajor, CblasUpper, d, 1, a.matrix, d,
+			w.vector, d);
+	if (info!=0)
+		SG_ERROR("Solving the system in the feature space failed (%d)\n", info)
+
+	/* alpha=(y-Z'*w)/tau */
+	cblas_dgemv(CblasColMajor, CblasTrans, d, n, -1.0, z.matrix, d, w.vector,
+			1, 1.0, m_alpha.vector, 1);
+	for (int32_t i=0; i<n; i++)
+		m_alpha[i]/=m_tau;
+
+	return true;
+}
+
+bool CKernelRidgeRegression::train_machine_cg()
+{
+#ifdef HAVE_EIGEN3
+	int32_t n=kernel->get_num_vec_rhs();
+	ASSERT(n>0)
+
+	SGVector<float64_t> y=((CRegressionLabels*) m_labels)->get_labels();
+	if (y.vlen!=n)
+	{
+		SG_ERROR("Number of labels does not match number of kernel"
+				" columns (num_labels=%d cols=%d\n", y.vlen, n);
+	}
+
+	SGMatrix<float64_t> z;
+	if (m_preconditioner)
+	{
+		CFeatures* lhs=kernel->get_lhs();
+		CFeatures* rhs=kernel->get_rhs();
+		m_preconditioner->init(lhs, rhs);
+		SG_UNREF(lhs);
+		SG_UNREF(rhs);
+
+		z=m_preconditioner->get_lhs_feature_map();
+		ASSERT(z.num_cols==n)
+	}
+
+	/* diagonal of K+tau*I that is not covered by the low rank part */
+	SGVector<float64_t> diag(n);
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
+	for (int32_t i=0; i<n; i++)
+	{
+		float64_t d=kernel->kernel(i, i);
+		if (z.matrix)
+			d-=SGVector<float64_t>::dot(z.get_column_vector(i),
+					z.get_column_vector(i), z.num_rows);
+
+		diag[i]=CMath::max(d, 0.0)+m_tau;
+		if (diag[i]<=0)
+			diag[i]=1.0;
+	}
+
+	CKernelOperator* op=new CKernelOperator(kernel, m_tau);
+	SG_REF(op);
+	CConjugateGradientSolver* solver=new CConjugateGradientSolver();
+	SG_REF(solver);
+	solver->set_preconditioner(new CLowRankInverseOperator(diag, z));
+	solver->set_relative_tolerence(m_epsilon);
+	solver->set_absolute_tolerence(0.0);
+
+	m_alpha=solver->solve(op, y);
+
+	SG_UNREF(solver);
+	SG_UNREF(op);
+
+	/* tell kernel machine that all alphas are needed as 'support vectors' */
+	m_svs=SGVector<index_t>(n);
+	m_svs.range_fill();
+
+	return true;
+#else
+	SG_ERROR("Conjugate gradient training requires Eigen3\n")
+	return false;
+#endif
+}
+
 bool CKernelRidgeRegression::train_machine_gs()
 {
 	int32_t n = kernel->get_num_vec_rhs();
@@ -138,6 +277,10 @@ bool CKernelRidgeRegression::train_machine(CFeatures *data)
 	}
 	ASSERT(kernel && kernel->has_features())
 
+	CApproximateKernel* approx_kernel=dynamic_cast<CApproximateKernel*>(kernel);
+	if (approx_kernel)
+		return train_machine_feature_map(approx_kernel);
+
 	switch (m_train_func)
 	{
 		case PINV:
@@ -146,6 +289,9 @@ bool CKernelRidgeRegression::train_machine(CFeatures *data)
 		case GS:
 			return train_machine_gs();
 			break;
+		case CG:
+			return train_machine_cg();
+			break;
 		default:
 			return train_machine_pinv();
 			break;
@@ -21,6 +21,7 @@
 
 namespace shogun
 {
+class CApproximateKernel;
 
 /** which training method to use for KRR */
 enum ETrainingType
@@ -28,7 +29,9 @@ enum ETrainingType
 	/// via pseudo inverse
 	PINV=1,
 	/// or gauss-seidel iterative method
-	GS=2
+	GS=2,
+	/// or matrix-free (preconditioned) conjugate gradient method
+	CG=3
 };
 
 /** @brief Class KernelRidgeRegression implements Kernel Ridge Regression - a regularized least square
@@ -60,6 +63,20 @@ enum ETrainingType
  * where K is the kernel matrix and y the vector of labels. The expressed
  * solution can again be written as a linear combination of kernels (cf.
  * CKernelMachine) with bias \f$b=0\f$.
+ *
+ * If the kernel is a CApproximateKernel with a feature map of dimension d,
+ * the first system is solved in the feature space instead, which takes
+ * \f$O(Nd^2+d^3)\f$ time rather than \f$O(N^3)\f$, and
+ * \f$\alpha=\frac{1}{\tau}({\bf y}-Z^T{\bf w})\f$ is recovered from
+ * \f${\bf w}\f$ for the mapped training examples Z. This requires
+ * \f$\tau>0\f$.
+ *
+ * With the CG training method the kernel matrix is never stored: the system
+ * is solved by conjugate gradients applying \f$K+\tau I\f$ through
+ * CKernelOperator, in \f$O(N)\f$ memory. It is preconditioned by the
+ * diagonal of \f$K+\tau I\f$ or, if set, by the low rank approximation
+ * \f$Z^TZ\f$ of K of an approximate kernel (e.g. CNystromKernel) plus the
+ * remaining diagonal.
  */
 class CKernelRidgeRegression : public CKernelMachine
 {
@@ -80,7 +97,7 @@ class CKernelRidgeRegression : public CKernelMachine
 		CKernelRidgeRegression(float64_t tau, CKernel* k, CLabels* lab, ETrainingType m=PINV);
 
 		/** default destructor */
-		virtual ~CKernelRidgeRegression() {}
+		virtual ~CKernelRidgeRegression();
 
 		/** set regularization constant
 		 *
@@ -88,12 +105,24 @@ class CKernelRidgeRegression : public CKernelMachine
 		 */
 		inline void set_tau(float64_t tau) { m_tau = tau; };
 
-		/** set convergence precision for gauss seidel method
+		/** set convergence precision for gauss seidel method, relative
+		 * precision of the residual for conjugate gradient
 		 *
 		 * @param epsilon new epsilon
 		 */
 		inline void set_epsilon(float64_t epsilon) { m_epsilon = epsilon; }
 
+		/** set the approximate kernel whose feature map preconditions the
+		 * conjugate gradient method, it is initialised with the training data
+		 *
+		 * @param preconditioner approximation of the kernel, NULL for the
+		 * diagonal preconditioner
+		 */
+		void set_preconditioner(CApproximateKernel* preconditioner);
+
+		/** @return approximate kernel used as preconditioner */
+		CApproximateKernel* get_preconditioner();
+
 		/** load regression from file
 		 *
 		 * @param srcfile file to load from
@@ -140,12 +169,25 @@ class CKernelRidgeRegression : public CKernelMachine
 		 */
 		bool train_machine_gs();
 
+		/** train regression using the matrix-free conjugate gradient method
+		 *
+		 * @return whether training was successful
+		 */
+		bool train_machine_cg();
+
 		/** train regression using pinv
 		 *
 		 * @return whether training was successful
 		 */
 		bool train_machine_pinv();
 
+		/** train regression in the feature space of an approximate kernel
+		 *
+		 * @param kernel approximate kernel initialised with training data
+		 * @return whether training was successful
+		 */
+		bool train_machine_feature_map(CApproximateKernel* kernel);
+
 	private:
 		/** regularization parameter tau */
 		float64_t m_tau;
@@ -155,6 +197,9 @@ class CKernelRidgeRegression : public CKernelMachine
 
 		/** training function */
 		ETrainingType m_train_func;
+
+		/** approximate kernel preconditioning conjugate gradient */
+		CApproximateKernel* m_preconditioner;
 };
 }
 
@@ -14,6 +14,7 @@
 #include <shogun/mathematics/Math.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/lib/config.h>
+#include <shogun/lib/ShogunException.h>
 #include <shogun/features/StringFeatures.h>
 #include <shogun/features/Alphabet.h>
 #include <shogun/structure/Plif.h>
@@ -393,34 +394,50 @@ void CDynProg::precompute_content_values()
 	for (int32_t s=0; s<m_num_svms; s++)
 	  m_lin_feat.set_element(0.0, s, 0);
 
-	for (int32_t p=0 ; p<m_seq_len-1 ; p++)
+	/* errors cannot leave the parallel region, so positions are checked here */
+	for (int32_t p=0 ; p<m_seq_len ; p++)
+		ASSERT(m_pos[p]<=m_genestr.get_dim1())
+
+	/* the content of each segment between two candidate positions only
+	 * depends on that segment, so the per-segment increments are computed
+	 * in parallel and accumulated afterwards */
+	#pragma omp parallel num_threads(parallel->get_num_threads())
 	{
-		int32_t from_pos = m_pos[p];
-		int32_t to_pos = m_pos[p+1];
 		float64_t* my_svm_values_unnormalized = SG_MALLOC(float64_t, m_num_svms);
-		//SG_PRINT("%i(%i->%i) ",p,from_pos, to_pos)
 
-	    ASSERT(from_pos<=m_genestr.get_dim1())
-	    ASSERT(to_pos<=m_genestr.get_dim1())
+		#pragma omp for schedule(dynamic, 256)
+		for (int32_t p=0 ; p<m_seq_len-1 ; p++)
+		{
+			int32_t from_pos = m_pos[p];
+			int32_t to_pos = m_pos[p+1];
+			//SG_PRINT("%i(%i->%i) ",p,from_pos, to_pos)
 
-	    for (int32_t s=0; s<m_num_svms; s++)
-			my_svm_values_unnormalized[s]=0.0;//precomputed_svm_values.element(s,p);
+			for (int32_t s=0; s<m_num_svms; s++)
+				my_svm_values_unnormalized[s]=0.0;//precomputed_svm_values.element(s,p);
 
-	    for (int32_t i=from_pos; i<to_pos; i++)
-		{
-			for (int32_t j=0; j<m_num_degrees; j++)
+			for (int32_t i=from_pos; i<to_pos; i++)
 			{
-				uint16_t word = m_wordstr[0][j][i] ;
-				for (int32_t s=0; s<m_num_svms; s++)
+				for (int32_t j=0; j<m_num_degrees; j++)
 				{
-					// check if this k-mer should be considered for this SVM
-					if (m_mod_words.get_element(s,0)==3 && i%3!=m_mod_words.get_element(s,1))
-						continue;
-					my_svm_values_unnormalized[s] += m_dict_weights[(word+m_cum_num_words_array[j])+s*m_cum_num_words_array[m_num_degrees]] ;
+					uint16_t word = m_wordstr[0][j][i] ;
+					for (int32_t s=0; s<m_num_svms; s++)
+					{
+						// check if this k-mer should be considered for this SVM
+						if (m_mod_words.get_element(s,0)==3 && i%3!=m_mod_words.get_element(s,1))
+							continue;
+						my_svm_values_unnormalized[s] += m_dict_weights[(word+m_cum_num_words_array[j])+s*m_cum_num_words_array[m_num_degrees]] ;
+					}
 				}
 			}
+			for (int32_t s=0; s<m_num_svms; s++)
+				m_lin_feat.element(s, p+1)=my_svm_values_unnormalized[s];
 		}
-	    for (int32_t s=0; s<m_num_svms; s++)
+		SG_FREE(my_svm_values_unnormalized);
+	}
+
+	for (int32_t p=0 ; p<m_seq_len-1 ; p++)
+	{
+		for (int32_t s=0; s<m_num_svms; s++)
 		{
 			float64_t prev = m_lin_feat.get_element(s, p);
 			//SG_PRINT("elem (%i, %i, %f)\n", s, p, prev)
@@ -429,9 +446,8 @@ void CDynProg::precompute_content_values()
 				SG_ERROR("initialization missing (%i, %i, %f)\n", s, p, prev)
 				prev=0 ;
 			}
-			m_lin_feat.set_element(prev + my_svm_values_unnormalized[s], s, p+1);
+			m_lin_feat.element(s, p+1)+=prev;
 		}
-		SG_FREE(my_svm_values_unnormalized);
 	}
 	//for (int32_t j=0; j<m_num_degrees; j++)
 	//	SG_FREE(m_wordstr[0][j]);
@@ -1172,12 +1188,6 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 		long_transition_content_end_position.set_const(0) ;
 #endif
 
-		svm_value = SG_MALLOC(float64_t , m_num_lin_feat_plifs_cum[m_num_raw_data]+m_num_intron_plifs);
-		{ // initialize svm_svalue
-			for (int32_t s=0; s<m_num_lin_feat_plifs_cum[m_num_raw_data]+m_num_intron_plifs; s++)
-				svm_value[s]=0 ;
-		}
-
 		CDynamicArray<int32_t> look_back(m_N,m_N) ; // 2d
 		look_back.set_array_name("look_back");
 		//CDynamicArray<int32_t> look_back_orig(m_N,m_N) ;
@@ -1269,8 +1279,6 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 		SG_DEBUG("use_svm=%i\n", use_svm)
 
 		SG_DEBUG("maxlook: %d m_N: %d nbest: %d \n", max_look_back, m_N, nbest)
-		const int32_t look_back_buflen = (max_look_back*m_N+1)*nbest ;
-		SG_DEBUG("look_back_buflen=%i\n", look_back_buflen)
 		/*const float64_t mem_use = (float64_t)(m_seq_len*m_N*nbest*(sizeof(T_STATES)+sizeof(int16_t)+sizeof(int32_t))+
 		  look_back_buflen*(2*sizeof(float64_t)+sizeof(int32_t))+
 		  m_seq_len*(sizeof(T_STATES)+sizeof(int32_t))+
@@ -1296,7 +1304,9 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 		psi.set_array_name("psi");
 		//psi.set_const(0) ;
 
-		CDynamicArray<int16_t> ktable(m_seq_len, m_N, nbest) ; // 3d
+		/* ktable is only accessed for nbest>1, don't spend m_seq_len*m_N
+		 * entries on it otherwise */
+		CDynamicArray<int16_t> ktable(nbest>1 ? m_seq_len : 1, m_N, nbest) ; // 3d
 		ktable.set_array_name("ktable");
 		//ktable.set_const(0) ;
 
@@ -1316,24 +1326,15 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 		ktable_end.set_array_name("ktable_end");
 		//ktable_end.set_const(0) ;
 
-		float64_t * fixedtempvv=SG_MALLOC(float64_t, look_back_buflen);
-		memset(fixedtempvv, 0, look_back_buflen*sizeof(float64_t)) ;
-		int32_t * fixedtempii=SG_MALLOC(int32_t, look_back_buflen);
-		memset(fixedtempii, 0, look_back_buflen*sizeof(int32_t)) ;
-
-		CDynamicArray<float64_t> oldtempvv(look_back_buflen) ;
+		/* the recursion keeps only the nbest best predecessors per state,
+		 * the termination ranks all m_N*nbest end states */
+		CDynamicArray<float64_t> oldtempvv(m_N*nbest) ;
 		oldtempvv.set_array_name("oldtempvv");
-
-		CDynamicArray<float64_t> oldtempvv2(look_back_buflen) ;
-		oldtempvv2.set_array_name("oldtempvv2");
 		//oldtempvv.set_const(0) ;
 		//oldtempvv.display_size() ;
 
-		CDynamicArray<int32_t> oldtempii(look_back_buflen) ;
+		CDynamicArray<int32_t> oldtempii(m_N*nbest) ;
 		oldtempii.set_array_name("oldtempii");
-
-		CDynamicArray<int32_t> oldtempii2(look_back_buflen) ;
-		oldtempii2.set_array_name("oldtempii2");
 		//oldtempii.set_const(0) ;
 
 		CDynamicArray<T_STATES> state_seq(m_seq_len) ;
@@ -1365,15 +1366,8 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 		path_ends.set_array_name("path_ends") ;
 		ktable_end.set_array_name("ktable_end") ;
 
-#ifdef USE_TMP_ARRAYCLASS
-		fixedtempvv.set_array_name("fixedtempvv") ;
-		fixedtempii.set_array_name("fixedtempvv") ;
-#endif
-
 		oldtempvv.set_array_name("oldtempvv") ;
-		oldtempvv2.set_array_name("oldtempvv2") ;
 		oldtempii.set_array_name("oldtempii") ;
-		oldtempii2.set_array_name("oldtempii2") ;
 
 
 		////////////////////////////////////////////////////////////////////////////////
@@ -1405,11 +1399,6 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 		path_ends.display_size() ;
 		ktable_end.display_size() ;
 
-#ifdef USE_TMP_ARRAYCLASS
-		fixedtempvv.display_size() ;
-		fixedtempii.display_size() ;
-#endif
-
 		//oldtempvv.display_size() ;
 		//oldtempii.display_size() ;
 
@@ -1478,498 +1467,545 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 
 		SG_DEBUG("START_RECURSION \n\n")
 
-		// recursion
+		/* recursion
+		 *
+		 * delta at position t only depends on positions ts<t, so the states
+		 * of one position are computed in parallel. All tables are written
+		 * at position t and state j only, the long transition tables in
+		 * column j only. The timers are shared, timing runs single threaded. */
+		int32_t num_threads=parallel->get_num_threads() ;
+#if defined(DYNPROG_TIMING) || defined(DYNPROG_TIMING_DETAIL)
+		num_threads=1 ;
+#endif
+		/* exceptions must not leave the parallel region, the first error
+		 * is kept and raised after it */
+		bool recursion_failed=false ;
+		char recursion_error[1024] ;
+		memset(recursion_error, 0, sizeof(recursion_error)) ;
+
+		#pragma omp parallel num_threads(num_threads) private(svm_value)
+		{
+		svm_value = SG_CALLOC(float64_t, m_num_lin_feat_plifs_cum[m_num_raw_data]+m_num_intron_plifs);
+		float64_t * fixedtempvv=SG_CALLOC(float64_t, nbest);
+		int32_t * fixedtempii=SG_CALLOC(int32_t, nbest);
+
 		for (int32_t t=1; t<m_seq_len; t++)
 		{
 			//if (is_big && t%(1+(m_seq_len/1000))==1)
 			//	SG_PROGRESS(t, 0, m_seq_len)
 			//SG_PRINT("%i\n", t)
 
-			for (T_STATES j=0; j<m_N; j++)
+			#pragma omp for schedule(dynamic)
+			for (int32_t state=0; state<m_N; state++)
 			{
-				if (seq.element(j,t)<=-1e20)
-				{ // if we cannot observe the symbol here, then we can omit the rest
-					for (int16_t k=0; k<nbest; k++)
-					{
-						delta.element(delta_array, t, j, k, m_seq_len, m_N)    = seq.element(j,t) ;
-						psi.element(t,j,k)         = 0 ;
-						if (nbest>1)
-							ktable.element(t,j,k)  = 0 ;
-						ptable.element(t,j,k)      = 0 ;
-					}
-				}
-				else
+				if (recursion_failed)
+					continue ;
+
+				try
 				{
-					const T_STATES num_elem   = trans_list_forward_cnt[j] ;
-					const T_STATES *elem_list = trans_list_forward[j] ;
-					const float64_t *elem_val      = trans_list_forward_val[j] ;
-					const int32_t *elem_id      = trans_list_forward_id[j] ;
+					const T_STATES j=(T_STATES) state ;
+					if (seq.element(j,t)<=-1e20)
+					{ // if we cannot observe the symbol here, then we can omit the rest
+						for (int16_t k=0; k<nbest; k++)
+						{
+							delta.element(delta_array, t, j, k, m_seq_len, m_N)    = seq.element(j,t) ;
+							psi.element(t,j,k)         = 0 ;
+							if (nbest>1)
+								ktable.element(t,j,k)  = 0 ;
+							ptable.element(t,j,k)      = 0 ;
+						}
+					}
+					else
+					{
+						const T_STATES num_elem   = trans_list_forward_cnt[j] ;
+						const T_STATES *elem_list = trans_list_forward[j] ;
+						const float64_t *elem_val      = trans_list_forward_val[j] ;
+						const int32_t *elem_id      = trans_list_forward_id[j] ;
 
-					int32_t fixed_list_len = 0 ;
-					float64_t fixedtempvv_ = CMath::INFTY ;
-					int32_t fixedtempii_ = 0 ;
-					bool fixedtemplong = false ;
+						int32_t fixed_list_len = 0 ;
+						float64_t fixedtempvv_ = CMath::INFTY ;
+						int32_t fixedtempii_ = 0 ;
+						bool fixedtemplong = false ;
 
-					for (int32_t i=0; i<num_elem; i++)
-					{
-						T_STATES ii = elem_list[i] ;
-
-						const CPlifBase* penalty = (CPlifBase*) PEN.element(j,ii) ;
-
-						/*int32_t look_back = max_look_back ;
-						  if (0)
-						  { // find lookback length
-						  CPlifBase *pen = (CPlifBase*) penalty ;
-						  if (pen!=NULL)
-						  look_back=(int32_t) (CMath::ceil(pen->get_max_value()));
-						  if (look_back>=1e6)
-						  SG_PRINT("%i,%i -> %d from %ld\n", j, ii, look_back, (long)pen)
-						  ASSERT(look_back<1e6)
-						  } */
-
-						int32_t look_back_ = look_back.element(j, ii) ;
-
-						int32_t orf_from = m_orf_info.element(ii,0) ;
-						int32_t orf_to   = m_orf_info.element(j,1) ;
-						if((orf_from!=-1)!=(orf_to!=-1))
-							SG_DEBUG("j=%i  ii=%i  orf_from=%i orf_to=%i p=%1.2f\n", j, ii, orf_from, orf_to, elem_val[i])
-						ASSERT((orf_from!=-1)==(orf_to!=-1))
-
-						int32_t orf_target = -1 ;
-						if (orf_from!=-1)
+						for (int32_t i=0; i<num_elem; i++)
 						{
-							orf_target=orf_to-orf_from ;
-							if (orf_target<0)
-								orf_target+=3 ;
-							ASSERT(orf_target>=0 && orf_target<3)
-						}
+							T_STATES ii = elem_list[i] ;
+
+							const CPlifBase* penalty = (CPlifBase*) PEN.element(j,ii) ;
+
+							/*int32_t look_back = max_look_back ;
+							  if (0)
+							  { // find lookback length
+							  CPlifBase *pen = (CPlifBase*) penalty ;
+							  if (pen!=NULL)
+							  look_back=(int32_t) (CMath::ceil(pen->get_max_value()));
+							  if (look_back>=1e6)
+							  SG_PRINT("%i,%i -> %d from %ld\n", j, ii, look_back, (long)pen)
+							  ASSERT(look_back<1e6)
+							  } */
+
+							int32_t look_back_ = look_back.element(j, ii) ;
+
+							int32_t orf_from = m_orf_info.element(ii,0) ;
+							int32_t orf_to   = m_orf_info.element(j,1) ;
+							if((orf_from!=-1)!=(orf_to!=-1))
+								SG_DEBUG("j=%i  ii=%i  orf_from=%i orf_to=%i p=%1.2f\n", j, ii, orf_from, orf_to, elem_val[i])
+							ASSERT((orf_from!=-1)==(orf_to!=-1))
+
+							int32_t orf_target = -1 ;
+							if (orf_from!=-1)
+							{
+								orf_target=orf_to-orf_from ;
+								if (orf_target<0)
+									orf_target+=3 ;
+								ASSERT(orf_target>=0 && orf_target<3)
+							}
 
-						int32_t orf_last_pos = m_pos[t] ;
+							int32_t orf_last_pos = m_pos[t] ;
 #ifdef DYNPROG_TIMING
-						MyTime3.start() ;
+							MyTime3.start() ;
 #endif
-						int32_t num_ok_pos = 0 ;
-
-						for (int32_t ts=t-1; ts>=0 && m_pos[t]-m_pos[ts]<=look_back_; ts--)
-						{
-							bool ok ;
-							//int32_t plen=t-ts;
-
-							/*for (int32_t s=0; s<m_num_svms; s++)
-							  if ((fabs(svs.svm_values[s*svs.seqlen+plen]-svs2.svm_values[s*svs.seqlen+plen])>1e-6) ||
-							  (fabs(svs.svm_values[s*svs.seqlen+plen]-svs3.svm_values[s*svs.seqlen+plen])>1e-6))
-							  {
-							  SG_DEBUG("s=%i, t=%i, ts=%i, %1.5e, %1.5e, %1.5e\n", s, t, ts, svs.svm_values[s*svs.seqlen+plen], svs2.svm_values[s*svs.seqlen+plen], svs3.svm_values[s*svs.seqlen+plen])
-							  }*/
-
-							if (orf_target==-1)
-								ok=true ;
-							else if (m_pos[ts]!=-1 && (m_pos[t]-m_pos[ts])%3==orf_target)
-								ok=(!use_orf) || extend_orf(orf_from, orf_to, m_pos[ts], orf_last_pos, m_pos[t]) ;
-							else
-								ok=false ;
+							int32_t num_ok_pos = 0 ;
 
-							if (ok)
+							for (int32_t ts=t-1; ts>=0 && m_pos[t]-m_pos[ts]<=look_back_; ts--)
 							{
+								bool ok ;
+								//int32_t plen=t-ts;
 
-								float64_t segment_loss = 0.0 ;
-								if (with_loss)
-								{
-									segment_loss = m_seg_loss_obj->get_segment_loss(ts, t, elem_id[i]);
-									//if (segment_loss!=segment_loss2)
-										//SG_PRINT("segment_loss:%f segment_loss2:%f\n", segment_loss, segment_loss2)
-								}
-								////////////////////////////////////////////////////////
-								// BEST_PATH_TRANS
-								////////////////////////////////////////////////////////
+								/*for (int32_t s=0; s<m_num_svms; s++)
+								  if ((fabs(svs.svm_values[s*svs.seqlen+plen]-svs2.svm_values[s*svs.seqlen+plen])>1e-6) ||
+								  (fabs(svs.svm_values[s*svs.seqlen+plen]-svs3.svm_values[s*svs.seqlen+plen])>1e-6))
+								  {
+								  SG_DEBUG("s=%i, t=%i, ts=%i, %1.5e, %1.5e, %1.5e\n", s, t, ts, svs.svm_values[s*svs.seqlen+plen], svs2.svm_values[s*svs.seqlen+plen], svs3.svm_values[s*svs.seqlen+plen])
+								  }*/
 
-								int32_t frame = orf_from;//m_orf_info.element(ii,0);
-								lookup_content_svm_values(ts, t, m_pos[ts], m_pos[t], svm_value, frame);
+								if (orf_target==-1)
+									ok=true ;
+								else if (m_pos[ts]!=-1 && (m_pos[t]-m_pos[ts])%3==orf_target)
+									ok=(!use_orf) || extend_orf(orf_from, orf_to, m_pos[ts], orf_last_pos, m_pos[t]) ;
+								else
+									ok=false ;
 
-								float64_t pen_val = 0.0 ;
-								if (penalty)
+								if (ok)
 								{
+
+									float64_t segment_loss = 0.0 ;
+									if (with_loss)
+									{
+										segment_loss = m_seg_loss_obj->get_segment_loss(ts, t, elem_id[i]);
+										//if (segment_loss!=segment_loss2)
+											//SG_PRINT("segment_loss:%f segment_loss2:%f\n", segment_loss, segment_loss2)
+									}
+									////////////////////////////////////////////////////////
+									// BEST_PATH_TRANS
+									////////////////////////////////////////////////////////
+
+									int32_t frame = orf_from;//m_orf_info.element(ii,0);
+									lookup_content_svm_values(ts, t, m_pos[ts], m_pos[t], svm_value, frame);
+
+									float64_t pen_val = 0.0 ;
+									if (penalty)
+									{
 #ifdef DYNPROG_TIMING_DETAIL
-									MyTime.start() ;
+										MyTime.start() ;
 #endif
-									pen_val = penalty->lookup_penalty(m_pos[t]-m_pos[ts], svm_value) ;
+										pen_val = penalty->lookup_penalty(m_pos[t]-m_pos[ts], svm_value) ;
 
 #ifdef DYNPROG_TIMING_DETAIL
-									MyTime.stop() ;
-									content_plifs_time += MyTime.time_diff_sec() ;
+										MyTime.stop() ;
+										content_plifs_time += MyTime.time_diff_sec() ;
 #endif
-								}
+									}
 
 #ifdef DYNPROG_TIMING_DETAIL
-								MyTime.start() ;
+									MyTime.start() ;
 #endif
-								num_ok_pos++ ;
+									num_ok_pos++ ;
 
-								if (nbest==1)
-								{
-									float64_t  val        = elem_val[i] + pen_val ;
-									if (with_loss)
-										val              += segment_loss ;
+									if (nbest==1)
+									{
+										float64_t  val        = elem_val[i] + pen_val ;
+										if (with_loss)
+											val              += segment_loss ;
 
-									float64_t mval = -(val + delta.element(delta_array, ts, ii, 0, m_seq_len, m_N)) ;
+										float64_t mval = -(val + delta.element(delta_array, ts, ii, 0, m_seq_len, m_N)) ;
 
-									if (mval<fixedtempvv_)
-									{
-										fixedtempvv_ = mval ;
-										fixedtempii_ = ii + ts*m_N;
-										fixed_list_len = 1 ;
-										fixedtemplong = false ;
+										if (mval<fixedtempvv_)
+										{
+											fixedtempvv_ = mval ;
+											fixedtempii_ = ii + ts*m_N;
+											fixed_list_len = 1 ;
+											fixedtemplong = false ;
+										}
 									}
-								}
-								else
-								{
-									for (int16_t diff=0; diff<nbest; diff++)
+									else
 									{
-										float64_t  val        = elem_val[i]  ;
-										val                  += pen_val ;
-										if (with_loss)
-											val              += segment_loss ;
+										for (int16_t diff=0; diff<nbest; diff++)
+										{
+											float64_t  val        = elem_val[i]  ;
+											val                  += pen_val ;
+											if (with_loss)
+												val              += segment_loss ;
 
-										float64_t mval = -(val + delta.element(delta_array, ts, ii, diff, m_seq_len, m_N)) ;
+											float64_t mval = -(val + delta.element(delta_array, ts, ii, diff, m_seq_len, m_N)) ;
 
-										/* only place -val in fixedtempvv if it is one of the nbest lowest values in there */
-										/* fixedtempvv[i], i=0:nbest-1, is sorted so that fixedtempvv[0] <= fixedtempvv[1] <= ...*/
-										/* fixed_list_len has the number of elements in fixedtempvv */
+											/* only place -val in fixedtempvv if it is one of the nbest lowest values in there */
+											/* fixedtempvv[i], i=0:nbest-1, is sorted so that fixedtempvv[0] <= fixedtempvv[1] <= ...*/
+											/* fixed_list_len has the number of elements in fixedtempvv */
 
-										if ((fixed_list_len < nbest) || ((0==fixed_list_len) || (mval < fixedtempvv[fixed_list_len-1])))
-										{
-											if ( (fixed_list_len<nbest) && ((0==fixed_list_len) || (mval>fixedtempvv[fixed_list_len-1])) )
-											{
-												fixedtempvv[fixed_list_len] = mval ;
-												fixedtempii[fixed_list_len] = ii + diff*m_N + ts*m_N*nbest;
-												fixed_list_len++ ;
-											}
-											else  // must have mval < fixedtempvv[fixed_list_len-1]
+											if ((fixed_list_len < nbest) || ((0==fixed_list_len) || (mval < fixedtempvv[fixed_list_len-1])))
 											{
-												int32_t addhere = fixed_list_len;
-												while ((addhere > 0) && (mval < fixedtempvv[addhere-1]))
-													addhere--;
-
-												// move everything from addhere+1 one forward
-												for (int32_t jj=fixed_list_len-1; jj>addhere; jj--)
+												if ( (fixed_list_len<nbest) && ((0==fixed_list_len) || (mval>fixedtempvv[fixed_list_len-1])) )
 												{
-													fixedtempvv[jj] = fixedtempvv[jj-1];
-													fixedtempii[jj] = fixedtempii[jj-1];
+													fixedtempvv[fixed_list_len] = mval ;
+													fixedtempii[fixed_list_len] = ii + diff*m_N + ts*m_N*nbest;
+													fixed_list_len++ ;
+												}
+												else  // must have mval < fixedtempvv[fixed_list_len-1]
+												{
+													int32_t addhere = fixed_list_len;
+													while ((addhere > 0) && (mval < fixedtempvv[addhere-1]))
+														addhere--;
+
+													// move everything from addhere+1 one forward
+													for (int32_t jj=fixed_list_len-1; jj>addhere; jj--)
+													{
+														fixedtempvv[jj] = fixedtempvv[jj-1];
+														fixedtempii[jj] = fixedtempii[jj-1];
+													}
+
+													fixedtempvv[addhere] = mval;
+													fixedtempii[addhere] = ii + diff*m_N + ts*m_N*nbest;
+
+													if (fixed_list_len < nbest)
+														fixed_list_len++;
 												}
-
-												fixedtempvv[addhere] = mval;
-												fixedtempii[addhere] = ii + diff*m_N + ts*m_N*nbest;
-
-												if (fixed_list_len < nbest)
-													fixed_list_len++;
 											}
 										}
 									}
-								}
 #ifdef DYNPROG_TIMING_DETAIL
-								MyTime.stop() ;
-								inner_loop_max_time += MyTime.time_diff_sec() ;
+									MyTime.stop() ;
+									inner_loop_max_time += MyTime.time_diff_sec() ;
 #endif
+								}
 							}
-						}
 #ifdef DYNPROG_TIMING
-						MyTime3.stop() ;
-						inner_loop_time += MyTime3.time_diff_sec() ;
+							MyTime3.stop() ;
+							inner_loop_time += MyTime3.time_diff_sec() ;
 #endif
-					}
-					for (int32_t i=0; i<num_elem; i++)
-					{
-						T_STATES ii = elem_list[i] ;
-
-						const CPlifBase* penalty = (CPlifBase*) PEN.element(j,ii) ;
-
-						/*int32_t look_back = max_look_back ;
-						  if (0)
-						  { // find lookback length
-						  CPlifBase *pen = (CPlifBase*) penalty ;
-						  if (pen!=NULL)
-						  look_back=(int32_t) (CMath::ceil(pen->get_max_value()));
-						  if (look_back>=1e6)
-						  SG_PRINT("%i,%i -> %d from %ld\n", j, ii, look_back, (long)pen)
-						  ASSERT(look_back<1e6)
-						  } */
-
-						int32_t look_back_ = look_back.element(j, ii) ;
-						//int32_t look_back_orig_ = look_back_orig.element(j, ii) ;
-
-						int32_t orf_from = m_orf_info.element(ii,0) ;
-						int32_t orf_to   = m_orf_info.element(j,1) ;
-						if((orf_from!=-1)!=(orf_to!=-1))
-							SG_DEBUG("j=%i  ii=%i  orf_from=%i orf_to=%i p=%1.2f\n", j, ii, orf_from, orf_to, elem_val[i])
-						ASSERT((orf_from!=-1)==(orf_to!=-1))
-
-						int32_t orf_target = -1 ;
-						if (orf_from!=-1)
-						{
-							orf_target=orf_to-orf_from ;
-							if (orf_target<0)
-								orf_target+=3 ;
-							ASSERT(orf_target>=0 && orf_target<3)
 						}
+						for (int32_t i=0; i<num_elem; i++)
+						{
+							T_STATES ii = elem_list[i] ;
+
+							const CPlifBase* penalty = (CPlifBase*) PEN.element(j,ii) ;
+
+							/*int32_t look_back = max_look_back ;
+							  if (0)
+							  { // find lookback length
+							  CPlifBase *pen = (CPlifBase*) penalty ;
+							  if (pen!=NULL)
+							  look_back=(int32_t) (CMath::ceil(pen->get_max_value()));
+							  if (look_back>=1e6)
+							  SG_PRINT("%i,%i -> %d from %ld\n", j, ii, look_back, (long)pen)
+							  ASSERT(look_back<1e6)
+							  } */
+
+							int32_t look_back_ = look_back.element(j, ii) ;
+							//int32_t look_back_orig_ = look_back_orig.element(j, ii) ;
+
+							int32_t orf_from = m_orf_info.element(ii,0) ;
+							int32_t orf_to   = m_orf_info.element(j,1) ;
+							if((orf_from!=-1)!=(orf_to!=-1))
+								SG_DEBUG("j=%i  ii=%i  orf_from=%i orf_to=%i p=%1.2f\n", j, ii, orf_from, orf_to, elem_val[i])
+							ASSERT((orf_from!=-1)==(orf_to!=-1))
+
+							int32_t orf_target = -1 ;
+							if (orf_from!=-1)
+							{
+								orf_target=orf_to-orf_from ;
+								if (orf_target<0)
+									orf_target+=3 ;
+								ASSERT(orf_target>=0 && orf_target<3)
+							}
 
-						//int32_t loss_last_pos = t ;
-						//float64_t last_loss = 0.0 ;
+							//int32_t loss_last_pos = t ;
+							//float64_t last_loss = 0.0 ;
 
 #ifdef DYNPROG_TIMING
-						MyTime3.start() ;
+							MyTime3.start() ;
 #endif
 
-						/* long transition stuff */
-						/* only do this, if
-						 * this feature is enabled
-						 * this is not a transition with ORF restrictions
-						 * the loss is switched off
-						 * nbest=1
-						 */
+							/* long transition stuff */
+							/* only do this, if
+							 * this feature is enabled
+							 * this is not a transition with ORF restrictions
+							 * the loss is switched off
+							 * nbest=1
+							 */
 #ifdef DYNPROG_TIMING
-						MyTime3.start() ;
+							MyTime3.start() ;
 #endif
-						// long transitions, only when not considering ORFs
-						if ( long_transitions && orf_target==-1 && look_back_ == m_long_transition_threshold )
-						{
-
-							// update table for 5' part  of the long segment
-
-							int32_t start = long_transition_content_start.get_element(ii, j) ;
-							int32_t end_5p_part = start ;
-							for (int32_t start_5p_part=start; m_pos[t]-m_pos[start_5p_part] > m_long_transition_threshold ; start_5p_part++)
+							// long transitions, only when not considering ORFs
+							if ( long_transitions && orf_target==-1 && look_back_ == m_long_transition_threshold )
 							{
-								// find end_5p_part, which is greater than start_5p_part and at least m_long_transition_threshold away
-								while (end_5p_part<=t && m_pos[end_5p_part+1]-m_pos[start_5p_part]<=m_long_transition_threshold)
-									end_5p_part++ ;
 
-								ASSERT(m_pos[end_5p_part+1]-m_pos[start_5p_part] > m_long_transition_threshold || end_5p_part==t)
-								ASSERT(m_pos[end_5p_part]-m_pos[start_5p_part] <= m_long_transition_threshold)
+								// update table for 5' part  of the long segment
 
-								float64_t pen_val = 0.0;
-								/* recompute penalty, if necessary */
-								if (penalty)
+								int32_t start = long_transition_content_start.get_element(ii, j) ;
+								int32_t end_5p_part = start ;
+								for (int32_t start_5p_part=start; m_pos[t]-m_pos[start_5p_part] > m_long_transition_threshold ; start_5p_part++)
 								{
-									int32_t frame = m_orf_info.element(ii,0);
-									lookup_content_svm_values(start_5p_part, end_5p_part, m_pos[start_5p_part], m_pos[end_5p_part], svm_value, frame); // * t -> end_5p_part
-									pen_val = penalty->lookup_penalty(m_pos[end_5p_part]-m_pos[start_5p_part], svm_value) ;
-								}
+									// find end_5p_part, which is greater than start_5p_part and at least m_long_transition_threshold away
+									while (end_5p_part<=t && m_pos[end_5p_part+1]-m_pos[start_5p_part]<=m_long_transition_threshold)
+										end_5p_part++ ;
 
-								/*if (m_pos[start_5p_part]==1003)
-								  {
-								  SG_PRINT("Part1: %i - %i   vs  %i - %i\n", m_pos[t], m_pos[ts], m_pos[end_5p_part], m_pos[start_5p_part])
-								  SG_PRINT("Part1: ts=%i  t=%i  start_5p_part=%i  m_seq_len=%i\n", m_pos[ts], m_pos[t], m_pos[start_5p_part], m_seq_len)
-								  }*/
+									ASSERT(m_pos[end_5p_part+1]-m_pos[start_5p_part] > m_long_transition_threshold || end_5p_part==t)
+									ASSERT(m_pos[end_5p_part]-m_pos[start_5p_part] <= m_long_transition_threshold)
 
-								float64_t mval_trans = -( elem_val[i] + pen_val*0.5 + delta.element(delta_array, start_5p_part, ii, 0, m_seq_len, m_N) ) ;
-								//float64_t mval_trans = -( elem_val[i] + delta.element(delta_array, ts, ii, 0, m_seq_len, m_N) ) ; // enable this for the incomplete extra check
+									float64_t pen_val = 0.0;
+									/* recompute penalty, if necessary */
+									if (penalty)
+									{
+										int32_t frame = m_orf_info.element(ii,0);
+										lookup_content_svm_values(start_5p_part, end_5p_part, m_pos[start_5p_part], m_pos[end_5p_part], svm_value, frame); // * t -> end_5p_part
+										pen_val = penalty->lookup_penalty(m_pos[end_5p_part]-m_pos[start_5p_part], svm_value) ;
+									}
 
-								float64_t segment_loss_part1=0.0 ;
-								if (with_loss)
-								{  // this is the loss from the start of the long segment (5' part + middle section)
+									/*if (m_pos[start_5p_part]==1003)
+									  {
+									  SG_PRINT("Part1: %i - %i   vs  %i - %i\n", m_pos[t], m_pos[ts], m_pos[end_5p_part], m_pos[start_5p_part])
+									  SG_PRINT("Part1: ts=%i  t=%i  start_5p_part=%i  m_seq_len=%i\n", m_pos[ts], m_pos[t], m_pos[start_5p_part], m_seq_len)
+									  }*/
 
-									segment_loss_part1 = m_seg_loss_obj->get_segment_loss(start_5p_part /*long_transition_content_start_position.get_element(ii,j)*/, end_5p_part, elem_id[i]); // * unsure
+									float64_t mval_trans = -( elem_val[i] + pen_val*0.5 + delta.element(delta_array, start_5p_part, ii, 0, m_seq_len, m_N) ) ;
+									//float64_t mval_trans = -( elem_val[i] + delta.element(delta_array, ts, ii, 0, m_seq_len, m_N) ) ; // enable this for the incomplete extra check
 
-									mval_trans -= segment_loss_part1 ;
-								}
+									float64_t segment_loss_part1=0.0 ;
+									if (with_loss)
+									{  // this is the loss from the start of the long segment (5' part + middle section)
 
+										segment_loss_part1 = m_seg_loss_obj->get_segment_loss(start_5p_part /*long_transition_content_start_position.get_element(ii,j)*/, end_5p_part, elem_id[i]); // * unsure
 
-								if (0)//m_pos[end_5p_part] - m_pos[long_transition_content_start_position.get_element(ii, j)] > look_back_orig_/*m_long_transition_max*/)
-								{
-									// this restricts the maximal length of segments,
-									// but the current implementation is not valid since the
-									// long transition is discarded without loocking if there
-									// is a second best long transition in between
-									long_transition_content_scores.set_element(-CMath::INFTY, ii, j) ;
-									long_transition_content_start_position.set_element(0, ii, j) ;
-									if (with_loss)
-										long_transition_content_scores_loss.set_element(0.0, ii, j) ;
+										mval_trans -= segment_loss_part1 ;
+									}
+
+
+									if (0)//m_pos[end_5p_part] - m_pos[long_transition_content_start_position.get_element(ii, j)] > look_back_orig_/*m_long_transition_max*/)
+									{
+										// this restricts the maximal length of segments,
+										// but the current implementation is not valid since the
+										// long transition is discarded without loocking if there
+										// is a second best long transition in between
+										long_transition_content_scores.set_element(-CMath::INFTY, ii, j) ;
+										long_transition_content_start_position.set_element(0, ii, j) ;
+										if (with_loss)
+											long_transition_content_scores_loss.set_element(0.0, ii, j) ;
 #ifdef DYNPROG_DEBUG
-									long_transition_content_scores_pen.set_element(0.0, ii, j) ;
-									long_transition_content_scores_elem.set_element(0.0, ii, j) ;
-									long_transition_content_scores_prev.set_element(0.0, ii, j) ;
-									long_transition_content_end_position.set_element(0, ii, j) ;
+										long_transition_content_scores_pen.set_element(0.0, ii, j) ;
+										long_transition_content_scores_elem.set_element(0.0, ii, j) ;
+										long_transition_content_scores_prev.set_element(0.0, ii, j) ;
+										long_transition_content_end_position.set_element(0, ii, j) ;
 #endif
-								}
-								if (with_loss)
-								{
-									float64_t old_loss = long_transition_content_scores_loss.get_element(ii, j) ;
-									float64_t new_loss = m_seg_loss_obj->get_segment_loss(long_transition_content_start_position.get_element(ii,j), end_5p_part, elem_id[i]);
-									float64_t score = long_transition_content_scores.get_element(ii, j) - old_loss + new_loss ;
-									long_transition_content_scores.set_element(score, ii, j) ;
-									long_transition_content_scores_loss.set_element(new_loss, ii, j) ;
+									}
+									if (with_loss)
+									{
+										float64_t old_loss = long_transition_content_scores_loss.get_element(ii, j) ;
+										float64_t new_loss = m_seg_loss_obj->get_segment_loss(long_transition_content_start_position.get_element(ii,j), end_5p_part, elem_id[i]);
+										float64_t score = long_transition_content_scores.get_element(ii, j) - old_loss + new_loss ;
+										long_transition_content_scores.set_element(score, ii, j) ;
+										long_transition_content_scores_loss.set_element(new_loss, ii, j) ;
 #ifdef DYNPROG_DEBUG
-									long_transition_content_end_position.set_element(end_5p_part, ii, j) ;
+										long_transition_content_end_position.set_element(end_5p_part, ii, j) ;
 #endif
 
-								}
-								if (-long_transition_content_scores.get_element(ii, j) > mval_trans )
-								{
-									/* then the old long transition is either too far away or worse than the current one */
-									long_transition_content_scores.set_element(-mval_trans, ii, j) ;
-									long_transition_content_start_position.set_element(start_5p_part, ii, j) ;
-									if (with_loss)
-										long_transition_content_scores_loss.set_element(segment_loss_part1, ii, j) ;
+									}
+									if (-long_transition_content_scores.get_element(ii, j) > mval_trans )
+									{
+										/* then the old long transition is either too far away or worse than the current one */
+										long_transition_content_scores.set_element(-mval_trans, ii, j) ;
+										long_transition_content_start_position.set_element(start_5p_part, ii, j) ;
+										if (with_loss)
+											long_transition_content_scores_loss.set_element(segment_loss_part1, ii, j) ;
 #ifdef DYNPROG_DEBUG
-									long_transition_content_scores_pen.set_element(pen_val*0.5, ii, j) ;
-									long_transition_content_scores_elem.set_element(elem_val[i], ii, j) ;
-									long_transition_content_scores_prev.set_element(delta.element(delta_array, start_5p_part, ii, 0, m_seq_len, m_N), ii, j) ;
-									/*ASSERT(fabs(long_transition_content_scores.get_element(ii, j)-(long_transition_content_scores_pen.get_element(ii, j) +
-									  long_transition_content_scores_elem.get_element(ii, j) +
-									  long_transition_content_scores_prev.get_element(ii, j)))<1e-6) ;*/
-									long_transition_content_end_position.set_element(end_5p_part, ii, j) ;
+										long_transition_content_scores_pen.set_element(pen_val*0.5, ii, j) ;
+										long_transition_content_scores_elem.set_element(elem_val[i], ii, j) ;
+										long_transition_content_scores_prev.set_element(delta.element(delta_array, start_5p_part, ii, 0, m_seq_len, m_N), ii, j) ;
+										/*ASSERT(fabs(long_transition_content_scores.get_element(ii, j)-(long_transition_content_scores_pen.get_element(ii, j) +
+										  long_transition_content_scores_elem.get_element(ii, j) +
+										  long_transition_content_scores_prev.get_element(ii, j)))<1e-6) ;*/
+										long_transition_content_end_position.set_element(end_5p_part, ii, j) ;
 #endif
+									}
+									//
+									// this sets the position where the search for better 5'parts is started the next time
+									// whithout this the prediction takes ages
+									//
+									long_transition_content_start.set_element(start_5p_part, ii, j) ;
 								}
-								//
-								// this sets the position where the search for better 5'parts is started the next time
-								// whithout this the prediction takes ages
-								//
-								long_transition_content_start.set_element(start_5p_part, ii, j) ;
-							}
 
-							// consider the 3' part at the end of the long segment:
-							// * with length = m_long_transition_threshold
-							// * content prediction and loss only for this part
+								// consider the 3' part at the end of the long segment:
+								// * with length = m_long_transition_threshold
+								// * content prediction and loss only for this part
 
-							// find ts > 0 with distance from m_pos[t] greater m_long_transition_threshold
-							// precompute: only depends on t
-							int ts = t;
-							while (ts>0 && m_pos[t]-m_pos[ts-1] <= m_long_transition_threshold)
-								ts-- ;
+								// find ts > 0 with distance from m_pos[t] greater m_long_transition_threshold
+								// precompute: only depends on t
+								int ts = t;
+								while (ts>0 && m_pos[t]-m_pos[ts-1] <= m_long_transition_threshold)
+									ts-- ;
 
-							if (ts>0)
-							{
-								ASSERT((m_pos[t]-m_pos[ts-1] > m_long_transition_threshold) && (m_pos[t]-m_pos[ts] <= m_long_transition_threshold))
+								if (ts>0)
+								{
+									ASSERT((m_pos[t]-m_pos[ts-1] > m_long_transition_threshold) && (m_pos[t]-m_pos[ts] <= m_long_transition_threshold))
 
 
-								/* only consider this transition, if the right position was found */
-								float pen_val_3p = 0.0 ;
-								if (penalty)
-								{
-									int32_t frame = orf_from ; //m_orf_info.element(ii, 0);
-									lookup_content_svm_values(ts, t, m_pos[ts], m_pos[t], svm_value, frame);
-									pen_val_3p = penalty->lookup_penalty(m_pos[t]-m_pos[ts], svm_value) ;
-								}
+									/* only consider this transition, if the right position was found */
+									float pen_val_3p = 0.0 ;
+									if (penalty)
+									{
+										int32_t frame = orf_from ; //m_orf_info.element(ii, 0);
+										lookup_content_svm_values(ts, t, m_pos[ts], m_pos[t], svm_value, frame);
+										pen_val_3p = penalty->lookup_penalty(m_pos[t]-m_pos[ts], svm_value) ;
+									}
 
-								float64_t mval = -(long_transition_content_scores.get_element(ii, j) + pen_val_3p*0.5) ;
+									float64_t mval = -(long_transition_content_scores.get_element(ii, j) + pen_val_3p*0.5) ;
 
-								{
+									{
 #ifdef DYNPROG_DEBUG
-									float64_t segment_loss_part2=0.0 ;
-									float64_t segment_loss_part1=0.0 ;
+										float64_t segment_loss_part2=0.0 ;
+										float64_t segment_loss_part1=0.0 ;
 #endif
-									float64_t segment_loss_total=0.0 ;
+										float64_t segment_loss_total=0.0 ;
 
-									if (with_loss)
-									{   // this is the loss for the 3' end fragment of the segment
-										// (the 5' end and the middle section loss is already contained in mval)
+										if (with_loss)
+										{   // this is the loss for the 3' end fragment of the segment
+											// (the 5' end and the middle section loss is already contained in mval)
 
 #ifdef DYNPROG_DEBUG
-										// this is an alternative, which should be identical, if the loss is additive
-										segment_loss_part2 = m_seg_loss_obj->get_segment_loss_extend(long_transition_content_end_position.get_element(ii,j), t, elem_id[i]);
-										//mval -= segment_loss_part2 ;
-										segment_loss_part1 = m_seg_loss_obj->get_segment_loss(long_transition_content_start_position.get_element(ii,j), long_transition_content_end_position.get_element(ii,j), elem_id[i]);
+											// this is an alternative, which should be identical, if the loss is additive
+											segment_loss_part2 = m_seg_loss_obj->get_segment_loss_extend(long_transition_content_end_position.get_element(ii,j), t, elem_id[i]);
+											//mval -= segment_loss_part2 ;
+											segment_loss_part1 = m_seg_loss_obj->get_segment_loss(long_transition_content_start_position.get_element(ii,j), long_transition_content_end_position.get_element(ii,j), elem_id[i]);
 #endif
-										segment_loss_total = m_seg_loss_obj->get_segment_loss(long_transition_content_start_position.get_element(ii,j), t, elem_id[i]);
-										mval -= (segment_loss_total-long_transition_content_scores_loss.get_element(ii, j)) ;
-									}
+											segment_loss_total = m_seg_loss_obj->get_segment_loss(long_transition_content_start_position.get_element(ii,j), t, elem_id[i]);
+											mval -= (segment_loss_total-long_transition_content_scores_loss.get_element(ii, j)) ;
+										}
 
 #ifdef DYNPROG_DEBUG
-									if (m_pos[t]==10108 ||m_pos[t]==12802 ||m_pos[t]== 12561)
-									{
-										SG_PRINT("Part2: %i,%i,%i: val=%1.6f  pen_val_3p*0.5=%1.6f (t=%i, ts=%i, ts-1=%i, ts+1=%i) scores=%1.6f (pen=%1.6f,prev=%1.6f,elem=%1.6f,loss=%1.1f), positions=%i,%i,%i,  loss=%1.1f/%1.1f (%i,%i)\n",
-												 m_pos[t], j, ii, -mval, 0.5*pen_val_3p, m_pos[t], m_pos[ts], m_pos[ts-1], m_pos[ts+1],
-												 long_transition_content_scores.get_element(ii, j),
-												 long_transition_content_scores_pen.get_element(ii, j),
-												 long_transition_content_scores_prev.get_element(ii, j),
-												 long_transition_content_scores_elem.get_element(ii, j),
-												 long_transition_content_scores_loss.get_element(ii, j),
-												 m_pos[long_transition_content_start_position.get_element(ii,j)],
-												 m_pos[long_transition_content_end_position.get_element(ii,j)],
-												 m_pos[long_transition_content_start.get_element(ii,j)], segment_loss_part2, segment_loss_total, long_transition_content_start_position.get_element(ii,j), t) ;
-										SG_PRINT("fixedtempvv_: %1.6f, from_state:%i from_pos:%i\n ",-fixedtempvv_, (fixedtempii_%m_N), m_pos[(fixedtempii_-(fixedtempii_%(m_N*nbest)))/(m_N*nbest)] )
+										if (m_pos[t]==10108 ||m_pos[t]==12802 ||m_pos[t]== 12561)
+										{
+											SG_PRINT("Part2: %i,%i,%i: val=%1.6f  pen_val_3p*0.5=%1.6f (t=%i, ts=%i, ts-1=%i, ts+1=%i) scores=%1.6f (pen=%1.6f,prev=%1.6f,elem=%1.6f,loss=%1.1f), positions=%i,%i,%i,  loss=%1.1f/%1.1f (%i,%i)\n",
+													 m_pos[t], j, ii, -mval, 0.5*pen_val_3p, m_pos[t], m_pos[ts], m_pos[ts-1], m_pos[ts+1],
+													 long_transition_content_scores.get_element(ii, j),
+													 long_transition_content_scores_pen.get_element(ii, j),
+													 long_transition_content_scores_prev.get_element(ii, j),
+													 long_transition_content_scores_elem.get_element(ii, j),
+													 long_transition_content_scores_loss.get_element(ii, j),
+													 m_pos[long_transition_content_start_position.get_element(ii,j)],
+													 m_pos[long_transition_content_end_position.get_element(ii,j)],
+													 m_pos[long_transition_content_start.get_element(ii,j)], segment_loss_part2, segment_loss_total, long_transition_content_start_position.get_element(ii,j), t) ;
+											SG_PRINT("fixedtempvv_: %1.6f, from_state:%i from_pos:%i\n ",-fixedtempvv_, (fixedtempii_%m_N), m_pos[(fixedtempii_-(fixedtempii_%(m_N*nbest)))/(m_N*nbest)] )
+										}
+
+										if (fabs(segment_loss_part2+long_transition_content_scores_loss.get_element(ii, j) - segment_loss_total)>1e-3)
+										{
+											SG_ERROR("LOSS: total=%1.1f (%i-%i)  part1=%1.1f/%1.1f (%i-%i)  part2=%1.1f (%i-%i)  sum=%1.1f  diff=%1.1f\n",
+													 segment_loss_total, m_pos[long_transition_content_start_position.get_element(ii,j)], m_pos[t],
+													 long_transition_content_scores_loss.get_element(ii, j), segment_loss_part1, m_pos[long_transition_content_start_position.get_element(ii,j)], m_pos[long_transition_content_end_position.get_element(ii,j)],
+													 segment_loss_part2, m_pos[long_transition_content_end_position.get_element(ii,j)], m_pos[t],
+													 segment_loss_part2+long_transition_content_scores_loss.get_element(ii, j),
+													 segment_loss_part2+long_transition_content_scores_loss.get_element(ii, j) - segment_loss_total) ;
+										}
+#endif
 									}
 
-									if (fabs(segment_loss_part2+long_transition_content_scores_loss.get_element(ii, j) - segment_loss_total)>1e-3)
+									// prefer simpler version to guarantee optimality
+									//
+									// original:
+									/* if ((mval < fixedtempvv_) &&
+										(m_pos[t] - m_pos[long_transition_content_start_position.get_element(ii, j)])<=look_back_orig_) */
+									if (mval < fixedtempvv_)
 									{
-										SG_ERROR("LOSS: total=%1.1f (%i-%i)  part1=%1.1f/%1.1f (%i-%i)  part2=%1.1f (%i-%i)  sum=%1.1f  diff=%1.1f\n",
-												 segment_loss_total, m_pos[long_transition_content_start_position.get_element(ii,j)], m_pos[t],
-												 long_transition_content_scores_loss.get_element(ii, j), segment_loss_part1, m_pos[long_transition_content_start_position.get_element(ii,j)], m_pos[long_transition_content_end_position.get_element(ii,j)],
-												 segment_loss_part2, m_pos[long_transition_content_end_position.get_element(ii,j)], m_pos[t],
-												 segment_loss_part2+long_transition_content_scores_loss.get_element(ii, j),
-												 segment_loss_part2+long_transition_content_scores_loss.get_element(ii, j) - segment_loss_total) ;
-									}
-#endif
-								}
+										/* then the long transition is better than the short one => replace it */
+										int32_t fromtjk =  fixedtempii_ ;
+										/*SG_PRINT("%i,%i: Long transition (%1.5f=-(%1.5f+%1.5f+%1.5f+%1.5f), %i) to m_pos %i better than short transition (%1.5f,%i) to m_pos %i \n",
+										  m_pos[t], j,
+										  mval, pen_val_3p*0.5, long_transition_content_scores_pen.get_element(ii, j), long_transition_content_scores_elem.get_element(ii, j), long_transition_content_scores_prev.get_element(ii, j), ii,
+										  m_pos[long_transition_content_position.get_element(ii, j)],
+										  fixedtempvv_, (fromtjk%m_N), m_pos[(fromtjk-(fromtjk%(m_N*nbest)))/(m_N*nbest)]) ;*/
+										ASSERT((fromtjk-(fromtjk%(m_N*nbest)))/(m_N*nbest)==0 || m_pos[(fromtjk-(fromtjk%(m_N*nbest)))/(m_N*nbest)]>=m_pos[long_transition_content_start_position.get_element(ii, j)] || fixedtemplong)
 
-								// prefer simpler version to guarantee optimality
-								//
-								// original:
-								/* if ((mval < fixedtempvv_) &&
-									(m_pos[t] - m_pos[long_transition_content_start_position.get_element(ii, j)])<=look_back_orig_) */
-								if (mval < fixedtempvv_)
-								{
-									/* then the long transition is better than the short one => replace it */
-									int32_t fromtjk =  fixedtempii_ ;
-									/*SG_PRINT("%i,%i: Long transition (%1.5f=-(%1.5f+%1.5f+%1.5f+%1.5f), %i) to m_pos %i better than short transition (%1.5f,%i) to m_pos %i \n",
-									  m_pos[t], j,
-									  mval, pen_val_3p*0.5, long_transition_content_scores_pen.get_element(ii, j), long_transition_content_scores_elem.get_element(ii, j), long_transition_content_scores_prev.get_element(ii, j), ii,
-									  m_pos[long_transition_content_position.get_element(ii, j)],
-									  fixedtempvv_, (fromtjk%m_N), m_pos[(fromtjk-(fromtjk%(m_N*nbest)))/(m_N*nbest)]) ;*/
-									ASSERT((fromtjk-(fromtjk%(m_N*nbest)))/(m_N*nbest)==0 || m_pos[(fromtjk-(fromtjk%(m_N*nbest)))/(m_N*nbest)]>=m_pos[long_transition_content_start_position.get_element(ii, j)] || fixedtemplong)
-
-									fixedtempvv_ = mval ;
-									fixedtempii_ = ii + m_N*long_transition_content_start_position.get_element(ii, j) ;
-									fixed_list_len = 1 ;
-									fixedtemplong = true ;
+										fixedtempvv_ = mval ;
+										fixedtempii_ = ii + m_N*long_transition_content_start_position.get_element(ii, j) ;
+										fixed_list_len = 1 ;
+										fixedtemplong = true ;
+									}
 								}
 							}
 						}
-					}
 #ifdef DYNPROG_TIMING
-					MyTime3.stop() ;
-					long_transition_time += MyTime3.time_diff_sec() ;
+						MyTime3.stop() ;
+						long_transition_time += MyTime3.time_diff_sec() ;
 #endif
 
 
-					int32_t numEnt = fixed_list_len;
+						int32_t numEnt = fixed_list_len;
 
-					float64_t minusscore;
-					int64_t fromtjk;
+						float64_t minusscore;
+						int64_t fromtjk;
 
-					for (int16_t k=0; k<nbest; k++)
-					{
-						if (k<numEnt)
+						for (int16_t k=0; k<nbest; k++)
 						{
-							if (nbest==1)
+							if (k<numEnt)
 							{
-								minusscore = fixedtempvv_ ;
-								fromtjk = fixedtempii_ ;
+								if (nbest==1)
+								{
+									minusscore = fixedtempvv_ ;
+									fromtjk = fixedtempii_ ;
+								}
+								else
+								{
+									minusscore = fixedtempvv[k];
+									fromtjk = fixedtempii[k];
+								}
+
+								delta.element(delta_array, t, j, k, m_seq_len, m_N)    = -minusscore + seq.element(j,t);
+								psi.element(t,j,k)      = (fromtjk%m_N) ;
+								if (nbest>1)
+									ktable.element(t,j,k)   = (fromtjk%(m_N*nbest)-psi.element(t,j,k))/m_N ;
+								ptable.element(t,j,k)   = (fromtjk-(fromtjk%(m_N*nbest)))/(m_N*nbest) ;
 							}
 							else
 							{
-								minusscore = fixedtempvv[k];
-								fromtjk = fixedtempii[k];
+								delta.element(delta_array, t, j, k, m_seq_len, m_N)    = -CMath::INFTY ;
+								psi.element(t,j,k)      = 0 ;
+								if (nbest>1)
+									ktable.element(t,j,k)     = 0 ;
+								ptable.element(t,j,k)     = 0 ;
 							}
-
-							delta.element(delta_array, t, j, k, m_seq_len, m_N)    = -minusscore + seq.element(j,t);
-							psi.element(t,j,k)      = (fromtjk%m_N) ;
-							if (nbest>1)
-								ktable.element(t,j,k)   = (fromtjk%(m_N*nbest)-psi.element(t,j,k))/m_N ;
-							ptable.element(t,j,k)   = (fromtjk-(fromtjk%(m_N*nbest)))/(m_N*nbest) ;
-						}
-						else
-						{
-							delta.element(delta_array, t, j, k, m_seq_len, m_N)    = -CMath::INFTY ;
-							psi.element(t,j,k)      = 0 ;
-							if (nbest>1)
-								ktable.element(t,j,k)     = 0 ;
-							ptable.element(t,j,k)     = 0 ;
 						}
 					}
 				}
+				catch (ShogunException& e)
+				{
+					#pragma omp critical (dynprog_recursion_error)
+					{
+						if (!recursion_failed)
+							strncpy(recursion_error, e.get_exception_string(), sizeof(recursion_error)-1) ;
+						recursion_failed=true ;
+					}
+				}
 			}
 		}
+
+		SG_FREE(fixedtempvv);
+		SG_FREE(fixedtempii);
+		SG_FREE(svm_value);
+		}
+
+		if (recursion_failed)
+			SG_ERROR("%s", recursion_error)
+
 		{ //termination
 			int32_t list_len = 0 ;
 			for (int16_t diff=0; diff<nbest; diff++)
@@ -2042,9 +2078,6 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 		//if (is_big)
 		SG_PRINT("Timing:  orf=%1.2f s \n Segment_init=%1.2f s Segment_pos=%1.2f s  Segment_extend=%1.2f s Segment_clean=%1.2f s\nsvm_init=%1.2f s  svm_pos=%1.2f  svm_clean=%1.2f\n  content_svm_values_time=%1.2f  content_plifs_time=%1.2f\ninner_loop_max_time=%1.2f inner_loop=%1.2f long_transition_time=%1.2f\n total=%1.2f\n", orf_time, segment_init_time, segment_pos_time, segment_extend_time, segment_clean_time, svm_init_time, svm_pos_time, svm_clean_time, content_svm_values_time, content_plifs_time, inner_loop_max_time, inner_loop_time, long_transition_time, MyTime2.time_diff_sec())
 #endif
-
-		SG_FREE(fixedtempvv);
-		SG_FREE(fixedtempii);
 	}
 
 
@@ -2500,7 +2533,12 @@ void CDynProg::lookup_content_svm_values(const int32_t from_state, const int32_t
 	}
 	if (m_intron_list)
 	{
-		int32_t* support = SG_MALLOC(int32_t, m_num_intron_plifs);
+		/* called for every transition, avoid the heap in the common case
+		 * of a few intron plifs (coverage and quality) */
+		int32_t support_buf[16];
+		int32_t* support = support_buf;
+		if (m_num_intron_plifs>16)
+			support = SG_MALLOC(int32_t, m_num_intron_plifs);
 		m_intron_list->get_intron_support(support, from_state, to_state);
 		int32_t intron_list_start = m_num_lin_feat_plifs_cum[m_num_raw_data];
 		int32_t intron_list_end = m_num_lin_feat_plifs_cum[m_num_raw_data]+m_num_intron_plifs;
@@ -2512,7 +2550,8 @@ void CDynProg::lookup_content_svm_values(const int32_t from_state, const int32_t
 		}
 		//if (to_pos>3990 && to_pos<4010)
 		//	SG_PRINT("from_state:%i to_state:%i support[0]:%i support[1]:%i\n",from_state, to_state, support[0], support[1])
-		SG_FREE(support);
+		if (support!=support_buf)
+			SG_FREE(support);
 	}
 	// find the correct row with precomputed frame predictions
 	if (frame!=-1)
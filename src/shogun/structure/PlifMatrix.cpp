@@ -12,20 +12,32 @@ CPlifMatrix::CPlifMatrix() : m_PEN(NULL), m_num_plifs(0), m_num_limits(0),
 
 CPlifMatrix::~CPlifMatrix()
 {
+	delete_plif_matrix();
+
 	for (int32_t i=0; i<m_num_plifs; i++)
 		delete m_PEN[i];
 	SG_FREE(m_PEN);
 
-	for (int32_t i=0; i<m_num_states*m_num_states; i++)
-		delete m_plif_matrix[i];
+	SG_FREE(m_state_signals);
+}
 
+void CPlifMatrix::delete_plif_matrix()
+{
+	/* entries with a single plif point into m_PEN, only the plif arrays
+	 * are owned by the matrix */
+	for (int32_t i=0; m_plif_matrix && i<m_num_states*m_num_states; i++)
+	{
+		if (dynamic_cast<CPlifArray*>(m_plif_matrix[i]))
+			delete m_plif_matrix[i];
+	}
 	SG_FREE(m_plif_matrix);
-
-	SG_FREE(m_state_signals);
+	m_plif_matrix=NULL;
 }
 
 void CPlifMatrix::create_plifs(int32_t num_plifs, int32_t num_limits)
 {
+	delete_plif_matrix();
+
 	for (int32_t i=0; i<m_num_plifs; i++)
 		delete m_PEN[i];
 	SG_FREE(m_PEN);
@@ -183,9 +195,7 @@ bool CPlifMatrix::compute_plif_matrix(SGNDArray<float64_t> penalties_array)
 	int32_t num_states = penalties_array.dims[0];
 	int32_t num_plifs = get_num_plifs();
 
-	for (int32_t i=0; i<m_num_states*m_num_states; i++)
-		delete  m_plif_matrix[i];
-	SG_FREE(m_plif_matrix);
+	delete_plif_matrix();
 
 	m_num_states = num_states;
 	m_plif_matrix = SG_MALLOC(CPlifBase*, num_states*num_states);
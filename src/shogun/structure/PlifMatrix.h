@@ -191,6 +191,9 @@ class CPlifMatrix: public CSGObject
 
 	protected:
 
+		/** free the plif matrix, the plifs it refers to belong to m_PEN */
+		void delete_plif_matrix();
+
 		/** array of plifs*/
 		CPlif** m_PEN;
 
@@ -42,6 +42,17 @@ class CDomainAdaptationMulticlassLibLinear : public CMulticlassLibLinear
 		/** get submachine outputs */
 		virtual CBinaryLabels* get_submachine_outputs(int32_t);
 
+		/** get outputs of all submachines, combining target and source
+		 * outputs per submachine
+		 *
+		 * @param outputs array of length number of machines to store
+		 * the outputs in
+		 */
+		virtual void get_all_submachine_outputs(CBinaryLabels** outputs)
+		{
+			CMulticlassMachine::get_all_submachine_outputs(outputs);
+		}
+
 		/** get name */
 		virtual const char* get_name() const
 		{
@@ -229,3 +229,73 @@ TEST(SGObject,equals_complex_equal)
 	SG_UNREF(gpr_copy);
 }
 #endif //HAVE_EIGEN3
+
+TEST(SGObject,get_memory_footprint)
+{
+	SGMatrix<float64_t> X(10, 20);
+	X.zero();
+	CDenseFeatures<float64_t>* feat=new CDenseFeatures<float64_t>(X);
+	SG_REF(feat);
+
+	int64_t feat_bytes=feat->get_memory_footprint();
+	EXPECT_GE(feat_bytes, 10*20*sizeof(float64_t));
+
+	/* features shared by lhs and rhs are counted once */
+	CGaussianKernel* kernel=new CGaussianKernel(feat, feat, 1.0);
+	SG_REF(kernel);
+	int64_t kernel_bytes=kernel->get_memory_footprint();
+	EXPECT_GE(kernel_bytes, feat_bytes);
+	EXPECT_LT(kernel_bytes, feat_bytes+10*20*sizeof(float64_t));
+
+	CBinaryLabels* labels=new CBinaryLabels(SGVector<float64_t>(1000));
+	EXPECT_GE(labels->get_memory_footprint(), 1000*sizeof(float64_t));
+	SG_UNREF(labels);
+
+	SG_UNREF(kernel);
+	SG_UNREF(feat);
+}
+
+TEST(SGObject,shared_clone)
+{
+	SGMatrix<float64_t> X(10, 20);
+	for (index_t i=0; i<X.num_rows*X.num_cols; i++)
+		X[i]=i;
+	CDenseFeatures<float64_t>* feat=new CDenseFeatures<float64_t>(X);
+	CGaussianKernel* kernel=new CGaussianKernel(feat, feat, 1.0);
+	SG_REF(kernel);
+
+	CGaussianKernel* copy=(CGaussianKernel*) kernel->shared_clone();
+	ASSERT_TRUE(copy);
+	EXPECT_NE(kernel, copy);
+	EXPECT_TRUE(kernel->equals(copy));
+
+	/* the features are new objects which share the matrix */
+	CDenseFeatures<float64_t>* copy_feat=
+		(CDenseFeatures<float64_t>*) copy->get_lhs();
+	EXPECT_NE(feat, copy_feat);
+	EXPECT_EQ(X.matrix, copy_feat->get_feature_matrix().matrix);
+
+	/* changes of the copy do not affect the original */
+	copy->set_width(2.0);
+	EXPECT_EQ(kernel->get_width(), 1.0);
+	SGVector<index_t> subset(5);
+	subset.range_fill();
+	copy_feat->add_subset(subset);
+	EXPECT_EQ(copy_feat->get_num_vectors(), 5);
+	EXPECT_EQ(feat->get_num_vectors(), 20);
+	copy_feat->set_feature_matrix(SGMatrix<float64_t>(10, 20));
+	EXPECT_EQ(X.matrix, feat->get_feature_matrix().matrix);
+	SG_UNREF(copy_feat);
+
+	SG_UNREF(copy);
+	EXPECT_EQ(X.matrix, feat->get_feature_matrix().matrix);
+	EXPECT_EQ(X(3, 4), 43);
+
+	CBinaryLabels* labels=new CBinaryLabels(SGVector<float64_t>(1000));
+	CBinaryLabels* copy_labels=(CBinaryLabels*) labels->shared_clone();
+	EXPECT_EQ(labels->get_labels().vector, copy_labels->get_labels().vector);
+	SG_UNREF(copy_labels);
+	SG_UNREF(labels);
+
+	SG_UNREF(kernel);
+}
@@ -0,0 +1,53 @@
+#include <shogun/classifier/PluginEstimate.h>
+#include <shogun/features/StringFeatures.h>
+#include <shogun/lib/SGStringList.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+TEST(PluginEstimate,apply_binary)
+{
+	CMath::init_random(5);
+	int32_t num=100;
+	int32_t len=20;
+
+	/* positive sequences prefer A and C, negative ones G and T */
+	SGStringList<char> strings(num, len);
+	SGVector<float64_t> lab(num);
+	for (index_t i=0; i<num; i++)
+	{
+		lab[i]=i%2 ? 1 : -1;
+		strings.strings[i]=SGString<char>(len);
+		for (index_t j=0; j<len; j++)
+		{
+			bool major=CMath::random(0, 4)!=0;
+			int32_t offset=(major==(lab[i]>0)) ? 0 : 2;
+			strings.strings[i].string[j]="ACGT"[offset+CMath::random(0, 1)];
+		}
+	}
+
+	CStringFeatures<char>* chars=new CStringFeatures<char>(strings, DNA);
+	CStringFeatures<uint16_t>* feats=new CStringFeatures<uint16_t>(DNA);
+	feats->obtain_from_char(chars, 0, 1, 0, false);
+	SG_UNREF(chars);
+
+	CPluginEstimate* plugin=new CPluginEstimate();
+	SG_REF(plugin);
+	plugin->set_labels(new CBinaryLabels(lab));
+	plugin->train(feats);
+
+	CBinaryLabels* out=plugin->apply_binary(feats);
+	int32_t correct=0;
+	for (index_t i=0; i<num; i++)
+	{
+		EXPECT_NEAR(out->get_value(i), plugin->apply_one(i), 1e-10);
+		if (out->get_label(i)==lab[i])
+			correct++;
+	}
+	EXPECT_GT(correct, num*3/4);
+
+	SG_UNREF(out);
+	SG_UNREF(plugin);
+}
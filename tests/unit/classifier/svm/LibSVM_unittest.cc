@@ -0,0 +1,121 @@
+#include <shogun/classifier/svm/LibSVM.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static void generate_data(SGMatrix<float64_t>& data, SGVector<float64_t>& labels)
+{
+	for (index_t i=0; i<data.num_cols; i++)
+	{
+		labels[i]=i%2 ? 1.0 : -1.0;
+		for (index_t j=0; j<data.num_rows; j++)
+			data(j,i)=CMath::randn_double()+0.8*labels[i];
+	}
+}
+
+TEST(LibSVM,warm_start_changed_training_set)
+{
+	CMath::init_random(17);
+	index_t num_vectors=200;
+	SGMatrix<float64_t> data(2, num_vectors);
+	SGVector<float64_t> labels(num_vectors);
+	generate_data(data, labels);
+
+	/* first training set drops the last 20 examples, the second one drops
+	 * the first 10 and adds those 20 in front */
+	SGVector<index_t> first_idx(180);
+	first_idx.range_fill();
+	SGVector<index_t> second_idx(190);
+	SGVector<index_t> previous_index(190);
+	for (index_t i=0; i<20; i++)
+	{
+		second_idx[i]=180+i;
+		previous_index[i]=-1;
+	}
+	for (index_t i=20; i<190; i++)
+	{
+		second_idx[i]=i-10;
+		previous_index[i]=i-10;
+	}
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+	SG_REF(features);
+	CFeatures* first_feats=features->copy_subset(first_idx);
+	CFeatures* second_feats=features->copy_subset(second_idx);
+	CBinaryLabels* first_labels=new CBinaryLabels(
+			SGVector<float64_t>(labels.vector, 180, false).clone());
+	SGVector<float64_t> second_lab(190);
+	for (index_t i=0; i<190; i++)
+		second_lab[i]=labels[second_idx[i]];
+	CBinaryLabels* second_labels=new CBinaryLabels(second_lab);
+
+	CLibSVM* cold=new CLibSVM(1.0, new CGaussianKernel(10, 2.0), second_labels);
+	cold->set_epsilon(1e-8);
+	cold->train(second_feats);
+
+	CLibSVM* warm=new CLibSVM(1.0, new CGaussianKernel(10, 2.0), first_labels);
+	warm->set_epsilon(1e-8);
+	warm->train(first_feats);
+	EXPECT_FALSE(warm->get_warm_start());
+
+	warm->set_labels(second_labels);
+	warm->set_warm_start(previous_index);
+	EXPECT_TRUE(warm->get_warm_start());
+	for (index_t i=0; i<warm->get_num_support_vectors(); i++)
+		EXPECT_LT(warm->get_support_vector(i), 190);
+	warm->train(second_feats);
+	EXPECT_FALSE(warm->get_warm_start());
+
+	EXPECT_NEAR(cold->get_objective(), warm->get_objective(), 1e-5);
+	EXPECT_NEAR(cold->get_bias(), warm->get_bias(), 1e-3);
+
+	CBinaryLabels* cold_out=cold->apply_binary(features);
+	CBinaryLabels* warm_out=warm->apply_binary(features);
+	for (index_t i=0; i<num_vectors; i++)
+		EXPECT_NEAR(cold_out->get_value(i), warm_out->get_value(i), 1e-3);
+
+	SG_UNREF(cold_out);
+	SG_UNREF(warm_out);
+	SG_UNREF(cold);
+	SG_UNREF(warm);
+	SG_UNREF(first_feats);
+	SG_UNREF(second_feats);
+	SG_UNREF(features);
+}
+
+TEST(LibSVM,warm_start_changed_C)
+{
+	CMath::init_random(17);
+	index_t num_vectors=100;
+	SGMatrix<float64_t> data(2, num_vectors);
+	SGVector<float64_t> labels(num_vectors);
+	generate_data(data, labels);
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+	SG_REF(features);
+	CBinaryLabels* lab=new CBinaryLabels(labels);
+
+	CLibSVM* cold=new CLibSVM(0.5, new CGaussianKernel(10, 2.0), lab);
+	cold->set_C(0.5, 2.0);
+	cold->set_epsilon(1e-8);
+	cold->train(features);
+
+	/* the solution for the larger C violates the new box constraints and,
+	 * once clipped to the unequal costs, the equality constraint too */
+	CLibSVM* warm=new CLibSVM(10.0, new CGaussianKernel(10, 2.0), lab);
+	warm->set_epsilon(1e-8);
+	warm->train(features);
+	warm->set_C(0.5, 2.0);
+	warm->set_warm_start();
+	warm->train(features);
+
+	EXPECT_NEAR(cold->get_objective(), warm->get_objective(), 1e-5);
+	EXPECT_NEAR(cold->get_bias(), warm->get_bias(), 1e-3);
+
+	SG_UNREF(cold);
+	SG_UNREF(warm);
+	SG_UNREF(features);
+}
@@ -0,0 +1,143 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ */
+
+#include <shogun/classifier/vw/cache/VwChunkedCacheWriter.h>
+#include <shogun/classifier/vw/cache/VwChunkedCacheReader.h>
+#include <unistd.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static void fill_example(VwExample* ex, int32_t i)
+{
+	ex->reset_members();
+	ex->ld->label = i % 2 ? 1 : -1;
+	ex->ld->weight = 1;
+	ex->ld->initial = 0;
+	ex->indices.push(i % 3);
+	for (int32_t j=0; j<=i%5; j++)
+	{
+		VwFeature f = {j == 0 ? 1.f : 0.5f*(j+i), (uint32_t) (7*j+i)};
+		ex->atomics[i%3].push(f);
+	}
+}
+
+static void write_cache(char* fname, CVwEnvironment* env, int32_t num_examples,
+		int32_t chunk_size, E_COMPRESSION_TYPE ct=UNCOMPRESSED)
+{
+	CVwChunkedCacheWriter* writer=new CVwChunkedCacheWriter(fname, env,
+			ct, chunk_size);
+	VwExample* ex=new VwExample();
+	for (int32_t i=0; i<num_examples; i++)
+	{
+		fill_example(ex, i);
+		writer->cache_example(ex);
+	}
+	delete ex;
+	SG_UNREF(writer);
+}
+
+static void check_sequential_round_trip(E_COMPRESSION_TYPE ct)
+{
+	std::string tmp_name = "/tmp/VwChunkedCache_sequential.XXXXXX";
+	char* fname = mktemp(const_cast<char*>(tmp_name.c_str()));
+	CVwEnvironment* env=new CVwEnvironment();
+	SG_REF(env);
+
+	int32_t num_examples=23;
+	write_cache(fname, env, num_examples, 5, ct);
+
+	CVwChunkedCacheReader* reader=new CVwChunkedCacheReader(fname, env);
+	EXPECT_EQ(ct, reader->get_compression_type());
+	EXPECT_EQ(5, reader->get_num_chunks());
+	EXPECT_EQ(num_examples, reader->get_num_examples());
+	EXPECT_EQ(3, reader->get_chunk_num_examples(4));
+
+	VwExample* ex=new VwExample();
+	VwExample* expected=new VwExample();
+	for (int32_t pass=0; pass<2; pass++)
+	{
+		int32_t i=0;
+		ex->reset_members();
+		while (reader->read_cached_example(ex))
+		{
+			fill_example(expected, i);
+			EXPECT_EQ(expected->ld->label, ex->ld->label);
+			ASSERT_EQ(1, ex->indices.index());
+			vw_size_t ns=ex->indices[0];
+			EXPECT_EQ(expected->indices[0], ns);
+			ASSERT_EQ(expected->atomics[ns].index(), ex->atomics[ns].index());
+			for (uint32_t j=0; j<ex->atomics[ns].index(); j++)
+			{
+				EXPECT_EQ(expected->atomics[ns][j].x, ex->atomics[ns][j].x);
+				EXPECT_EQ(expected->atomics[ns][j].weight_index & env->mask,
+						ex->atomics[ns][j].weight_index);
+			}
+			ex->reset_members();
+			i++;
+		}
+		EXPECT_EQ(num_examples, i);
+		reader->reset();
+	}
+
+	delete ex;
+	delete expected;
+	SG_UNREF(reader);
+	SG_UNREF(env);
+	unlink(fname);
+}
+
+TEST(VwChunkedCacheTest, write_read_sequential)
+{
+	check_sequential_round_trip(UNCOMPRESSED);
+}
+
+#ifdef USE_GZIP
+TEST(VwChunkedCacheTest, write_read_gzip)
+{
+	check_sequential_round_trip(GZIP);
+}
+#endif
+
+#ifdef USE_LZMA
+TEST(VwChunkedCacheTest, write_read_lzma)
+{
+	check_sequential_round_trip(LZMA);
+}
+#endif
+
+TEST(VwChunkedCacheTest, partitioned_readers)
+{
+	std::string tmp_name = "/tmp/VwChunkedCache_partitioned.XXXXXX";
+	char* fname = mktemp(const_cast<char*>(tmp_name.c_str()));
+	CVwEnvironment* env=new CVwEnvironment();
+	SG_REF(env);
+
+	int32_t num_examples=40;
+	write_cache(fname, env, num_examples, 4);
+
+	int32_t num_parts=3;
+	int32_t total=0;
+	VwExample* ex=new VwExample();
+	for (int32_t part=0; part<num_parts; part++)
+	{
+		CVwChunkedCacheReader* reader=new CVwChunkedCacheReader(fname, env);
+		reader->set_partition(part, num_parts);
+		reader->shuffle_chunks();
+		while (reader->read_cached_example(ex))
+		{
+			ex->reset_members();
+			total++;
+		}
+		SG_UNREF(reader);
+	}
+	EXPECT_EQ(num_examples, total);
+
+	delete ex;
+	SG_UNREF(env);
+	unlink(fname);
+}
@@ -0,0 +1,108 @@
+#include <shogun/lib/config.h>
+
+#ifdef HAVE_LAPACK
+
+#include <shogun/clustering/GMM.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static CDenseFeatures<float64_t>* generate_clusters(int32_t num_per_cluster)
+{
+	float64_t centers[3][2]={{-5, 0}, {5, 1}, {0, 8}};
+	SGMatrix<float64_t> data(2, 3*num_per_cluster);
+	for (index_t i=0; i<data.num_cols; i++)
+	{
+		data(0,i)=centers[i%3][0]+CMath::randn_double();
+		data(1,i)=centers[i%3][1]+0.5*CMath::randn_double();
+	}
+
+	return new CDenseFeatures<float64_t>(data);
+}
+
+static float64_t pointwise_log_likelihood(CGMM* gmm, CDenseFeatures<float64_t>* feats)
+{
+	float64_t result=0;
+	int32_t num_comp=gmm->get_num_components();
+	for (index_t i=0; i<feats->get_num_vectors(); i++)
+		result+=gmm->cluster(feats->get_feature_vector(i))[num_comp];
+
+	return result;
+}
+
+TEST(GMM,train_em_threads)
+{
+	CMath::init_random(7);
+	CDenseFeatures<float64_t>* feats=generate_clusters(700);
+	SG_REF(feats);
+
+	ECovType cov_types[3]={FULL, DIAG, SPHERICAL};
+	for (int32_t t=0; t<3; t++)
+	{
+		CGMM* serial=new CGMM(3, cov_types[t]);
+		serial->parallel->set_num_threads(1);
+		serial->train(feats);
+		CMath::init_random(11);
+		float64_t serial_likelihood=serial->train_em(1e-9, 100, 1e-9);
+
+		CGMM* threaded=new CGMM(3, cov_types[t]);
+		threaded->parallel->set_num_threads(4);
+		threaded->train(feats);
+		CMath::init_random(11);
+		float64_t threaded_likelihood=threaded->train_em(1e-9, 100, 1e-9);
+
+		EXPECT_NEAR(serial_likelihood, threaded_likelihood, 1e-6);
+		EXPECT_NEAR(threaded_likelihood, pointwise_log_likelihood(threaded, feats), 1e-6);
+
+		SGVector<float64_t> serial_coef=serial->get_coef();
+		SGVector<float64_t> threaded_coef=threaded->get_coef();
+		for (index_t i=0; i<3; i++)
+		{
+			EXPECT_NEAR(serial_coef[i], threaded_coef[i], 1e-8);
+			EXPECT_NEAR(threaded_coef[i], 1.0/3, 1e-2);
+
+			SGVector<float64_t> serial_mean=serial->get_nth_mean(i);
+			SGVector<float64_t> threaded_mean=threaded->get_nth_mean(i);
+			for (index_t j=0; j<2; j++)
+				EXPECT_NEAR(serial_mean[j], threaded_mean[j], 1e-8);
+		}
+
+		SG_UNREF(serial);
+		SG_UNREF(threaded);
+	}
+
+	SG_UNREF(feats);
+}
+
+TEST(GMM,train_smem)
+{
+	CMath::init_random(7);
+	CDenseFeatures<float64_t>* feats=generate_clusters(300);
+	SG_REF(feats);
+
+	CGMM* em=new CGMM(4, FULL);
+	em->train(feats);
+	CMath::init_random(5);
+	float64_t em_likelihood=em->train_em(1e-9, 100, 1e-9);
+
+	CGMM* smem=new CGMM(4, FULL);
+	smem->train(feats);
+	CMath::init_random(5);
+	float64_t smem_likelihood=smem->train_smem(10, 5, 1e-9, 100, 1e-9);
+
+	EXPECT_GE(smem_likelihood, em_likelihood-1e-6);
+
+	float64_t coef_sum=0;
+	for (index_t i=0; i<4; i++)
+		coef_sum+=smem->get_coef()[i];
+	EXPECT_NEAR(coef_sum, 1, 1e-10);
+
+	SG_UNREF(em);
+	SG_UNREF(smem);
+	SG_UNREF(feats);
+}
+
+#endif
@@ -7,6 +7,7 @@
 #include <shogun/lib/DelimiterTokenizer.h>
 #include <shogun/lib/NGramTokenizer.h>
 #include <gtest/gtest.h>
+#include <string>
 
 using namespace shogun;
 
@@ -164,3 +165,57 @@ TEST(HashedDocConverterTest, apply_quadratic_test)
 	SG_FREE(hashes);
 	SG_UNREF(converter);
 }
+
+TEST(HashedDocConverterTest, apply_parallel)
+{
+	CMath::init_random(3);
+	const char* words[] = {"rock", "and", "roll", "old", "too", "young", "hope", "steam"};
+	index_t num_docs = 200;
+
+	SGStringList<char> list(num_docs, 200);
+	for (index_t i=0; i<num_docs; i++)
+	{
+		std::string doc;
+		for (index_t j=0; j<1+i%30; j++)
+		{
+			doc += words[CMath::random(0, 7)];
+			doc += j%3 ? " " : ",";
+		}
+
+		list.strings[i] = SGString<char>(doc.size());
+		memcpy(list.strings[i].string, doc.c_str(), doc.size());
+	}
+
+	CDelimiterTokenizer* tokenizer = new CDelimiterTokenizer();
+	tokenizer->delimiters[' '] = 1;
+	tokenizer->delimiters[','] = 1;
+
+	CStringFeatures<char>* s_feats = new CStringFeatures<char>(list, RAWBYTE);
+	SG_REF(s_feats);
+	CHashedDocConverter* converter = new CHashedDocConverter(tokenizer, 8, true, 2, 1);
+	converter->parallel->set_num_threads(4);
+
+	CSparseFeatures<float64_t>* h_feats = (CSparseFeatures<float64_t>*) converter->apply(s_feats);
+	EXPECT_EQ(num_docs, h_feats->get_num_vectors());
+	EXPECT_EQ(256, h_feats->get_num_features());
+
+	for (index_t i=0; i<num_docs; i++)
+	{
+		SGSparseVector<float64_t> expected = converter->apply(
+				SGVector<char>(list.strings[i].string, list.strings[i].slen, false));
+		SGSparseVector<float64_t> vec = h_feats->get_sparse_feature_vector(i);
+
+		ASSERT_EQ(expected.num_feat_entries, vec.num_feat_entries);
+		for (index_t j=0; j<vec.num_feat_entries; j++)
+		{
+			EXPECT_EQ(expected.features[j].feat_index, vec.features[j].feat_index);
+			EXPECT_EQ(expected.features[j].entry, vec.features[j].entry);
+		}
+
+		h_feats->free_sparse_feature_vector(i);
+	}
+
+	SG_UNREF(h_feats);
+	SG_UNREF(converter);
+	SG_UNREF(s_feats);
+}
@@ -138,6 +138,60 @@ TEST(IsomapTest,neighbors_preserving)
 	SG_UNREF(low_dimensional_dist);
 }
 
+/* Embeds points of a line in 3d into 1d and checks that the pairwise
+ * distances, which are geodesic distances as well, are preserved.
+ */
+void check_line_embedding(bool landmark)
+{
+	const index_t n_samples = 50;
+	CMath::init_random(17);
+	SGVector<float64_t> positions(n_samples);
+	SGMatrix<float64_t> matrix(3, n_samples);
+	for (index_t i=0; i<n_samples; i++)
+	{
+		positions[i] = CMath::random(0.0, 10.0);
+		matrix(0,i) = positions[i]/3;
+		matrix(1,i) = 2*positions[i]/3;
+		matrix(2,i) = 2*positions[i]/3;
+	}
+
+	CDenseFeatures<float64_t>* features = new CDenseFeatures<float64_t>(matrix);
+	CDistance* distance = new CEuclideanDistance(features, features);
+
+	CIsomap* isomap = new CIsomap();
+	isomap->set_k(5);
+	isomap->set_target_dim(1);
+	isomap->set_landmark(landmark);
+	isomap->set_landmark_number(10);
+	CDenseFeatures<float64_t>* embedding = isomap->embed_distance(distance);
+	SGMatrix<float64_t> embedded = embedding->get_feature_matrix();
+	ASSERT_EQ(embedded.num_rows, 1);
+	ASSERT_EQ(embedded.num_cols, n_samples);
+
+	for (index_t i=0; i<n_samples; i++)
+	{
+		for (index_t j=0; j<n_samples; j++)
+		{
+			EXPECT_NEAR(CMath::abs(embedded(0,i)-embedded(0,j)),
+					CMath::abs(positions[i]-positions[j]), 1e-6);
+		}
+	}
+
+	SG_UNREF(embedding);
+	SG_UNREF(isomap);
+	SG_UNREF(distance);
+}
+
+TEST(IsomapTest,line_distances)
+{
+	check_line_embedding(false);
+}
+
+TEST(IsomapTest,landmark_line_distances)
+{
+	check_line_embedding(true);
+}
+
 std::set<index_t> get_neighbors_indices(CDistance* distance_object, index_t feature_vector_index, index_t n_neighbors)
 {
 	index_t n_vectors = distance_object->get_num_vec_lhs();
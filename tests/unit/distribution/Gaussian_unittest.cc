@@ -0,0 +1,115 @@
+#include <shogun/lib/config.h>
+
+#ifdef HAVE_LAPACK
+
+#include <shogun/distributions/Gaussian.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static void check_batch_log_pdf(ECovType cov_type)
+{
+	int32_t dim=5;
+	int32_t num_points=600;
+
+	SGVector<float64_t> mean(dim);
+	SGMatrix<float64_t> cov(dim, dim);
+	SGMatrix<float64_t> a(dim, dim);
+	for (index_t i=0; i<dim; i++)
+	{
+		mean[i]=CMath::randn_double();
+		for (index_t j=0; j<dim; j++)
+			a(i,j)=CMath::randn_double();
+	}
+
+	/* a*a'+I is positive definite */
+	for (index_t i=0; i<dim; i++)
+	{
+		for (index_t j=0; j<dim; j++)
+		{
+			cov(i,j)=i==j ? 1 : 0;
+			for (index_t k=0; k<dim; k++)
+				cov(i,j)+=a(i,k)*a(j,k);
+		}
+	}
+
+	CGaussian* gauss=new CGaussian(mean, cov, cov_type);
+	SG_REF(gauss);
+
+	SGMatrix<float64_t> points(dim, num_points);
+	for (index_t i=0; i<dim*num_points; i++)
+		points.matrix[i]=2*CMath::randn_double();
+
+	SGVector<float64_t> batch=gauss->compute_log_PDF(points);
+	ASSERT_EQ(batch.vlen, num_points);
+
+	for (index_t i=0; i<num_points; i++)
+	{
+		SGVector<float64_t> p(points.get_column_vector(i), dim, false);
+		EXPECT_NEAR(batch[i], gauss->compute_log_PDF(p), 1e-9);
+	}
+
+	SG_UNREF(gauss);
+}
+
+TEST(Gaussian,compute_log_PDF_batch_full)
+{
+	CMath::init_random(3);
+	check_batch_log_pdf(FULL);
+}
+
+TEST(Gaussian,compute_log_PDF_batch_diag)
+{
+	CMath::init_random(3);
+	check_batch_log_pdf(DIAG);
+}
+
+TEST(Gaussian,compute_log_PDF_batch_spherical)
+{
+	CMath::init_random(3);
+	check_batch_log_pdf(SPHERICAL);
+}
+
+TEST(Gaussian,get_log_likelihood_batch)
+{
+	CMath::init_random(3);
+	SGVector<float64_t> mean(3);
+	SGMatrix<float64_t> cov(3, 3);
+	cov.zero();
+	for (index_t i=0; i<3; i++)
+	{
+		mean[i]=i;
+		cov(i,i)=i+1;
+	}
+	cov(0,1)=cov(1,0)=0.5;
+
+	SGMatrix<float64_t> data(3, 700);
+	for (index_t i=0; i<data.num_rows*data.num_cols; i++)
+		data.matrix[i]=CMath::randn_double();
+
+	CGaussian* gauss=new CGaussian(mean, cov);
+	SG_REF(gauss);
+	gauss->parallel->set_num_threads(3);
+	gauss->set_features(new CDenseFeatures<float64_t>(data));
+
+	SGVector<float64_t> all=gauss->get_log_likelihood();
+	ASSERT_EQ(all.vlen, 700);
+	for (index_t i=0; i<all.vlen; i++)
+		EXPECT_NEAR(all[i], gauss->get_log_likelihood_example(i), 1e-10);
+
+	SGVector<index_t> idx(3);
+	idx[0]=699;
+	idx[1]=0;
+	idx[2]=350;
+	SGVector<float64_t> batch(3);
+	gauss->get_log_likelihood(idx, batch);
+	for (index_t i=0; i<idx.vlen; i++)
+		EXPECT_NEAR(batch[i], all[idx[i]], 1e-10);
+
+	SG_UNREF(gauss);
+}
+
+#endif
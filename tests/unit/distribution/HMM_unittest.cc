@@ -0,0 +1,101 @@
+#include <shogun/distributions/HMM.h>
+#include <shogun/distributions/Histogram.h>
+#include <shogun/distributions/LinearHMM.h>
+#include <shogun/features/StringFeatures.h>
+#include <shogun/lib/SGStringList.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static CStringFeatures<uint16_t>* random_observations(int32_t num, int32_t len)
+{
+	SGStringList<char> strings(num, len);
+	const char* dna="ACGT";
+	for (index_t i=0; i<num; i++)
+	{
+		strings.strings[i]=SGString<char>(len);
+		for (index_t j=0; j<len; j++)
+			strings.strings[i].string[j]=dna[CMath::random(0, 3)];
+	}
+
+	CStringFeatures<char>* chars=new CStringFeatures<char>(strings, DNA);
+	CStringFeatures<uint16_t>* obs=new CStringFeatures<uint16_t>(DNA);
+	obs->obtain_from_char(chars, 0, 1, 0, false);
+	SG_UNREF(chars);
+
+	return obs;
+}
+
+TEST(HMM,get_log_likelihood_batch)
+{
+	CMath::init_random(17);
+	CStringFeatures<uint16_t>* obs=random_observations(300, 40);
+	SG_REF(obs);
+
+	CHMM* hmm=new CHMM(obs, 3, 4, 1e-5);
+	SG_REF(hmm);
+	hmm->parallel->set_num_threads(4);
+	hmm->baum_welch_viterbi_train(BW_NORMAL);
+
+	SGVector<index_t> idx(50);
+	for (index_t i=0; i<idx.vlen; i++)
+		idx[i]=(7*i)%300;
+
+	SGVector<float64_t> batch(idx.vlen);
+	hmm->get_log_likelihood(idx, batch);
+	for (index_t i=0; i<idx.vlen; i++)
+		EXPECT_NEAR(batch[i], hmm->get_log_likelihood_example(idx[i]), 1e-10);
+
+	SGVector<float64_t> all=hmm->get_log_likelihood();
+	ASSERT_EQ(all.vlen, 300);
+	float64_t sum=0;
+	for (index_t i=0; i<all.vlen; i++)
+	{
+		EXPECT_NEAR(all[i], hmm->model_probability(i), 1e-10);
+		sum+=all[i];
+	}
+	EXPECT_NEAR(hmm->get_log_likelihood_sample(), sum/300, 1e-10);
+
+	SG_UNREF(hmm);
+	SG_UNREF(obs);
+}
+
+TEST(Histogram,get_log_likelihood_batch)
+{
+	CMath::init_random(17);
+	CStringFeatures<uint16_t>* obs=random_observations(200, 30);
+
+	CHistogram* hist=new CHistogram(obs);
+	SG_REF(hist);
+	hist->train();
+
+	SGVector<float64_t> all=hist->get_log_likelihood();
+	ASSERT_EQ(all.vlen, 200);
+	for (index_t i=0; i<all.vlen; i++)
+		EXPECT_NEAR(all[i], hist->get_log_likelihood_example(i), 1e-10);
+
+	SG_UNREF(hist);
+}
+
+TEST(LinearHMM,get_log_likelihood_batch)
+{
+	CMath::init_random(17);
+	CStringFeatures<uint16_t>* obs=random_observations(200, 30);
+
+	CLinearHMM* lhmm=new CLinearHMM(obs);
+	SG_REF(lhmm);
+	lhmm->train();
+
+	SGVector<index_t> idx(20);
+	for (index_t i=0; i<idx.vlen; i++)
+		idx[i]=199-3*i;
+
+	SGVector<float64_t> batch(idx.vlen);
+	lhmm->get_log_likelihood(idx, batch);
+	for (index_t i=0; i<idx.vlen; i++)
+		EXPECT_NEAR(batch[i], lhmm->get_log_likelihood_example(idx[i]), 1e-10);
+
+	SG_UNREF(lhmm);
+}
@@ -11,6 +11,8 @@
 #include <shogun/base/init.h>
 #include <shogun/labels/BinaryLabels.h>
 #include <shogun/evaluation/ROCEvaluation.h>
+#include <shogun/evaluation/StreamingROCEvaluation.h>
+#include <shogun/mathematics/Math.h>
 #include <gtest/gtest.h>
 
 using namespace shogun;
@@ -34,3 +36,67 @@ TEST(ROCEvaluation,one)
 	SG_UNREF(roc);
 	SG_UNREF(gt);
 }
+
+TEST(ROCEvaluation,binned_and_streaming)
+{
+	index_t num_labels=20000;
+	SGVector<float64_t> scores(num_labels);
+	SGVector<float64_t> truth(num_labels);
+	CMath::init_random(17);
+	for (index_t i=0; i<num_labels; i++)
+	{
+		truth[i]=i%3==0 ? 1 : -1;
+		scores[i]=CMath::random(-1.0, 1.0)+0.5*truth[i];
+	}
+
+	/* auROC is the probability that a positive is ranked above a negative */
+	SGVector<float64_t> sorted=scores.clone();
+	SGVector<index_t> idx(num_labels);
+	idx.range_fill();
+	CMath::qsort_index(sorted.vector, idx.vector, num_labels);
+	float64_t num_pos=0;
+	float64_t num_neg=0;
+	float64_t num_ordered=0;
+	for (index_t i=0; i<num_labels; i++)
+	{
+		if (truth[idx[i]]>0)
+		{
+			num_ordered+=num_neg;
+			num_pos++;
+		}
+		else
+			num_neg++;
+	}
+	float64_t expected=num_ordered/(num_pos*num_neg);
+
+	CBinaryLabels* pred=new CBinaryLabels(scores);
+	CBinaryLabels* gt=new CBinaryLabels(truth);
+
+	CROCEvaluation* roc=new CROCEvaluation();
+	EXPECT_NEAR(roc->evaluate(pred, gt), expected, 1E-10);
+
+	roc->set_num_bins(1000);
+	EXPECT_NEAR(roc->evaluate(pred, gt), expected, 1E-3);
+
+	/* same result when the predictions arrive in batches */
+	CStreamingROCEvaluation* streaming=new CStreamingROCEvaluation(1000, -2, 2);
+	index_t batch_size=num_labels/4;
+	for (index_t b=0; b<4; b++)
+	{
+		SGVector<float64_t> batch_scores(batch_size);
+		SGVector<float64_t> batch_truth(batch_size);
+		for (index_t i=0; i<batch_size; i++)
+		{
+			batch_scores[i]=scores[b*batch_size+i];
+			batch_truth[i]=truth[b*batch_size+i];
+		}
+		streaming->update(batch_scores, batch_truth);
+	}
+	EXPECT_EQ(streaming->get_num_examples(), num_labels);
+	EXPECT_NEAR(streaming->get_auROC(), expected, 1E-3);
+
+	SG_UNREF(streaming);
+	SG_UNREF(roc);
+	SG_UNREF(gt);
+	SG_UNREF(pred);
+}
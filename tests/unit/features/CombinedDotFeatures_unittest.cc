@@ -108,6 +108,42 @@ TEST(CombinedDotFeaturesTest, dot_products)
 	SG_UNREF(comb_feat_2);
 }
 
+TEST(CombinedDotFeaturesTest, dense_dot_range_multi)
+{
+	SGMatrix<float64_t> data_1(3,4);
+	SGMatrix<float64_t> data_2(2,4);
+	for (index_t i=0; i<12; i++)
+		data_1[i] = i;
+	for (index_t i=0; i<8; i++)
+		data_2[i] = -i;
+
+	CCombinedDotFeatures* comb_feat = new CCombinedDotFeatures();
+	comb_feat->append_feature_obj(new CDenseFeatures<float64_t>(data_1));
+	comb_feat->append_feature_obj(new CDenseFeatures<float64_t>(data_2));
+
+	SGMatrix<float64_t> W(5,2);
+	for (index_t i=0; i<10; i++)
+		W[i] = 0.5*i-2;
+	float64_t b[2] = {1, -3};
+
+	SGVector<float64_t> expected(4);
+	comb_feat->dense_dot_range(expected.vector, 0, 4, NULL, W.matrix, 5, b[0]);
+
+	/* a single vector goes through dense_dot_range */
+	SGVector<float64_t> single(4);
+	comb_feat->dense_dot_range_multi(single.vector, 0, 4, W.matrix, 5, 1, b);
+	SGMatrix<float64_t> multi(4,2);
+	comb_feat->dense_dot_range_multi(multi.matrix, 0, 4, W.matrix, 5, 2, b);
+	for (index_t i=0; i<4; i++)
+	{
+		EXPECT_EQ(expected[i], single[i]);
+		EXPECT_NEAR(expected[i], multi(i,0), 1e-12);
+		EXPECT_NEAR(comb_feat->dense_dot(i, W.matrix+5, 5)+b[1], multi(i,1), 1e-12);
+	}
+
+	SG_UNREF(comb_feat);
+}
+
 TEST(CombinedDotFeaturesTest, nnz_features)
 {
 	SGMatrix<float64_t> data_1(3,2);
@@ -55,3 +55,106 @@ TEST(DenseFeaturesTest,create_merged_copy)
 	SG_UNREF(features_1);
 	SG_UNREF(features_2);
 }
+
+TEST(DenseFeaturesTest,dense_dot_range_multi)
+{
+	index_t dim=7;
+	index_t n=301;
+	index_t num_w=3;
+
+	SGMatrix<float64_t> data(dim,n);
+	for (index_t i=0; i<dim*n; ++i)
+		data.matrix[i]=CMath::randn_double();
+
+	SGMatrix<float64_t> W(dim,num_w);
+	for (index_t i=0; i<dim*num_w; ++i)
+		W.matrix[i]=CMath::randn_double();
+
+	SGVector<float64_t> b(num_w);
+	for (index_t k=0; k<num_w; ++k)
+		b[k]=k-1.0;
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+
+	/* once on the full matrix, once through a subset */
+	SGVector<index_t> subset(n/2);
+	for (index_t i=0; i<subset.vlen; ++i)
+		subset[i]=(7*i)%n;
+
+	for (index_t pass=0; pass<2; ++pass)
+	{
+		if (pass==1)
+			features->add_subset(subset);
+
+		index_t num=features->get_num_vectors();
+		SGMatrix<float64_t> out(num-1,num_w);
+		features->dense_dot_range_multi(out.matrix, 1, num, W.matrix, dim,
+				num_w, b.vector);
+
+		for (index_t k=0; k<num_w; ++k)
+		{
+			for (index_t i=1; i<num; ++i)
+			{
+				float64_t expected=features->dense_dot(i, W.get_column_vector(k),
+						dim)+b[k];
+				EXPECT_NEAR(expected, out(i-1,k), 1E-10);
+			}
+		}
+	}
+
+	SG_UNREF(features);
+}
+
+TEST(DenseFeaturesTest, materialize_subset)
+{
+	index_t dim=3;
+	index_t n=10;
+	SGMatrix<float64_t> data(dim,n);
+	for (index_t i=0; i<dim*n; ++i)
+		data.matrix[i]=i;
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+	SG_REF(features);
+
+	/* no subset, no copy */
+	CFeatures* materialized=features->materialize_subset();
+	EXPECT_EQ(features, materialized);
+	SG_UNREF(materialized);
+
+	SGVector<index_t> subset(4);
+	subset[0]=7;
+	subset[1]=2;
+	subset[2]=9;
+	subset[3]=2;
+	features->add_subset(subset);
+	EXPECT_EQ(features->get_subset_copy_size(),
+			(int64_t) (dim*subset.vlen*sizeof(float64_t)));
+
+	/* small subsets are copied in auto mode */
+	CDenseFeatures<float64_t>* copy=(CDenseFeatures<float64_t>*)
+			features->materialize_subset();
+	EXPECT_NE(features, copy);
+	EXPECT_FALSE(copy->get_subset_stack()->has_subsets());
+	EXPECT_EQ(copy->get_num_vectors(), subset.vlen);
+	for (index_t i=0; i<subset.vlen; ++i)
+	{
+		SGVector<float64_t> expected=features->get_feature_vector(i);
+		SGVector<float64_t> actual=copy->get_feature_vector(i);
+		for (index_t j=0; j<dim; ++j)
+			EXPECT_EQ(expected[j], actual[j]);
+	}
+	SG_UNREF(copy);
+
+	/* too large or disabled */
+	features->set_subset_materialization(SM_AUTO, 8);
+	materialized=features->materialize_subset();
+	EXPECT_EQ(features, materialized);
+	SG_UNREF(materialized);
+
+	features->set_subset_materialization(SM_NEVER);
+	materialized=features->materialize_subset();
+	EXPECT_EQ(features, materialized);
+	SG_UNREF(materialized);
+
+	SG_UNREF(features);
+}
@@ -10,6 +10,7 @@ namespace shogun {
 			MOCK_CONST_METHOD0(get_feature_class, EFeatureClass());
 			MOCK_CONST_METHOD0(get_num_vectors, int32_t());
 
+			MOCK_METHOD0(shared_clone, CSGObject*());
 			virtual const char* get_name() const { return "MockCFeatures"; }
 	};
 
@@ -392,3 +392,42 @@ TEST(SparseFeaturesTest,subset_get_full_feature_vector_smaller)
 
 	SG_UNREF(features);
 }
+
+TEST(SparseFeaturesTest,dense_dot_range_multi)
+{
+	index_t dim=10;
+	index_t n=40;
+	index_t num_w=4;
+
+	SGMatrix<float64_t> data(dim, n);
+	for (index_t i=0; i<dim*n; ++i)
+		data.matrix[i]=i%3==0 ? CMath::randn_double() : 0;
+
+	SGMatrix<float64_t> W(dim, num_w);
+	for (index_t i=0; i<dim*num_w; ++i)
+		W.matrix[i]=CMath::randn_double();
+
+	SGVector<float64_t> b(num_w);
+	b.range_fill();
+
+	CSparseFeatures<float64_t>* features=new CSparseFeatures<float64_t>(data);
+
+	for (index_t nw=1; nw<=num_w; nw+=num_w-1)
+	{
+		SGMatrix<float64_t> out(n, nw);
+		features->dense_dot_range_multi(out.matrix, 0, n, W.matrix, dim, nw,
+				b.vector);
+
+		for (index_t k=0; k<nw; ++k)
+		{
+			for (index_t i=0; i<n; ++i)
+			{
+				float64_t expected=features->dense_dot(i, W.get_column_vector(k),
+						dim)+b[k];
+				EXPECT_NEAR(expected, out(i,k), 1E-10);
+			}
+		}
+	}
+
+	SG_UNREF(features);
+}
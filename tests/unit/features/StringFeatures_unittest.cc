@@ -11,8 +11,12 @@
 #include <shogun/lib/memory.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/features/Subset.h>
+#include <shogun/features/StringFeatures.h>
 #include <shogun/lib/SGStringList.h>
+#include <shogun/io/SerializableAsciiFile.h>
 #include <gtest/gtest.h>
+#include <stdio.h>
+#include <unistd.h>
 
 using namespace shogun;
 
@@ -108,3 +112,286 @@ TEST(StringFeaturesTest,copy_subset)
 	SG_UNREF(f);
 	SG_UNREF(subset_copy);
 }
+
+static SGStringList<char> random_dna(index_t num_strings, index_t max_len)
+{
+	const char* acgt="ACGT";
+	SGStringList<char> list(num_strings, max_len);
+	for (index_t i=0; i<num_strings; i++)
+	{
+		list.strings[i]=SGString<char>(CMath::random(1, max_len));
+		for (index_t j=0; j<list.strings[i].slen; j++)
+			list.strings[i].string[j]=acgt[CMath::random(0, 3)];
+	}
+
+	return list;
+}
+
+static void expect_same_strings(CStringFeatures<char>* a, CStringFeatures<char>* b)
+{
+	ASSERT_EQ(a->get_num_vectors(), b->get_num_vectors());
+
+	for (index_t i=0; i<a->get_num_vectors(); i++)
+	{
+		SGVector<char> va=a->get_feature_vector(i);
+		SGVector<char> vb=b->get_feature_vector(i);
+
+		ASSERT_EQ(va.vlen, vb.vlen);
+		EXPECT_EQ(va.vlen, b->get_vector_length(i));
+		for (index_t j=0; j<va.vlen; j++)
+			EXPECT_EQ(va[j], vb[j]);
+	}
+}
+
+TEST(StringFeaturesTest,pack_unpack)
+{
+	/* the features take over the strings */
+	CMath::init_random(3);
+	CStringFeatures<char>* f=new CStringFeatures<char>(random_dna(50, 100), DNA);
+	CMath::init_random(3);
+	CStringFeatures<char>* packed=new CStringFeatures<char>(random_dna(50, 100), DNA);
+	packed->pack();
+	EXPECT_TRUE(packed->is_packed());
+	expect_same_strings(f, packed);
+
+	for (index_t i=0; i<f->get_num_vectors(); i++)
+	{
+		int64_t offset;
+		int32_t len;
+		uint64_t* p=packed->get_packed_string(i, offset, len);
+		SGVector<char> v=f->get_feature_vector(i);
+		ASSERT_EQ(v.vlen, len);
+
+		for (index_t j=0; j<len; j++)
+		{
+			CAlphabet* alpha=f->get_alphabet();
+			EXPECT_EQ(alpha->remap_to_bin(v[j]),
+					CStringFeatures<char>::get_packed_symbol(p, offset+j));
+			SG_UNREF(alpha);
+		}
+
+		uint64_t word=CStringFeatures<char>::get_packed_word(p, offset);
+		for (index_t j=0; j<CMath::min(len, 32); j++)
+		{
+			EXPECT_EQ(CStringFeatures<char>::get_packed_symbol(p, offset+j),
+					(word>>(2*j)) & 3);
+		}
+	}
+
+	/* copies of packed strings are packed as well */
+	SGVector<index_t> idx(20);
+	for (index_t i=0; i<idx.vlen; i++)
+		idx[i]=(7*i)%f->get_num_vectors();
+	CStringFeatures<char>* copy=(CStringFeatures<char>*) f->copy_subset(idx);
+	CStringFeatures<char>* packed_copy=(CStringFeatures<char>*)
+		packed->copy_subset(idx);
+	EXPECT_TRUE(packed_copy->is_packed());
+	expect_same_strings(copy, packed_copy);
+	EXPECT_GT(packed->get_subset_copy_size(), 0);
+
+	/* modifying strings unpacks them */
+	SGVector<char> first=f->get_feature_vector(0);
+	packed->set_feature_vector(first, 1);
+	f->set_feature_vector(first, 1);
+	EXPECT_FALSE(packed->is_packed());
+	expect_same_strings(f, packed);
+
+	SG_UNREF(copy);
+	SG_UNREF(packed_copy);
+	SG_UNREF(packed);
+	SG_UNREF(f);
+}
+
+TEST(StringFeaturesTest,load_fasta_file_packed)
+{
+	CMath::init_random(5);
+	SGStringList<char> list=random_dna(30, 200);
+	const char* fname="StringFeaturesTest_load_fasta_file_packed.fa";
+
+	/* sequences span lines of 60 symbols */
+	FILE* f=fopen(fname, "w");
+	for (index_t i=0; i<list.num_strings; i++)
+	{
+		fprintf(f, ">seq%d some description\n", i);
+		for (index_t j=0; j<list.strings[i].slen; j+=60)
+		{
+			fprintf(f, "%.*s\n", CMath::min(60, list.strings[i].slen-j),
+					&list.strings[i].string[j]);
+		}
+	}
+	fclose(f);
+
+	CStringFeatures<char>* expected=new CStringFeatures<char>(list, DNA);
+	CStringFeatures<char>* unpacked=new CStringFeatures<char>(DNA);
+	CStringFeatures<char>* packed=new CStringFeatures<char>(DNA);
+	EXPECT_TRUE(unpacked->load_fasta_file(fname));
+	EXPECT_TRUE(packed->load_fasta_file(fname, false, true));
+
+	EXPECT_FALSE(unpacked->is_packed());
+	EXPECT_TRUE(packed->is_packed());
+	EXPECT_EQ(unpacked->get_max_vector_length(), packed->get_max_vector_length());
+	expect_same_strings(expected, unpacked);
+	expect_same_strings(expected, packed);
+
+	CAlphabet* alpha=packed->get_alphabet();
+	EXPECT_EQ(alpha->get_num_symbols_in_histogram(), 4);
+	SG_UNREF(alpha);
+
+	SG_UNREF(expected);
+	SG_UNREF(unpacked);
+	SG_UNREF(packed);
+
+	ASSERT_EQ(0, unlink(fname));
+}
+
+TEST(StringFeaturesTest,load_fastq_file_packed)
+{
+	CMath::init_random(9);
+	SGStringList<char> list=random_dna(40, 150);
+	const char* fname="StringFeaturesTest_load_fastq_file_packed.fq";
+
+	/* the last read contains an N */
+	list.strings[list.num_strings-1].string[0]='N';
+
+	FILE* f=fopen(fname, "w");
+	for (index_t i=0; i<list.num_strings; i++)
+	{
+		fprintf(f, "@read%d\n%.*s\n+\n", i, list.strings[i].slen,
+				list.strings[i].string);
+		for (index_t j=0; j<list.strings[i].slen; j++)
+			fprintf(f, "I");
+		fprintf(f, "\n");
+	}
+	fclose(f);
+
+	CStringFeatures<char>* unpacked=new CStringFeatures<char>(DNA);
+	CStringFeatures<char>* packed=new CStringFeatures<char>(DNA);
+	EXPECT_TRUE(unpacked->load_fastq_file(fname, true));
+	EXPECT_TRUE(packed->load_fastq_file(fname, true, false, true));
+
+	list.strings[list.num_strings-1].string[0]='A';
+	CStringFeatures<char>* expected=new CStringFeatures<char>(list, DNA);
+
+	EXPECT_TRUE(packed->is_packed());
+	EXPECT_EQ(unpacked->get_max_vector_length(), packed->get_max_vector_length());
+	expect_same_strings(expected, unpacked);
+	expect_same_strings(expected, packed);
+
+	SG_UNREF(expected);
+	SG_UNREF(unpacked);
+	SG_UNREF(packed);
+
+	ASSERT_EQ(0, unlink(fname));
+}
+
+TEST(StringFeaturesTest,move_to_arena)
+{
+	CMath::init_random(11);
+	CStringFeatures<char>* f=new CStringFeatures<char>(random_dna(40, 60), DNA);
+	CMath::init_random(11);
+	CStringFeatures<char>* arena=new CStringFeatures<char>(random_dna(40, 60), DNA);
+
+	EXPECT_FALSE(arena->has_arena());
+	arena->move_to_arena();
+	EXPECT_TRUE(arena->has_arena());
+	expect_same_strings(f, arena);
+
+	/* strings in the arena are views, replacing one must not free it */
+	SGVector<char> first=f->get_feature_vector(0);
+	f->set_feature_vector(first, 3);
+	arena->set_feature_vector(first, 3);
+	expect_same_strings(f, arena);
+
+	/* copies are stored in an arena of their own */
+	SGVector<index_t> idx(10);
+	idx.range_fill(5);
+	CStringFeatures<char>* copy=(CStringFeatures<char>*) f->copy_subset(idx);
+	CStringFeatures<char>* arena_copy=(CStringFeatures<char>*)
+		arena->copy_subset(idx);
+	EXPECT_TRUE(arena_copy->has_arena());
+	expect_same_strings(copy, arena_copy);
+
+	/* transforms work on the strings in place */
+	CStringFeatures<uint16_t>* words=new CStringFeatures<uint16_t>(DNA);
+	words->obtain_from_char(f, 0, 1, 0, false);
+	CStringFeatures<uint16_t>* arena_words=new CStringFeatures<uint16_t>(DNA);
+	arena_words->obtain_from_char(arena, 0, 1, 0, false);
+	EXPECT_TRUE(arena_words->has_arena());
+	for (index_t i=0; i<f->get_num_vectors(); i++)
+	{
+		SGVector<uint16_t> v=words->get_feature_vector(i);
+		SGVector<uint16_t> w=arena_words->get_feature_vector(i);
+		ASSERT_EQ(v.vlen, w.vlen);
+		for (index_t j=0; j<v.vlen; j++)
+			EXPECT_EQ(v[j], w[j]);
+	}
+
+	SG_UNREF(words);
+	SG_UNREF(arena_words);
+	SG_UNREF(copy);
+	SG_UNREF(arena_copy);
+	SG_UNREF(arena);
+	SG_UNREF(f);
+}
+
+TEST(StringFeaturesTest,serialize_arena)
+{
+	CMath::init_random(13);
+	CStringFeatures<char>* f=new CStringFeatures<char>(random_dna(20, 50), DNA);
+	f->move_to_arena();
+	const char* fname="StringFeaturesTest_serialize_arena.txt";
+
+	CSerializableAsciiFile* outfile=new CSerializableAsciiFile(fname, 'w');
+	EXPECT_TRUE(f->save_serializable(outfile));
+	SG_UNREF(outfile);
+	EXPECT_TRUE(f->has_arena());
+
+	/* loading replaces the strings of the arena one by one */
+	CMath::init_random(14);
+	CStringFeatures<char>* loaded=new CStringFeatures<char>(random_dna(30, 40), DNA);
+	loaded->move_to_arena();
+	CSerializableAsciiFile* infile=new CSerializableAsciiFile(fname, 'r');
+	EXPECT_TRUE(loaded->load_serializable(infile));
+	SG_UNREF(infile);
+	EXPECT_FALSE(loaded->has_arena());
+	expect_same_strings(f, loaded);
+
+	SG_UNREF(loaded);
+	SG_UNREF(f);
+
+	ASSERT_EQ(0, unlink(fname));
+}
+
+/* empty strings first, in between and at the end */
+static SGStringList<char> strings_with_empty()
+{
+	SGStringList<char> list(5, 3);
+	index_t lengths[5]={0, 3, 0, 2, 0};
+	for (index_t i=0; i<5; i++)
+	{
+		list.strings[i]=SGString<char>(lengths[i]);
+		for (index_t j=0; j<lengths[i]; j++)
+			list.strings[i].string[j]="ACG"[j];
+	}
+	return list;
+}
+
+TEST(StringFeaturesTest,arena_empty_strings)
+{
+	CStringFeatures<char>* f=new CStringFeatures<char>(strings_with_empty(), DNA);
+	CStringFeatures<char>* arena=new CStringFeatures<char>(strings_with_empty(), DNA);
+	arena->move_to_arena();
+	expect_same_strings(f, arena);
+
+	/* a string set after the arena was created is freed on its own */
+	SGVector<char> str(4);
+	str.set_const('T');
+	f->set_feature_vector(str, 4);
+	arena->set_feature_vector(str, 4);
+	expect_same_strings(f, arena);
+	arena->cleanup_feature_vector(4);
+	EXPECT_EQ(arena->get_vector_length(4), 0);
+
+	SG_UNREF(arena);
+	SG_UNREF(f);
+}
@@ -0,0 +1,143 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society
+ */
+
+#include <shogun/lib/config.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/NystromKernel.h>
+#include <shogun/kernel/RandomFourierKernel.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/regression/KernelRidgeRegression.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static CDenseFeatures<float64_t>* generate_data(index_t dim, index_t num)
+{
+	SGMatrix<float64_t> data(dim, num);
+	for (index_t i=0; i<dim*num; i++)
+		data.matrix[i]=CMath::randn_double();
+
+	return new CDenseFeatures<float64_t>(data);
+}
+
+TEST(ApproximateKernel, random_fourier_features)
+{
+	CMath::init_random(17);
+	index_t num=50;
+	CDenseFeatures<float64_t>* feats=generate_data(3, num);
+	SG_REF(feats);
+
+	CGaussianKernel* gauss=new CGaussianKernel(10, 4.0);
+	CRandomFourierKernel* approx=new CRandomFourierKernel(gauss, 20000);
+	SG_REF(approx);
+
+	approx->init(feats, feats);
+	gauss->init(feats, feats);
+	EXPECT_TRUE(approx->is_fitted());
+
+	SGMatrix<float64_t> exact=gauss->get_kernel_matrix();
+	SGMatrix<float64_t> approximated=approx->get_kernel_matrix();
+	for (index_t i=0; i<num*num; i++)
+		EXPECT_NEAR(exact.matrix[i], approximated.matrix[i], 0.05);
+
+	CDenseFeatures<float64_t>* mapped=approx->apply_feature_map(feats);
+	EXPECT_EQ(mapped->get_num_features(), 20000);
+	EXPECT_NEAR(mapped->dot(0, mapped, 1), approximated(0, 1), 1e-10);
+	SG_UNREF(mapped);
+
+	SG_UNREF(approx);
+	SG_UNREF(feats);
+}
+
+#ifdef HAVE_EIGEN3
+TEST(ApproximateKernel, nystrom_all_landmarks_is_exact)
+{
+	CMath::init_random(17);
+	index_t num=30;
+	CDenseFeatures<float64_t>* feats=generate_data(2, num);
+	CDenseFeatures<float64_t>* test=generate_data(2, 10);
+	SG_REF(feats);
+	SG_REF(test);
+
+	CGaussianKernel* gauss=new CGaussianKernel(10, 2.0);
+	SG_REF(gauss);
+
+	for (index_t s=0; s<2; s++)
+	{
+		CNystromKernel* approx=new CNystromKernel(gauss, num,
+				s==0 ? LS_UNIFORM : LS_FARTHEST_POINT);
+		SG_REF(approx);
+
+		approx->init(feats, test);
+		EXPECT_EQ(approx->get_landmark_indices().vlen, num);
+
+		gauss->init(feats, test);
+		SGMatrix<float64_t> exact=gauss->get_kernel_matrix();
+		SGMatrix<float64_t> approximated=approx->get_kernel_matrix();
+		for (index_t i=0; i<exact.num_rows*exact.num_cols; i++)
+			EXPECT_NEAR(exact.matrix[i], approximated.matrix[i], 1e-4);
+
+		SG_UNREF(approx);
+	}
+
+	SG_UNREF(gauss);
+	SG_UNREF(test);
+	SG_UNREF(feats);
+}
+
+#ifdef HAVE_LAPACK
+TEST(ApproximateKernel, kernel_ridge_regression)
+{
+	CMath::init_random(17);
+	index_t num=40;
+	CDenseFeatures<float64_t>* feats=generate_data(2, num);
+	CDenseFeatures<float64_t>* test=generate_data(2, 15);
+	SG_REF(feats);
+	SG_REF(test);
+
+	SGVector<float64_t> y(num);
+	for (index_t i=0; i<num; i++)
+		y[i]=CMath::sin(feats->get_feature_matrix()(0, i));
+	CRegressionLabels* labels=new CRegressionLabels(y);
+	SG_REF(labels);
+
+	CGaussianKernel* gauss=new CGaussianKernel(10, 2.0);
+	CKernelRidgeRegression* exact=new CKernelRidgeRegression(0.1, gauss,
+			labels);
+	SG_REF(exact);
+	exact->train(feats);
+	CRegressionLabels* exact_out=exact->apply_regression(test);
+
+	CNystromKernel* approx=new CNystromKernel(gauss, num);
+	CKernelRidgeRegression* krr=new CKernelRidgeRegression(0.1, approx,
+			labels);
+	SG_REF(krr);
+	krr->train(feats);
+	CRegressionLabels* out=krr->apply_regression(test);
+
+	for (index_t i=0; i<test->get_num_vectors(); i++)
+		EXPECT_NEAR(exact_out->get_label(i), out->get_label(i), 1e-4);
+
+	SGVector<float64_t> alpha_exact=exact->get_alphas();
+	SGVector<float64_t> alpha=krr->get_alphas();
+	for (index_t i=0; i<num; i++)
+		EXPECT_NEAR(alpha_exact[i], alpha[i], 1e-4);
+
+	SG_UNREF(out);
+	SG_UNREF(exact_out);
+	SG_UNREF(krr);
+	SG_UNREF(exact);
+	SG_UNREF(labels);
+	SG_UNREF(test);
+	SG_UNREF(feats);
+}
+#endif // HAVE_LAPACK
+#endif // HAVE_EIGEN3
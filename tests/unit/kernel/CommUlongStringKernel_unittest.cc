@@ -66,3 +66,43 @@ TEST(CommUlongStringKernel, kernel_matrix)
 	SG_UNREF(alphabet);
 	SG_UNREF(h_feats);
 }
+
+TEST(CommUlongStringKernel, kernel_row)
+{
+	CMath::init_random(5);
+	const char* acgt="ACGT";
+	index_t num_strings=25;
+
+	SGStringList<char> list(num_strings, 60);
+	for (index_t i=0; i<num_strings; i++)
+	{
+		list.strings[i]=SGString<char>(30+i);
+		for (index_t j=0; j<list.strings[i].slen; j++)
+			list.strings[i].string[j]=acgt[CMath::random(0, 3)];
+	}
+
+	CStringFeatures<char>* s_feats=new CStringFeatures<char>(list, DNA);
+	CStringFeatures<uint64_t>* l_feats=new CStringFeatures<uint64_t>(DNA);
+	l_feats->obtain_from_char(s_feats, 3, 4, 0, false);
+	CSortUlongString* preproc=new CSortUlongString();
+	preproc->init(l_feats);
+	l_feats->add_preprocessor(preproc);
+	l_feats->apply_preprocessor();
+
+	CCommUlongStringKernel* kernel=new CCommUlongStringKernel(l_feats, l_feats);
+	EXPECT_TRUE(kernel->has_property(KP_ROWEVALUATION));
+
+	SGVector<float64_t> row=kernel->get_kernel_row(3);
+	for (index_t j=0; j<num_strings; j++)
+		EXPECT_NEAR(kernel->kernel(3, j), row[j], 1e-12);
+
+	SGMatrix<float64_t> km=kernel->get_kernel_matrix();
+	for (index_t i=0; i<num_strings; i++)
+	{
+		for (index_t j=0; j<num_strings; j++)
+			EXPECT_NEAR(kernel->kernel(i, j), km(i, j), 1e-12);
+	}
+
+	SG_UNREF(kernel);
+	SG_UNREF(s_feats);
+}
@@ -0,0 +1,175 @@
+#include <shogun/kernel/string/CommWordStringKernel.h>
+#include <shogun/preprocessor/SortWordString.h>
+#include <shogun/features/StringFeatures.h>
+#include <shogun/lib/SGStringList.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+TEST(CommWordStringKernel,compute_batch)
+{
+	CMath::init_random(7);
+	const char* acgt="ACGT";
+	index_t num_strings=60;
+
+	SGStringList<char> list(num_strings, 40);
+	for (index_t i=0; i<num_strings; i++)
+	{
+		list.strings[i]=SGString<char>(20+i%21);
+		for (index_t j=0; j<list.strings[i].slen; j++)
+			list.strings[i].string[j]=acgt[CMath::random(0, 3)];
+	}
+
+	CStringFeatures<char>* chars=new CStringFeatures<char>(list, DNA);
+	CStringFeatures<uint16_t>* words=new CStringFeatures<uint16_t>(DNA);
+	words->obtain_from_char(chars, 2, 3, 0, false);
+	CSortWordString* preproc=new CSortWordString();
+	preproc->init(words);
+	words->add_preprocessor(preproc);
+	words->apply_preprocessor();
+
+	CCommWordStringKernel* kernel=new CCommWordStringKernel(words, words, false);
+	EXPECT_TRUE(kernel->has_property(KP_BATCHEVALUATION));
+
+	index_t num_sv=20;
+	SGVector<int32_t> sv_idx(num_sv);
+	SGVector<float64_t> alphas(num_sv);
+	for (index_t j=0; j<num_sv; j++)
+	{
+		sv_idx[j]=3*j;
+		alphas[j]=CMath::random(-1.0, 1.0);
+	}
+
+	/* the batch evaluation must neither use nor touch the normal */
+	kernel->init_optimization(1, sv_idx.vector, alphas.vector);
+	float64_t optimized=kernel->compute_optimized(5);
+
+	SGVector<int32_t> vec_idx(num_strings);
+	vec_idx.range_fill();
+	SGVector<float64_t> target(num_strings);
+	target.zero();
+	kernel->compute_batch(num_strings, vec_idx.vector, target.vector, num_sv,
+			sv_idx.vector, alphas.vector);
+
+	for (index_t i=0; i<num_strings; i++)
+	{
+		float64_t expected=0;
+		for (index_t j=0; j<num_sv; j++)
+			expected+=alphas[j]*kernel->kernel(sv_idx[j], i);
+
+		EXPECT_NEAR(expected, target[i], 1e-10);
+	}
+
+	EXPECT_TRUE(kernel->get_is_initialized());
+	EXPECT_EQ(optimized, kernel->compute_optimized(5));
+
+	SG_UNREF(kernel);
+	SG_UNREF(chars);
+}
+
+static CStringFeatures<uint16_t>* random_word_features(index_t num_strings)
+{
+	const char* acgt="ACGT";
+	SGStringList<char> list(num_strings, 40);
+	for (index_t i=0; i<num_strings; i++)
+	{
+		list.strings[i]=SGString<char>(20+i%21);
+		for (index_t j=0; j<list.strings[i].slen; j++)
+			list.strings[i].string[j]=acgt[CMath::random(0, 3)];
+	}
+
+	CStringFeatures<char>* chars=new CStringFeatures<char>(list, DNA);
+	SG_REF(chars);
+	CStringFeatures<uint16_t>* words=new CStringFeatures<uint16_t>(DNA);
+	words->obtain_from_char(chars, 2, 3, 0, false);
+	CSortWordString* preproc=new CSortWordString();
+	preproc->init(words);
+	words->add_preprocessor(preproc);
+	words->apply_preprocessor();
+	SG_UNREF(chars);
+
+	return words;
+}
+
+TEST(CommWordStringKernel,kernel_row)
+{
+	CMath::init_random(11);
+	CStringFeatures<uint16_t>* lhs=random_word_features(30);
+	CStringFeatures<uint16_t>* rhs=random_word_features(45);
+	SG_REF(lhs);
+	SG_REF(rhs);
+
+	for (index_t sign=0; sign<2; sign++)
+	{
+		CCommWordStringKernel* kernel=new CCommWordStringKernel(lhs, rhs, sign==1);
+		SG_REF(kernel);
+		EXPECT_TRUE(kernel->has_property(KP_ROWEVALUATION));
+
+		for (index_t i=0; i<30; i+=7)
+		{
+			SGVector<float64_t> row=kernel->get_kernel_row(i);
+			ASSERT_EQ(45, row.vlen);
+			for (index_t j=0; j<45; j++)
+				EXPECT_NEAR(kernel->kernel(i, j), row[j], 1e-12);
+		}
+
+		SGMatrix<float64_t> km=kernel->get_kernel_matrix();
+		ASSERT_EQ(30, km.num_rows);
+		ASSERT_EQ(45, km.num_cols);
+		for (index_t i=0; i<30; i++)
+		{
+			for (index_t j=0; j<45; j++)
+				EXPECT_NEAR(kernel->kernel(i, j), km(i, j), 1e-12);
+		}
+
+		SG_UNREF(kernel);
+	}
+
+	SG_UNREF(lhs);
+	SG_UNREF(rhs);
+}
+
+TEST(CommWordStringKernel,obtain_from_packed)
+{
+	const char* acgt="ACGT";
+	index_t num_strings=30;
+
+	SGStringList<char> list(num_strings, 80);
+	SGStringList<char> list_copy(num_strings, 80);
+	for (index_t i=0; i<num_strings; i++)
+	{
+		list.strings[i]=SGString<char>(20+2*i);
+		list_copy.strings[i]=SGString<char>(20+2*i);
+		for (index_t j=0; j<list.strings[i].slen; j++)
+		{
+			list.strings[i].string[j]=acgt[CMath::random(0, 3)];
+			list_copy.strings[i].string[j]=list.strings[i].string[j];
+		}
+	}
+
+	CStringFeatures<char>* chars=new CStringFeatures<char>(list, DNA);
+	CStringFeatures<char>* packed=new CStringFeatures<char>(list_copy, DNA);
+	packed->pack();
+
+	/* the spectrum features are computed from the packed symbols */
+	CStringFeatures<uint16_t>* words=new CStringFeatures<uint16_t>(DNA);
+	words->obtain_from_char(chars, 0, 4, 0, false);
+	CStringFeatures<uint16_t>* packed_words=new CStringFeatures<uint16_t>(DNA);
+	packed_words->obtain_from_char(packed, 0, 4, 0, false);
+	EXPECT_TRUE(packed->is_packed());
+
+	ASSERT_EQ(words->get_num_vectors(), packed_words->get_num_vectors());
+	for (index_t i=0; i<num_strings; i++)
+	{
+		SGVector<uint16_t> v=words->get_feature_vector(i);
+		SGVector<uint16_t> p=packed_words->get_feature_vector(i);
+		ASSERT_EQ(v.vlen, p.vlen);
+		for (index_t j=0; j<v.vlen; j++)
+			EXPECT_EQ(v[j], p[j]);
+	}
+
+	SG_UNREF(words);
+	SG_UNREF(packed_words);
+	SG_UNREF(chars);
+	SG_UNREF(packed);
+}
@@ -0,0 +1,95 @@
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/PolyKernel.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SparseFeatures.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static void check_compute_batch(CKernel* kernel, index_t num_lhs, index_t num_rhs)
+{
+	EXPECT_TRUE(kernel->has_property(KP_BATCHEVALUATION));
+
+	/* every third lhs vector is a support vector */
+	index_t num_sv=(num_lhs+2)/3;
+	SGVector<int32_t> sv_idx(num_sv);
+	SGVector<float64_t> alphas(num_sv);
+	for (index_t j=0; j<num_sv; j++)
+	{
+		sv_idx[j]=3*j;
+		alphas[j]=CMath::random(-1.0, 1.0);
+	}
+
+	SGVector<int32_t> vec_idx(num_rhs);
+	vec_idx.range_fill();
+	SGVector<float64_t> target(num_rhs);
+	target.set_const(1.0);
+
+	kernel->compute_batch(num_rhs, vec_idx.vector, target.vector, num_sv,
+			sv_idx.vector, alphas.vector, 0.5);
+
+	for (index_t i=0; i<num_rhs; i++)
+	{
+		float64_t expected=0;
+		for (index_t j=0; j<num_sv; j++)
+			expected+=alphas[j]*kernel->kernel(sv_idx[j], i);
+
+		EXPECT_NEAR(1.0+0.5*expected, target[i], 1e-10);
+	}
+}
+
+static CDenseFeatures<float64_t>* random_features(index_t dim, index_t num)
+{
+	SGMatrix<float64_t> data(dim, num);
+	for (index_t i=0; i<dim*num; i++)
+		data.matrix[i]=CMath::randn_double();
+
+	return new CDenseFeatures<float64_t>(data);
+}
+
+TEST(DotKernel,compute_batch_gaussian)
+{
+	CMath::init_random(3);
+	CDenseFeatures<float64_t>* lhs=random_features(7, 300);
+	CDenseFeatures<float64_t>* rhs=random_features(7, 150);
+
+	CGaussianKernel* kernel=new CGaussianKernel(lhs, rhs, 3.0);
+	check_compute_batch(kernel, 300, 150);
+
+	kernel->set_compact_enabled(true);
+	check_compute_batch(kernel, 300, 150);
+
+	SG_UNREF(kernel);
+}
+
+TEST(DotKernel,compute_batch_poly)
+{
+	CMath::init_random(3);
+	CDenseFeatures<float64_t>* lhs=random_features(5, 200);
+	CDenseFeatures<float64_t>* rhs=random_features(5, 70);
+
+	/* normalized by the default CSqrtDiagKernelNormalizer */
+	CPolyKernel* kernel=new CPolyKernel(lhs, rhs, 3, true);
+	check_compute_batch(kernel, 200, 70);
+
+	SG_UNREF(kernel);
+}
+
+TEST(DotKernel,compute_batch_sparse)
+{
+	CMath::init_random(3);
+	SGMatrix<float64_t> dense_lhs(6, 100);
+	SGMatrix<float64_t> dense_rhs(6, 80);
+	for (index_t i=0; i<6*100; i++)
+		dense_lhs.matrix[i]=i%4 ? 0 : CMath::randn_double();
+	for (index_t i=0; i<6*80; i++)
+		dense_rhs.matrix[i]=i%3 ? 0 : CMath::randn_double();
+
+	CSparseFeatures<float64_t>* lhs=new CSparseFeatures<float64_t>(dense_lhs);
+	CSparseFeatures<float64_t>* rhs=new CSparseFeatures<float64_t>(dense_rhs);
+
+	CGaussianKernel* kernel=new CGaussianKernel(lhs, rhs, 2.0);
+	check_compute_batch(kernel, 100, 80);
+
+	SG_UNREF(kernel);
+}
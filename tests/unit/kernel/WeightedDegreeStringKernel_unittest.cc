@@ -0,0 +1,50 @@
+#include <shogun/kernel/string/WeightedDegreeStringKernel.h>
+#include <shogun/features/StringFeatures.h>
+#include <shogun/lib/SGStringList.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static CStringFeatures<char>* random_dna_features(index_t num_strings,
+		index_t len)
+{
+	const char* acgt="ACGT";
+	SGStringList<char> list(num_strings, len);
+	for (index_t i=0; i<num_strings; i++)
+	{
+		list.strings[i]=SGString<char>(len);
+		for (index_t j=0; j<len; j++)
+			list.strings[i].string[j]=acgt[CMath::random(0, 3)];
+
+		/* long matching blocks */
+		if (i%2)
+			memcpy(list.strings[i].string, list.strings[i-1].string, len/2);
+	}
+
+	return new CStringFeatures<char>(list, DNA);
+}
+
+TEST(WeightedDegreeStringKernel,compute_packed)
+{
+	/* lengths around multiples of the 32 symbols per packed word */
+	for (index_t len=31; len<=97; len+=33)
+	{
+		CMath::init_random(len);
+		CStringFeatures<char>* feats=random_dna_features(20, len);
+		CMath::init_random(len);
+		CStringFeatures<char>* packed=random_dna_features(20, len);
+		packed->pack();
+
+		CWeightedDegreeStringKernel* kernel=new CWeightedDegreeStringKernel(20);
+		kernel->init(feats, feats);
+		SGMatrix<float64_t> expected=kernel->get_kernel_matrix();
+
+		kernel->init(packed, packed);
+		SGMatrix<float64_t> result=kernel->get_kernel_matrix();
+
+		for (index_t i=0; i<expected.num_rows*expected.num_cols; i++)
+			EXPECT_NEAR(expected.matrix[i], result.matrix[i], 1e-10);
+
+		SG_UNREF(kernel);
+	}
+}
@@ -10,6 +10,7 @@ namespace shogun {
 			MOCK_CONST_METHOD0(get_label_type, ELabelType());
 			MOCK_METHOD0(get_values, SGVector<float64_t>());
 
+			MOCK_METHOD0(shared_clone, CSGObject*());
 			virtual const char* get_name() const { return "MockCLabels"; }
 	};
 
@@ -1,4 +1,7 @@
 #include <shogun/lib/memory.h>
+#include <shogun/lib/MemoryPool.h>
+#include <shogun/lib/MemoryArena.h>
+#include <shogun/lib/AllocationSampler.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/lib/SGSparseVector.h>
 #include <shogun/lib/SGVector.h>
@@ -54,3 +57,127 @@ TEST(MemoryTest,SGMatrix)
 	EXPECT_NE((SGMatrix<float64_t>*) NULL, m);
 	SG_FREE(m);
 }
+
+TEST(MemoryTest,pool_reuses_blocks)
+{
+	MemoryPoolStatistics before=SGMemoryPool::get_statistics();
+
+	float64_t* a=(float64_t*) SGMemoryPool::allocate(sizeof(float64_t)*100);
+	EXPECT_TRUE(SGMemoryPool::owns(a));
+	EXPECT_EQ(1024, SGMemoryPool::get_block_size(a));
+	for (int32_t i=0; i<100; i++)
+		a[i]=i;
+	SGMemoryPool::free(a);
+
+	float64_t* b=(float64_t*) SGMemoryPool::allocate(sizeof(float64_t)*120);
+	EXPECT_EQ(a, b);
+	SGMemoryPool::free(b);
+
+	MemoryPoolStatistics after=SGMemoryPool::get_statistics();
+	EXPECT_EQ(before.num_allocs+2, after.num_allocs);
+	EXPECT_EQ(before.num_frees+2, after.num_frees);
+	EXPECT_LE(before.num_cache_hits+1, after.num_cache_hits);
+}
+
+TEST(MemoryTest,pool_large_and_foreign_blocks)
+{
+	void* large=SGMemoryPool::allocate(1<<20);
+	EXPECT_FALSE(SGMemoryPool::owns(large));
+	SGMemoryPool::free(large);
+
+	void* p=malloc(64);
+	EXPECT_FALSE(SGMemoryPool::owns(p));
+	SGMemoryPool::free(p);
+}
+
+TEST(MemoryTest,pool_reallocate)
+{
+	int32_t* a=(int32_t*) SGMemoryPool::allocate(sizeof(int32_t)*10);
+	for (int32_t i=0; i<10; i++)
+		a[i]=i;
+
+	a=(int32_t*) SGMemoryPool::reallocate(a, sizeof(int32_t)*5000);
+	for (int32_t i=0; i<10; i++)
+		EXPECT_EQ(i, a[i]);
+
+	a=(int32_t*) SGMemoryPool::reallocate(a, sizeof(int32_t)*100000);
+	EXPECT_FALSE(SGMemoryPool::owns(a));
+	for (int32_t i=0; i<10; i++)
+		EXPECT_EQ(i, a[i]);
+
+	SGMemoryPool::free(a);
+}
+
+TEST(MemoryTest,pool_threads)
+{
+	#pragma omp parallel for
+	for (int32_t t=0; t<8; t++)
+	{
+		for (int32_t i=0; i<1000; i++)
+		{
+			uint8_t* p=(uint8_t*) SGMemoryPool::allocate_zeroed(i+1, 1);
+			for (int32_t j=0; j<=i; j++)
+				EXPECT_EQ(0, p[j]);
+			memset(p, 1, i+1);
+			SGMemoryPool::free(p);
+		}
+	}
+	SGMemoryPool::flush_thread_cache();
+}
+
+TEST(MemoryTest,arena_scope)
+{
+	SGArena arena(1024);
+	float64_t* a=arena.allocate<float64_t>(10);
+	EXPECT_EQ(0, ((uintptr_t) a) % 16);
+	size_t used=arena.get_used();
+
+	for (int32_t i=0; i<3; i++)
+	{
+		SGArenaScope scope(&arena);
+		int32_t* b=arena.allocate<int32_t>(100);
+		float64_t* c=arena.allocate<float64_t>(1000);
+		EXPECT_NE((void*) a, (void*) b);
+		EXPECT_NE((void*) b, (void*) c);
+		EXPECT_LT(used, arena.get_used());
+	}
+	EXPECT_EQ(used, arena.get_used());
+
+	// blocks are kept for the next iteration
+	size_t capacity=arena.get_capacity();
+	{
+		SGArenaScope scope(&arena);
+		arena.allocate<int32_t>(100);
+		arena.allocate<float64_t>(1000);
+	}
+	EXPECT_EQ(capacity, arena.get_capacity());
+
+	arena.reset();
+	EXPECT_EQ(0, arena.get_used());
+}
+
+TEST(MemoryTest,allocation_sampler)
+{
+	SGAllocationSampler::enable(1024);
+	EXPECT_TRUE(SGAllocationSampler::is_enabled());
+
+	// every allocation of at least 1.5 times the interval is sampled
+	float64_t* buffers[10];
+	for (int32_t i=0; i<10; i++)
+		buffers[i]=SG_MALLOC(float64_t, 1000);
+
+	EXPECT_EQ(10, SGAllocationSampler::get_num_samples());
+	EXPECT_EQ(10*1000*sizeof(float64_t), SGAllocationSampler::get_estimated_bytes());
+
+	for (int32_t i=0; i<5; i++)
+		SG_FREE(buffers[i]);
+
+	EXPECT_EQ(5, SGAllocationSampler::get_num_samples());
+	EXPECT_EQ(5*1000*sizeof(float64_t), SGAllocationSampler::get_estimated_bytes());
+
+	SGAllocationSampler::disable();
+	EXPECT_EQ(0, SGAllocationSampler::get_num_samples());
+
+	for (int32_t i=5; i<10; i++)
+		SG_FREE(buffers[i]);
+}
@@ -0,0 +1,156 @@
+#include <shogun/machine/DecisionTree.h>
+#include <shogun/machine/BaggingMachine.h>
+#include <shogun/ensemble/MajorityVote.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/base/Parallel.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static void generate_blobs(SGMatrix<float64_t>& data, SGVector<float64_t>& labels,
+		int32_t num_classes)
+{
+	for (index_t i=0; i<data.num_cols; i++)
+	{
+		labels[i]=i%num_classes;
+		for (index_t j=0; j<data.num_rows; j++)
+			data(j,i)=0.3*CMath::randn_double()+(j==labels[i] ? 3 : 0);
+	}
+}
+
+TEST(DecisionTree,regression_step)
+{
+	SGMatrix<float64_t> data(1, 100);
+	SGVector<float64_t> labels(100);
+	for (index_t i=0; i<100; i++)
+	{
+		data(0,i)=i;
+		labels[i]=i<50 ? 1 : 3;
+	}
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+	SG_REF(features);
+	CDecisionTree* tree=new CDecisionTree();
+	tree->set_labels(new CRegressionLabels(labels));
+	tree->train(features);
+
+	EXPECT_EQ(tree->get_machine_problem_type(), PT_REGRESSION);
+	EXPECT_EQ(tree->get_num_nodes(), 3);
+
+	CRegressionLabels* output=tree->apply_regression(features);
+	for (index_t i=0; i<100; i++)
+		EXPECT_NEAR(output->get_label(i), labels[i], 1e-12);
+
+	SG_UNREF(output);
+	SG_UNREF(tree);
+	SG_UNREF(features);
+}
+
+TEST(DecisionTree,binary_xor)
+{
+	CMath::init_random(17);
+	SGMatrix<float64_t> data(2, 200);
+	SGVector<float64_t> labels(200);
+	for (index_t i=0; i<200; i++)
+	{
+		data(0,i)=CMath::random(-1.0, 1.0);
+		data(1,i)=CMath::random(-1.0, 1.0);
+		labels[i]=data(0,i)*data(1,i)>0 ? 1 : -1;
+	}
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+	SG_REF(features);
+	CDecisionTree* tree=new CDecisionTree();
+	tree->set_labels(new CBinaryLabels(labels));
+	tree->train(features);
+
+	CBinaryLabels* output=(CBinaryLabels*) tree->apply(features);
+	for (index_t i=0; i<200; i++)
+		EXPECT_EQ(output->get_label(i), labels[i]);
+
+	/* the tree does not depend on the number of threads */
+	CDecisionTree* serial=new CDecisionTree();
+	serial->parallel->set_num_threads(1);
+	serial->set_labels(new CBinaryLabels(labels));
+	serial->train(features);
+	tree->parallel->set_num_threads(4);
+	CBinaryLabels* serial_output=serial->apply_binary(features);
+	CBinaryLabels* parallel_output=tree->apply_binary(features);
+	EXPECT_EQ(serial->get_num_nodes(), tree->get_num_nodes());
+	for (index_t i=0; i<200; i++)
+		EXPECT_EQ(serial_output->get_value(i), parallel_output->get_value(i));
+
+	SG_UNREF(output);
+	SG_UNREF(serial_output);
+	SG_UNREF(parallel_output);
+	SG_UNREF(serial);
+	SG_UNREF(tree);
+	SG_UNREF(features);
+}
+
+TEST(DecisionTree,multiclass)
+{
+	CMath::init_random(17);
+	SGMatrix<float64_t> data(3, 150);
+	SGVector<float64_t> labels(150);
+	generate_blobs(data, labels, 3);
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+	SG_REF(features);
+	CDecisionTree* tree=new CDecisionTree(2);
+	tree->set_labels(new CMulticlassLabels(labels));
+	tree->train(features);
+
+	CMulticlassLabels* output=tree->apply_multiclass(features);
+	for (index_t i=0; i<150; i++)
+	{
+		EXPECT_EQ(output->get_label(i), labels[i]);
+		SGVector<float64_t> conf=output->get_multiclass_confidences(i);
+		EXPECT_EQ(conf.vlen, 3);
+		EXPECT_NEAR(SGVector<float64_t>::sum(conf), 1, 1e-12);
+	}
+
+	SG_UNREF(output);
+	SG_UNREF(tree);
+	SG_UNREF(features);
+}
+
+TEST(DecisionTree,random_forest)
+{
+	CMath::init_random(17);
+	SGMatrix<float64_t> train_data(4, 200);
+	SGVector<float64_t> train_labels(200);
+	generate_blobs(train_data, train_labels, 4);
+	SGMatrix<float64_t> test_data(4, 100);
+	SGVector<float64_t> test_labels(100);
+	generate_blobs(test_data, test_labels, 4);
+
+	CDenseFeatures<float64_t>* train_features=
+		new CDenseFeatures<float64_t>(train_data);
+	CDenseFeatures<float64_t>* test_features=
+		new CDenseFeatures<float64_t>(test_data);
+	SG_REF(test_features);
+
+	CDecisionTree* tree=new CDecisionTree();
+	tree->set_num_random_features(2);
+	CBaggingMachine* forest=new CBaggingMachine(train_features,
+			new CMulticlassLabels(train_labels));
+	forest->set_machine(tree);
+	forest->set_bag_size(150);
+	forest->set_num_bags(10);
+	forest->set_combination_rule(new CMajorityVote());
+	forest->train();
+
+	CMulticlassLabels* output=forest->apply_multiclass(test_features);
+	int32_t correct=0;
+	for (index_t i=0; i<100; i++)
+		correct+=output->get_label(i)==test_labels[i];
+	EXPECT_GE(correct, 95);
+
+	SG_UNREF(output);
+	SG_UNREF(forest);
+	SG_UNREF(test_features);
+}
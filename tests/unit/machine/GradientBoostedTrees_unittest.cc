@@ -0,0 +1,101 @@
+#include <shogun/machine/GradientBoostedTrees.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+TEST(GradientBoostedTrees,regression)
+{
+	CMath::init_random(17);
+	SGMatrix<float64_t> data(2, 300);
+	SGVector<float64_t> labels(300);
+	for (index_t i=0; i<300; i++)
+	{
+		data(0,i)=CMath::random(-3.0, 3.0);
+		data(1,i)=CMath::random(-3.0, 3.0);
+		labels[i]=CMath::sin(data(0,i))+0.5*data(1,i);
+	}
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+	SG_REF(features);
+	CGradientBoostedTrees* gbt=new CGradientBoostedTrees(200, 0.1, 3);
+	gbt->set_labels(new CRegressionLabels(labels));
+	gbt->train(features);
+
+	EXPECT_EQ(gbt->get_machine_problem_type(), PT_REGRESSION);
+	EXPECT_EQ(gbt->get_num_trees(), 200);
+
+	CRegressionLabels* output=(CRegressionLabels*) gbt->apply(features);
+	float64_t mse=0;
+	for (index_t i=0; i<300; i++)
+		mse+=CMath::sq(output->get_label(i)-labels[i])/300;
+	EXPECT_LT(mse, 0.01);
+
+	SG_UNREF(output);
+	SG_UNREF(gbt);
+	SG_UNREF(features);
+}
+
+TEST(GradientBoostedTrees,binary_xor)
+{
+	CMath::init_random(17);
+	SGMatrix<float64_t> data(2, 200);
+	SGVector<float64_t> labels(200);
+	for (index_t i=0; i<200; i++)
+	{
+		data(0,i)=CMath::random(-1.0, 1.0);
+		data(1,i)=CMath::random(-1.0, 1.0);
+		labels[i]=data(0,i)*data(1,i)>0 ? 1 : -1;
+	}
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+	SG_REF(features);
+	CGradientBoostedTrees* gbt=new CGradientBoostedTrees(50, 0.3, 2);
+	gbt->set_labels(new CBinaryLabels(labels));
+	gbt->train(features);
+
+	CBinaryLabels* output=gbt->apply_binary(features);
+	for (index_t i=0; i<200; i++)
+		EXPECT_EQ(output->get_label(i), labels[i]);
+
+	SG_UNREF(output);
+	SG_UNREF(gbt);
+	SG_UNREF(features);
+}
+
+TEST(GradientBoostedTrees,multiclass)
+{
+	CMath::init_random(17);
+	SGMatrix<float64_t> data(3, 150);
+	SGVector<float64_t> labels(150);
+	for (index_t i=0; i<150; i++)
+	{
+		labels[i]=i%3;
+		for (index_t j=0; j<3; j++)
+			data(j,i)=0.3*CMath::randn_double()+(j==labels[i] ? 3 : 0);
+	}
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+	SG_REF(features);
+	CGradientBoostedTrees* gbt=new CGradientBoostedTrees(20, 0.3, 2);
+	gbt->set_labels(new CMulticlassLabels(labels));
+	gbt->train(features);
+
+	EXPECT_EQ(gbt->get_num_trees(), 60);
+
+	CMulticlassLabels* output=gbt->apply_multiclass(features);
+	for (index_t i=0; i<150; i++)
+	{
+		EXPECT_EQ(output->get_label(i), labels[i]);
+		SGVector<float64_t> conf=output->get_multiclass_confidences(i);
+		EXPECT_NEAR(SGVector<float64_t>::sum(conf), 1, 1e-12);
+		EXPECT_GT(conf[int32_t(labels[i])], 0.5);
+	}
+
+	SG_UNREF(output);
+	SG_UNREF(gbt);
+	SG_UNREF(features);
+}
@@ -0,0 +1,251 @@
+#include <shogun/machine/KernelMulticlassMachine.h>
+#include <shogun/multiclass/MulticlassOneVsRestStrategy.h>
+#include <shogun/multiclass/MulticlassOneVsOneStrategy.h>
+#include <shogun/classifier/svm/LibSVM.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/base/Parallel.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+TEST(KernelMulticlassMachineTest,shared_kernel_rows_apply)
+{
+	index_t num_vec=30;
+	index_t num_class=3;
+	index_t num_feat=num_class;
+
+	SGMatrix<float64_t> matrix(num_feat, num_vec);
+	SGMatrix<float64_t> matrix_test(num_feat, num_vec);
+	CMulticlassLabels* labels=new CMulticlassLabels(num_vec);
+	for (index_t i=0; i<num_vec; ++i)
+	{
+		index_t label=i%num_class;
+		for (index_t j=0; j<num_feat; ++j)
+		{
+			matrix(j, i)=CMath::randn_double();
+			matrix_test(j, i)=CMath::randn_double();
+		}
+		matrix(label, i)+=2;
+		matrix_test(label, i)+=2;
+		labels->set_label(i, label);
+	}
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(matrix);
+	SG_REF(features);
+	CDenseFeatures<float64_t>* features_test=new CDenseFeatures<float64_t>(
+			matrix_test);
+	CGaussianKernel* kernel=new CGaussianKernel(features, features, 2.0);
+	CLibSVM* svm=new CLibSVM();
+
+	CKernelMulticlassMachine* machine=new CKernelMulticlassMachine(
+			new CMulticlassOneVsRestStrategy(), kernel, svm, labels);
+	machine->train(features);
+
+	CMulticlassLabels* pred=machine->apply_multiclass(features_test);
+	ASSERT_EQ(num_class, machine->get_num_machines());
+
+	/* shared kernel rows must give the outputs of the single machines */
+	for (index_t m=0; m<machine->get_num_machines(); ++m)
+	{
+		CBinaryLabels* outputs=machine->get_submachine_outputs(m);
+		for (index_t i=0; i<num_vec; ++i)
+		{
+			EXPECT_NEAR(outputs->get_value(i),
+					pred->get_multiclass_confidences(i)[m], 1E-10);
+		}
+		SG_UNREF(outputs);
+	}
+
+	SG_UNREF(pred);
+	SG_UNREF(machine);
+	SG_UNREF(features);
+}
+
+TEST(KernelMulticlassMachineTest,parallel_training)
+{
+	index_t num_vec=40;
+	index_t num_class=4;
+	index_t num_feat=num_class;
+
+	SGMatrix<float64_t> matrix(num_feat, num_vec);
+	CMulticlassLabels* labels=new CMulticlassLabels(num_vec);
+	for (index_t i=0; i<num_vec; ++i)
+	{
+		index_t label=i%num_class;
+		for (index_t j=0; j<num_feat; ++j)
+			matrix(j, i)=CMath::randn_double();
+
+		matrix(label, i)+=2;
+		labels->set_label(i, label);
+	}
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(matrix);
+	SG_REF(features);
+
+	CLibSVM* svm=new CLibSVM();
+	svm->set_epsilon(1e-8);
+	CKernelMulticlassMachine* sequential=new CKernelMulticlassMachine(
+			new CMulticlassOneVsRestStrategy(),
+			new CGaussianKernel(features, features, 2.0), svm, labels);
+	sequential->train(features);
+
+	svm=new CLibSVM();
+	svm->set_epsilon(1e-8);
+	CGaussianKernel* kernel=new CGaussianKernel(features, features, 2.0);
+	CKernelMulticlassMachine* parallel=new CKernelMulticlassMachine(
+			new CMulticlassOneVsRestStrategy(), kernel, svm, labels);
+	parallel->set_parallel_training(true);
+
+	int32_t num_threads=parallel->parallel->get_num_threads();
+	parallel->parallel->set_num_threads(3);
+	parallel->train(features);
+	parallel->parallel->set_num_threads(num_threads);
+
+	/* submachines are stored in strategy order and use the original kernel */
+	ASSERT_EQ(sequential->get_num_machines(), parallel->get_num_machines());
+	for (index_t m=0; m<parallel->get_num_machines(); ++m)
+	{
+		CKernelMachine* s=(CKernelMachine*) sequential->get_machine(m);
+		CKernelMachine* p=(CKernelMachine*) parallel->get_machine(m);
+		CKernel* k=p->get_kernel();
+		EXPECT_EQ(kernel, k);
+		EXPECT_NEAR(s->get_bias(), p->get_bias(), 1E-4);
+
+		SG_UNREF(k);
+		SG_UNREF(s);
+		SG_UNREF(p);
+	}
+
+	CMulticlassLabels* pred_s=sequential->apply_multiclass(features);
+	CMulticlassLabels* pred_p=parallel->apply_multiclass(features);
+	for (index_t i=0; i<num_vec; ++i)
+	{
+		EXPECT_EQ(pred_s->get_label(i), pred_p->get_label(i));
+		for (index_t m=0; m<num_class; ++m)
+		{
+			EXPECT_NEAR(pred_s->get_multiclass_confidences(i)[m],
+					pred_p->get_multiclass_confidences(i)[m], 1E-4);
+		}
+	}
+
+	SG_UNREF(pred_s);
+	SG_UNREF(pred_p);
+	SG_UNREF(sequential);
+	SG_UNREF(parallel);
+	SG_UNREF(features);
+}
+
+TEST(KernelMulticlassMachineTest,parallel_training_one_vs_one)
+{
+	index_t num_vec=60;
+	index_t num_class=4;
+	index_t num_feat=num_class;
+
+	SGMatrix<float64_t> matrix(num_feat, num_vec);
+	CMulticlassLabels* labels=new CMulticlassLabels(num_vec);
+	for (index_t i=0; i<num_vec; ++i)
+	{
+		index_t label=i%num_class;
+		for (index_t j=0; j<num_feat; ++j)
+			matrix(j, i)=0.1*CMath::randn_double();
+
+		matrix(label, i)+=2;
+		labels->set_label(i, label);
+	}
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(matrix);
+	SG_REF(features);
+
+	CKernelMulticlassMachine* machine=new CKernelMulticlassMachine(
+			new CMulticlassOneVsOneStrategy(),
+			new CGaussianKernel(features, features, 2.0), new CLibSVM(), labels);
+	machine->set_parallel_training(true);
+	machine->parallel->set_num_threads(2);
+	machine->train(features);
+
+	/* every submachine is trained on the vectors of two classes, its
+	 * support vectors index into all training vectors */
+	ASSERT_EQ(num_class*(num_class-1)/2, machine->get_num_machines());
+	for (index_t m=0; m<machine->get_num_machines(); ++m)
+	{
+		CKernelMachine* sub=(CKernelMachine*) machine->get_machine(m);
+		SGVector<int32_t> svs=sub->get_support_vectors();
+		EXPECT_GT(svs.vlen, 0);
+
+		SGVector<bool> seen(num_class);
+		seen.set_const(false);
+		for (index_t i=0; i<svs.vlen; ++i)
+		{
+			ASSERT_GE(svs[i], 0);
+			ASSERT_LT(svs[i], num_vec);
+			seen[labels->get_int_label(svs[i])]=true;
+		}
+		index_t num_seen=0;
+		for (index_t c=0; c<num_class; ++c)
+			num_seen+=seen[c];
+		EXPECT_EQ(2, num_seen);
+		SG_UNREF(sub);
+	}
+
+	CMulticlassLabels* pred=machine->apply_multiclass(features);
+	for (index_t i=0; i<num_vec; ++i)
+		EXPECT_EQ(labels->get_label(i), pred->get_label(i));
+
+	SG_UNREF(pred);
+	SG_UNREF(machine);
+	SG_UNREF(features);
+}
+
+TEST(KernelMulticlassMachineTest,parallel_training_kernel_size_limit)
+{
+	index_t num_vec=40;
+	index_t num_class=4;
+	index_t num_feat=num_class;
+
+	SGMatrix<float64_t> matrix(num_feat, num_vec);
+	CMulticlassLabels* labels=new CMulticlassLabels(num_vec);
+	for (index_t i=0; i<num_vec; ++i)
+	{
+		index_t label=i%num_class;
+		for (index_t j=0; j<num_feat; ++j)
+			matrix(j, i)=CMath::randn_double();
+
+		matrix(label, i)+=2;
+		labels->set_label(i, label);
+	}
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(matrix);
+	SG_REF(features);
+
+	CKernelMulticlassMachine* sequential=new CKernelMulticlassMachine(
+			new CMulticlassOneVsRestStrategy(),
+			new CGaussianKernel(features, features, 2.0), new CLibSVM(), labels);
+	sequential->parallel->set_num_threads(1);
+	sequential->train(features);
+
+	/* the kernel matrix does not fit, so training falls back to the
+	 * sequential one in double precision */
+	CKernelMulticlassMachine* limited=new CKernelMulticlassMachine(
+			new CMulticlassOneVsRestStrategy(),
+			new CGaussianKernel(features, features, 2.0), new CLibSVM(), labels);
+	limited->set_parallel_training(true);
+	limited->set_max_shared_kernel_size(0);
+	limited->parallel->set_num_threads(2);
+	limited->train(features);
+
+	ASSERT_EQ(sequential->get_num_machines(), limited->get_num_machines());
+	for (index_t m=0; m<limited->get_num_machines(); ++m)
+	{
+		CKernelMachine* s=(CKernelMachine*) sequential->get_machine(m);
+		CKernelMachine* l=(CKernelMachine*) limited->get_machine(m);
+		EXPECT_EQ(s->get_bias(), l->get_bias());
+		SG_UNREF(s);
+		SG_UNREF(l);
+	}
+
+	SG_UNREF(sequential);
+	SG_UNREF(limited);
+	SG_UNREF(features);
+}
@@ -0,0 +1,102 @@
+#include <shogun/machine/LinearMulticlassMachine.h>
+#include <shogun/multiclass/MulticlassOneVsRestStrategy.h>
+#include <shogun/multiclass/MulticlassOneVsOneStrategy.h>
+#include <shogun/classifier/svm/LibLinear.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/base/Parallel.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static CLinearMulticlassMachine* train_machine(CMulticlassStrategy* strategy,
+		CDenseFeatures<float64_t>* features, CMulticlassLabels* labels,
+		bool parallel_training)
+{
+	CLibLinear* svm=new CLibLinear(L2R_L2LOSS_SVC);
+	svm->set_epsilon(1e-8);
+
+	CLinearMulticlassMachine* machine=new CLinearMulticlassMachine(strategy,
+			features, svm, labels);
+	machine->set_parallel_training(parallel_training);
+
+	int32_t num_threads=machine->parallel->get_num_threads();
+	machine->parallel->set_num_threads(4);
+	machine->train();
+	machine->parallel->set_num_threads(num_threads);
+
+	return machine;
+}
+
+static void check_parallel_training(CMulticlassStrategy* sequential_strategy,
+		CMulticlassStrategy* parallel_strategy)
+{
+	index_t num_vec=60;
+	index_t num_class=5;
+	index_t num_feat=num_class;
+
+	CMath::init_random(5);
+	SGMatrix<float64_t> matrix(num_feat, num_vec);
+	CMulticlassLabels* labels=new CMulticlassLabels(num_vec);
+	for (index_t i=0; i<num_vec; ++i)
+	{
+		index_t label=i%num_class;
+		for (index_t j=0; j<num_feat; ++j)
+			matrix(j, i)=CMath::randn_double();
+
+		matrix(label, i)+=2;
+		labels->set_label(i, label);
+	}
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(matrix);
+	SG_REF(features);
+
+	CLinearMulticlassMachine* sequential=train_machine(sequential_strategy,
+			features, labels, false);
+	CLinearMulticlassMachine* parallel=train_machine(parallel_strategy,
+			features, labels, true);
+
+	/* the features are not left with a subset */
+	EXPECT_EQ(num_vec, features->get_num_vectors());
+
+	ASSERT_EQ(sequential->get_num_machines(), parallel->get_num_machines());
+	for (index_t m=0; m<sequential->get_num_machines(); ++m)
+	{
+		CLinearMachine* s=(CLinearMachine*) sequential->get_machine(m);
+		CLinearMachine* p=(CLinearMachine*) parallel->get_machine(m);
+
+		SGVector<float64_t> w_s=s->get_w();
+		SGVector<float64_t> w_p=p->get_w();
+		ASSERT_EQ(w_s.vlen, w_p.vlen);
+		for (index_t i=0; i<w_s.vlen; ++i)
+			EXPECT_NEAR(w_s[i], w_p[i], 1E-10);
+
+		EXPECT_NEAR(s->get_bias(), p->get_bias(), 1E-10);
+
+		SG_UNREF(s);
+		SG_UNREF(p);
+	}
+
+	CMulticlassLabels* pred_s=sequential->apply_multiclass(features);
+	CMulticlassLabels* pred_p=parallel->apply_multiclass(features);
+	for (index_t i=0; i<num_vec; ++i)
+		EXPECT_EQ(pred_s->get_label(i), pred_p->get_label(i));
+
+	SG_UNREF(pred_s);
+	SG_UNREF(pred_p);
+	SG_UNREF(sequential);
+	SG_UNREF(parallel);
+	SG_UNREF(features);
+}
+
+TEST(LinearMulticlassMachineTest,parallel_training_one_vs_rest)
+{
+	check_parallel_training(new CMulticlassOneVsRestStrategy(),
+			new CMulticlassOneVsRestStrategy());
+}
+
+TEST(LinearMulticlassMachineTest,parallel_training_one_vs_one)
+{
+	check_parallel_training(new CMulticlassOneVsOneStrategy(),
+			new CMulticlassOneVsOneStrategy());
+}
@@ -76,6 +76,103 @@ TEST(CMath, parallel_qsort_index_test)
 	SG_FREE(i1);
 }
 
+TEST(CMath, radix_sort_index_test)
+{
+	CMath::radix_sort_index((float64_t *)NULL, (int32_t *)NULL, 0, 4);
+
+	const index_t n=100000;
+	SGVector<float64_t> v(n);
+	SGVector<index_t> idx(n);
+	for (index_t i=0; i<n; i++)
+	{
+		// many duplicates, both signs and zeros of both signs
+		v[i]=(i%1000)-500.0;
+		if (i%1000==500 && i%2000==500)
+			v[i]=-0.0;
+		idx[i]=i;
+	}
+	v[7]=-1e300;
+	v[8]=1e-300;
+
+	SGVector<float64_t> sorted=v.clone();
+	CMath::radix_sort_index(sorted.vector, idx.vector, n, 4);
+
+	for (index_t i=0; i<n; i++)
+		EXPECT_EQ(v[idx[i]], sorted[i]);
+	for (index_t i=1; i<n; i++)
+	{
+		EXPECT_LE(sorted[i-1], sorted[i]);
+		// stable
+		if (sorted[i-1]==sorted[i])
+		{
+			EXPECT_LT(idx[i-1], idx[i]);
+		}
+	}
+
+	int32_t iv[]={5, -3, 2147483647, 0, -2147483647-1, -3, 17};
+	int32_t ii[]={0, 1, 2, 3, 4, 5, 6};
+	CMath::radix_sort_index(iv, ii, 7);
+	int32_t expected_iv[]={-2147483647-1, -3, -3, 0, 5, 17, 2147483647};
+	int32_t expected_ii[]={4, 1, 5, 3, 0, 6, 2};
+	for (index_t i=0; i<7; i++)
+	{
+		EXPECT_EQ(expected_iv[i], iv[i]);
+		EXPECT_EQ(expected_ii[i], ii[i]);
+	}
+}
+
+TEST(CMath, parallel_merge_sort_index_test)
+{
+	const index_t n=50000;
+	SGVector<float64_t> v(n);
+	SGVector<index_t> idx(n);
+	for (index_t i=0; i<n; i++)
+	{
+		v[i]=CMath::random(-100.0, 100.0);
+		idx[i]=i;
+	}
+
+	SGVector<float64_t> sorted=v.clone();
+	CMath::parallel_merge_sort_index(sorted.vector, idx.vector, n, 4);
+
+	for (index_t i=0; i<n; i++)
+		EXPECT_EQ(v[idx[i]], sorted[i]);
+	for (index_t i=1; i<n; i++)
+		EXPECT_LE(sorted[i-1], sorted[i]);
+}
+
+TEST(CMath, select_and_partial_sort_index_test)
+{
+	const index_t n=1001;
+	SGVector<float64_t> v(n);
+	for (index_t i=0; i<n; i++)
+		v[i]=(i*7919)%n;
+
+	SGVector<float64_t> w=v.clone();
+	EXPECT_EQ(500, CMath::select(w.vector, n, 500));
+	for (index_t i=0; i<500; i++)
+		EXPECT_LE(w[i], 500);
+	for (index_t i=501; i<n; i++)
+		EXPECT_GE(w[i], 500);
+
+	w=v.clone();
+	SGVector<index_t> idx(n);
+	idx.range_fill();
+	CMath::partial_sort_index(w.vector, idx.vector, n, 10);
+	for (index_t i=0; i<10; i++)
+	{
+		EXPECT_EQ(i, w[i]);
+		EXPECT_EQ(w[i], v[idx[i]]);
+	}
+
+	// k larger than size sorts everything
+	w=v.clone();
+	idx.range_fill();
+	CMath::partial_sort_index(w.vector, idx.vector, n, n+5);
+	for (index_t i=0; i<n; i++)
+		EXPECT_EQ(i, w[i]);
+}
+
 TEST(CMath, float64_tests)
 {
 	// round, ceil, floor
@@ -6,6 +6,8 @@
 #include <shogun/lib/SGSparseMatrix.h>
 #include <shogun/lib/SGSparseVector.h>
 #include <shogun/mathematics/Statistics.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/mathematics/eigen3.h>
 #include <math.h>
 #include <gtest/gtest.h>
@@ -330,4 +332,134 @@ TEST(Statistics, lnormal_cdf)
 	EXPECT_NEAR(lphi, 0.0, 1e-6);
 }
 
+
+TEST(Statistics, matrix_mean_variance)
+{
+	index_t num_rows=1100;
+	index_t num_cols=7;
+	SGMatrix<float64_t> data(num_rows, num_cols);
+	for (index_t i=0; i<num_rows*num_cols; i++)
+		data.matrix[i]=CMath::randn_double()*(i%5+1)+i%3;
+
+	SGVector<float64_t> col_mean=CStatistics::matrix_mean(data, true);
+	SGVector<float64_t> col_var=CStatistics::matrix_variance(data, true);
+	for (index_t j=0; j<num_cols; j++)
+	{
+		SGVector<float64_t> col(data.get_column_vector(j), num_rows, false);
+		EXPECT_NEAR(col_mean[j], CStatistics::mean(col), 1e-12);
+		EXPECT_NEAR(col_var[j], CStatistics::variance(col), 1e-10);
+	}
+
+	SGVector<float64_t> row_mean=CStatistics::matrix_mean(data, false);
+	SGVector<float64_t> row_var=CStatistics::matrix_variance(data, false);
+	for (index_t i=0; i<num_rows; i++)
+	{
+		SGVector<float64_t> row(num_cols);
+		for (index_t j=0; j<num_cols; j++)
+			row[j]=data(i,j);
+
+		EXPECT_NEAR(row_mean[i], CStatistics::mean(row), 1e-12);
+		EXPECT_NEAR(row_var[i], CStatistics::variance(row), 1e-10);
+	}
+}
+
+TEST(Statistics, quantiles)
+{
+	index_t n=1001;
+	SGVector<float64_t> values(n);
+	for (index_t i=0; i<n; i++)
+		values[i]=(i*7919)%n;
+
+	SGVector<float64_t> p(4);
+	p[0]=0.9;
+	p[1]=0.0;
+	p[2]=0.25;
+	p[3]=1.0;
+
+	SGVector<float64_t> q=CStatistics::quantiles(values, p);
+	EXPECT_EQ(q[0], 900);
+	EXPECT_EQ(q[1], 0);
+	EXPECT_EQ(q[2], 250);
+	EXPECT_EQ(q[3], 1000);
+
+	/* values are not modified */
+	for (index_t i=0; i<n; i++)
+		EXPECT_EQ(values[i], (i*7919)%n);
+
+	/* interpolation between order statistics */
+	SGVector<float64_t> small(4);
+	small[0]=4;
+	small[1]=1;
+	small[2]=3;
+	small[3]=2;
+	EXPECT_NEAR(CStatistics::quantile(small, 0.5), 2.5, 1e-15);
+	EXPECT_NEAR(CStatistics::quantile(small, 0.1), 1.3, 1e-15);
+	EXPECT_EQ(CStatistics::median(small), 2);
+}
+
+#ifdef HAVE_LAPACK
+TEST(Statistics, covariance_matrix)
+{
+	index_t num_rows=2000;
+	index_t num_cols=3;
+	SGMatrix<float64_t> data(num_rows, num_cols);
+	for (index_t i=0; i<num_rows; i++)
+	{
+		data(i,0)=CMath::randn_double();
+		data(i,1)=2*data(i,0)+CMath::randn_double();
+		data(i,2)=CMath::randn_double()+5;
+	}
+
+	SGMatrix<float64_t> cov=CStatistics::covariance_matrix(data);
+
+	SGVector<float64_t> mean=CStatistics::matrix_mean(data);
+	for (index_t a=0; a<num_cols; a++)
+	{
+		for (index_t b=0; b<num_cols; b++)
+		{
+			float64_t c=0;
+			for (index_t i=0; i<num_rows; i++)
+				c+=(data(i,a)-mean[a])*(data(i,b)-mean[b]);
+
+			EXPECT_NEAR(cov(a,b), c/(num_rows-1), 1e-10);
+		}
+	}
+
+	SGMatrix<float64_t> cov_in_place=CStatistics::covariance_matrix(data, true);
+	for (index_t i=0; i<num_cols*num_cols; i++)
+		EXPECT_NEAR(cov.matrix[i], cov_in_place.matrix[i], 1e-10);
+}
+#endif // HAVE_LAPACK
+
+TEST(Statistics, streaming_mean_variance)
+{
+	index_t dim=5;
+	index_t num_vectors=1003;
+	SGMatrix<float64_t> data(dim, num_vectors);
+	for (index_t i=0; i<dim*num_vectors; i++)
+		data.matrix[i]=CMath::randn_double()*3+1e6;
+
+	CDenseFeatures<float64_t>* dense=new CDenseFeatures<float64_t>(data);
+	CStreamingDenseFeatures<float64_t>* streaming=
+			new CStreamingDenseFeatures<float64_t>(dense);
+	SG_REF(streaming);
+
+	SGVector<float64_t> mean;
+	SGVector<float64_t> variance;
+	index_t num_read=CStatistics::streaming_mean_variance(streaming, mean,
+			variance, -1, 100);
+
+	EXPECT_EQ(num_read, num_vectors);
+	SGVector<float64_t> expected_mean=CStatistics::matrix_mean(data, false);
+	SGVector<float64_t> expected_variance=CStatistics::matrix_variance(data,
+			false);
+	for (index_t i=0; i<dim; i++)
+	{
+		EXPECT_NEAR(mean[i], expected_mean[i], 1e-8);
+		EXPECT_NEAR(variance[i], expected_variance[i], 1e-8);
+	}
+
+	SG_UNREF(streaming);
+}
+
 #endif // HAVE_EIGEN3
@@ -0,0 +1,63 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society
+ */
+
+#include <shogun/lib/common.h>
+
+#ifdef HAVE_EIGEN3
+#include <shogun/lib/SGVector.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/mathematics/linalg/linop/LowRankInverseOperator.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+using namespace Eigen;
+
+TEST(LowRankInverseOperator, apply)
+{
+	CMath::init_random(3);
+	const index_t size=30;
+	const index_t rank=4;
+
+	SGVector<float64_t> diag(size);
+	SGMatrix<float64_t> z(rank, size);
+	SGVector<float64_t> b(size);
+	for (index_t i=0; i<size; ++i)
+	{
+		diag[i]=CMath::random(0.5, 2.0);
+		b[i]=CMath::randn_double();
+		for (index_t j=0; j<rank; ++j)
+			z(j,i)=CMath::randn_double();
+	}
+
+	CLowRankInverseOperator* op=new CLowRankInverseOperator(diag, z);
+	SG_REF(op);
+	SGVector<float64_t> x=op->apply(b);
+
+	Map<MatrixXd> map_z(z.matrix, z.num_rows, z.num_cols);
+	Map<VectorXd> map_d(diag.vector, diag.vlen);
+	Map<VectorXd> map_b(b.vector, b.vlen);
+	Map<VectorXd> map_x(x.vector, x.vlen);
+	MatrixXd m=map_z.transpose()*map_z;
+	m.diagonal()+=map_d;
+
+	EXPECT_NEAR((map_x-m.llt().solve(map_b)).norm(), 0.0, 1E-10);
+
+	/* without the low rank part it is the inverse of the diagonal */
+	CLowRankInverseOperator* jacobi=new CLowRankInverseOperator(diag);
+	SG_REF(jacobi);
+	x=jacobi->apply(b);
+	for (index_t i=0; i<size; ++i)
+		EXPECT_NEAR(b[i]/diag[i], x[i], 1E-12);
+
+	SG_UNREF(jacobi);
+	SG_UNREF(op);
+}
+#endif //HAVE_EIGEN3
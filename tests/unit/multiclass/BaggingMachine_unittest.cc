@@ -4,6 +4,11 @@
 #include <shogun/lib/config.h>
 #include <shogun/machine/BaggingMachine.h>
 #include <shogun/ensemble/MajorityVote.h>
+#include <shogun/machine/DecisionTree.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/evaluation/MulticlassAccuracy.h>
+#include <shogun/base/Parallel.h>
 #include <gtest/gtest.h>
 
 #ifdef USE_REFERENCE_COUNTING
@@ -22,6 +27,7 @@ TEST(BaggingMachine, mock_train)
 	using ::testing::InSequence;
 	using ::testing::Mock;
 	using ::testing::DefaultValue;
+	using ::testing::Invoke;
 
 	int32_t bag_size = 20;
 	int32_t num_bags = 10;
@@ -43,12 +49,33 @@ TEST(BaggingMachine, mock_train)
 	ON_CALL(features, get_num_vectors())
 		.WillByDefault(Return(100));
 
+	/* every bag is trained on a view of the data, and as the machine is
+	 * shared by all bags here they are trained one by one */
+	bm->parallel->set_num_threads(1);
+	ON_CALL(features, shared_clone())
+		.WillByDefault(Invoke([]() {
+			NiceMock<MockCFeatures>* view = new NiceMock<MockCFeatures>();
+			ON_CALL(*view, get_num_vectors()).WillByDefault(Return(100));
+			SG_REF(view);
+			return (CSGObject*) view;
+		}));
+	ON_CALL(labels, shared_clone())
+		.WillByDefault(Invoke([]() {
+			NiceMock<MockCLabels>* view = new NiceMock<MockCLabels>();
+			ON_CALL(*view, get_num_labels()).WillByDefault(Return(100));
+			SG_REF(view);
+			return (CSGObject*) view;
+		}));
+
 	{
 		InSequence s;
 		for (int i = 0; i < num_bags; i++) {
 			EXPECT_CALL(mm, clone())
 				.Times(1)
-				.WillRepeatedly(Return(&mm));
+				.WillRepeatedly(Invoke([&mm]() {
+					SG_REF(&mm);
+					return (CSGObject*) &mm;
+				}));
 
 			EXPECT_CALL(mm, train_machine(_))
 				.Times(1)
@@ -60,4 +87,89 @@ TEST(BaggingMachine, mock_train)
 
 	SG_UNREF(bm);
 }
+
+TEST(BaggingMachine, parallel_views)
+{
+	CMath::init_random(17);
+	SGMatrix<float64_t> data(3, 300);
+	SGVector<float64_t> labels(300);
+	for (index_t i = 0; i < 300; i++)
+	{
+		labels[i] = i%3;
+		for (index_t j = 0; j < 3; j++)
+			data(j,i) = CMath::randn_double()+(j == labels[i] ? 2.5 : 0);
+	}
+
+	CDenseFeatures<float64_t>* features = new CDenseFeatures<float64_t>(data);
+	CMulticlassLabels* lab = new CMulticlassLabels(labels);
+	SG_REF(features);
+	SG_REF(lab);
+
+	/* the bags and the seeds of their trees are drawn before the training,
+	 * so the forest does not depend on the number of threads */
+	SGVector<float64_t> outputs[2];
+	float64_t accuracy[2];
+	for (index_t t = 0; t < 2; t++)
+	{
+		CMath::init_random(7);
+		CBaggingMachine* bm = new CBaggingMachine(features, lab);
+		bm->parallel->set_num_threads(t ? 4 : 1);
+		bm->set_parallel_bags(t == 1);
+		CDecisionTree* tree = new CDecisionTree(4);
+		tree->set_num_random_features(1);
+		bm->set_machine(tree);
+		bm->set_bag_size(200);
+		bm->set_num_bags(20);
+		bm->set_combination_rule(new CMajorityVote());
+		bm->train();
+
+		CMulticlassLabels* pred = bm->apply_multiclass(features);
+		outputs[t] = pred->get_labels();
+
+		CMulticlassAccuracy* eval = new CMulticlassAccuracy();
+		accuracy[t] = bm->get_oob_error(eval);
+
+		SG_UNREF(eval);
+		SG_UNREF(pred);
+		SG_UNREF(bm);
+	}
+
+	for (index_t i = 0; i < 300; i++)
+		EXPECT_EQ(outputs[0][i], outputs[1][i]);
+	EXPECT_EQ(accuracy[0], accuracy[1]);
+	EXPECT_GT(accuracy[0], 0.8);
+
+	/* the training data was not touched */
+	EXPECT_EQ(features->get_num_vectors(), 300);
+	EXPECT_EQ(lab->get_num_labels(), 300);
+
+	SG_UNREF(lab);
+	SG_UNREF(features);
+}
+
+TEST(BaggingMachine, parallel_training_error)
+{
+	SGMatrix<int32_t> data(2, 50);
+	SGVector<float64_t> labels(50);
+	for (index_t i = 0; i < 50; i++)
+	{
+		labels[i] = i%2;
+		data(0,i) = i;
+		data(1,i) = -i;
+	}
+
+	/* trees only take real valued features, the error of the bags is raised
+	 * once the parallel training is done */
+	CBaggingMachine* bm = new CBaggingMachine(
+			new CDenseFeatures<int32_t>(data), new CMulticlassLabels(labels));
+	bm->parallel->set_num_threads(4);
+	bm->set_parallel_bags(true);
+	bm->set_machine(new CDecisionTree(2));
+	bm->set_bag_size(20);
+	bm->set_num_bags(8);
+	bm->set_combination_rule(new CMajorityVote());
+	EXPECT_THROW(bm->train(), ShogunException);
+
+	SG_UNREF(bm);
+}
 #endif
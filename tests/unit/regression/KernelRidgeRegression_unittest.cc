@@ -0,0 +1,79 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Copyright (C) 2014 Berlin Institute of Technology and Max-Planck-Society
+ */
+
+#include <shogun/lib/config.h>
+
+#if defined(HAVE_LAPACK) && defined(HAVE_EIGEN3)
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/LinearKernel.h>
+#include <shogun/kernel/NystromKernel.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/regression/KernelRidgeRegression.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static void compare_cg_to_pinv(CKernel* kernel, CApproximateKernel* preconditioner)
+{
+	CMath::init_random(17);
+	index_t num=150;
+	SGMatrix<float64_t> data(2, num);
+	SGVector<float64_t> y(num);
+	for (index_t i=0; i<num; i++)
+	{
+		data(0, i)=CMath::randn_double();
+		data(1, i)=CMath::randn_double();
+		y[i]=CMath::sin(data(0, i))+0.1*CMath::randn_double();
+	}
+
+	CDenseFeatures<float64_t>* feats=new CDenseFeatures<float64_t>(data);
+	SG_REF(feats);
+	CRegressionLabels* labels=new CRegressionLabels(y);
+
+	CKernelRidgeRegression* pinv=new CKernelRidgeRegression(0.1, kernel, labels);
+	SG_REF(pinv);
+	pinv->train(feats);
+	SGVector<float64_t> alpha_pinv=pinv->get_alphas().clone();
+
+	CKernelRidgeRegression* cg=new CKernelRidgeRegression(0.1, kernel, labels, CG);
+	SG_REF(cg);
+	cg->set_epsilon(1e-12);
+	cg->set_preconditioner(preconditioner);
+	cg->train(feats);
+	SGVector<float64_t> alpha_cg=cg->get_alphas();
+
+	ASSERT_EQ(num, alpha_cg.vlen);
+	for (index_t i=0; i<num; i++)
+		EXPECT_NEAR(alpha_pinv[i], alpha_cg[i], 1e-6);
+
+	SG_UNREF(cg);
+	SG_UNREF(pinv);
+	SG_UNREF(feats);
+}
+
+TEST(KernelRidgeRegression, cg_diagonal_preconditioner)
+{
+	compare_cg_to_pinv(new CGaussianKernel(10, 2.0), NULL);
+}
+
+TEST(KernelRidgeRegression, cg_no_batch_evaluation)
+{
+	CLinearKernel* kernel=new CLinearKernel();
+	EXPECT_FALSE(kernel->has_property(KP_BATCHEVALUATION));
+	compare_cg_to_pinv(kernel, NULL);
+}
+
+TEST(KernelRidgeRegression, cg_nystrom_preconditioner)
+{
+	compare_cg_to_pinv(new CGaussianKernel(10, 2.0),
+			new CNystromKernel(new CGaussianKernel(10, 2.0), 20));
+}
+#endif // HAVE_LAPACK && HAVE_EIGEN3
@@ -0,0 +1,198 @@
+#include <shogun/base/Parallel.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGNDArray.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/structure/DynProg.h>
+#include <shogun/structure/PlifMatrix.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static SGNDArray<float64_t> create_array3(index_t d1, index_t d2, index_t d3)
+{
+	index_t* dims=SG_MALLOC(index_t, 3);
+	dims[0]=d1;
+	dims[1]=d2;
+	dims[2]=d3;
+	return SGNDArray<float64_t>(dims, 3);
+}
+
+/* small gene finding like model with random content and signals:
+ * 4 fully connected states, a length plif on 0->1, a content plif on 1->2,
+ * everything else without plif and thus subject to long transitions */
+static CDynProg* create_dynprog(bool long_transitions)
+{
+	const int32_t num_states=4;
+	const int32_t num_svms=8;
+	const int32_t seq_len=120;
+
+	CMath::init_random(42);
+
+	SGVector<int32_t> pos(seq_len);
+	pos[0]=0;
+	for (int32_t i=1; i<seq_len; i++)
+		pos[i]=pos[i-1]+CMath::random(1, 15);
+
+	const char* acgt="ACGT";
+	SGVector<char> genestr(pos[seq_len-1]+1);
+	for (int32_t i=0; i<genestr.vlen; i++)
+		genestr[i]=acgt[CMath::random(0, 3)];
+
+	CPlifMatrix* pm=new CPlifMatrix();
+	pm->create_plifs(2, 4);
+	SGVector<int32_t> ids(2);
+	ids[0]=0;
+	ids[1]=1;
+	pm->set_plif_ids(ids);
+	SGVector<float64_t> min_values(2);
+	min_values[0]=1;
+	min_values[1]=0;
+	pm->set_plif_min_values(min_values);
+	SGVector<float64_t> max_values(2);
+	max_values[0]=200;
+	max_values[1]=300;
+	pm->set_plif_max_values(max_values);
+	SGVector<bool> use_cache(2);
+	use_cache.set_const(false);
+	pm->set_plif_use_cache(use_cache);
+	SGVector<int32_t> use_svm(2);
+	use_svm[0]=0;
+	use_svm[1]=1;
+	pm->set_plif_use_svm(use_svm);
+	SGMatrix<float64_t> limits(2, 4);
+	SGMatrix<float64_t> penalties(2, 4);
+	float64_t length_limits[4]={1, 10, 50, 200};
+	float64_t length_penalties[4]={0, -0.2, -1, -3};
+	float64_t content_limits[4]={-1, -0.1, 0.1, 1};
+	float64_t content_penalties[4]={-1, -0.5, 0.5, 1};
+	for (int32_t k=0; k<4; k++)
+	{
+		limits.matrix[k]=length_limits[k];
+		limits.matrix[4+k]=content_limits[k];
+		penalties.matrix[k]=length_penalties[k];
+		penalties.matrix[4+k]=content_penalties[k];
+	}
+	pm->set_plif_limits(limits);
+	pm->set_plif_penalties(penalties);
+
+	SGNDArray<float64_t> transition_ptrs=create_array3(num_states, num_states, 2);
+	for (int32_t i=0; i<num_states*num_states*2; i++)
+		transition_ptrs.array[i]=0;
+	transition_ptrs.array[1+0*num_states]=1;
+	transition_ptrs.array[2+1*num_states]=2;
+	pm->compute_plif_matrix(transition_ptrs);
+
+	SGMatrix<int32_t> state_signals(num_states, 1);
+	state_signals.set_const(0);
+	pm->compute_signal_plifs(state_signals);
+
+	CDynProg* dp=new CDynProg(num_svms);
+	dp->set_num_states(num_states);
+	dp->long_transition_settings(long_transitions, 100, 1000);
+	dp->set_pos(pos);
+	dp->set_gene_string(genestr);
+	dp->create_word_string();
+	dp->precompute_stop_codons();
+	dp->init_content_svm_value_array(num_svms);
+
+	SGMatrix<float64_t> dict_weights(5440, num_svms);
+	for (index_t i=0; i<dict_weights.num_rows*dict_weights.num_cols; i++)
+		dict_weights.matrix[i]=CMath::random(-0.01, 0.01);
+	dp->set_dict_weights(dict_weights);
+	dp->precompute_content_values();
+
+	SGMatrix<int32_t> mod_words(num_svms, 2);
+	mod_words.set_const(1);
+	dp->init_mod_words_array(mod_words);
+
+	SGMatrix<int32_t> orf_info(num_states, 2);
+	orf_info.set_const(-1);
+	dp->set_orf_info(orf_info);
+
+	SGVector<float64_t> p(num_states);
+	SGVector<float64_t> q(num_states);
+	for (int32_t i=0; i<num_states; i++)
+	{
+		p[i]=CMath::random(-1.0, 0.0);
+		q[i]=CMath::random(-1.0, 0.0);
+	}
+	dp->set_p_vector(p);
+	dp->set_q_vector(q);
+
+	/* transitions have to be grouped by target state */
+	SGMatrix<float64_t> a_trans(num_states*num_states, 3);
+	for (int32_t to=0; to<num_states; to++)
+	{
+		for (int32_t from=0; from<num_states; from++)
+		{
+			int32_t row=to*num_states+from;
+			a_trans(row, 0)=from;
+			a_trans(row, 1)=to;
+			a_trans(row, 2)=CMath::random(-1.0, 0.0);
+		}
+	}
+	dp->set_a_trans_matrix(a_trans);
+	EXPECT_TRUE(dp->check_svm_arrays());
+
+	/* some positions cannot be observed in some states */
+	SGNDArray<float64_t> observations=create_array3(num_states, seq_len, 1);
+	for (int32_t i=0; i<num_states*seq_len; i++)
+	{
+		if (CMath::random(0, 9)==0)
+			observations.array[i]=-CMath::INFTY;
+		else
+			observations.array[i]=CMath::random(-1.0, 1.0);
+	}
+	dp->set_observation_matrix(observations);
+
+	SGMatrix<float64_t> seg_path(2, seq_len);
+	seg_path.set_const(0);
+	dp->set_content_type_array(seg_path);
+	dp->set_plif_matrices(pm);
+
+	return dp;
+}
+
+static void check_parallel_viterbi(bool long_transitions)
+{
+	CDynProg* serial=create_dynprog(long_transitions);
+	serial->parallel->set_num_threads(1);
+	serial->compute_nbest_paths(1, false, 1, false, false);
+
+	CDynProg* parallel=create_dynprog(long_transitions);
+	parallel->parallel->set_num_threads(4);
+	parallel->compute_nbest_paths(1, false, 1, false, false);
+
+	SGVector<float64_t> serial_scores=serial->get_scores();
+	SGVector<float64_t> parallel_scores=parallel->get_scores();
+	ASSERT_EQ(1, serial_scores.vlen);
+	ASSERT_EQ(1, parallel_scores.vlen);
+	EXPECT_GT(serial_scores[0], -CMath::INFTY);
+	EXPECT_DOUBLE_EQ(serial_scores[0], parallel_scores[0]);
+
+	SGMatrix<int32_t> serial_states=serial->get_states();
+	SGMatrix<int32_t> parallel_states=parallel->get_states();
+	SGMatrix<int32_t> serial_positions=serial->get_positions();
+	SGMatrix<int32_t> parallel_positions=parallel->get_positions();
+	ASSERT_EQ(serial_states.num_rows*serial_states.num_cols,
+			parallel_states.num_rows*parallel_states.num_cols);
+	for (index_t i=0; i<serial_states.num_rows*serial_states.num_cols; i++)
+	{
+		EXPECT_EQ(serial_states.matrix[i], parallel_states.matrix[i]);
+		EXPECT_EQ(serial_positions.matrix[i], parallel_positions.matrix[i]);
+	}
+
+	SG_UNREF(serial);
+	SG_UNREF(parallel);
+}
+
+TEST(DynProg, parallel_viterbi_long_transitions)
+{
+	check_parallel_viterbi(true);
+}
+
+TEST(DynProg, parallel_viterbi_short_transitions)
+{
+	check_parallel_viterbi(false);
+}